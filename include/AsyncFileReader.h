@@ -0,0 +1,166 @@
+#ifndef ASYNC_FILE_READER_H
+#define ASYNC_FILE_READER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+/**
+ * @brief Options controlling how AsyncFileReader accesses the disk
+ */
+struct ReaderOptions
+{
+    std::size_t block_bytes;   // Size of each read (rounded up to the alignment)
+    bool direct_io;            // Bypass the page cache with O_DIRECT where supported
+    bool sequential_hint;      // Advise the kernel of sequential access (posix_fadvise)
+    bool io_uring;             // Read through MultiFileReader (io_uring where available)
+    std::size_t queue_depth;   // Reads kept in flight by MultiFileReader
+
+    /**
+     * @brief Default constructor
+     *
+     * Defaults to 4 MiB blocks, buffered I/O, a sequential access hint
+     * and the double-buffered reader (8 reads in flight if io_uring is
+     * enabled).
+     */
+    ReaderOptions()
+        : block_bytes(4 << 20),
+          direct_io(false),
+          sequential_hint(true),
+          io_uring(false),
+          queue_depth(8)
+    {}
+};
+
+/**
+ * @brief Class that prefetches a file on a dedicated thread into two buffers
+ *
+ * While the caller consumes one buffer, a background thread fills the
+ * other with the next block of the file, so parsing never waits on a
+ * disk read unless the disk is slower than the parser. Buffers are
+ * aligned to 4 KiB so they can be used with O_DIRECT.
+ *
+ * On POSIX systems the reader uses open()/read() and optionally
+ * posix_fadvise(POSIX_FADV_SEQUENTIAL) and O_DIRECT; if O_DIRECT is
+ * rejected by the filesystem it silently falls back to buffered I/O.
+ * Elsewhere it falls back to std::ifstream on the same background thread.
+ *
+ * Only one thread may consume from a reader.
+ */
+class AsyncFileReader
+{
+public:
+    /**
+     * @brief Default constructor
+     */
+    AsyncFileReader();
+
+    /**
+     * @brief Destructor - stops the background thread and releases buffers
+     */
+    ~AsyncFileReader();
+
+    AsyncFileReader(const AsyncFileReader&) = delete;
+    AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+    /**
+     * @brief Opens a file and starts prefetching
+     *
+     * @param path Path to the file
+     * @param options Block size and I/O hints
+     * @return true if the file was opened, false otherwise
+     */
+    bool open(const std::string& path, const ReaderOptions& options);
+
+    /**
+     * @brief Gets the next filled block (zero-copy)
+     *
+     * The returned view stays valid until the next call to nextBlock(),
+     * read() or close(); the buffer is then handed back to the reader.
+     *
+     * @param block Receives a view of the next block
+     * @return true if a block was returned, false at end of file or on error
+     */
+    bool nextBlock(std::string_view& block);
+
+    /**
+     * @brief Copies up to size bytes into destination
+     *
+     * @param destination Buffer to copy into
+     * @param size Maximum number of bytes to copy
+     * @return Number of bytes copied (0 at end of file)
+     */
+    std::size_t read(char* destination, std::size_t size);
+
+    /**
+     * @brief Checks whether a read error occurred
+     *
+     * @return true if the background thread stopped because of an I/O error
+     */
+    bool failed() const;
+
+    /**
+     * @brief Stops prefetching and closes the file
+     */
+    void close();
+
+    /**
+     * @brief Checks whether O_DIRECT is actually in use
+     *
+     * @return true if the file was opened with O_DIRECT
+     */
+    bool usingDirectIo() const;
+
+private:
+    /**
+     * @brief One of the two prefetch buffers
+     */
+    struct Buffer
+    {
+        char* data;          // Aligned storage of capacity_ bytes
+        std::size_t size;    // Valid bytes (0 marks end of file)
+        bool full;           // Owned by the consumer when true
+    };
+
+    /**
+     * @brief Background loop filling buffers in turn
+     */
+    void readerLoop();
+
+    /**
+     * @brief Fills a buffer from the file
+     *
+     * @param data Destination
+     * @param capacity Bytes to read
+     * @return Bytes read, 0 at end of file; sets error_ on failure
+     */
+    std::size_t fill(char* data, std::size_t capacity);
+
+    /**
+     * @brief Returns the currently held buffer to the reader thread
+     */
+    void releaseCurrent();
+
+    static constexpr std::size_t kAlignment = 4096;   // O_DIRECT alignment
+
+    int fd_;                           // POSIX file descriptor (-1 if unused)
+    std::ifstream fallback_;           // Portable fallback stream
+    bool direct_io_;                   // O_DIRECT in effect
+    std::size_t capacity_;             // Size of each buffer
+    Buffer buffers_[2];                // Double buffer
+    std::size_t consume_index_;        // Buffer the consumer reads next
+    bool holding_;                     // Consumer currently owns buffers_[consume_index_]
+    std::size_t consume_offset_;       // Read position inside the held buffer (read())
+    bool finished_;                    // Consumer has seen end of file
+    bool stop_;                        // Reader thread should exit
+    bool error_;                       // A read failed
+    mutable std::mutex mutex_;         // Guards buffer ownership flags
+    std::condition_variable changed_;  // Signals buffer state changes
+    std::thread thread_;               // Background reader
+};
+
+#endif // ASYNC_FILE_READER_H
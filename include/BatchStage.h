@@ -0,0 +1,75 @@
+#ifndef BATCH_STAGE_H
+#define BATCH_STAGE_H
+
+#include "BoundedQueue.h"
+#include "LogEntry.h"
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Class running a consumer of entry batches on its own thread
+ *
+ * The last stage of the loading pipeline: batches delivered by LogLoader
+ * are pushed into a bounded queue (see BoundedQueue) and consumed in
+ * order on a separate thread, so detection work done per batch (grouping
+ * timelines, cross-user trackers, spilling) overlaps with reading and
+ * parsing the next batches. A full queue makes push() wait, which keeps
+ * the loader from running arbitrarily far ahead of the consumer.
+ *
+ * Exactly one thread may push. An exception thrown by the consumer is
+ * kept, the remaining batches are discarded so the producer never blocks,
+ * and finish() rethrows it.
+ */
+class BatchStage
+{
+public:
+    using Consumer = std::function<void(std::vector<LogEntry>&)>;
+
+    /**
+     * @brief Constructor - starts the consumer thread
+     *
+     * @param consumer Called with each batch, in push order
+     * @param depth Batches that may wait in the queue
+     */
+    explicit BatchStage(const Consumer& consumer, std::size_t depth = 4);
+
+    /**
+     * @brief Destructor - waits for the consumer (see finish())
+     */
+    ~BatchStage();
+
+    BatchStage(const BatchStage&) = delete;
+    BatchStage& operator=(const BatchStage&) = delete;
+
+    /**
+     * @brief Hands a batch to the consumer, waiting while the queue is full
+     *
+     * @param batch Entries to consume (moved from; empty batches are skipped)
+     */
+    void push(std::vector<LogEntry>&& batch);
+
+    /**
+     * @brief Waits until every pushed batch has been consumed
+     *
+     * Ends the stream; call once after the last push(). Rethrows an
+     * exception of the consumer.
+     */
+    void finish();
+
+private:
+    /**
+     * @brief Consumer thread: pops and consumes batches until the end of the stream
+     */
+    void run();
+
+    Consumer consumer_;                             // Called with each batch
+    BoundedQueue<std::vector<LogEntry>> queue_;     // Batches not yet consumed
+    std::exception_ptr error_;                      // Exception of the consumer
+    bool finished_;                                 // finish() has joined the thread
+    std::thread thread_;                            // Consumer thread (started last)
+};
+
+#endif // BATCH_STAGE_H
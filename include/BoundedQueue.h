@@ -0,0 +1,167 @@
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Bounded lock-free single-producer/single-consumer queue
+ *
+ * A fixed-size ring buffer used to connect pipeline stages. Exactly one
+ * thread may push and exactly one thread may pop. When the queue is full
+ * the producer waits, which provides backpressure so a fast stage cannot
+ * run arbitrarily far ahead of a slow one.
+ *
+ * The producer signals end of stream with close(); pop() then returns
+ * false once all remaining items have been consumed.
+ *
+ * @tparam T Element type (must be default-constructible and movable)
+ */
+template <typename T>
+class BoundedQueue
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param capacity Maximum number of queued items (rounded up to a power of two)
+     */
+    explicit BoundedQueue(std::size_t capacity)
+        : slots_(roundUpToPowerOfTwo(capacity)),
+          mask_(slots_.size() - 1),
+          head_(0),
+          tail_(0),
+          closed_(false)
+    {
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * @brief Attempts to enqueue an item without waiting
+     *
+     * @param value Item to move into the queue
+     * @return true if the item was enqueued, false if the queue is full
+     */
+    bool tryPush(T& value)
+    {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == slots_.size())
+        {
+            return false;
+        }
+
+        slots_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Attempts to dequeue an item without waiting
+     *
+     * @param value Receives the dequeued item
+     * @return true if an item was dequeued, false if the queue is empty
+     */
+    bool tryPop(T& value)
+    {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        value = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Enqueues an item, waiting while the queue is full
+     *
+     * @param value Item to move into the queue
+     */
+    void push(T value)
+    {
+        std::size_t spins = 0;
+        while (!tryPush(value))
+        {
+            backoff(spins);
+        }
+    }
+
+    /**
+     * @brief Dequeues an item, waiting while the queue is empty
+     *
+     * @param value Receives the dequeued item
+     * @return true if an item was dequeued, false if the queue was closed and drained
+     */
+    bool pop(T& value)
+    {
+        std::size_t spins = 0;
+        while (!tryPop(value))
+        {
+            if (closed_.load(std::memory_order_acquire))
+            {
+                // Re-check: items pushed before close() must still be delivered
+                return tryPop(value);
+            }
+            backoff(spins);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Marks the end of the stream (producer side)
+     */
+    void close()
+    {
+        closed_.store(true, std::memory_order_release);
+    }
+
+private:
+    /**
+     * @brief Waits progressively longer while the other side catches up
+     *
+     * Spins briefly, then yields, then sleeps so an idle stage does not
+     * burn a full core.
+     *
+     * @param spins Number of unsuccessful attempts so far (incremented)
+     */
+    static void backoff(std::size_t& spins)
+    {
+        ++spins;
+        if (spins < 64)
+        {
+            return;
+        }
+        if (spins < 1024)
+        {
+            std::this_thread::yield();
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t value)
+    {
+        std::size_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    std::vector<T> slots_;                         // Ring storage
+    std::size_t mask_;                             // slots_.size() - 1
+    alignas(64) std::atomic<std::size_t> head_;    // Next slot to pop (consumer)
+    alignas(64) std::atomic<std::size_t> tail_;    // Next slot to push (producer)
+    std::atomic<bool> closed_;                     // Set once the producer is done
+};
+
+#endif // BOUNDED_QUEUE_H
@@ -0,0 +1,130 @@
+#ifndef CIDR_TRIE_H
+#define CIDR_TRIE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Class that checks IP addresses against a set of CIDR prefixes
+ *
+ * IPv4 and IPv6 prefixes are kept in one compressed binary (Patricia)
+ * trie over 128-bit keys; IPv4 addresses are mapped to ::ffff:a.b.c.d.
+ * Every node stores its full prefix and length, so chains of single-child
+ * nodes are skipped in one comparison and a lookup visits at most one
+ * node per branching bit, not one per address bit.
+ *
+ * Only coverage matters (is the address inside any prefix?), so a prefix
+ * that is covered by a shorter one is not stored and inserting a shorter
+ * prefix drops everything below it. A lookup therefore stops at the first
+ * prefix on its path. The nodes live in one vector and refer to each
+ * other by index, which keeps the trie compact and cache friendly.
+ */
+class CidrTrie
+{
+public:
+    /**
+     * @brief A 128-bit address (IPv4 addresses are IPv4-mapped)
+     */
+    struct Address
+    {
+        std::uint64_t high;   // Bits 0-63 (most significant first)
+        std::uint64_t low;    // Bits 64-127
+    };
+
+    /**
+     * @brief Default constructor - creates an empty set
+     */
+    CidrTrie();
+
+    /**
+     * @brief Adds a prefix
+     *
+     * @param cidr Prefix such as "10.0.0.0/8" or "2001:db8::/32"; a bare
+     *             address is a /32 (IPv4) or /128 (IPv6) prefix
+     * @return true if added, false if the prefix is invalid
+     */
+    bool insert(std::string_view cidr);
+
+    /**
+     * @brief Loads prefixes from a file, one per line
+     *
+     * Blank lines and text after '#' are ignored.
+     *
+     * @param path File to load
+     * @return true on success, false if the file cannot be read or a line
+     *         is invalid (see failedLine())
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Checks whether an address is inside any prefix
+     *
+     * @param ip_address IPv4 or IPv6 address
+     * @return true if covered, false if not or if the address is invalid
+     */
+    bool contains(std::string_view ip_address) const;
+
+    /**
+     * @brief Checks whether a parsed address is inside any prefix
+     *
+     * @param address Parsed address
+     * @return true if covered
+     */
+    bool contains(const Address& address) const;
+
+    /**
+     * @brief Gets the number of prefixes added
+     *
+     * @return Successful insert() calls, including covered prefixes
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Gets the line that made the last load fail
+     *
+     * @return 1-based line number, or 0 if the failure was not a bad line
+     */
+    std::size_t failedLine() const;
+
+    /**
+     * @brief Parses an IPv4 or IPv6 address
+     *
+     * @param text Address such as "192.168.1.10" or "fe80::1"
+     * @return The 128-bit address, or std::nullopt if invalid
+     */
+    static std::optional<Address> parseAddress(std::string_view text);
+
+private:
+    static constexpr std::uint32_t kNoChild = 0xFFFFFFFFu;   // Missing child index
+
+    /**
+     * @brief A trie node: a prefix and the subtrees below it
+     */
+    struct Node
+    {
+        Address prefix;               // Prefix bits (bits beyond length are zero)
+        std::uint8_t length;          // Prefix length (0-128)
+        bool terminal;                // An inserted prefix ends here
+        std::uint32_t children[2];    // Subtrees for the next bit 0 and 1
+    };
+
+    /**
+     * @brief Adds a parsed prefix
+     */
+    void insertPrefix(const Address& prefix, int length);
+
+    /**
+     * @brief Appends a node and returns its index
+     */
+    std::uint32_t addNode(const Address& prefix, int length, bool terminal);
+
+    std::vector<Node> nodes_;     // Nodes; index 0 is the root (length 0)
+    std::size_t prefix_count_;    // Prefixes added
+    std::size_t failed_line_;     // Line of the last load error
+};
+
+#endif // CIDR_TRIE_H
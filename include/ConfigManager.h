@@ -2,6 +2,7 @@
 #define CONFIG_MANAGER_H
 
 #include <string>
+#include <vector>
 
 /**
  * @brief Structure holding all configuration parameters for the log analyzer
@@ -15,14 +16,54 @@ struct Configuration
     // Detection thresholds
     int failed_login_threshold;      // Minimum failed attempts to trigger alert
     int time_window_minutes;         // Time window for event clustering (minutes)
+    int spray_user_threshold;        // Distinct users failing from one IP (password spraying)
+    int distributed_ip_threshold;    // Distinct IPs failing for one user (distributed brute force)
+    int max_travel_speed_kmh;        // Fastest plausible travel between logins (impossible travel)
     
     // Business hours configuration
     int business_hour_start;         // Start of business hours (0-23)
     int business_hour_end;           // End of business hours (0-23)
     
+    // Detection rules
+    std::string rules;               // Rules to run (comma-separated names, "all")
+    std::vector<std::string> rule_profiles;  // Named threshold sets evaluated together (--rule-profile)
+    
     // File paths
     std::string log_file_path;       // Path to input log file
+    std::vector<std::string> additional_log_file_paths;  // Further inputs (--add-input)
     std::string report_output_path;  // Path to output report file
+    std::string input_format;        // Line format: pipe, syslog, json or csv
+    std::string line_pattern;        // User line template (overrides input_format)
+    int syslog_year;                 // Year of syslog timestamps (0 = from each file's mtime)
+    std::string geoip_path;          // GeoIP CSV or binary table (empty = no impossible travel)
+    std::string geoip_save_path;     // Write the loaded GeoIP table in binary form
+    std::string allowlist_path;      // CIDRs whose entries are not analyzed (empty = none)
+    std::string denylist_path;       // CIDRs of known-bad networks (empty = none)
+    std::string baseline_path;       // Per-user login-hour profiles, read and updated (empty = none)
+    
+    // Parse-time filters (empty = no filtering)
+    std::string filter_user;         // Only keep entries for this username
+    std::string filter_ip;           // Only keep entries from this IP address
+    std::string filter_status;       // Only keep entries with this status (SUCCESS/FAILED)
+    
+    // Invalid-line diagnostics
+    bool verbose_errors;             // Print a warning for every invalid line
+    int max_error_samples;           // Number of invalid lines kept as samples
+    
+    // Report
+    int top_k;                       // Entries per top-activity ranking (0 = no rankings)
+    int spike_z_threshold;           // z-score of a failed-login rate spike (0 = no rate spikes)
+    int risk_top;                    // Users and IPs listed by risk score (0 = no risk scores)
+    std::string sweep;               // Threshold/window grid to count events for (empty = no sweep)
+    
+    // Execution
+    int parser_threads;              // Pipelined parser workers (0 = single-threaded)
+    bool prefetch_input;             // Read the input on a background thread
+    bool direct_io;                  // Bypass the page cache (O_DIRECT) when prefetching
+    bool use_io_uring;               // Read through io_uring with several reads in flight
+    int io_queue_depth;              // Reads in flight with --io-uring
+    int memory_limit_mb;             // Spill entries to disk above this size (0 = in memory)
+    int lateness_seconds;            // Reorder input within this lateness watermark (0 = off)
     
     /**
      * @brief Default constructor with standard values
@@ -30,18 +71,74 @@ struct Configuration
      * Initializes configuration with default values:
      * - failed_login_threshold: 5
      * - time_window_minutes: 10
+     * - spray_user_threshold: 20
+     * - distributed_ip_threshold: 10
+     * - max_travel_speed_kmh: 900
      * - business_hour_start: 8
      * - business_hour_end: 18
+     * - rules: "all"
+     * - rule_profiles: empty (global thresholds only)
      * - log_file_path: "logs/sample.log"
+     * - additional_log_file_paths: empty
      * - report_output_path: "reports/report.txt"
+     * - input_format: "pipe"
+     * - line_pattern: empty (use input_format)
+     * - syslog_year: 0 (from each file's modification time)
+     * - geoip_path, geoip_save_path: empty (no GeoIP table)
+     * - allowlist_path, denylist_path: empty (no CIDR lists)
+     * - baseline_path: empty (no login-hour profiles)
+     * - filter_user, filter_ip, filter_status: empty (no filtering)
+     * - verbose_errors: false
+     * - max_error_samples: 10
+     * - top_k: 10
+     * - spike_z_threshold: 4
+     * - risk_top: 10
+     * - sweep: empty (no threshold sweep)
+     * - parser_threads: 1
+     * - prefetch_input: true
+     * - direct_io: false
+     * - use_io_uring: false
+     * - io_queue_depth: 8
+     * - memory_limit_mb: 0 (keep all entries in memory)
+     * - lateness_seconds: 0 (no reordering)
      */
     Configuration()
         : failed_login_threshold(5),
           time_window_minutes(10),
+          spray_user_threshold(20),
+          distributed_ip_threshold(10),
+          max_travel_speed_kmh(900),
           business_hour_start(8),
           business_hour_end(18),
+          rules("all"),
+          rule_profiles(),
           log_file_path("logs/sample.log"),
-          report_output_path("reports/report.txt")
+          additional_log_file_paths(),
+          report_output_path("reports/report.txt"),
+          input_format("pipe"),
+          line_pattern(""),
+          syslog_year(0),
+          geoip_path(""),
+          geoip_save_path(""),
+          allowlist_path(""),
+          denylist_path(""),
+          baseline_path(""),
+          filter_user(""),
+          filter_ip(""),
+          filter_status(""),
+          verbose_errors(false),
+          max_error_samples(10),
+          top_k(10),
+          spike_z_threshold(4),
+          risk_top(10),
+          sweep(""),
+          parser_threads(1),
+          prefetch_input(true),
+          direct_io(false),
+          use_io_uring(false),
+          io_queue_depth(8),
+          memory_limit_mb(0),
+          lateness_seconds(0)
     {}
 };
 
@@ -73,10 +170,40 @@ public:
      * Processes command-line arguments to extract configuration parameters.
      * Supports the following arguments:
      * - --input <path>         : Path to input log file
+     * - --add-input <path>     : Further log file analyzed after --input (repeatable)
      * - --output <path>        : Path to output report file
+     * - --format-in <format>   : Input line format (pipe, syslog, json, csv)
+     * - --pattern <template>   : Line template, e.g. "%ts [%user] from %ip: %status"
+     * - --syslog-year <year>   : Year of syslog timestamps (default: from file mtime)
      * - --threshold <number>   : Failed login threshold
      * - --window <minutes>     : Time window in minutes
+     * - --spray-threshold <n>  : Distinct users per IP for password spraying
+     * - --distributed-threshold <n> : Distinct IPs per user for distributed brute force
+     * - --geoip <path>         : GeoIP table (CSV or binary) for impossible travel
+     * - --geoip-save <path>    : Write the loaded GeoIP table in binary form
+     * - --max-speed <km/h>     : Fastest plausible travel between logins
+     * - --rules <list>         : Detection rules to run
+     * - --rule-profile <spec>  : Named thresholds evaluated in the same pass (repeatable)
+     * - --allowlist <path>     : CIDRs whose entries are skipped
+     * - --denylist <path>      : CIDRs of known-bad networks to report
+     * - --baseline <path>      : Per-user login-hour profiles to compare and update
      * - --hours <start>-<end>  : Business hours (e.g., "9-17")
+     * - --user <name>          : Only analyze entries for this username
+     * - --ip <address>         : Only analyze entries from this IP address
+     * - --status <status>      : Only analyze SUCCESS or FAILED entries
+     * - --verbose-errors       : Report every invalid line individually
+     * - --error-samples <n>    : Number of invalid lines kept as samples
+     * - --top-k <n>            : Keys per top-activity ranking
+     * - --spike-z <n>          : z-score of a spike in failed logins per minute
+     * - --top <n>              : Users and IPs listed by risk score
+     * - --sweep <grid>         : Brute-force event counts per threshold and window
+     * - --threads <n>          : Parser worker threads (0 = no pipeline)
+     * - --no-prefetch          : Read the input on the parsing thread
+     * - --direct-io            : Use O_DIRECT for prefetched reads
+     * - --io-uring             : Read through io_uring (pread if unavailable)
+     * - --io-depth <n>         : Reads in flight with --io-uring
+     * - --memory-limit <MB>    : Spill parsed entries to disk above this size
+     * - --lateness <seconds>   : Reorder out-of-order input within this lateness
      * - --help                 : Display usage information
      * 
      * @param argc Argument count from main()
@@ -111,10 +238,25 @@ public:
      * Checks that all configuration parameters are within valid ranges:
      * - failed_login_threshold > 0
      * - time_window_minutes > 0
+     * - spray_user_threshold >= 2
+     * - distributed_ip_threshold >= 2
+     * - max_travel_speed_kmh > 0
+     * - geoip_save_path requires geoip_path
+     * - rules is a valid rule list
+     * - rule_profiles are valid specifications with distinct names
      * - business_hour_start in range [0, 23]
      * - business_hour_end in range [0, 23]
      * - business_hour_start < business_hour_end
      * - File paths are not empty
+     * - filter_status is empty, "SUCCESS" or "FAILED" (case-insensitive)
+     * - max_error_samples >= 0
+     * - top_k in range [0, 1000]
+     * - spike_z_threshold in range [0, 100]
+     * - risk_top in range [0, 1000]
+     * - sweep is empty or a valid grid
+     * - syslog_year is 0 or in range [1970, 9999]
+     * - parser_threads in range [0, 256]
+     * - lateness_seconds in range [0, 86400]
      * 
      * @return true if configuration is valid, false otherwise
      */
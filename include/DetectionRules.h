@@ -0,0 +1,322 @@
+#ifndef DETECTION_RULES_H
+#define DETECTION_RULES_H
+
+#include "EventDetector.h"
+#include "LogEntry.h"
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Namespace containing the detection rules and their pipeline
+ *
+ * Every rule is a stateless policy class with the same two constants:
+ *
+ *   static constexpr RuleSet kTypes;    // Event types the rule reports
+ *   static constexpr bool kPerUser;     // Only compares entries of one user
+ *
+ * A per-user rule implements
+ *
+ *   static void detectUser(const EventDetector& detector,
+ *                          const std::vector<LogEntry>& timeline,
+ *                          RuleSet enabled, EventBuckets& buckets);
+ *
+ * which sees the entries of one user in timestamp order, and a rule
+ * comparing entries across users implements detect() with the same
+ * parameters on all entries. Both append their events to the bucket of
+ * their type, using the detector's thresholds and attached tables. A rule
+ * reporting several types (such as the fused failure scan) skips the
+ * types not in enabled.
+ *
+ * RulePipeline composes rules at compile time: run() groups and sorts the
+ * entries into per-user timelines once, folds the per-user rules over each
+ * timeline and then runs the cross-user rules. Each call expands to one
+ * direct call per rule, and rules that do not fit are discarded by
+ * if constexpr, so the pipeline costs one bit test per rule and call
+ * rather than a virtual call per entry and rule. The buckets are
+ * concatenated in SuspiciousEventType order (see collectEvents()), so the
+ * output does not depend on the order of the rules.
+ *
+ * To add a rule: add its event type (and name in ruleName()), write the
+ * policy class, and append it to BuiltInRules.
+ */
+namespace DetectionRules
+{
+
+/**
+ * @brief Detected events, one vector per SuspiciousEventType
+ */
+using EventBuckets = std::array<std::vector<SuspiciousEvent>, kSuspiciousEventTypeCount>;
+
+/**
+ * @brief Gets the bucket of an event type
+ */
+inline std::vector<SuspiciousEvent>& bucketOf(EventBuckets& buckets, SuspiciousEventType type)
+{
+    return buckets[static_cast<std::size_t>(type)];
+}
+
+/**
+ * @brief Concatenates the buckets in SuspiciousEventType order
+ *
+ * After-hours and unusual-hour logins are ordered by time (they come
+ * from several timelines), the other events keep their bucket order.
+ *
+ * @param buckets Buckets filled by the rules; left empty
+ * @return The events, grouped by type in SuspiciousEventType order
+ */
+std::vector<SuspiciousEvent> collectEvents(EventBuckets& buckets);
+
+/**
+ * @brief Brute force and successes after failures, from one per-user scan
+ */
+struct FailureSequenceRule
+{
+    static constexpr RuleSet kTypes = ruleBit(SuspiciousEventType::MULTIPLE_FAILED_LOGINS) |
+                                       ruleBit(SuspiciousEventType::SUCCESS_AFTER_FAILURES);
+    static constexpr bool kPerUser = true;
+    static void detectUser(const EventDetector& detector, const std::vector<LogEntry>& timeline,
+                           RuleSet enabled, EventBuckets& buckets);
+};
+
+/**
+ * @brief Successful logins outside business hours
+ */
+struct AfterHoursRule
+{
+    static constexpr RuleSet kTypes = ruleBit(SuspiciousEventType::LOGIN_OUTSIDE_BUSINESS_HOURS);
+    static constexpr bool kPerUser = true;
+    static void detectUser(const EventDetector& detector, const std::vector<LogEntry>& timeline,
+                           RuleSet enabled, EventBuckets& buckets);
+};
+
+/**
+ * @brief Successful logins at hours the user rarely uses
+ */
+struct UnusualHourRule
+{
+    static constexpr RuleSet kTypes = ruleBit(SuspiciousEventType::UNUSUAL_LOGIN_HOUR);
+    static constexpr bool kPerUser = true;
+    static void detectUser(const EventDetector& detector, const std::vector<LogEntry>& timeline,
+                           RuleSet enabled, EventBuckets& buckets);
+};
+
+/**
+ * @brief Successful logins of one user from several IP addresses
+ */
+struct MultipleIpRule
+{
+    static constexpr RuleSet kTypes = ruleBit(SuspiciousEventType::MULTIPLE_IP_ADDRESSES);
+    static constexpr bool kPerUser = true;
+    static void detectUser(const EventDetector& detector, const std::vector<LogEntry>& timeline,
+                           RuleSet enabled, EventBuckets& buckets);
+};
+
+/**
+ * @brief Failures of one user from many distinct IP addresses
+ */
+struct DistributedBruteForceRule
+{
+    static constexpr RuleSet kTypes = ruleBit(SuspiciousEventType::DISTRIBUTED_BRUTE_FORCE);
+    static constexpr bool kPerUser = true;
+    static void detectUser(const EventDetector& detector, const std::vector<LogEntry>& timeline,
+                           RuleSet enabled, EventBuckets& buckets);
+};
+
+/**
+ * @brief Successful logins from places too far apart to travel
+ */
+struct ImpossibleTravelRule
+{
+    static constexpr RuleSet kTypes = ruleBit(SuspiciousEventType::IMPOSSIBLE_TRAVEL);
+    static constexpr bool kPerUser = true;
+    static void detectUser(const EventDetector& detector, const std::vector<LogEntry>& timeline,
+                           RuleSet enabled, EventBuckets& buckets);
+};
+
+/**
+ * @brief Login attempts from denylisted networks
+ */
+struct DenylistRule
+{
+    static constexpr RuleSet kTypes = ruleBit(SuspiciousEventType::DENYLISTED_IP);
+    static constexpr bool kPerUser = true;
+    static void detectUser(const EventDetector& detector, const std::vector<LogEntry>& timeline,
+                           RuleSet enabled, EventBuckets& buckets);
+};
+
+/**
+ * @brief Successes from an IP address after failures of several users from it
+ */
+struct IpFailureSequenceRule
+{
+    static constexpr RuleSet kTypes = ruleBit(SuspiciousEventType::SUCCESS_AFTER_FAILURES);
+    static constexpr bool kPerUser = false;
+    static void detect(const EventDetector& detector, const std::vector<LogEntry>& entries,
+                       RuleSet enabled, EventBuckets& buckets);
+};
+
+/**
+ * @brief Failures for many distinct users from one IP address
+ */
+struct PasswordSprayingRule
+{
+    static constexpr RuleSet kTypes = ruleBit(SuspiciousEventType::PASSWORD_SPRAYING);
+    static constexpr bool kPerUser = false;
+    static void detect(const EventDetector& detector, const std::vector<LogEntry>& entries,
+                       RuleSet enabled, EventBuckets& buckets);
+};
+
+/**
+ * @brief Rules composed at compile time into one detection pass
+ *
+ * @tparam Rules Rule policy classes (see the namespace description)
+ */
+template <typename... Rules>
+class RulePipeline
+{
+public:
+    static constexpr RuleSet kTypes = (RuleSet{0} | ... | Rules::kTypes);   // Types of all rules
+    static constexpr RuleSet kPerUserTypes =
+        (RuleSet{0} | ... | (Rules::kPerUser ? Rules::kTypes : RuleSet{0}));   // Types of per-user rules
+
+    /**
+     * @brief Runs the enabled rules of a scope
+     *
+     * Groups the entries into timelines once (see
+     * EventDetector::groupTimelines()) and folds the per-user rules over
+     * each of them before the cross-user rules see all entries.
+     *
+     * @tparam kPerUserOnly true to run only the rules with kPerUser
+     * @param detector Detector providing thresholds and attached tables
+     * @param entries Entries to analyze
+     * @param enabled Rules to run
+     * @return The events, grouped by type in SuspiciousEventType order
+     */
+    template <bool kPerUserOnly>
+    static std::vector<SuspiciousEvent> run(const EventDetector& detector,
+                                            const std::vector<LogEntry>& entries,
+                                            RuleSet enabled)
+    {
+        EventBuckets buckets;
+        if ((enabled & kPerUserTypes) != 0)
+        {
+            for (const auto& timeline : detector.groupTimelines(entries))
+            {
+                runUser(detector, timeline, enabled, buckets);
+            }
+        }
+        if constexpr (!kPerUserOnly)
+        {
+            (runCrossUserRule<Rules>(detector, entries, enabled, buckets), ...);
+        }
+        return collectEvents(buckets);
+    }
+
+    /**
+     * @brief Runs the enabled per-user rules on one user's timeline
+     *
+     * @param detector Detector providing thresholds and attached tables
+     * @param timeline Entries of one user in timestamp order
+     * @param enabled Rules to run
+     * @param buckets Receive the events
+     */
+    static void runUser(const EventDetector& detector, const std::vector<LogEntry>& timeline,
+                        RuleSet enabled, EventBuckets& buckets)
+    {
+        (runUserRule<Rules>(detector, timeline, enabled, buckets), ...);
+    }
+
+private:
+    /**
+     * @brief Runs one rule on a timeline if it is per-user and enabled
+     */
+    template <typename Rule>
+    static void runUserRule(const EventDetector& detector, const std::vector<LogEntry>& timeline,
+                            RuleSet enabled, EventBuckets& buckets)
+    {
+        if constexpr (Rule::kPerUser)
+        {
+            if ((enabled & Rule::kTypes) != 0)
+            {
+                Rule::detectUser(detector, timeline, enabled, buckets);
+            }
+        }
+    }
+
+    /**
+     * @brief Runs one rule on all entries if it is cross-user and enabled
+     */
+    template <typename Rule>
+    static void runCrossUserRule(const EventDetector& detector, const std::vector<LogEntry>& entries,
+                                 RuleSet enabled, EventBuckets& buckets)
+    {
+        if constexpr (!Rule::kPerUser)
+        {
+            if ((enabled & Rule::kTypes) != 0)
+            {
+                Rule::detect(detector, entries, enabled, buckets);
+            }
+        }
+    }
+};
+
+/**
+ * @brief The rules run by EventDetector::detectPerUser() and detectAll()
+ */
+using BuiltInRules = RulePipeline<FailureSequenceRule,
+                                  AfterHoursRule,
+                                  UnusualHourRule,
+                                  MultipleIpRule,
+                                  DistributedBruteForceRule,
+                                  ImpossibleTravelRule,
+                                  DenylistRule,
+                                  IpFailureSequenceRule,
+                                  PasswordSprayingRule>;
+
+/**
+ * @brief Sorts events from several runs into the order of one run
+ *
+ * Events are grouped by type in SuspiciousEventType order, as run()
+ * returns them. Within a type, after-hours and unusual-hour logins are
+ * ordered by time and all other events by username. The sort is stable.
+ *
+ * @param events Events collected from per-user runs
+ */
+void sortEventsByType(std::vector<SuspiciousEvent>& events);
+
+/**
+ * @brief Gets the command-line name of a rule
+ *
+ * @param type The event type the rule reports
+ * @return Lowercase rule name (for example "failed-logins")
+ */
+const char* ruleName(SuspiciousEventType type);
+
+/**
+ * @brief Converts a comma-separated list of rule names to a RuleSet
+ *
+ * Names are applied from left to right; "all" adds every rule and a
+ * name prefixed with '-' removes that rule. A list starting with a
+ * removal starts from all rules, so "-after-hours" runs everything
+ * except the after-hours rule.
+ *
+ * @param list Rule names separated by commas (any case)
+ * @param rules Receives the selected rules
+ * @return false if the list is empty or contains an unknown name
+ */
+bool parseRuleList(std::string_view list, RuleSet& rules);
+
+/**
+ * @brief Formats a RuleSet as a comma-separated list of rule names
+ *
+ * @param rules The rules
+ * @return "all" for every rule, else the names in SuspiciousEventType order
+ */
+std::string formatRuleList(RuleSet rules);
+
+} // namespace DetectionRules
+
+#endif // DETECTION_RULES_H
@@ -2,9 +2,14 @@
 #define EVENT_DETECTOR_H
 
 #include "LogEntry.h"
+#include "GeoIpTable.h"
+#include "CidrTrie.h"
+#include "LoginHourProfiles.h"
 #include <vector>
 #include <string>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 
 /**
  * @brief Enumeration of different types of suspicious activities
@@ -16,9 +21,38 @@ enum class SuspiciousEventType
 {
     MULTIPLE_FAILED_LOGINS,      // Brute-force attack indicator
     LOGIN_OUTSIDE_BUSINESS_HOURS, // After-hours access
-    MULTIPLE_IP_ADDRESSES         // Account compromise indicator
+    UNUSUAL_LOGIN_HOUR,           // Login at an hour the user rarely uses
+    MULTIPLE_IP_ADDRESSES,        // Account compromise indicator
+    DISTRIBUTED_BRUTE_FORCE,      // One account failing from many IPs
+    SUCCESS_AFTER_FAILURES,       // Failure burst ending in a successful login
+    IMPOSSIBLE_TRAVEL,            // Successes too far apart for the time between them
+    DENYLISTED_IP,                // Login attempts from a known-bad address
+    PASSWORD_SPRAYING             // One IP failing against many accounts
 };
 
+/**
+ * @brief Number of SuspiciousEventType values
+ */
+constexpr std::size_t kSuspiciousEventTypeCount =
+    static_cast<std::size_t>(SuspiciousEventType::PASSWORD_SPRAYING) + 1;
+
+/**
+ * @brief Set of detection rules, one bit per SuspiciousEventType
+ */
+using RuleSet = std::uint32_t;
+
+/**
+ * @brief Gets the RuleSet bit of an event type
+ */
+constexpr RuleSet ruleBit(SuspiciousEventType type)
+{
+    return RuleSet{1} << static_cast<unsigned>(type);
+}
+
+constexpr RuleSet kAllRules = (RuleSet{1} << kSuspiciousEventTypeCount) - 1;   // Every rule enabled
+
+class ProfiledDetector;
+
 /**
  * @brief Structure representing a detected suspicious event
  * 
@@ -35,6 +69,7 @@ struct SuspiciousEvent
     std::chrono::system_clock::time_point last_occurrence;  // When pattern ended
     int event_count;                                        // Number of related events
     std::string description;                                // Human-readable description
+    std::string profile;                                    // Rule profile that reported it (empty = none)
     
     /**
      * @brief Default constructor
@@ -48,7 +83,8 @@ struct SuspiciousEvent
           first_occurrence(std::chrono::system_clock::now()),
           last_occurrence(std::chrono::system_clock::now()),
           event_count(0),
-          description("") {}
+          description(""),
+          profile("") {}
     
     /**
      * @brief Parameterized constructor
@@ -72,7 +108,8 @@ struct SuspiciousEvent
           first_occurrence(first_time),
           last_occurrence(last_time),
           event_count(count),
-          description("") {}
+          description(""),
+          profile("") {}
 };
 
 /**
@@ -85,7 +122,13 @@ struct SuspiciousEvent
  * Detection capabilities:
  * - Multiple failed login attempts (brute-force indicators)
  * - Logins outside defined business hours
+ * - Logins at hours a user rarely uses (with per-user baseline profiles)
  * - Logins from multiple IP addresses in short time windows
+ * - Distributed brute force: failures for one user from many distinct IPs
+ * - Successful logins right after a burst of failures (likely compromise)
+ * - Impossible travel between successful logins (with a GeoIP table)
+ * - Login attempts from denylisted networks (with a denylist)
+ * - Password spraying: failures for many distinct users from one IP
  */
 class EventDetector 
 {
@@ -133,6 +176,43 @@ public:
     std::vector<SuspiciousEvent> detectMultipleFailedLogins(
         const std::vector<LogEntry>& entries) const;
     
+    /**
+     * @brief Detects successful logins that end a burst of failed attempts
+     * 
+     * A success preceded by at least the failed-login threshold of failures
+     * for the same user within the time window means the attack most
+     * likely worked. Each burst is reported once, at the first success
+     * after it, with the winning IP address and the number of failures;
+     * the description also tells how many failures came from that IP.
+     * 
+     * Runs in the same per-user pass as detectMultipleFailedLogins()
+     * (see scanUserFailures()), so detectPerUser() gets both from one
+     * walk over each user's timeline. Failures of several users from one
+     * IP address are detected by detectSuccessAfterIpFailures().
+     * 
+     * @param entries Vector of log entries to analyze
+     * @return Vector of SUCCESS_AFTER_FAILURES events
+     */
+    std::vector<SuspiciousEvent> detectSuccessAfterFailures(
+        const std::vector<LogEntry>& entries) const;
+    
+    /**
+     * @brief Detects successful logins from an IP address that ends a
+     *        burst of failures from that address
+     * 
+     * The per-IP half of detectSuccessAfterFailures(): at least the
+     * failed-login threshold of failures from one IP address within the
+     * time window, for any users, followed by a success of any user from
+     * that address. Bursts whose failures are all for the user that logged
+     * in are left to the per-user detector. Compares entries across users,
+     * so it is not part of detectPerUser(); see IpFailureTracker.
+     * 
+     * @param entries Vector of log entries to analyze
+     * @return Vector of SUCCESS_AFTER_FAILURES events, ordered by success
+     */
+    std::vector<SuspiciousEvent> detectSuccessAfterIpFailures(
+        const std::vector<LogEntry>& entries) const;
+    
     /**
      * @brief Detects successful logins outside business hours
      * 
@@ -140,15 +220,42 @@ public:
      * configured business hours, which may indicate unauthorized access
      * or policy violations.
      * 
+     * The after-hours logins of one user from one IP address during one
+     * night (from the end of business hours to the next start) are merged
+     * into a single event with their count and time span, so a service
+     * account logging in every minute yields one event per night.
+     * 
      * @param entries Vector of log entries to analyze
-     * @return Vector of SuspiciousEvent objects for after-hours logins
+     * @return Vector of SuspiciousEvent objects, one per user, IP address
+     *         and night, in order of their first login in the input
      * 
      * @note Only considers entries with LoginStatus::SUCCESS
      * @note Business hours are defined by business_hour_start_ and business_hour_end_
+     * @note Users with an established baseline profile (see
+     *       setLoginHourProfiles()) are judged by detectUnusualLoginHours() instead
      */
     std::vector<SuspiciousEvent> detectLoginsOutsideBusinessHours(
         const std::vector<LogEntry>& entries) const;
     
+    /**
+     * @brief Detects successful logins at hours the user rarely uses
+     * 
+     * Looks up each user's baseline profile (logins per hour of the week
+     * learned in earlier runs). Once a profile holds kMinProfileLogins
+     * logins, a login is reported if the profile's share of the login's
+     * hour and the hours before and after it is below kRareHourShare.
+     * Night-shift staff are thus judged by their own habits rather than
+     * by the global business hours.
+     * 
+     * @param entries Vector of log entries to analyze
+     * @return Vector of UNUSUAL_LOGIN_HOUR events, one per login
+     * 
+     * @note Only considers entries with LoginStatus::SUCCESS
+     * @note Returns nothing unless profiles are attached (setLoginHourProfiles())
+     */
+    std::vector<SuspiciousEvent> detectUnusualLoginHours(
+        const std::vector<LogEntry>& entries) const;
+    
     /**
      * @brief Detects logins from multiple IP addresses for the same user
      * 
@@ -165,19 +272,310 @@ public:
     std::vector<SuspiciousEvent> detectMultipleIPAddresses(
         const std::vector<LogEntry>& entries) const;
     
+    /**
+     * @brief Detects successful logins from places too far apart to travel
+     * 
+     * Locates the IP address of every successful login with the attached
+     * GeoIpTable and compares each user's consecutive located successes:
+     * if they are at least kMinTravelKm apart and the distance divided by
+     * the time between them exceeds the maximum travel speed, the pair is
+     * reported. Unlike detectMultipleIPAddresses() this ignores address
+     * changes within one region, as caused by VPNs and mobile networks.
+     * 
+     * @param entries Vector of log entries to analyze
+     * @return Vector of IMPOSSIBLE_TRAVEL events; ip_addresses holds the
+     *         earlier and the later address
+     * 
+     * @note Only considers entries with LoginStatus::SUCCESS
+     * @note Returns nothing unless a table is attached (setGeoIpTable())
+     */
+    std::vector<SuspiciousEvent> detectImpossibleTravel(
+        const std::vector<LogEntry>& entries) const;
+    
+    /**
+     * @brief Detects login attempts from denylisted IP addresses
+     * 
+     * Checks the IP address of every entry against the attached denylist
+     * (one trie lookup each) and reports each user and denylisted address
+     * once, with the number of attempts and how many of them succeeded.
+     * 
+     * @param entries Vector of log entries to analyze
+     * @return Vector of DENYLISTED_IP events
+     * 
+     * @note Considers entries of any status
+     * @note Returns nothing unless a denylist is attached (setDenylist())
+     */
+    std::vector<SuspiciousEvent> detectDenylisted(
+        const std::vector<LogEntry>& entries) const;
+    
+    /**
+     * @brief Detects distributed brute-force attacks on single accounts
+     * 
+     * Identifies users whose failed logins come from at least the
+     * distributed threshold of distinct IP addresses within the time
+     * window, as produced by botnets that stay below per-IP limits.
+     * Distinct IPs are counted with a SlidingDistinctCounter per user,
+     * so each failure costs amortized O(1) and memory stays bounded
+     * however many addresses take part.
+     * 
+     * A detection lasts while the count stays at or above the threshold
+     * and is reported once, with the largest count observed and up to
+     * five of the participating IP addresses.
+     * 
+     * @param entries Vector of log entries to analyze
+     * @return Vector of DISTRIBUTED_BRUTE_FORCE events
+     * 
+     * @note Only considers entries with LoginStatus::FAILED
+     */
+    std::vector<SuspiciousEvent> detectDistributedBruteForce(
+        const std::vector<LogEntry>& entries) const;
+    
+    /**
+     * @brief Detects password spraying from single IP addresses
+     * 
+     * Identifies IP addresses whose failed logins within the time window
+     * cover at least the spraying threshold of distinct usernames. Distinct
+     * users are counted with a bounded-memory sketch per active IP (see
+     * PasswordSprayTracker).
+     * 
+     * @param entries Vector of log entries to analyze
+     * @return Vector of PASSWORD_SPRAYING events ordered by first failure
+     * 
+     * @note Only considers entries with LoginStatus::FAILED
+     * @note The event's username is empty; ip_addresses holds the source IP
+     */
+    std::vector<SuspiciousEvent> detectPasswordSpraying(
+        const std::vector<LogEntry>& entries) const;
+    
+    /**
+     * @brief Runs the detectors that examine one user at a time
+     * 
+     * Failed logins, successes after failures, after-hours logins,
+     * unusual login hours, multiple IP addresses, distributed brute force, impossible travel
+     * and denylisted addresses only compare entries of the same user, so they can be run on each
+     * user's entries separately (as the external-memory mode does).
+     * 
+     * Groups the entries into timelines once (see groupTimelines()) and
+     * runs the enabled per-user rules of DetectionRules::BuiltInRules on
+     * each timeline in turn (see setEnabledRules()).
+     * 
+     * @param entries Vector of log entries to analyze
+     * @return Vector containing the events of the per-user detectors,
+     *         grouped by event type in SuspiciousEventType order
+     */
+    std::vector<SuspiciousEvent> detectPerUser(
+        const std::vector<LogEntry>& entries) const;
+    
     /**
      * @brief Runs all detection methods on the provided log entries
      * 
-     * Convenience method that executes all available detection algorithms
-     * and returns a combined list of all detected suspicious events.
+     * Convenience method that executes all enabled detection rules
+     * (see setEnabledRules()) and returns a combined list of all detected
+     * suspicious events.
      * 
      * @param entries Vector of log entries to analyze
-     * @return Vector containing all detected suspicious events from all detectors
+     * @return Vector containing all detected suspicious events from all detectors,
+     *         grouped by event type in SuspiciousEventType order
      */
     std::vector<SuspiciousEvent> detectAll(
         const std::vector<LogEntry>& entries) const;
+    
+    /**
+     * @brief Groups entries into one timeline per user
+     * 
+     * Copies every entry once into its user's timeline (see UserTimelines)
+     * and sorts each timeline by timestamp. All per-user rules of
+     * DetectionRules::BuiltInRules run on these timelines, so the entries
+     * are grouped and sorted once per detection pass rather than once per rule.
+     * 
+     * @param entries Entries of any users, in any order
+     * @return One timeline per user in timestamp order, ordered by username
+     */
+    std::vector<std::vector<LogEntry>> groupTimelines(
+        const std::vector<LogEntry>& entries) const;
+    
+    /**
+     * @brief Sorts timelines that were grouped elsewhere by timestamp
+     * 
+     * @param timelines Timelines of single users (see UserTimelines::release())
+     */
+    void sortTimelines(std::vector<std::vector<LogEntry>>& timelines) const;
+    
+    /**
+     * @brief Runs the per-user rules on timelines grouped beforehand
+     * 
+     * Gives the events of detectPerUser() without grouping the entries again.
+     * 
+     * @param timelines One timeline per user, each in timestamp order
+     * @return Vector containing the events of the per-user detectors,
+     *         grouped by event type in SuspiciousEventType order
+     */
+    std::vector<SuspiciousEvent> detectTimelines(
+        const std::vector<std::vector<LogEntry>>& timelines) const;
+    
+    /**
+     * @brief Runs the per-user rules on timelines grouped while loading
+     *        and adds the events of the cross-user rules
+     * 
+     * The cross-user rules are streamed (PasswordSprayTracker and
+     * IpFailureTracker) while the input is loaded; their events join the
+     * per-user events of their type, so with the trackers fed the entries
+     * in timestamp order this gives the events of detectAll().
+     * 
+     * @param timelines One timeline per user, each in timestamp order
+     * @param cross_user_events Events of the cross-user trackers
+     * @return Vector containing all detected events, grouped by event
+     *         type in SuspiciousEventType order
+     */
+    std::vector<SuspiciousEvent> detectTimelines(
+        const std::vector<std::vector<LogEntry>>& timelines,
+        std::vector<SuspiciousEvent> cross_user_events) const;
+    
+    /**
+     * @brief Runs the per-user rules on one user's timeline
+     * 
+     * @param timeline Entries of one user in timestamp order (such as a
+     *                 merged run in external-memory mode)
+     * @return Vector containing the events of the per-user detectors,
+     *         grouped by event type in SuspiciousEventType order
+     */
+    std::vector<SuspiciousEvent> detectTimeline(
+        const std::vector<LogEntry>& timeline) const;
+    
+    /**
+     * @brief Scans one user's failures and successes in one pass
+     * 
+     * While walking the timeline, failures are collected for the
+     * brute-force sliding window, and a small state machine tracks the
+     * failures since the last reported burst: a success with at least
+     * failed_login_threshold_ of them within the time window is reported.
+     * 
+     * @param timeline Entries of one user in timestamp order
+     * @param brute_force Receives MULTIPLE_FAILED_LOGINS events, or nullptr
+     * @param compromises Receives SUCCESS_AFTER_FAILURES events, or nullptr
+     */
+    void scanUserFailures(const std::vector<LogEntry>& timeline,
+                          std::vector<SuspiciousEvent>* brute_force,
+                          std::vector<SuspiciousEvent>* compromises) const;
+    
+    /**
+     * @brief detectMultipleIPAddresses() for one user's timeline
+     * 
+     * @param timeline Entries of one user in timestamp order
+     * @param events Receives the MULTIPLE_IP_ADDRESSES events
+     */
+    void detectUserMultipleIPAddresses(const std::vector<LogEntry>& timeline,
+                                       std::vector<SuspiciousEvent>& events) const;
+    
+    /**
+     * @brief detectDistributedBruteForce() for one user's timeline
+     * 
+     * @param timeline Entries of one user in timestamp order
+     * @param events Receives the DISTRIBUTED_BRUTE_FORCE events
+     */
+    void detectUserDistributedBruteForce(const std::vector<LogEntry>& timeline,
+                                         std::vector<SuspiciousEvent>& events) const;
+    
+    /**
+     * @brief detectImpossibleTravel() for one user's timeline
+     * 
+     * @param timeline Entries of one user in timestamp order
+     * @param events Receives the IMPOSSIBLE_TRAVEL events
+     */
+    void detectUserImpossibleTravel(const std::vector<LogEntry>& timeline,
+                                    std::vector<SuspiciousEvent>& events) const;
+    
+    /**
+     * @brief detectDenylisted() for one user's timeline
+     * 
+     * @param timeline Entries of one user
+     * @param events Receives the DENYLISTED_IP events, ordered by IP address
+     */
+    void detectUserDenylisted(const std::vector<LogEntry>& timeline,
+                              std::vector<SuspiciousEvent>& events) const;
+    
+    /**
+     * @brief Declares whether entries are passed in timestamp order
+     * 
+     * Authentication logs are normally written in time order. When the
+     * caller knows this (for example from LoadStatistics::out_of_order_entries)
+     * the windowed detectors skip sorting each user's entries.
+     * 
+     * @param ordered true if no entry is older than the entry before it
+     * 
+     * @note Passing true for unordered input gives wrong results
+     */
+    void setInputTimeOrdered(bool ordered);
+    
+    /**
+     * @brief Sets the distinct-user threshold for password spraying
+     * 
+     * @param threshold Minimum distinct usernames failing from one IP
+     *                  within the time window (default 20)
+     */
+    void setSprayingThreshold(int threshold);
+    
+    /**
+     * @brief Sets the distinct-IP threshold for distributed brute force
+     * 
+     * @param threshold Minimum distinct IP addresses with failed logins
+     *                  for one user within the time window (default 10)
+     */
+    void setDistributedThreshold(int threshold);
+    
+    /**
+     * @brief Attaches the GeoIP table used for impossible travel
+     * 
+     * @param table Loaded table, or nullptr to disable the detection.
+     *              Must outlive detection.
+     */
+    void setGeoIpTable(const GeoIpTable* table);
+    
+    /**
+     * @brief Sets the fastest plausible travel speed
+     * 
+     * @param speed_kmh Speed in km/h above which travel is impossible
+     *                  (default 900, about a passenger jet)
+     */
+    void setMaxTravelSpeed(double speed_kmh);
+    
+    /**
+     * @brief Attaches the denylist of known-bad networks
+     * 
+     * @param deny_list Loaded prefixes, or nullptr to disable the detection.
+     *                  Must outlive detection.
+     */
+    void setDenylist(const CidrTrie* deny_list);
+    
+    /**
+     * @brief Attaches the per-user login-hour baselines
+     * 
+     * @param profiles Loaded profiles, or nullptr to disable the detection.
+     *                 Must outlive detection.
+     */
+    void setLoginHourProfiles(const LoginHourProfiles* profiles);
+    
+    /**
+     * @brief Selects the rules run by detectPerUser() and detectAll()
+     * 
+     * @param rules One bit per event type (see ruleBit() and
+     *              DetectionRules::parseRuleList()); default kAllRules
+     */
+    void setEnabledRules(RuleSet rules);
+    
+    /**
+     * @brief Gets the rules run by detectPerUser() and detectAll()
+     */
+    RuleSet enabledRules() const;
+    
+    static constexpr std::uint32_t kMinProfileLogins = 20;   // Logins before a profile is trusted
+    static constexpr double kRareHourShare = 0.01;           // Share of logins below which an hour is rare
+    static constexpr double kMinTravelKm = 200.0;   // GeoIP locations are often off by 100 km
 
 private:
+    // Overrides thresholds per profile
+    friend class ProfiledDetector;
+    
     /**
      * @brief Helper function to check if two timestamps are within time window
      * 
@@ -189,6 +587,18 @@ private:
         std::chrono::system_clock::time_point time1,
         std::chrono::system_clock::time_point time2) const;
     
+    /**
+     * @brief Runs scanUserFailures() on every user of a flat entry list
+     * 
+     * @param entries Vector of log entries to analyze
+     * @param brute_force Receives MULTIPLE_FAILED_LOGINS events, or nullptr
+     * @param compromises Receives SUCCESS_AFTER_FAILURES events, or nullptr
+     *                    (successes are then not even grouped)
+     */
+    void scanFailureSequences(const std::vector<LogEntry>& entries,
+                              std::vector<SuspiciousEvent>* brute_force,
+                              std::vector<SuspiciousEvent>* compromises) const;
+    
     /**
      * @brief Helper function to extract hour from timestamp
      * 
@@ -197,11 +607,34 @@ private:
      */
     int getHourOfDay(std::chrono::system_clock::time_point timestamp) const;
     
+    /**
+     * @brief Sorts one user's entries by timestamp (earliest first)
+     * 
+     * Adapts to how disordered the entries are:
+     * - Nothing is done if the input was declared time-ordered or
+     *   the entries turn out to be sorted already
+     * - Insertion sort fixes a few out-of-place entries in linear time
+     * - A radix sort on the integer timestamps handles the rest
+     * 
+     * The sort is stable, so entries with equal timestamps keep input order.
+     * 
+     * @param entries Entries of a single user
+     */
+    void sortByTimestamp(std::vector<LogEntry>& entries) const;
+    
     // Configuration parameters
     int failed_login_threshold_;    // Minimum failed attempts for detection
     int time_window_minutes_;       // Time window for event clustering
     int business_hour_start_;       // Start of business hours (0-23)
     int business_hour_end_;         // End of business hours (0-23)
+    int spray_user_threshold_;      // Distinct users per IP for password spraying
+    int distributed_ip_threshold_;  // Distinct IPs per user for distributed brute force
+    const GeoIpTable* geo_ip_table_;  // Locations for impossible travel (optional)
+    double max_travel_speed_kmh_;   // Fastest plausible travel speed
+    const CidrTrie* deny_list_;     // Known-bad networks (optional)
+    const LoginHourProfiles* login_hour_profiles_;  // Per-user baselines (optional)
+    bool input_time_ordered_;       // Entries are passed in timestamp order
+    RuleSet enabled_rules_;         // Rules run by detectPerUser() and detectAll()
 };
 
 #endif // EVENT_DETECTOR_H
\ No newline at end of file
@@ -0,0 +1,262 @@
+#ifndef EXTERNAL_ENTRY_STORE_H
+#define EXTERNAL_ENTRY_STORE_H
+
+#include "LogEntry.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Class that holds log entries in sorted runs on disk
+ *
+ * Used when the input does not fit into memory. Entries are assigned to
+ * one of a fixed number of partitions by a hash of their username and
+ * buffered in memory. Whenever the buffered entries exceed the memory
+ * budget, every partition buffer is sorted by (username, timestamp) and
+ * appended to that partition's spill file as one run, in a compact
+ * binary form.
+ *
+ * forEachUser() then processes one partition at a time: the runs of the
+ * partition are combined with a k-way merge over a min-heap, which yields
+ * the entries of each user contiguously and in time order. A merge reads
+ * at most fanIn() runs at once, each through its own file descriptor and
+ * read buffer sized from the memory limit. A partition with more runs is
+ * first merged in passes, fanIn() runs into one longer run at a time,
+ * until a single merge can read them all. Only the read buffers and the
+ * entries of a single user are then held in memory.
+ *
+ * Because all entries of a user land in the same partition, per-user
+ * detectors see exactly the data they would see in memory.
+ *
+ * Every entry is numbered in the order it was added, and entries with
+ * equal keys are ordered by that number, so the entries of a user come
+ * back as after a stable sort. forEachInTimeOrder() visits all entries
+ * by timestamp for the detectors that compare users (see
+ * IpFailureTracker), which must see out-of-order input sorted.
+ *
+ * Spill files are created in the system temporary directory (or the
+ * given directory) and removed by the destructor.
+ */
+class ExternalEntryStore
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param memory_limit_bytes Buffered bytes that trigger a spill to disk
+     * @param directory Directory for spill files (empty = system temporary directory)
+     * @param partitions Number of user-hash partitions (at least 1)
+     * @param max_fan_in Upper bound on runs read by one merge (0 = only
+     *        the memory limit and the descriptor limit apply)
+     */
+    ExternalEntryStore(std::size_t memory_limit_bytes,
+                       const std::string& directory = "",
+                       std::size_t partitions = 16,
+                       std::size_t max_fan_in = 0);
+
+    /**
+     * @brief Destructor - removes the spill files
+     */
+    ~ExternalEntryStore();
+
+    ExternalEntryStore(const ExternalEntryStore&) = delete;
+    ExternalEntryStore& operator=(const ExternalEntryStore&) = delete;
+
+    /**
+     * @brief Adds an entry, spilling buffered entries if over the budget
+     *
+     * @param entry The entry to store
+     * @return true on success, false if a spill file could not be written
+     */
+    bool add(const LogEntry& entry);
+
+    /**
+     * @brief Visits the entries of every user, sorted by timestamp
+     *
+     * Users are visited partition by partition; within a partition in
+     * username order. The store is left empty afterwards.
+     *
+     * @param visit Called once per user with that user's entries
+     * @return true on success, false if a spill file could not be read or written
+     */
+    bool forEachUser(const std::function<void(std::vector<LogEntry>&)>& visit);
+
+    /**
+     * @brief Visits all entries sorted by timestamp
+     *
+     * Entries with equal timestamps are visited in the order they were
+     * added, as after a stable sort of the input. If nothing was spilled
+     * the buffered entries are sorted in place. Otherwise every buffer is
+     * spilled first; then the spill files are read once, copied into
+     * time-sorted runs of their own within the memory limit, and those
+     * are merged like the runs of a partition. The store keeps its
+     * entries, so forEachUser() can still be called afterwards.
+     *
+     * @param visit Called once per entry, in time order
+     * @return true on success, false if a spill file could not be read or written
+     */
+    bool forEachInTimeOrder(const std::function<void(const LogEntry&)>& visit);
+
+    /**
+     * @brief Gets the number of entries added
+     *
+     * @return Total entries, whether buffered or on disk
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Gets the number of runs written to disk
+     *
+     * @return Runs over all partitions (0 if everything fit into memory)
+     */
+    std::size_t runCount() const;
+
+    /**
+     * @brief Gets the number of runs a merge reads at once
+     *
+     * @return Runs whose read buffers fit into the memory limit, bounded by
+     *         half the open file limit (at least 2)
+     */
+    std::size_t fanIn() const;
+
+private:
+    /**
+     * @brief A stored entry and the order it was added in
+     */
+    struct Record
+    {
+        LogEntry entry;           // The entry
+        std::uint64_t arrival;    // Number of entries added before it
+    };
+
+    /**
+     * @brief Strict weak order of records in runs and merges
+     */
+    using RecordLess = bool (*)(const Record&, const Record&);
+
+    /**
+     * @brief A sorted run inside a partition's spill file
+     */
+    struct Run
+    {
+        std::uint64_t offset;    // Byte offset of the first record
+        std::size_t count;       // Number of records
+    };
+
+    /**
+     * @brief Entries of one user-hash partition (or the time-sorted copy)
+     */
+    struct Partition
+    {
+        std::vector<Record> buffer;     // Entries not yet spilled
+        std::vector<Run> runs;          // Runs already on disk
+        std::uint64_t file_size;        // Bytes written to the spill file
+        std::string path;               // Spill file (empty until first spill)
+    };
+
+    /**
+     * @brief Sorts every non-empty partition buffer and writes it as a run
+     *
+     * @return true on success, false on a write error
+     */
+    bool spill();
+
+    /**
+     * @brief Sorts one partition buffer and appends it to its spill file
+     *
+     * @return true on success, false on a write error
+     */
+    bool spillPartition(std::size_t index);
+
+    /**
+     * @brief Sorts a buffer in the given order and appends it as a run
+     *
+     * @return true on success, false on a write error
+     */
+    bool spillRun(Partition& partition, RecordLess less) const;
+
+    /**
+     * @brief Reads every record of a partition's spill file, in file order
+     *
+     * @return true on success, false on a read error or if consume failed
+     */
+    bool readAll(const Partition& partition,
+                 const std::function<bool(const Record&)>& consume) const;
+
+    /**
+     * @brief Merges the runs of a partition and visits its users
+     *
+     * @return true on success, false on a read error
+     */
+    bool mergePartition(Partition& partition,
+                        const std::function<void(std::vector<LogEntry>&)>& visit);
+
+    /**
+     * @brief Merges every fanIn() consecutive runs of a partition into one
+     *
+     * The merged runs are written to a new file that replaces the
+     * partition's spill file.
+     *
+     * @param partition Partition whose runs are merged
+     * @param less Order of the runs
+     * @return true on success, false on a read or write error
+     */
+    bool mergePass(Partition& partition, RecordLess less) const;
+
+    /**
+     * @brief Merges consecutive runs of a spill file
+     *
+     * @param path Spill file holding the runs
+     * @param runs Runs of the file
+     * @param first Index of the first run to merge
+     * @param count Number of runs to merge (at most fanIn())
+     * @param less Order of the runs
+     * @param consume Called with each record in order; returns false to fail the merge
+     * @return true on success, false on a read error or if consume failed
+     */
+    bool mergeRuns(const std::string& path, const std::vector<Run>& runs,
+                   std::size_t first, std::size_t count, RecordLess less,
+                   const std::function<bool(Record&)>& consume) const;
+
+    /**
+     * @brief Orders records by username, then by timestamp and arrival
+     */
+    static bool userOrderLess(const Record& a, const Record& b);
+
+    /**
+     * @brief Orders records by timestamp, then by arrival
+     */
+    static bool timeOrderLess(const Record& a, const Record& b);
+
+    /**
+     * @brief Approximate memory held by a buffered record
+     */
+    static std::size_t recordBytes(const Record& record);
+
+    /**
+     * @brief Writes a record in binary form
+     */
+    static void writeRecord(std::ostream& output, const Record& record);
+
+    /**
+     * @brief Reads a binary record written by writeRecord()
+     *
+     * @return true if a complete record was read
+     */
+    static bool readRecord(std::istream& input, Record& record);
+
+    std::size_t memory_limit_;               // Budget for buffered entries
+    std::size_t run_buffer_bytes_;           // Read buffer of each run during a merge
+    std::size_t fan_in_;                     // Runs read by one merge
+    std::string directory_;                  // Directory for spill files
+    std::vector<Partition> partitions_;      // User-hash partitions
+    std::string ordered_path_;               // Spill file of forEachInTimeOrder()
+    std::size_t buffered_bytes_;             // Approximate bytes in all buffers
+    std::size_t size_;                       // Entries added
+    std::size_t run_count_;                  // Runs written
+};
+
+#endif // EXTERNAL_ENTRY_STORE_H
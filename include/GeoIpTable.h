@@ -0,0 +1,143 @@
+#ifndef GEO_IP_TABLE_H
+#define GEO_IP_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief A range of IPv4 addresses located at one place
+ *
+ * Fixed-size and trivially copyable, so an array of ranges can be written
+ * to disk and mapped back into memory as is.
+ */
+struct GeoIpRange
+{
+    std::uint32_t first;     // First address of the range (host byte order)
+    std::uint32_t last;      // Last address of the range (inclusive)
+    float latitude;          // Degrees, north positive
+    float longitude;         // Degrees, east positive
+    char country[4];         // Country code, NUL-padded (may be empty)
+};
+
+/**
+ * @brief Class that maps IPv4 addresses to locations
+ *
+ * The table is loaded from a local GeoIP CSV file with one range per line:
+ *
+ *     first_ip,last_ip,latitude,longitude[,country]
+ *
+ * Addresses are dotted quads or 32-bit integers; blank lines, lines
+ * starting with '#' and a header line are skipped, and fields may be
+ * quoted. The ranges are compiled into an array sorted by first address,
+ * so a lookup is one binary search and allocates nothing.
+ *
+ * saveBinary() writes the compiled array behind a small header. load()
+ * recognizes that form and maps the file into memory (read into memory
+ * where mmap is not available), which makes loading a large table with
+ * millions of ranges nearly free.
+ */
+class GeoIpTable
+{
+public:
+    /**
+     * @brief Default constructor - creates an empty table
+     */
+    GeoIpTable();
+
+    /**
+     * @brief Destructor - unmaps a mapped binary table
+     */
+    ~GeoIpTable();
+
+    GeoIpTable(const GeoIpTable&) = delete;
+    GeoIpTable& operator=(const GeoIpTable&) = delete;
+
+    /**
+     * @brief Loads a table from a CSV file or its binary form
+     *
+     * @param path File to load
+     * @return true on success, false if the file cannot be read, a line is
+     *         invalid (see failedLine()) or ranges overlap (or, in a binary
+     *         file, are not sorted)
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Writes the compiled table in binary form
+     *
+     * @param path File to write
+     * @return true on success, false if the file cannot be written
+     */
+    bool saveBinary(const std::string& path) const;
+
+    /**
+     * @brief Finds the range containing an address
+     *
+     * @param ip_address Dotted-quad IPv4 address
+     * @return The range, or nullptr if the address is invalid or unknown
+     */
+    const GeoIpRange* lookup(std::string_view ip_address) const;
+
+    /**
+     * @brief Gets the number of ranges
+     *
+     * @return Ranges in the table
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Gets the line that made the last CSV load fail
+     *
+     * @return 1-based line number, or 0 if the failure was not a bad line
+     */
+    std::size_t failedLine() const;
+
+    /**
+     * @brief Parses a dotted-quad IPv4 address
+     *
+     * @param text Address such as "192.168.1.10"
+     * @return The address in host byte order, or std::nullopt if invalid
+     */
+    static std::optional<std::uint32_t> parseIPv4(std::string_view text);
+
+    /**
+     * @brief Computes the great-circle distance between two ranges
+     *
+     * @return Distance in kilometers (haversine formula)
+     */
+    static double distanceKm(const GeoIpRange& from, const GeoIpRange& to);
+
+private:
+    /**
+     * @brief Loads the CSV form
+     */
+    bool loadCsv(const std::string& path);
+
+    /**
+     * @brief Maps (or reads) the binary form
+     */
+    bool loadBinary(const std::string& path);
+
+    /**
+     * @brief Sorts the owned ranges and rejects overlaps
+     */
+    bool compile();
+
+    /**
+     * @brief Releases the owned or mapped ranges
+     */
+    void clear();
+
+    std::vector<GeoIpRange> owned_;   // Ranges loaded from CSV (or read)
+    const GeoIpRange* ranges_;        // Sorted ranges (owned_ or the mapping)
+    std::size_t count_;               // Number of ranges
+    void* mapping_;                   // Mapped binary file, or nullptr
+    std::size_t mapping_size_;        // Size of the mapping in bytes
+    std::size_t failed_line_;         // Line of the last CSV error
+};
+
+#endif // GEO_IP_TABLE_H
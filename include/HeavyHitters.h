@@ -0,0 +1,116 @@
+#ifndef HEAVY_HITTERS_H
+#define HEAVY_HITTERS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief A key reported by HeavyHitters with its estimated count
+ */
+struct HeavyHitter
+{
+    std::string key;        // The counted key
+    std::uint64_t count;    // Estimated occurrences (never an underestimate)
+    std::uint64_t error;    // count overestimates by at most this much
+};
+
+/**
+ * @brief Class that finds the most frequent keys of a stream in bounded memory
+ *
+ * Implements the Space-Saving algorithm (Metwally, Agrawal and El Abbadi):
+ * at most capacity keys are tracked. A key that is not tracked while all
+ * counters are in use replaces the key with the smallest count and
+ * inherits that count, which is recorded as its possible error. Every key
+ * that occurs more than total / capacity times is guaranteed to be
+ * tracked, and the reported counts are off by at most the recorded error.
+ *
+ * The counters form a min-heap that points into a hash map of the tracked
+ * keys, so add() costs one or two hash lookups plus O(log capacity) heap
+ * steps, replacing a key reuses its map node instead of allocating, and
+ * memory is O(capacity) however many distinct keys the stream contains.
+ */
+class HeavyHitters
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param capacity Maximum number of keys tracked (0 tracks nothing)
+     */
+    explicit HeavyHitters(std::size_t capacity);
+
+    /**
+     * @brief Counts one occurrence of a key
+     *
+     * @param key The key to count
+     */
+    void add(const std::string& key);
+
+    /**
+     * @brief Gets the most frequent tracked keys
+     *
+     * @param k Maximum number of keys to return
+     * @return Keys by decreasing count, ties by key
+     */
+    std::vector<HeavyHitter> top(std::size_t k) const;
+
+    /**
+     * @brief Gets the most occurrences a key that is not tracked can have
+     *
+     * A tracked key whose count minus error exceeds this value is certainly
+     * more frequent than every key that was dropped.
+     *
+     * @return The smallest tracked count once all counters are in use, else 0
+     */
+    std::uint64_t maxUntrackedCount() const;
+
+    /**
+     * @brief Gets the number of occurrences counted so far
+     *
+     * @return Total of all add() calls
+     */
+    std::uint64_t total() const;
+
+    /**
+     * @brief Removes all keys and counts
+     */
+    void clear();
+
+private:
+    using PositionMap = std::unordered_map<std::string, std::size_t>;
+
+    /**
+     * @brief A tracked key's counters
+     */
+    struct Counter
+    {
+        std::uint64_t count;            // Estimated occurrences
+        std::uint64_t error;            // Possible overestimate
+        PositionMap::iterator entry;    // Key and position of this counter
+    };
+
+    /**
+     * @brief Moves a counter towards the root while it is smaller than its parent
+     */
+    void siftUp(std::size_t index);
+
+    /**
+     * @brief Moves a counter towards the leaves while it is larger than a child
+     */
+    void siftDown(std::size_t index);
+
+    /**
+     * @brief Swaps two counters and updates their positions
+     */
+    void swapCounters(std::size_t a, std::size_t b);
+
+    std::size_t capacity_;      // Maximum tracked keys
+    std::uint64_t total_;       // Occurrences counted
+    std::vector<Counter> heap_; // Counters, smallest count first
+    PositionMap positions_;     // Key -> index in heap_ (reserved, never rehashes)
+};
+
+#endif // HEAVY_HITTERS_H
@@ -0,0 +1,53 @@
+#ifndef HYPER_LOG_LOG_H
+#define HYPER_LOG_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Namespace containing the HyperLogLog building blocks
+ *
+ * A HyperLogLog sketch hashes every value, uses the top precision bits
+ * of the hash to select one of 2^precision registers and keeps in each
+ * register the largest rank seen (see rank()). harmonicEstimate() turns
+ * the register statistics into an estimate of the distinct values; its
+ * standard error is about 1.04 / sqrt(2^precision).
+ *
+ * SlidingDistinctCounter keeps its registers over a time window and uses
+ * these functions for hashing, ranks and the estimate.
+ */
+namespace HyperLogLog
+{
+
+/**
+ * @brief Hashes a value to 64 well-mixed bits
+ *
+ * @param value The value to hash
+ * @return Hash used for exact counting and the sketch registers
+ */
+std::uint64_t hash(std::string_view value);
+
+/**
+ * @brief Computes the rank a hash contributes to its register
+ *
+ * @param hash_value Hash of a value
+ * @param precision Number of index bits
+ * @return Position of the first set bit after the index bits (1-based)
+ */
+std::uint8_t rank(std::uint64_t hash_value, int precision);
+
+/**
+ * @brief Computes the HyperLogLog estimate from register statistics
+ *
+ * @param register_sum Sum of 2^-rank over all registers
+ * @param zero_registers Number of registers that are still zero
+ * @param register_count Number of registers (a power of two)
+ * @return Estimated number of distinct values
+ */
+std::size_t harmonicEstimate(double register_sum, std::size_t zero_registers,
+                             std::size_t register_count);
+
+} // namespace HyperLogLog
+
+#endif // HYPER_LOG_LOG_H
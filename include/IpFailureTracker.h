@@ -0,0 +1,95 @@
+#ifndef IP_FAILURE_TRACKER_H
+#define IP_FAILURE_TRACKER_H
+
+#include "EventDetector.h"
+#include "LogEntry.h"
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Class that detects successful logins from an IP address after
+ *        a burst of failures from that address
+ *
+ * The per-user scan of EventDetector reports a success that follows
+ * failures of the same user. An attacker guessing several accounts from
+ * one host shows up differently: many failures from one IP address, for
+ * various users, followed by a success of any user from that address.
+ *
+ * Entries are observed one at a time in timestamp order. For every IP
+ * address with recent failures the tracker keeps the failures of the last
+ * time_window_minutes that were not yet reported. A success from the
+ * address with at least failure_threshold of them is reported as a
+ * SUCCESS_AFTER_FAILURES event of the user that logged in, and the burst
+ * is then cleared. Bursts whose failures are all for the user that logged
+ * in are left to the per-user scan, which already reports them.
+ *
+ * IPs without a failure in the last window are dropped in a sweep once
+ * per window of stream time, so only recently failing IPs stay in memory.
+ * Entries that arrive slightly out of order are accepted; an entry older
+ * than its IP's newest failure is counted at that newest time.
+ */
+class IpFailureTracker
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param time_window_minutes Window length in minutes
+     * @param failure_threshold Minimum failures in the window before a success
+     */
+    IpFailureTracker(int time_window_minutes, int failure_threshold);
+
+    /**
+     * @brief Observes one entry (failed and successful logins are considered)
+     *
+     * @param entry The next entry in timestamp order
+     */
+    void observe(const LogEntry& entry);
+
+    /**
+     * @brief Returns the detected events and forgets all failures
+     *
+     * @return SUCCESS_AFTER_FAILURES events ordered by their success
+     */
+    std::vector<SuspiciousEvent> finish();
+
+private:
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    /**
+     * @brief One failure, with a hash of its username
+     */
+    struct Failure
+    {
+        TimePoint timestamp;     // Time of the failure
+        std::size_t user_hash;   // std::hash of the username
+    };
+
+    /**
+     * @brief Checks whether a timestamp is within the window of a start time
+     */
+    bool isWithinWindow(TimePoint start, TimePoint timestamp) const;
+
+    /**
+     * @brief Reports a success that ends a burst of failures from its IP
+     */
+    void report(const LogEntry& success, const std::deque<Failure>& failures);
+
+    /**
+     * @brief Drops IPs without a failure in the window ending at latest_
+     */
+    void expireIdle();
+
+    int time_window_minutes_;                                   // Window length
+    int failure_threshold_;                                     // Failures to report
+    std::unordered_map<std::string, std::deque<Failure>> open_;   // Unreported failures per IP
+    TimePoint latest_;                                          // Latest observed entry
+    TimePoint last_sweep_;                                      // Last expireIdle() sweep
+    std::vector<SuspiciousEvent> events_;                       // Reported successes
+};
+
+#endif // IP_FAILURE_TRACKER_H
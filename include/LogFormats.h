@@ -0,0 +1,195 @@
+#ifndef LOG_FORMATS_H
+#define LOG_FORMATS_H
+
+#include "LogEntry.h"
+#include "LogParser.h"
+#include "PatternMatcher.h"
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Namespace containing the supported input line formats
+ *
+ * Every format is a policy class with the same two members:
+ *
+ *   bool locate(std::string_view line, LogParser::LogFields& fields,
+ *               LogParser::ParseError& error) const;
+ *   std::optional<time_point> parseTimestamp(std::string_view text) const;
+ *
+ * locate() finds the username, IP, status and timestamp text of a line
+ * as views into the line (no allocation). It returns false with error
+ * NONE for lines that are valid but carry no login event (for example
+ * other syslog messages or a CSV header); those are skipped, not counted
+ * as invalid.
+ *
+ * The loader instantiates its parse loop once per policy, so the choice
+ * of format costs one dispatch per chunk rather than a virtual call per
+ * line. All formats produce the same LogEntry for EventDetector.
+ */
+namespace LogFormats
+{
+
+using TimePoint = std::chrono::system_clock::time_point;
+
+/**
+ * @brief Built-in input formats selectable with --format-in
+ */
+enum class InputFormat
+{
+    PIPE,     // "YYYY-MM-DD HH:MM:SS | user | ip | STATUS"
+    SYSLOG,   // sshd messages in a syslog file
+    JSON,     // One JSON object per line
+    CSV,      // "timestamp,user,ip,status"
+    PATTERN   // User template given with --pattern
+};
+
+/**
+ * @brief Converts a format name to an InputFormat
+ *
+ * @param name Format name ("pipe", "syslog", "json" or "csv", any case)
+ * @return The format, or empty if the name is unknown
+ *
+ * @note PATTERN is not selected by name but by giving --pattern
+ */
+std::optional<InputFormat> parseInputFormat(std::string_view name);
+
+/**
+ * @brief Gets the command-line name of a format
+ *
+ * @param format The format
+ * @return Lowercase format name
+ */
+const char* inputFormatName(InputFormat format);
+
+/**
+ * @brief The original pipe-delimited format
+ *
+ * Example: "2026-01-10 08:45:12 | jdoe | 192.168.1.10 | FAILED"
+ */
+struct PipeFormat
+{
+    bool locate(std::string_view line, LogParser::LogFields& fields,
+                LogParser::ParseError& error) const;
+    std::optional<TimePoint> parseTimestamp(std::string_view text) const;
+};
+
+/**
+ * @brief OpenSSH daemon messages in a syslog file
+ *
+ * Recognized messages:
+ * - "Mmm dd HH:MM:SS host sshd[pid]: Failed <method> for [invalid user ]<user> from <ip> ..."
+ * - "Mmm dd HH:MM:SS host sshd[pid]: Accepted <method> for <user> from <ip> ..."
+ *
+ * All other lines (other programs, other sshd messages) are skipped.
+ * Syslog timestamps carry no year, so the caller supplies the year and
+ * month the log was last written in. A timestamp with a later month was
+ * written before the year rolled over and belongs to the previous year,
+ * so a log spanning New Year keeps its order.
+ */
+struct SyslogFormat
+{
+    int year;         // Year the log was last written in
+    int last_month;   // Month (1-12) the log was last written in
+
+    /**
+     * @brief Constructor
+     *
+     * @param log_year Year the log was last written in
+     * @param log_last_month Month of the last entry; 12 keeps every
+     *        timestamp in log_year
+     */
+    explicit SyslogFormat(int log_year, int log_last_month = 12)
+        : year(log_year), last_month(log_last_month) {}
+
+    bool locate(std::string_view line, LogParser::LogFields& fields,
+                LogParser::ParseError& error) const;
+    std::optional<TimePoint> parseTimestamp(std::string_view text) const;
+};
+
+/**
+ * @brief One flat JSON object per line
+ *
+ * Example: {"timestamp":"2026-01-10T08:45:12","user":"jdoe","ip":"192.168.1.10","status":"FAILED"}
+ *
+ * Keys "user"/"username" and "ip"/"ip_address" are accepted. Values must
+ * be plain strings without escape sequences, so they can be returned as
+ * views into the line. The timestamp may use 'T' or ' ' between date and time.
+ */
+struct JsonFormat
+{
+    bool locate(std::string_view line, LogParser::LogFields& fields,
+                LogParser::ParseError& error) const;
+    std::optional<TimePoint> parseTimestamp(std::string_view text) const;
+};
+
+/**
+ * @brief Comma-separated export with four columns
+ *
+ * Example: 2026-01-10 08:45:12,jdoe,192.168.1.10,FAILED
+ *
+ * Fields may be enclosed in double quotes (without embedded quotes).
+ * A header line starting with "timestamp" is skipped.
+ */
+struct CsvFormat
+{
+    bool locate(std::string_view line, LogParser::LogFields& fields,
+                LogParser::ParseError& error) const;
+    std::optional<TimePoint> parseTimestamp(std::string_view text) const;
+};
+
+/**
+ * @brief Lines described by a user template (see PatternMatcher)
+ *
+ * Example template: "%ts [%user] from %ip: %status"
+ */
+struct PatternFormat
+{
+    const PatternMatcher* matcher;   // Compiled template (nullptr rejects every line)
+
+    /**
+     * @brief Constructor
+     *
+     * @param compiled Compiled template owned by the caller
+     */
+    explicit PatternFormat(const PatternMatcher* compiled) : matcher(compiled) {}
+
+    bool locate(std::string_view line, LogParser::LogFields& fields,
+                LogParser::ParseError& error) const;
+    std::optional<TimePoint> parseTimestamp(std::string_view text) const;
+};
+
+/**
+ * @brief Builds a LogEntry from located fields using a format's timestamp rules
+ *
+ * @param format The format policy that located the fields
+ * @param fields Field views returned by Format::locate()
+ * @param error Set to BAD_TIMESTAMP on failure, UNKNOWN_STATUS if the entry
+ *              was built but has an unrecognized status, NONE otherwise
+ * @return std::optional containing the parsed LogEntry, or empty on failure
+ */
+template <typename Format>
+std::optional<LogEntry> materialize(const Format& format, const LogParser::LogFields& fields,
+                                    LogParser::ParseError& error)
+{
+    auto timestamp_opt = format.parseTimestamp(fields.timestamp);
+    if (!timestamp_opt.has_value())
+    {
+        error = LogParser::ParseError::BAD_TIMESTAMP;
+        return std::nullopt;
+    }
+
+    LoginStatus status = LogParser::parseStatus(fields.status);
+    error = (status == LoginStatus::UNKNOWN) ? LogParser::ParseError::UNKNOWN_STATUS
+                                             : LogParser::ParseError::NONE;
+
+    return LogEntry(timestamp_opt.value(),
+                    std::string(fields.username),
+                    std::string(fields.ip_address),
+                    status);
+}
+
+} // namespace LogFormats
+
+#endif // LOG_FORMATS_H
@@ -0,0 +1,302 @@
+#ifndef LOG_LOADER_H
+#define LOG_LOADER_H
+
+#include "LogEntry.h"
+#include "LogParser.h"
+#include "LogFormats.h"
+#include "ParseDiagnostics.h"
+#include "AsyncFileReader.h"
+#include "MultiFileReader.h"
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Options controlling how log files are read and parsed
+ */
+struct LoaderOptions
+{
+    LogFormats::InputFormat format;     // Line format of the input
+    int syslog_year;                    // Year for syslog timestamps (0 = from file mtime)
+    std::string pattern;                // Template for InputFormat::PATTERN
+    LogParser::FieldFilter filter;      // Parse-time predicate on raw fields
+    std::size_t worker_threads;         // Parser workers (0 = single-threaded)
+    std::size_t max_error_samples;      // Invalid lines kept as samples
+    bool verbose_errors;                // Print a warning for every invalid line
+    std::size_t chunk_bytes;            // Size of the blocks handed to parsers
+    bool prefetch;                      // Read files on a background thread
+    ReaderOptions reader;               // Block size and I/O hints for prefetching
+
+    /**
+     * @brief Default constructor
+     *
+     * Defaults to the pipe format, one pipelined parser worker,
+     * 10 error samples, 1 MiB chunks and prefetching enabled.
+     */
+    LoaderOptions()
+        : format(LogFormats::InputFormat::PIPE),
+          syslog_year(0),
+          pattern(),
+          filter(),
+          worker_threads(1),
+          max_error_samples(10),
+          verbose_errors(false),
+          chunk_bytes(1 << 20),
+          prefetch(true),
+          reader()
+    {}
+};
+
+/**
+ * @brief Counters describing a completed load
+ */
+struct LoadStatistics
+{
+    std::size_t lines_processed;   // Lines read, including empty ones
+    std::size_t valid_entries;     // Entries delivered to the sink
+    std::size_t invalid_entries;   // Lines rejected by the parser
+    std::size_t filtered_entries;  // Lines dropped by the filter
+    std::size_t skipped_lines;     // Lines without a login event (e.g. other syslog messages)
+    std::size_t out_of_order_entries;  // Delivered entries older than the entry before them
+
+    LoadStatistics()
+        : lines_processed(0),
+          valid_entries(0),
+          invalid_entries(0),
+          filtered_entries(0),
+          skipped_lines(0),
+          out_of_order_entries(0)
+    {}
+};
+
+/**
+ * @brief Class responsible for reading a log file and parsing it into entries
+ *
+ * The loader reads input in large chunks of whole lines and parses them
+ * into batches of LogEntry objects which are handed to a caller-provided
+ * sink in input order.
+ *
+ * With worker_threads == 0 everything runs on the calling thread. With
+ * worker_threads >= 1 the load runs as a pipeline:
+ *
+ *   reader thread -> N parser workers -> calling thread (sink)
+ *
+ * Stages are connected by bounded lock-free queues, so reading, parsing
+ * and whatever the sink does (grouping, statistics) overlap and wall time
+ * approaches that of the slowest stage. Chunks are distributed to workers
+ * round-robin and collected in the same order, so the sink observes
+ * exactly the same sequence as in single-threaded mode.
+ *
+ * Files are read through an AsyncFileReader (unless prefetch is disabled),
+ * so even single-threaded parsing never blocks on an individual disk read.
+ * With reader.io_uring set, all files of a load go through one
+ * MultiFileReader, which keeps several reads in flight across files.
+ *
+ * Lines are parsed by one of the LogFormats policies. The per-line loop
+ * is a template instantiated for each format and selected once per chunk.
+ *
+ * Several files are loaded as one logical input: counters, diagnostics and
+ * line numbers continue from one file to the next, but a line never spans
+ * two files.
+ */
+class LogLoader
+{
+public:
+    /**
+     * @brief Callback receiving parsed entries in input order
+     *
+     * The sink may move entries out of the batch.
+     */
+    using BatchSink = std::function<void(std::vector<LogEntry>& batch)>;
+
+    /**
+     * @brief Constructor
+     *
+     * @param options Reading, filtering and diagnostics options
+     * @param warnings Stream for per-line warnings in verbose mode
+     *
+     * @note With InputFormat::PATTERN the template is compiled here; if it
+     *       is invalid an error is written to warnings and every line is
+     *       rejected
+     */
+    explicit LogLoader(const LoaderOptions& options, std::ostream& warnings);
+
+    /**
+     * @brief Loads a log file
+     *
+     * @param path Path to the log file
+     * @param sink Callback receiving entry batches in input order
+     * @return true on success, false if the file cannot be opened or read
+     */
+    bool loadFile(const std::string& path, const BatchSink& sink);
+
+    /**
+     * @brief Loads several log files in order (e.g. rotated logs)
+     *
+     * @param paths Paths to the log files
+     * @param sink Callback receiving entry batches in input order
+     * @return true on success, false if a file cannot be opened or read
+     */
+    bool loadFiles(const std::vector<std::string>& paths, const BatchSink& sink);
+
+    /**
+     * @brief Loads log lines from an already opened stream
+     *
+     * @param input Stream to read from
+     * @param sink Callback receiving entry batches in input order
+     */
+    void loadStream(std::istream& input, const BatchSink& sink);
+
+    /**
+     * @brief Gets counters from the last load
+     *
+     * @return Const reference to the load statistics
+     */
+    const LoadStatistics& statistics() const;
+
+    /**
+     * @brief Gets invalid-line diagnostics from the last load
+     *
+     * @return Const reference to the diagnostics
+     */
+    const ParseDiagnostics& diagnostics() const;
+
+    /**
+     * @brief Gets the file that made the last load fail
+     *
+     * @return Path of the file that could not be opened or read (empty on success)
+     */
+    const std::string& failedPath() const;
+
+private:
+    /**
+     * @brief Source of raw input bytes
+     *
+     * Copies up to the requested number of bytes into the buffer and
+     * returns how many were copied; 0 means end of input.
+     */
+    using ReadFunction = std::function<std::size_t(char* destination, std::size_t size)>;
+
+    /**
+     * @brief A block of whole lines read from the input
+     */
+    struct Chunk
+    {
+        std::string text;          // One or more complete lines
+        std::size_t first_line;    // 1-based number of the first line
+        std::size_t file;          // Index of the file in the list given to loadFiles()
+    };
+
+    /**
+     * @brief Parse results for one chunk
+     */
+    struct ParsedChunk
+    {
+        std::vector<LogEntry> entries;   // Valid entries in input order
+        LoadStatistics statistics;       // Counters for this chunk
+        ParseDiagnostics diagnostics;    // Invalid lines in this chunk
+        std::string warnings;            // Per-line warnings (verbose mode only)
+    };
+
+    /**
+     * @brief Reads the next chunk of complete lines
+     *
+     * @param read Source of input bytes
+     * @param carry Partial line left over from the previous read (updated)
+     * @param next_line Number of the next line to be read (updated)
+     * @param chunk Receives the chunk
+     * @return true if a chunk was produced, false at end of input
+     */
+    bool readChunk(const ReadFunction& read, std::string& carry,
+                   std::size_t& next_line, Chunk& chunk) const;
+
+    /**
+     * @brief Parses every line of a chunk with the configured format
+     *
+     * @param chunk Lines to parse
+     * @param parsed Receives entries, counters and diagnostics
+     */
+    void parseChunk(const Chunk& chunk, ParsedChunk& parsed) const;
+
+    /**
+     * @brief Parse loop specialized for one format policy
+     *
+     * @param format The format policy
+     * @param chunk Lines to parse
+     * @param parsed Receives entries, counters and diagnostics
+     */
+    template <typename Format>
+    void parseChunkAs(const Format& format, const Chunk& chunk, ParsedChunk& parsed) const;
+
+    /**
+     * @brief Parses a single line and records the outcome
+     *
+     * @param format The format policy
+     * @param line The line to parse
+     * @param line_number 1-based line number
+     * @param parsed Receives the entry or the error
+     */
+    template <typename Format>
+    void parseLine(const Format& format, std::string_view line,
+                   std::size_t line_number, ParsedChunk& parsed) const;
+
+    /**
+     * @brief Hands a parsed chunk to the sink and accumulates its counters
+     *
+     * @param parsed Parsed chunk (entries may be moved out)
+     * @param sink Callback receiving the entries
+     */
+    void deliver(ParsedChunk& parsed, const BatchSink& sink);
+
+    /**
+     * @brief Resets counters, diagnostics and line numbering
+     */
+    void reset();
+
+    /**
+     * @brief Gets the syslog format of a file
+     *
+     * Without LoaderOptions::syslog_year the file is assumed to end in the
+     * year and month of its modification time, so timestamps in later
+     * months belong to the year before. A file that cannot be examined
+     * ends at the current time.
+     */
+    LogFormats::SyslogFormat syslogFormatOf(const std::string& path) const;
+
+    /**
+     * @brief Dispatches one input to the sequential or pipelined path
+     *
+     * @param read Source of input bytes
+     * @param sink Callback receiving entry batches in input order
+     */
+    void load(const ReadFunction& read, const BatchSink& sink);
+
+    /**
+     * @brief Loads files through a single MultiFileReader
+     */
+    bool loadWithRing(const std::vector<std::string>& paths, const BatchSink& sink);
+
+    void loadSequential(const ReadFunction& read, const BatchSink& sink);
+    void loadPipelined(const ReadFunction& read, const BatchSink& sink);
+
+    LoaderOptions options_;          // Reading and parsing options
+    std::ostream& warnings_;         // Destination for verbose warnings
+    LoadStatistics statistics_;      // Counters from the last load
+    ParseDiagnostics diagnostics_;   // Diagnostics from the last load
+    std::optional<PatternMatcher> pattern_matcher_;   // Compiled options_.pattern
+    LogFormats::SyslogFormat syslog_default_;   // Syslog year of streams and unknown files
+    std::vector<LogFormats::SyslogFormat> syslog_formats_;   // Syslog year of each loaded file
+    std::size_t next_line_;          // Number of the next input line
+    std::size_t file_index_;         // File being read
+    std::chrono::system_clock::time_point last_timestamp_;   // Last delivered entry's timestamp
+    bool has_last_timestamp_;        // An entry has been delivered
+    std::string failed_path_;        // File that made the last load fail
+};
+
+#endif // LOG_LOADER_H
@@ -3,6 +3,7 @@
 
 #include "LogEntry.h"
 #include <string>
+#include <string_view>
 #include <optional>
 #include <chrono>
 
@@ -15,6 +16,38 @@
 namespace LogParser 
 {
 
+/**
+ * @brief Reason a log line was rejected
+ * 
+ * Used by the locate and materialize steps to classify invalid lines so
+ * that callers can aggregate diagnostics instead of reporting each line.
+ */
+enum class ParseError 
+{
+    NONE,            // Line parsed successfully
+    FIELD_COUNT,     // Line does not have the expected field layout
+    EMPTY_FIELD,     // A required field is empty after trimming
+    BAD_TIMESTAMP,   // Timestamp field cannot be parsed
+    UNKNOWN_STATUS   // Status is neither SUCCESS nor FAILED
+};
+
+/**
+ * @brief Trims whitespace from both ends of a string view
+ * 
+ * @param str The view to trim
+ * @return A view with leading and trailing whitespace removed
+ */
+std::string_view trim(std::string_view str);
+
+/**
+ * @brief Case-insensitive comparison of a view against an uppercase literal
+ * 
+ * @param str The view to compare
+ * @param upper The expected value in uppercase
+ * @return true if both have the same length and match ignoring case
+ */
+bool equalsIgnoreCase(std::string_view str, std::string_view upper);
+
 /**
  * @brief Parses a timestamp string into a time_point object
  * 
@@ -24,11 +57,14 @@ namespace LogParser
  * @param timestamp_str The timestamp string to parse
  * @return std::optional containing the parsed time_point, or empty if parsing failed
  * 
- * @note This function uses std::tm for parsing and converts to system_clock::time_point
- * @note Returns std::nullopt if the string format is invalid
+ * @note Digits are decoded by hand; the date and hour are converted with
+ *       std::mktime only when they differ from the previous call on the
+ *       same thread, so consecutive lines from the same hour are cheap
+ * @note Returns std::nullopt if the string format is invalid or a field
+ *       is out of range
  */
 std::optional<std::chrono::system_clock::time_point> 
-parseTimestamp(const std::string& timestamp_str);
+parseTimestamp(std::string_view timestamp_str);
 
 /**
  * @brief Converts a status string to LoginStatus enum
@@ -40,7 +76,100 @@ parseTimestamp(const std::string& timestamp_str);
  * 
  * @note Returns LoginStatus::UNKNOWN for any unrecognized status string
  */
-LoginStatus parseStatus(const std::string& status_str);
+LoginStatus parseStatus(std::string_view status_str);
+
+/**
+ * @brief Raw, trimmed field boundaries of a single log line
+ * 
+ * Produced by the cheap locate step of parsing. The views point into the
+ * caller's line buffer and are only valid as long as that buffer is alive
+ * and unmodified. No allocation or timestamp conversion has happened yet.
+ */
+struct LogFields 
+{
+    std::string_view timestamp;   // "YYYY-MM-DD HH:MM:SS"
+    std::string_view username;    // User attempting login
+    std::string_view ip_address;  // Source IP address
+    std::string_view status;      // Raw status text (e.g. "FAILED")
+};
+
+/**
+ * @brief Locates and trims the four fields of a log line without materializing them
+ * 
+ * This is the cheap first half of parseLogLine(): it only scans for the
+ * pipe delimiters and trims whitespace, so callers can inspect or filter
+ * on the raw bytes before paying for allocation and timestamp parsing.
+ * 
+ * @param line The log line to scan
+ * @return std::optional containing the field views, or empty if the line
+ *         does not have four non-empty pipe-separated fields
+ * 
+ * @note The status field extends to the end of the line, matching parseLogLine()
+ */
+std::optional<LogFields> locateFields(std::string_view line);
+
+/**
+ * @brief Locates fields and reports why the line was rejected
+ * 
+ * @param line The log line to scan
+ * @param error Set to FIELD_COUNT or EMPTY_FIELD on failure, NONE on success
+ * @return std::optional containing the field views, or empty on failure
+ */
+std::optional<LogFields> locateFields(std::string_view line, ParseError& error);
+
+/**
+ * @brief Builds a LogEntry from previously located fields
+ * 
+ * This is the expensive second half of parseLogLine(): it parses the
+ * timestamp and status and copies username and IP into owned strings.
+ * 
+ * @param fields Field views returned by locateFields()
+ * @return std::optional containing the parsed LogEntry, or empty if the
+ *         timestamp cannot be parsed
+ */
+std::optional<LogEntry> materializeEntry(const LogFields& fields);
+
+/**
+ * @brief Builds a LogEntry and reports why materialization failed
+ * 
+ * @param fields Field views returned by locateFields()
+ * @param error Set to BAD_TIMESTAMP on failure, UNKNOWN_STATUS if the entry
+ *              was built but has an unrecognized status, NONE otherwise
+ * @return std::optional containing the parsed LogEntry, or empty on failure
+ * 
+ * @note Like the single-argument overload, entries with UNKNOWN status are
+ *       still returned; the error code lets the caller decide to drop them
+ */
+std::optional<LogEntry> materializeEntry(const LogFields& fields, ParseError& error);
+
+/**
+ * @brief Predicate evaluated on located fields before an entry is materialized
+ * 
+ * Empty criteria match everything. All non-empty criteria must match
+ * (logical AND). Username and IP are compared exactly; status is compared
+ * case-insensitively, consistent with parseStatus().
+ */
+struct FieldFilter 
+{
+    std::string username;                // Required username (empty = any)
+    std::string ip_address;              // Required source IP (empty = any)
+    std::optional<LoginStatus> status;   // Required status (nullopt = any)
+    
+    /**
+     * @brief Checks whether any criterion is set
+     * 
+     * @return true if at least one criterion restricts the input
+     */
+    bool isActive() const;
+    
+    /**
+     * @brief Evaluates the filter against raw field views
+     * 
+     * @param fields Field views returned by locateFields()
+     * @return true if the line should be materialized
+     */
+    bool matches(const LogFields& fields) const;
+};
 
 /**
  * @brief Parses a single log line into a LogEntry object
@@ -51,6 +180,7 @@ LoginStatus parseStatus(const std::string& status_str);
  * @param line The log line to parse
  * @return std::optional containing the parsed LogEntry, or empty if parsing failed
  * 
+ * @note Equivalent to locateFields() followed by materializeEntry()
  * @note The function trims whitespace around each field
  * @note Returns std::nullopt if:
  *       - The line doesn't contain exactly 4 pipe-separated fields
@@ -0,0 +1,147 @@
+#ifndef LOGIN_HOUR_PROFILES_H
+#define LOGIN_HOUR_PROFILES_H
+
+#include "LogEntry.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief One user's successful logins per hour of the week
+ *
+ * Fixed-size and trivially copyable, so an array of profiles can be
+ * written to disk and mapped back into memory as is. The username is
+ * stored in a separate name block of the file.
+ */
+struct HourProfile
+{
+    std::uint32_t name_offset;    // Offset of the username in the name block
+    std::uint32_t name_length;    // Length of the username in bytes
+    std::uint32_t total;          // Sum of the counts
+    std::uint32_t counts[168];    // Logins per hour of the week (Sunday 00:00 first)
+};
+
+/**
+ * @brief Class keeping per-user login-hour baselines between runs
+ *
+ * The baseline is a profile file written by an earlier run. load()
+ * maps it into memory (reads it where mmap is not available), so the
+ * profiles are available at startup without parsing. Profiles are sorted
+ * by username; finding one is a binary search.
+ *
+ * Successful logins of the current run are learned with add(), which
+ * costs one hash lookup and one increment per entry. They are kept apart
+ * from the baseline, so detection compares a run against earlier runs
+ * only, and are merged into it by save() for the next run. Profiles that
+ * grow beyond kMaxProfileLogins are halved when saved, so old habits fade.
+ *
+ * File layout: a header (magic "LAHOURS1", profile count, name block
+ * size), the profiles, then the name block.
+ */
+class LoginHourProfiles
+{
+public:
+    static constexpr std::size_t kBuckets = 168;                 // Hours of the week
+    static constexpr std::uint32_t kMaxProfileLogins = 100000;   // Halve profiles above this
+
+    /**
+     * @brief Default constructor - creates an empty baseline
+     */
+    LoginHourProfiles();
+
+    /**
+     * @brief Destructor - unmaps a mapped profile file
+     */
+    ~LoginHourProfiles();
+
+    LoginHourProfiles(const LoginHourProfiles&) = delete;
+    LoginHourProfiles& operator=(const LoginHourProfiles&) = delete;
+
+    /**
+     * @brief Loads the baseline from a profile file
+     *
+     * @param path File written by save(); a missing file is an empty
+     *             baseline (the first run)
+     * @return true on success, false if the file cannot be read or is
+     *         not a valid profile file
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Writes the baseline merged with the learned logins
+     *
+     * The file is written next to the target and renamed over it, so a
+     * mapped baseline stays valid and a failed write keeps the old file.
+     *
+     * @param path File to write
+     * @return true on success, false if the file cannot be written
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Learns one entry
+     *
+     * @param entry The analyzed entry (only successful logins are counted)
+     */
+    void add(const LogEntry& entry);
+
+    /**
+     * @brief Finds a user's baseline profile
+     *
+     * @param username User to look up
+     * @return The profile, or nullptr if the baseline has none
+     *
+     * @note Logins learned in this run are not included
+     */
+    const HourProfile* find(std::string_view username) const;
+
+    /**
+     * @brief Gets the number of users in the baseline
+     *
+     * @return Profiles loaded
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Gets the hour of the week of a timestamp
+     *
+     * @param timestamp Timestamp to convert (local time)
+     * @return Hour of the week (0-167, Sunday 00:00 first)
+     */
+    static std::size_t hourOfWeek(std::chrono::system_clock::time_point timestamp);
+
+private:
+    using Histogram = std::array<std::uint32_t, kBuckets>;
+
+    /**
+     * @brief Gets the username of a baseline profile
+     */
+    std::string_view nameOf(const HourProfile& profile) const;
+
+    /**
+     * @brief Checks the layout of a loaded file and sets up the pointers
+     */
+    bool attach(const char* data, std::size_t size);
+
+    /**
+     * @brief Releases the mapped or read baseline
+     */
+    void clear();
+
+    std::vector<char> owned_;                // File contents where mmap is not used
+    const HourProfile* profiles_;            // Baseline profiles, sorted by username
+    std::size_t count_;                      // Number of baseline profiles
+    const char* names_;                      // Name block
+    void* mapping_;                          // Mapped file, or nullptr
+    std::size_t mapping_size_;               // Size of the mapping in bytes
+    std::unordered_map<std::string, Histogram> learned_;   // Logins of this run per user
+    std::int64_t cached_hour_start_;         // Start of the hour cached below (seconds)
+    std::size_t cached_bucket_;              // Hour of the week of that hour
+};
+
+#endif // LOGIN_HOUR_PROFILES_H
@@ -0,0 +1,211 @@
+#ifndef MULTI_FILE_READER_H
+#define MULTI_FILE_READER_H
+
+#include "AsyncFileReader.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef LOG_ANALYZER_HAVE_URING
+#include <liburing.h>
+#endif
+
+/**
+ * @brief Class that reads one or more files with many large reads in flight
+ *
+ * All input files are split into fixed-size blocks up front and the blocks
+ * are read in order through a ring of queue_depth buffers. With io_uring
+ * (compiled in when liburing is found, see LOG_ANALYZER_HAVE_URING) every
+ * buffer has a read outstanding at all times, across file boundaries, so
+ * the next rotated file is already being fetched while the current one is
+ * parsed and an NVMe device sees enough concurrent requests to reach full
+ * bandwidth.
+ *
+ * Without liburing, or when the kernel refuses to set up a ring, blocks
+ * are read synchronously with pread() when they are consumed. No read is
+ * then in flight and queue_depth only sets the number of buffers; the
+ * only overlap is the kernel read-ahead requested through posix_fadvise().
+ * On non-POSIX platforms std::ifstream is used instead of pread().
+ *
+ * With ReaderOptions::direct_io files are opened with O_DIRECT, which only
+ * accepts reads at aligned offsets into aligned buffers. A short read is
+ * continued with O_DIRECT while it stays aligned; an unaligned remainder
+ * is read through a second descriptor opened without O_DIRECT.
+ *
+ * Files are consumed one after another:
+ *
+ *   while (reader.nextFile())
+ *       while ((n = reader.read(buffer, size)) > 0) ...
+ *
+ * Only one thread may consume from a reader.
+ */
+class MultiFileReader
+{
+public:
+    /**
+     * @brief Default constructor
+     */
+    MultiFileReader();
+
+    /**
+     * @brief Destructor - waits for outstanding reads and releases buffers
+     */
+    ~MultiFileReader();
+
+    MultiFileReader(const MultiFileReader&) = delete;
+    MultiFileReader& operator=(const MultiFileReader&) = delete;
+
+    /**
+     * @brief Opens all files and starts the first reads
+     *
+     * @param paths Files to read, in order
+     * @param options Block size, queue depth and I/O hints
+     * @return true if every file was opened, false otherwise (see failedPath())
+     */
+    bool open(const std::vector<std::string>& paths, const ReaderOptions& options);
+
+    /**
+     * @brief Advances to the next file
+     *
+     * Unread data of the current file is skipped.
+     *
+     * @return true if there is another file, false once all files are done
+     */
+    bool nextFile();
+
+    /**
+     * @brief Copies up to size bytes of the current file into destination
+     *
+     * @param destination Buffer to copy into
+     * @param size Maximum number of bytes to copy
+     * @return Number of bytes copied (0 at end of the current file)
+     */
+    std::size_t read(char* destination, std::size_t size);
+
+    /**
+     * @brief Checks whether a read error occurred
+     *
+     * @return true if any read failed
+     */
+    bool failed() const;
+
+    /**
+     * @brief Gets the path that could not be opened
+     *
+     * @return Path of the file that made open() fail (empty otherwise)
+     */
+    const std::string& failedPath() const;
+
+    /**
+     * @brief Waits for outstanding reads and closes all files
+     */
+    void close();
+
+    /**
+     * @brief Checks whether reads go through io_uring
+     *
+     * @return true if an io_uring instance is in use
+     */
+    bool usingIoUring() const;
+
+private:
+    /**
+     * @brief A contiguous range of one file read into one buffer
+     */
+    struct Block
+    {
+        std::size_t file;        // Index of the file in open()'s path list
+        std::uint64_t offset;    // Byte offset in the file
+        std::size_t length;      // Expected number of bytes
+    };
+
+    /**
+     * @brief One buffer of the read ring
+     */
+    struct Slot
+    {
+        char* data;              // Aligned storage of capacity_ bytes
+        std::size_t size;        // Bytes read
+        std::size_t block;       // Block assigned to this slot
+        bool pending;            // A read has been queued on the ring
+        bool ready;              // The read has completed
+    };
+
+    /**
+     * @brief Starts reading a block into a slot
+     *
+     * With io_uring a request is queued (flushed by submitPending());
+     * otherwise the read is deferred until the slot is waited for.
+     */
+    void startRead(Slot& slot, std::size_t block_index);
+
+    /**
+     * @brief Hands queued requests to the kernel (io_uring only)
+     */
+    void submitPending();
+
+    /**
+     * @brief Waits until the read of a slot has completed
+     *
+     * @return true once the slot holds data, false if waiting failed
+     */
+    bool waitFor(Slot& slot);
+
+    /**
+     * @brief Records a completed read, finishing a short read synchronously
+     *
+     * @param slot Slot whose read completed
+     * @param result Bytes read, or a negative errno value
+     */
+    void complete(Slot& slot, long result);
+
+    /**
+     * @brief Reads a range of a file synchronously
+     *
+     * On an O_DIRECT file aligned reads are rounded up to whole alignment
+     * units, so data must have room for length rounded up to kAlignment.
+     *
+     * @return Bytes read (at most length); sets error_ on failure
+     */
+    std::size_t readAt(std::size_t file, std::uint64_t offset, char* data, std::size_t length);
+
+    /**
+     * @brief Gets a descriptor of a file that accepts unaligned reads
+     *
+     * @return The file's descriptor, or for an O_DIRECT file a second one
+     *         opened without O_DIRECT on first use (-1 if that fails)
+     */
+    int bufferedDescriptor(std::size_t file);
+
+    /**
+     * @brief Returns the slot of the current block to the ring
+     */
+    void releaseCurrent();
+
+    static constexpr std::size_t kAlignment = 4096;   // O_DIRECT alignment
+    static constexpr std::size_t kNoFile = static_cast<std::size_t>(-1);
+
+    std::vector<std::string> paths_;       // Paths of the open files
+    std::vector<int> descriptors_;         // POSIX file descriptors
+    std::vector<bool> direct_;             // File was opened with O_DIRECT
+    std::vector<int> buffered_;            // Descriptors without O_DIRECT (-1 = not opened)
+    std::vector<std::ifstream> streams_;   // Portable fallback streams
+    std::vector<Block> blocks_;            // Every block of every file, in order
+    std::vector<Slot> slots_;              // Read ring (block b uses slot b % size)
+    std::size_t capacity_;                 // Size of each buffer
+    std::size_t current_file_;             // File being consumed (kNoFile before the first)
+    std::size_t next_block_;               // Next block to consume
+    std::size_t consume_offset_;           // Read position inside the held block
+    bool holding_;                         // Consumer holds slots_[next_block_ % size]
+    bool error_;                           // A read failed
+    std::string failed_path_;              // File that could not be opened
+#ifdef LOG_ANALYZER_HAVE_URING
+    struct io_uring ring_;                 // Submission and completion queues
+    bool ring_ready_;                      // ring_ was initialized
+    std::size_t queued_;                   // Requests prepared but not yet submitted
+#endif
+};
+
+#endif // MULTI_FILE_READER_H
@@ -0,0 +1,109 @@
+#ifndef PARSE_DIAGNOSTICS_H
+#define PARSE_DIAGNOSTICS_H
+
+#include "LogParser.h"
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief A retained example of an invalid log line
+ */
+struct ParseErrorSample
+{
+    std::size_t line_number;         // 1-based line number in the input
+    LogParser::ParseError reason;    // Why the line was rejected
+    std::string line;                // Line content (possibly truncated)
+};
+
+/**
+ * @brief Class aggregating invalid-line diagnostics during log loading
+ *
+ * Instead of writing a warning for every rejected line, the loader records
+ * each rejection here. Errors are counted per reason and only the first
+ * few lines are kept as samples, so memory and output stay bounded no
+ * matter how corrupted the input is. A single summary is written at the
+ * end of the run and included in the report.
+ */
+class ParseDiagnostics
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param max_samples Maximum number of invalid lines to retain as samples
+     */
+    explicit ParseDiagnostics(std::size_t max_samples = 10);
+
+    /**
+     * @brief Records a rejected line
+     *
+     * @param reason Why the line was rejected (must not be ParseError::NONE)
+     * @param line_number 1-based line number in the input
+     * @param line The raw line content
+     *
+     * @note O(1); the line is only copied while fewer than max_samples are stored
+     */
+    void record(LogParser::ParseError reason, std::size_t line_number, std::string_view line);
+
+    /**
+     * @brief Merges counters and samples from another instance
+     *
+     * Samples are kept in line-number order and capped at max_samples,
+     * so merging per-worker diagnostics gives the same result as a
+     * sequential run.
+     *
+     * @param other Diagnostics to merge into this one
+     */
+    void merge(const ParseDiagnostics& other);
+
+    /**
+     * @brief Gets the number of lines rejected for a reason
+     *
+     * @param reason The reason to query
+     * @return Number of lines rejected with that reason
+     */
+    std::size_t count(LogParser::ParseError reason) const;
+
+    /**
+     * @brief Gets the total number of rejected lines
+     *
+     * @return Sum of all per-reason counters
+     */
+    std::size_t totalErrors() const;
+
+    /**
+     * @brief Gets the retained samples in line-number order
+     *
+     * @return Const reference to the sample list
+     */
+    const std::vector<ParseErrorSample>& samples() const;
+
+    /**
+     * @brief Writes a human-readable summary of all counters and samples
+     *
+     * @param output Stream to write the summary to
+     */
+    void writeSummary(std::ostream& output) const;
+
+    /**
+     * @brief Converts a ParseError to a human-readable string
+     *
+     * @param reason The reason to convert
+     * @return Short description of the reason
+     */
+    static std::string reasonToString(LogParser::ParseError reason);
+
+private:
+    static constexpr std::size_t kReasonCount = 5;         // Number of ParseError values
+    static constexpr std::size_t kMaxSampleLength = 200;   // Truncate longer sample lines
+
+    std::size_t max_samples_;                              // Sample retention limit
+    std::array<std::size_t, kReasonCount> counts_;         // Counters indexed by ParseError
+    std::vector<ParseErrorSample> samples_;                // First max_samples_ rejected lines
+};
+
+#endif // PARSE_DIAGNOSTICS_H
@@ -0,0 +1,112 @@
+#ifndef PASSWORD_SPRAY_TRACKER_H
+#define PASSWORD_SPRAY_TRACKER_H
+
+#include "SlidingDistinctCounter.h"
+#include "EventDetector.h"
+#include "LogEntry.h"
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Class that detects password spraying in a stream of log entries
+ *
+ * Password spraying tries one or a few passwords against many accounts
+ * from the same source, so it shows up as failed logins for many distinct
+ * usernames from one IP address rather than many failures for one user.
+ *
+ * Entries are observed one at a time in timestamp order. For every IP
+ * address with recent failures the tracker keeps a window that slides
+ * with the IP's newest failure and spans time_window_minutes, the same
+ * window detectDistributedBruteForce() slides per user. The usernames in
+ * the window are counted with a SlidingDistinctCounter, so an attacker
+ * rotating through millions of usernames costs a bounded sketch per IP,
+ * and an early probe does not hold the window back from a later spray.
+ * A spray is reported from the first failure of the window in which the
+ * count reached the threshold until the count falls below it again.
+ *
+ * IPs without a failure in the last window are dropped in a sweep once
+ * per window of stream time, so only recently failing IPs stay in memory.
+ *
+ * Entries that arrive slightly out of order are accepted; an entry older
+ * than its IP's newest failure is counted at that newest time.
+ */
+class PasswordSprayTracker
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param time_window_minutes Window length in minutes
+     * @param user_threshold Minimum distinct usernames per window to report
+     */
+    PasswordSprayTracker(int time_window_minutes, int user_threshold);
+
+    /**
+     * @brief Observes one entry (only failed logins are considered)
+     *
+     * @param entry The next entry in timestamp order
+     */
+    void observe(const LogEntry& entry);
+
+    /**
+     * @brief Closes all open sprays and returns the detected events
+     *
+     * @return PASSWORD_SPRAYING events ordered by their first failure
+     */
+    std::vector<SuspiciousEvent> finish();
+
+private:
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    /**
+     * @brief Recent failures from one IP address
+     */
+    struct IpWindow
+    {
+        SlidingDistinctCounter usernames;   // Distinct usernames in the window
+        std::deque<TimePoint> failures;     // Distinct failure times in the window, oldest first
+        bool spraying;                      // The count is at or above the threshold
+        TimePoint spray_first;              // Start of the current spray
+        TimePoint spray_last;               // Latest failure of the current spray
+        std::size_t peak_users;             // Highest count of the current spray
+        bool peak_exact;                    // peak_users was counted exactly
+
+        explicit IpWindow(SlidingDistinctCounter::Duration window)
+            : usernames(window),
+              failures(),
+              spraying(false),
+              spray_first(),
+              spray_last(),
+              peak_users(0),
+              peak_exact(true)
+        {}
+    };
+
+    /**
+     * @brief Checks whether a timestamp is within the window of a start time
+     */
+    bool isWithinWindow(TimePoint start, TimePoint timestamp) const;
+
+    /**
+     * @brief Reports the current spray of an IP and ends it
+     */
+    void closeSpray(const std::string& ip_address, IpWindow& window);
+
+    /**
+     * @brief Drops IPs without a failure in the window ending at latest_
+     */
+    void expireIdle();
+
+    int time_window_minutes_;                          // Window length
+    int user_threshold_;                               // Distinct users to report
+    std::unordered_map<std::string, IpWindow> open_;   // Window per recently failing IP
+    TimePoint latest_;                                 // Latest observed failure
+    TimePoint last_sweep_;                             // Last expireIdle() sweep
+    std::vector<SuspiciousEvent> events_;              // Reported sprays
+};
+
+#endif // PASSWORD_SPRAY_TRACKER_H
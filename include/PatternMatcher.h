@@ -0,0 +1,98 @@
+#ifndef PATTERN_MATCHER_H
+#define PATTERN_MATCHER_H
+
+#include "LogParser.h"
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Extracts log fields from lines described by a user template
+ *
+ * A template is literal text with placeholders:
+ * - %ts     : timestamp, exactly "YYYY-MM-DD HH:MM:SS" (or with 'T')
+ * - %user   : username
+ * - %ip     : source IP address
+ * - %status : SUCCESS or FAILED
+ * - %*      : any text that is ignored
+ * - %%      : a literal '%'
+ *
+ * Example: "%ts [%user] from %ip: %status"
+ *
+ * The template is compiled once into a list of states. A literal state
+ * compares bytes at the current position. A field state scans forward
+ * for the literal that follows it using a precomputed KMP automaton, so
+ * every byte of the line is examined at most a constant number of times
+ * and matching never backtracks. A field at the end of the template
+ * extends to the end of the line. Captured fields are trimmed.
+ *
+ * Each of %ts, %user, %ip and %status must appear exactly once, and two
+ * placeholders may not follow each other without literal text between them
+ * (except after %ts, whose width is fixed).
+ */
+class PatternMatcher
+{
+public:
+    /**
+     * @brief Compiles a template
+     *
+     * @param pattern The template text
+     * @param error_message Receives a description of the problem on failure
+     * @return The compiled matcher, or empty if the template is invalid
+     */
+    static std::optional<PatternMatcher> compile(std::string_view pattern,
+                                                 std::string& error_message);
+
+    /**
+     * @brief Matches a line and locates its fields
+     *
+     * @param line The line to match
+     * @param fields Receives views of the captured fields
+     * @param error Set to FIELD_COUNT if the line does not match the template,
+     *              EMPTY_FIELD if a captured field is empty, NONE otherwise
+     * @return true if the line matched and every field is non-empty
+     */
+    bool match(std::string_view line, LogParser::LogFields& fields,
+               LogParser::ParseError& error) const;
+
+private:
+    /**
+     * @brief What a placeholder captures
+     */
+    enum class Field
+    {
+        TIMESTAMP,
+        USERNAME,
+        IP_ADDRESS,
+        STATUS,
+        IGNORED
+    };
+
+    /**
+     * @brief One state of the compiled matcher
+     */
+    struct Step
+    {
+        bool is_literal;              // Literal text (true) or placeholder (false)
+        Field field;                  // Captured field (placeholders only)
+        std::string literal;          // Text to match (literals only)
+        std::vector<int> failure;     // KMP failure function of literal
+    };
+
+    PatternMatcher() = default;
+
+    /**
+     * @brief Finds a literal step's text in line starting at position
+     *
+     * @param step Literal step with its failure function
+     * @param line Text to search
+     * @param position Where to start searching
+     * @return Position of the first occurrence, or npos
+     */
+    static std::size_t find(const Step& step, std::string_view line, std::size_t position);
+
+    std::vector<Step> steps_;   // Compiled states in template order
+};
+
+#endif // PATTERN_MATCHER_H
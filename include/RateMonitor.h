@@ -0,0 +1,116 @@
+#ifndef RATE_MONITOR_H
+#define RATE_MONITOR_H
+
+#include "LogEntry.h"
+#include "RateSeries.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief A spike window of one IP address or username
+ */
+struct KeyRateSpike
+{
+    std::string key;     // IP address or username
+    RateSpike spike;     // The spike window
+};
+
+/**
+ * @brief Class keeping per-minute login rates while a log is loaded
+ *
+ * One RateSeries counts all entries. Further series follow the IP
+ * addresses and usernames with failed logins, at most tracked_keys of
+ * each. The keys are chosen like in HeavyHitters (Space-Saving): when a
+ * table is full, a newly failing key takes the place of the key with the
+ * smallest failure count and inherits that count, so the series end up
+ * following the most failing sources and targets. A displaced key keeps
+ * the spike windows it has already shown.
+ *
+ * Counting costs one array increment for the global series plus one hash
+ * lookup per table, so the rates add little to loading.
+ */
+class RateMonitor
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param tracked_keys IP addresses and usernames followed (each)
+     * @param z_threshold z-score of a spike minute (0 disables the monitor)
+     */
+    RateMonitor(std::size_t tracked_keys, double z_threshold);
+
+    /**
+     * @brief Counts one entry
+     *
+     * @param entry The analyzed entry
+     */
+    void add(const LogEntry& entry);
+
+    /**
+     * @brief Closes all series; call once after the last add()
+     */
+    void finish();
+
+    /**
+     * @brief Checks whether the monitor is enabled
+     *
+     * @return true if the z-score threshold is greater than 0
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Gets the series of all entries
+     */
+    const RateSeries& global() const;
+
+    /**
+     * @brief Gets the spike windows of the followed IP addresses
+     *
+     * @return Windows ordered by start, then by key
+     */
+    std::vector<KeyRateSpike> ipSpikes() const;
+
+    /**
+     * @brief Gets the spike windows of the followed usernames
+     *
+     * @return Windows ordered by start, then by key
+     */
+    std::vector<KeyRateSpike> userSpikes() const;
+
+    static constexpr std::size_t kMaxReportedSpikes = 20;   // Windows listed per report list
+
+private:
+    /**
+     * @brief The series followed for one dimension (IP addresses or usernames)
+     */
+    struct KeyTable
+    {
+        std::vector<std::string> keys;                     // Followed keys
+        std::vector<RateSeries> series;                    // Series by key position
+        std::vector<std::uint64_t> weights;                // Failure counts, inherited ones included
+        std::unordered_map<std::string, std::size_t> positions;   // Key to position
+        std::vector<KeyRateSpike> displaced_spikes;        // Windows of displaced keys
+    };
+
+    /**
+     * @brief Counts an entry in a table, following the key if it failed
+     */
+    void addToTable(KeyTable& table, const std::string& key, std::int64_t minute, bool failed);
+
+    /**
+     * @brief Collects and orders the windows of a table
+     */
+    static std::vector<KeyRateSpike> collectSpikes(const KeyTable& table);
+
+    std::size_t tracked_keys_;      // Keys followed per table
+    double z_threshold_;            // Spike threshold (0 = disabled)
+    RateSeries global_;             // All entries
+    KeyTable ips_;                  // Failing IP addresses
+    KeyTable users_;                // Failing usernames
+};
+
+#endif // RATE_MONITOR_H
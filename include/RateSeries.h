@@ -0,0 +1,141 @@
+#ifndef RATE_SERIES_H
+#define RATE_SERIES_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief A window of consecutive minutes with a spike in failed logins
+ */
+struct RateSpike
+{
+    std::int64_t first_minute;     // First minute of the window (minutes since the epoch)
+    std::int64_t last_minute;      // Last minute of the window (inclusive)
+    std::uint64_t failures;        // Failed logins within the window
+    std::uint64_t successes;       // Successful logins within the window
+    std::uint32_t peak_failures;   // Most failed logins in one minute
+    double expected_failures;      // Smoothed failures per minute before the window
+    double peak_score;             // Highest z-score within the window
+};
+
+/**
+ * @brief Class counting logins per minute and detecting spikes in failures
+ *
+ * The counts live in a fixed ring of kRingMinutes minutes indexed by
+ * minute offset, so counting an entry is one array increment. Entries may
+ * arrive out of order by up to the ring width; older entries are counted
+ * as late and left out.
+ *
+ * A minute is closed when it falls out of the ring (or on finish()) and
+ * its failures are compared with an exponentially weighted moving
+ * average and variance of the minutes before it:
+ *
+ *     z = (failures - mean) / max(standard deviation, 1)
+ *
+ * After kWarmupMinutes, a minute with at least kMinSpikeFailures failures
+ * and z of at least the threshold is a spike; consecutive spike minutes
+ * form one RateSpike window. Idle stretches feed at most kMaxIdleMinutes
+ * empty minutes into the average, so a gap of months costs nothing.
+ */
+class RateSeries
+{
+public:
+    static constexpr std::size_t kRingMinutes = 256;          // Out-of-order tolerance in minutes
+    static constexpr double kSmoothing = 0.1;                 // EWMA weight of each closed minute
+    static constexpr std::int64_t kWarmupMinutes = 30;        // Closed minutes before detecting
+    static constexpr std::uint32_t kMinSpikeFailures = 10;    // Failures a spike minute needs at least
+    static constexpr std::int64_t kMaxIdleMinutes = 1440;     // Empty minutes fed for a gap at most
+
+    /**
+     * @brief Constructor
+     *
+     * @param z_threshold z-score at or above which a minute is a spike
+     */
+    explicit RateSeries(double z_threshold);
+
+    /**
+     * @brief Counts one login
+     *
+     * @param minute Minute of the login (see minuteOf())
+     * @param failed true for a failed login, false for a successful one
+     * @return true if counted, false if the minute has already been closed
+     */
+    bool add(std::int64_t minute, bool failed);
+
+    /**
+     * @brief Closes all open minutes; call once after the last add()
+     */
+    void finish();
+
+    /**
+     * @brief Forgets everything, as if newly constructed
+     *
+     * Only the ring slots in use are cleared, so resetting a series that
+     * saw few minutes is cheap.
+     */
+    void reset();
+
+    /**
+     * @brief Gets the detected spike windows, ordered by time
+     *
+     * @return Windows closed so far (all of them after finish())
+     */
+    const std::vector<RateSpike>& spikes() const;
+
+    /**
+     * @brief Gets the number of failed logins counted
+     */
+    std::uint64_t failures() const;
+
+    /**
+     * @brief Gets the number of entries that arrived too late to count
+     */
+    std::uint64_t lateEntries() const;
+
+    /**
+     * @brief Gets the minute of a timestamp
+     *
+     * @param timestamp Timestamp to convert
+     * @return Whole minutes since the epoch (rounded down)
+     */
+    static std::int64_t minuteOf(std::chrono::system_clock::time_point timestamp);
+
+private:
+    /**
+     * @brief Counts of one minute
+     */
+    struct MinuteCount
+    {
+        std::uint32_t successes;    // Successful logins
+        std::uint32_t failures;     // Failed logins
+    };
+
+    /**
+     * @brief Moves the newest minute forward, closing minutes that leave the ring
+     */
+    void advanceTo(std::int64_t minute);
+
+    /**
+     * @brief Feeds one finished minute to the detector
+     */
+    void closeMinute(std::int64_t minute, const MinuteCount& count);
+
+    std::array<MinuteCount, kRingMinutes> ring_;   // Counts by minute % kRingMinutes
+    double z_threshold_;            // Spike threshold
+    bool started_;                  // At least one login counted
+    std::int64_t open_from_;        // Oldest minute not closed yet
+    std::int64_t newest_minute_;    // Newest minute counted
+    std::int64_t closed_minutes_;   // Minutes fed to the detector
+    double mean_;                   // EWMA of failures per minute
+    double variance_;               // EW variance of failures per minute
+    bool in_spike_;                 // The last closed minute was a spike
+    RateSpike current_;             // Window being extended while in_spike_
+    std::vector<RateSpike> spikes_; // Finished windows
+    std::uint64_t failures_;        // Failed logins counted
+    std::uint64_t late_entries_;    // Logins for closed minutes
+};
+
+#endif // RATE_SERIES_H
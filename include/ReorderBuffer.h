@@ -0,0 +1,89 @@
+#ifndef REORDER_BUFFER_H
+#define REORDER_BUFFER_H
+
+#include "LogEntry.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Class restoring time order to slightly out-of-order log entries
+ *
+ * Logs merged from several hosts arrive a little out of order. Instead of
+ * sorting the whole dataset, entries pass through a min-heap ordered by
+ * timestamp. The watermark trails the newest timestamp seen by the
+ * lateness; once an entry is at or below the watermark no earlier entry
+ * is expected, so it is released. Released entries are therefore in time
+ * order (ties keep their input order), and the heap only holds the
+ * entries of the last lateness interval.
+ *
+ * An entry older than the watermark when it arrives could no longer be
+ * put in order. Such late entries are counted and dropped rather than
+ * passed on, so consumers can rely on the order.
+ */
+class ReorderBuffer
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param lateness How far an entry may lag behind the newest timestamp
+     */
+    explicit ReorderBuffer(std::chrono::seconds lateness);
+
+    /**
+     * @brief Adds one entry and releases the entries below the watermark
+     *
+     * @param entry The next entry in input order
+     * @param released Receives released entries in time order (appended)
+     */
+    void push(LogEntry&& entry, std::vector<LogEntry>& released);
+
+    /**
+     * @brief Releases all buffered entries; call once after the last push()
+     *
+     * @param released Receives the entries in time order (appended)
+     */
+    void flush(std::vector<LogEntry>& released);
+
+    /**
+     * @brief Gets the number of entries dropped as later than the watermark
+     */
+    std::size_t lateEntries() const;
+
+    /**
+     * @brief Gets the largest number of entries buffered at once
+     */
+    std::size_t peakSize() const;
+
+private:
+    /**
+     * @brief A buffered entry with its arrival number (tie-breaker)
+     */
+    struct Pending
+    {
+        LogEntry entry;
+        std::uint64_t sequence;
+    };
+
+    /**
+     * @brief Heap order: the root is the oldest, earliest-arrived entry
+     */
+    static bool isLater(const Pending& a, const Pending& b);
+
+    /**
+     * @brief Moves the root of the heap to the released entries
+     */
+    void releaseOldest(std::vector<LogEntry>& released);
+
+    std::chrono::system_clock::duration lateness_;
+    std::vector<Pending> heap_;                     // Min-heap by (timestamp, sequence)
+    std::chrono::system_clock::time_point watermark_;  // Newest timestamp minus lateness
+    bool has_watermark_;                            // false until the first entry
+    std::uint64_t next_sequence_;
+    std::size_t late_entries_;
+    std::size_t peak_size_;
+};
+
+#endif // REORDER_BUFFER_H
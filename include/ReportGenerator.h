@@ -3,9 +3,57 @@
 
 #include "EventDetector.h"
 #include "LogEntry.h"
+#include "ParseDiagnostics.h"
+#include "TopActivity.h"
+#include "RateMonitor.h"
+#include "RiskScorer.h"
+#include "ThresholdSweep.h"
 #include <string>
 #include <vector>
 #include <ostream>
+#include <cstddef>
+
+/**
+ * @brief Entry counters shown in the report summary
+ *
+ * Lets a report be generated without keeping every analyzed entry
+ * in memory (see the external-memory mode).
+ */
+struct ReportTotals
+{
+    std::size_t total_entries;       // Entries analyzed
+    std::size_t successful_logins;   // Entries with LoginStatus::SUCCESS
+    std::size_t failed_logins;       // Entries with LoginStatus::FAILED
+    std::size_t late_entries;        // Entries later than the lateness watermark (not analyzed)
+
+    /**
+     * @brief Default constructor - all counters zero
+     */
+    ReportTotals()
+        : total_entries(0),
+          successful_logins(0),
+          failed_logins(0),
+          late_entries(0)
+    {}
+
+    /**
+     * @brief Counts one entry
+     *
+     * @param entry The analyzed entry
+     */
+    void add(const LogEntry& entry)
+    {
+        total_entries++;
+        if (entry.status == LoginStatus::SUCCESS)
+        {
+            successful_logins++;
+        }
+        else if (entry.status == LoginStatus::FAILED)
+        {
+            failed_logins++;
+        }
+    }
+};
 
 /**
  * @brief Class responsible for generating security analysis reports
@@ -17,6 +65,11 @@
  * Report sections:
  * - Header with generation timestamp
  * - Summary statistics (total entries, suspicious events)
+ * - Riskiest users and IP addresses (if attached)
+ * - Top activity rankings (if attached)
+ * - Rate spikes (if attached)
+ * - Threshold sweep matrix (if attached)
+ * - Parse diagnostics (if attached)
  * - Detailed list of detected anomalies with context
  * - Footer
  */
@@ -46,6 +99,17 @@ public:
                        const std::vector<SuspiciousEvent>& suspicious_events,
                        std::ostream& output) const;
     
+    /**
+     * @brief Generates a complete security report from entry counters
+     * 
+     * @param totals Counters of the analyzed entries
+     * @param suspicious_events Detected suspicious events
+     * @param output Output stream to write the report to
+     */
+    void generateReport(const ReportTotals& totals,
+                       const std::vector<SuspiciousEvent>& suspicious_events,
+                       std::ostream& output) const;
+    
     /**
      * @brief Generates a report and saves it to a file
      * 
@@ -63,6 +127,58 @@ public:
     bool generateReportToFile(const std::vector<LogEntry>& log_entries,
                              const std::vector<SuspiciousEvent>& suspicious_events,
                              const std::string& output_filepath) const;
+    
+    /**
+     * @brief Generates a report from entry counters and saves it to a file
+     * 
+     * @param totals Counters of the analyzed entries
+     * @param suspicious_events Detected suspicious events
+     * @param output_filepath Path where the report file should be saved
+     * @return true if report was successfully written, false on error
+     */
+    bool generateReportToFile(const ReportTotals& totals,
+                             const std::vector<SuspiciousEvent>& suspicious_events,
+                             const std::string& output_filepath) const;
+    
+    /**
+     * @brief Attaches invalid-line diagnostics to include in the report
+     * 
+     * @param diagnostics Diagnostics collected while loading, or nullptr to
+     *                    omit the section. Must outlive report generation.
+     */
+    void setParseDiagnostics(const ParseDiagnostics* diagnostics);
+    
+    /**
+     * @brief Attaches top IP address and user rankings to include in the report
+     * 
+     * @param top_activity Rankings collected while loading, or nullptr to
+     *                     omit the section. Must outlive report generation.
+     */
+    void setTopActivity(const TopActivity* top_activity);
+    
+    /**
+     * @brief Attaches per-minute login rates whose spikes to include in the report
+     * 
+     * @param rate_monitor Finished rates collected while loading, or nullptr
+     *                     to omit the section. Must outlive report generation.
+     */
+    void setRateMonitor(const RateMonitor* rate_monitor);
+    
+    /**
+     * @brief Attaches per-user and per-IP risk scores to include in the report
+     * 
+     * @param risk_scorer Scores of the detected events, or nullptr to omit
+     *                    the section. Must outlive report generation.
+     */
+    void setRiskScorer(const RiskScorer* risk_scorer);
+    
+    /**
+     * @brief Attaches a threshold/window sweep to include in the report
+     * 
+     * @param sweep Counts of brute-force events per grid point, or nullptr
+     *              to omit the section. Must outlive report generation.
+     */
+    void setThresholdSweep(const ThresholdSweep* sweep);
 
 private:
     /**
@@ -81,16 +197,91 @@ private:
      * - Total number of log entries processed
      * - Number of successful logins
      * - Number of failed logins
+     * - Number of late entries skipped (if any)
      * - Number of suspicious events detected
      * 
-     * @param log_entries All log entries analyzed
+     * @param totals Counters of the analyzed entries
      * @param suspicious_events Detected suspicious events
      * @param output Output stream to write summary to
      */
-    void generateSummary(const std::vector<LogEntry>& log_entries,
+    void generateSummary(const ReportTotals& totals,
                         const std::vector<SuspiciousEvent>& suspicious_events,
                         std::ostream& output) const;
     
+    /**
+     * @brief Generates risk scores section
+     * 
+     * Writes the users and IP addresses with the highest risk scores,
+     * with their events per type. Does nothing if no enabled scorer
+     * is attached.
+     * 
+     * @param output Output stream to write the section to
+     */
+    void generateRiskScores(std::ostream& output) const;
+    
+    /**
+     * @brief Writes one risk ranking
+     * 
+     * @param title Heading of the ranking
+     * @param scores Ranked scores, highest first
+     * @param output Output stream to write the ranking to
+     */
+    void writeRiskRanking(const std::string& title,
+                          const std::vector<RiskScore>& scores,
+                          std::ostream& output) const;
+    
+    /**
+     * @brief Generates top activity section
+     * 
+     * Writes the most failing IP addresses, most targeted users and most
+     * active users. Does nothing if no enabled rankings are attached.
+     * 
+     * @param output Output stream to write the section to
+     */
+    void generateTopActivity(std::ostream& output) const;
+    
+    /**
+     * @brief Generates rate spikes section
+     * 
+     * Writes the windows with spikes in failed logins per minute, for all
+     * entries and for the followed IP addresses and usernames. Does nothing
+     * if no enabled rate monitor is attached.
+     * 
+     * @param output Output stream to write the section to
+     */
+    void generateRateSpikes(std::ostream& output) const;
+    
+    /**
+     * @brief Writes one list of spike windows
+     * 
+     * @param title Heading of the list
+     * @param spikes Windows to write, at most RateMonitor::kMaxReportedSpikes
+     * @param output Output stream to write the list to
+     */
+    void writeSpikeList(const std::string& title,
+                        const std::vector<KeyRateSpike>& spikes,
+                        std::ostream& output) const;
+    
+    /**
+     * @brief Generates parse diagnostics section
+     * 
+     * Writes per-reason invalid line counters and retained samples.
+     * Does nothing if no diagnostics are attached.
+     * 
+     * @param output Output stream to write the section to
+     */
+    void generateParseDiagnostics(std::ostream& output) const;
+    
+    /**
+     * @brief Generates threshold sweep section
+     * 
+     * Writes brute-force event and user counts per threshold and window.
+     * Does nothing if no enabled sweep is attached.
+     * 
+     * @param output Output stream to write the section to
+     */
+    void generateThresholdSweep(std::ostream& output) const;
+    
     /**
      * @brief Generates detailed anomalies section
      * 
@@ -129,6 +320,12 @@ private:
      * @return Formatted timestamp string
      */
     std::string formatTimestamp(std::chrono::system_clock::time_point timestamp) const;
+    
+    const ParseDiagnostics* parse_diagnostics_;  // Optional invalid-line diagnostics
+    const TopActivity* top_activity_;            // Optional activity rankings
+    const RateMonitor* rate_monitor_;            // Optional per-minute rates
+    const RiskScorer* risk_scorer_;              // Optional risk scores
+    const ThresholdSweep* threshold_sweep_;      // Optional threshold/window sweep
 };
 
 #endif // REPORT_GENERATOR_H
\ No newline at end of file
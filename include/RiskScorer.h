@@ -0,0 +1,168 @@
+#ifndef RISK_SCORER_H
+#define RISK_SCORER_H
+
+#include "EventDetector.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The accumulated risk of one username or IP address
+ */
+struct RiskScore
+{
+    std::string key;                                 // Username or IP address
+    double score;                                    // Decayed score at the newest event
+    std::uint32_t events;                            // Events that contributed
+    std::array<std::uint32_t, kSuspiciousEventTypeCount> events_by_type;   // Events per type
+    std::chrono::system_clock::time_point last_event;  // Latest event
+};
+
+/**
+ * @brief Class aggregating suspicious events into per-user and per-IP risk
+ *
+ * Every event adds weightOf(type) * (1 + log10(event_count)) to its user
+ * and to each of its IP addresses, so a brute-force burst of 1000 attempts
+ * outweighs one of 5 without drowning every other signal. Scores decay
+ * with a half-life of kHalfLifeHours of log time: an event counts half as
+ * much as one kHalfLifeHours newer. Each subject stores its score as of
+ * its own latest event, so add() is O(1) and scores are only brought to
+ * a common time when they are ranked.
+ *
+ * Names are interned once into dense IDs through an open-addressing
+ * table of IDs (no node per name), and the scores live in flat arrays
+ * indexed by ID, so millions of events cost one probe sequence per
+ * subject and memory grows with the distinct subjects, not the events.
+ */
+class RiskScorer
+{
+public:
+    static constexpr double kHalfLifeHours = 24.0;   // Log time after which an event counts half
+
+    /**
+     * @brief Constructor
+     *
+     * @param top_n Users and IP addresses ranked (0 disables scoring)
+     */
+    explicit RiskScorer(std::size_t top_n);
+
+    /**
+     * @brief Adds one event to the scores of its user and IP addresses
+     *
+     * Events may be added in any order.
+     *
+     * @param event The detected event
+     */
+    void add(const SuspiciousEvent& event);
+
+    /**
+     * @brief Adds several events
+     *
+     * Rule profiles with similar thresholds often report the same
+     * behaviour, so an event equal to one already added from another
+     * profile (same type, username, IP addresses and span) is scored
+     * only once. Events of one profile, or untagged ones, all count.
+     *
+     * @param events The detected events
+     */
+    void add(const std::vector<SuspiciousEvent>& events);
+
+    /**
+     * @brief Checks whether scoring is enabled
+     *
+     * @return true if top_n is greater than 0
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Gets the riskiest users
+     *
+     * @return At most top_n users by decreasing score, ties by name
+     */
+    std::vector<RiskScore> topUsers() const;
+
+    /**
+     * @brief Gets the riskiest IP addresses
+     *
+     * @return At most top_n addresses by decreasing score, ties by address
+     */
+    std::vector<RiskScore> topIps() const;
+
+    /**
+     * @brief Gets the number of users with a score
+     */
+    std::size_t userCount() const;
+
+    /**
+     * @brief Gets the number of IP addresses with a score
+     */
+    std::size_t ipCount() const;
+
+    /**
+     * @brief Gets the weight of an event type
+     *
+     * @param type The event type
+     * @return Points added by one event of the type with event_count 1
+     */
+    static double weightOf(SuspiciousEventType type);
+
+private:
+    /**
+     * @brief Scores of one dimension (usernames or IP addresses) by interned ID
+     */
+    class ScoreTable
+    {
+    public:
+        /**
+         * @brief Constructor - empty table
+         */
+        ScoreTable();
+
+        /**
+         * @brief Adds points at a time to a name's score
+         */
+        void add(const std::string& name, SuspiciousEventType type,
+                 double points, std::int64_t second);
+
+        /**
+         * @brief Ranks the names by their score at a reference time
+         */
+        std::vector<RiskScore> top(std::size_t n, std::int64_t now_second) const;
+
+        /**
+         * @brief Gets the number of interned names
+         */
+        std::size_t size() const;
+
+    private:
+        /**
+         * @brief Gets the ID of a name, interning it with a zero score if new
+         */
+        std::uint32_t intern(const std::string& name, std::int64_t second);
+
+        /**
+         * @brief Doubles the slot array and reinserts all IDs
+         */
+        void grow();
+
+        static constexpr std::uint32_t kEmptySlot = 0xFFFFFFFFu;
+
+        std::vector<std::uint32_t> slots_;     // Open-addressing table of IDs (power of two)
+        std::vector<std::string> names_;       // Name by ID
+        std::vector<std::size_t> hashes_;      // Hash of the name by ID
+        std::vector<double> scores_;           // Score as of last_seconds_, by ID
+        std::vector<std::int64_t> last_seconds_;   // Latest event by ID
+        std::vector<std::array<std::uint32_t, kSuspiciousEventTypeCount>> counts_;   // Events per type by ID
+    };
+
+    std::size_t top_n_;            // Subjects ranked per list
+    bool has_events_;              // At least one event added
+    std::int64_t newest_second_;   // Latest event of all, the ranking time
+    ScoreTable users_;             // Scores by username
+    ScoreTable ips_;               // Scores by IP address
+};
+
+#endif // RISK_SCORER_H
@@ -0,0 +1,166 @@
+#ifndef RULE_PROFILES_H
+#define RULE_PROFILES_H
+
+#include "EventDetector.h"
+#include "LogEntry.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Named set of detection thresholds, such as one compliance policy
+ */
+struct RuleProfile
+{
+    std::string name;                // Tag of the profile's events
+    int failed_login_threshold;      // Minimum failed attempts to trigger alert
+    int time_window_minutes;         // Time window for event clustering (minutes)
+    int business_hour_start;         // Start of business hours (0-23)
+    int business_hour_end;           // End of business hours (0-23)
+    int spray_user_threshold;        // Distinct users failing from one IP
+    int distributed_ip_threshold;    // Distinct IPs failing for one user
+
+    /**
+     * @brief Default constructor with the detector's default thresholds
+     *
+     * - name: empty
+     * - failed_login_threshold: 5
+     * - time_window_minutes: 10
+     * - business_hour_start: 8
+     * - business_hour_end: 18
+     * - spray_user_threshold: 20
+     * - distributed_ip_threshold: 10
+     */
+    RuleProfile()
+        : name(""),
+          failed_login_threshold(5),
+          time_window_minutes(10),
+          business_hour_start(8),
+          business_hour_end(18),
+          spray_user_threshold(20),
+          distributed_ip_threshold(10)
+    {}
+};
+
+/**
+ * @brief Parses a --rule-profile specification
+ *
+ * A specification is a name, optionally followed by a colon and
+ * comma-separated settings:
+ *
+ *   pci:threshold=3,window=5,hours=9-17,spray=10,distributed=5
+ *
+ * Settings that are not given keep their value in profile, so callers
+ * fill it with the global options first.
+ *
+ * @param spec The specification
+ * @param profile Receives the name and settings
+ * @return false if the name is empty or not made of letters, digits,
+ *         '-' and '_', a key is unknown or a value is out of range
+ */
+bool parseRuleProfile(const std::string& spec, RuleProfile& profile);
+
+/**
+ * @brief Class evaluating several rule profiles in one detection pass
+ *
+ * Running the analyzer once per policy groups and sorts every user's
+ * entries once per run. ProfiledDetector instead groups and sorts the
+ * entries into per-user timelines once (EventDetector::groupTimelines())
+ * and folds the per-user rules of every profile over each timeline, and it
+ * sorts the failed logins once for the password spraying trackers of all
+ * profiles. Each event is tagged with the name of the profile that
+ * reported it.
+ *
+ * Every profile uses the rules, tables and input order of the detector
+ * it was built from, with its own thresholds.
+ */
+class ProfiledDetector
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param detector Detector providing rules, attached tables and input order
+     * @param profiles Profiles to evaluate, in report order
+     */
+    ProfiledDetector(const EventDetector& detector, const std::vector<RuleProfile>& profiles);
+
+    /**
+     * @brief Runs the per-user rules of every profile
+     *
+     * Groups the entries into timelines once; see detectTimelines().
+     *
+     * @param entries Entries of one or more complete users
+     * @return Tagged events, by profile and then by type
+     */
+    std::vector<SuspiciousEvent> detectPerUser(const std::vector<LogEntry>& entries) const;
+
+    /**
+     * @brief Runs the per-user rules of every profile on grouped timelines
+     *
+     * Each timeline is passed through the rules of all profiles in turn
+     * (see DetectionRules::RulePipeline::runUser()), so it is read while
+     * it is still in cache rather than once per profile.
+     *
+     * @param timelines One timeline per user, each in timestamp order
+     * @return Tagged events, by profile and then by type
+     */
+    std::vector<SuspiciousEvent> detectTimelines(
+        const std::vector<std::vector<LogEntry>>& timelines) const;
+
+    /**
+     * @brief Runs the per-user rules of every profile on timelines grouped
+     *        while loading and adds each profile's cross-user events
+     *
+     * See EventDetector::detectTimelines(); with the trackers fed in
+     * timestamp order this gives the events of detectAll().
+     *
+     * @param timelines One timeline per user, each in timestamp order
+     * @param cross_user_events Events of each profile's cross-user trackers,
+     *        in report order
+     * @return Tagged events, by profile and then by type
+     */
+    std::vector<SuspiciousEvent> detectTimelines(
+        const std::vector<std::vector<LogEntry>>& timelines,
+        std::vector<std::vector<SuspiciousEvent>> cross_user_events) const;
+
+    /**
+     * @brief Runs the per-user rules of every profile on one user's timeline
+     *
+     * Used on each user's merged history in external mode.
+     *
+     * @param timeline Entries of one user in timestamp order
+     * @return Tagged events, by profile and then by type
+     */
+    std::vector<SuspiciousEvent> detectTimeline(const std::vector<LogEntry>& timeline) const;
+
+    /**
+     * @brief Runs all rules of every profile
+     *
+     * @param entries Entries to analyze
+     * @return Tagged events in sortEvents() order
+     */
+    std::vector<SuspiciousEvent> detectAll(const std::vector<LogEntry>& entries) const;
+
+    /**
+     * @brief Sorts events by profile, then as DetectionRules::sortEventsByType()
+     *
+     * @param events Tagged events collected from several runs
+     */
+    void sortEvents(std::vector<SuspiciousEvent>& events) const;
+
+    /**
+     * @brief Gets the profiles in report order
+     */
+    const std::vector<RuleProfile>& profiles() const;
+
+private:
+    /**
+     * @brief Gets a profile's position in report order
+     */
+    std::size_t profileIndex(const std::string& name) const;
+
+    std::vector<RuleProfile> profiles_;      // Profiles in report order
+    std::vector<EventDetector> detectors_;   // Detector of each profile
+};
+
+#endif // RULE_PROFILES_H
@@ -0,0 +1,128 @@
+#ifndef SLIDING_DISTINCT_COUNTER_H
+#define SLIDING_DISTINCT_COUNTER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Class that counts distinct strings seen within a sliding time window
+ *
+ * Values are added with non-decreasing timestamps; a value stops counting
+ * once it was last seen window or longer ago.
+ *
+ * While few values are in the window they are counted exactly: the last
+ * time each hash was seen is kept, and a FIFO of arrivals expires them.
+ * When more than kExactLimit distinct values (or 4 * kExactLimit
+ * arrivals) are in the window, the counter switches to a sliding
+ * HyperLogLog (Chabchoub and Hebrail): each of the 2^precision registers
+ * keeps the timestamps of its possible future maxima, a list with
+ * increasing times and decreasing ranks that stays a few entries long.
+ * Adding a value touches one register, and the HyperLogLog sum is
+ * maintained incrementally, so both add() and estimate() take amortized
+ * constant time and memory no longer grows with the number of values.
+ *
+ * Registers other than the one being updated are expired in a sweep
+ * every eighth of the window, so a sketched estimate may still include
+ * values up to window / 8 older than the window.
+ */
+class SlidingDistinctCounter
+{
+public:
+    using TimePoint = std::chrono::system_clock::time_point;
+    using Duration = std::chrono::system_clock::duration;
+
+    /**
+     * @brief Constructor
+     *
+     * @param window Values last seen this long ago or longer are dropped
+     * @param precision Number of index bits of the sketch (4-16)
+     */
+    explicit SlidingDistinctCounter(Duration window, int precision = 8);
+
+    /**
+     * @brief Adds a value and moves the window to end at its timestamp
+     *
+     * @param value The value to count
+     * @param timestamp When it was seen (not earlier than previous calls)
+     */
+    void add(std::string_view value, TimePoint timestamp);
+
+    /**
+     * @brief Estimates the distinct values in the window ending at the last add()
+     *
+     * @return Exact count while isExact(), otherwise the sketch estimate
+     */
+    std::size_t estimate() const;
+
+    /**
+     * @brief Checks whether estimate() is exact
+     *
+     * @return true until the counter switched to the sketch
+     */
+    bool isExact() const;
+
+    /**
+     * @brief Removes all values and returns to exact counting
+     */
+    void clear();
+
+    static constexpr std::size_t kExactLimit = 256;   // Distinct values counted exactly
+
+private:
+    /**
+     * @brief A possible future maximum of a register
+     */
+    struct Candidate
+    {
+        TimePoint timestamp;   // When the rank was observed
+        std::uint8_t rank;     // HyperLogLog rank
+    };
+
+    /**
+     * @brief Drops exact arrivals that left the window
+     */
+    void expireExact();
+
+    /**
+     * @brief Moves the exact values into the sketch
+     */
+    void convertToSketch();
+
+    /**
+     * @brief Inserts a rank into a register
+     */
+    void addToSketch(std::uint64_t hash_value, TimePoint timestamp);
+
+    /**
+     * @brief Drops candidates of a register that left the window
+     */
+    void expireRegister(std::size_t index);
+
+    /**
+     * @brief Updates the running sum when a register's maximum changes
+     */
+    void replaceMaximum(std::uint8_t old_rank, std::uint8_t new_rank);
+
+    /**
+     * @brief Checks whether a timestamp is outside the window ending at now_
+     */
+    bool isExpired(TimePoint timestamp) const;
+
+    Duration window_;                                       // Window length
+    int precision_;                                         // Index bits of the sketch
+    TimePoint now_;                                         // End of the window
+    std::unordered_map<std::uint64_t, TimePoint> last_seen_;      // Exact mode: hash -> last time
+    std::deque<std::pair<TimePoint, std::uint64_t>> arrivals_;    // Exact mode: arrivals in order
+    std::vector<std::vector<Candidate>> registers_;         // Sketch mode: candidates per register
+    double register_sum_;                                   // Sum of 2^-max over registers
+    std::size_t zero_registers_;                            // Registers without candidates
+    TimePoint last_sweep_;                                  // Last full expiry sweep
+};
+
+#endif // SLIDING_DISTINCT_COUNTER_H
@@ -0,0 +1,133 @@
+#ifndef THRESHOLD_SWEEP_H
+#define THRESHOLD_SWEEP_H
+
+#include "LogEntry.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Class counting brute-force events over a grid of thresholds and windows
+ *
+ * Tuning the failed-login threshold and time window normally means one
+ * full analysis per combination. The sweep instead sorts each user's
+ * failure timestamps once. For every window, one two-pointer pass gives
+ * the number of failures in the window starting at each failure, and
+ * every threshold is answered from those counts by the greedy walk
+ * EventDetector::detectMultipleFailedLogins() performs: report a window
+ * that reaches the threshold and continue after it. The counts equal the
+ * MULTIPLE_FAILED_LOGINS events of a run with that threshold and window.
+ *
+ * Users with fewer failures than the smallest threshold are skipped
+ * without sorting, and thresholds above a user's largest window count
+ * cost nothing.
+ */
+class ThresholdSweep
+{
+public:
+    static constexpr std::size_t kMaxValues = 100;   // Values per axis of the grid
+
+    /**
+     * @brief Constructor
+     *
+     * @param thresholds Failed-login thresholds (rows; empty disables the sweep)
+     * @param windows Time windows in minutes (columns)
+     */
+    ThresholdSweep(const std::vector<int>& thresholds, const std::vector<int>& windows);
+
+    /**
+     * @brief Parses a grid such as "threshold=3..10 window=1,5,10,30"
+     *
+     * Items are separated by spaces or semicolons. Each axis is a comma
+     * list of numbers and inclusive ranges ("a..b"); values are sorted
+     * and duplicates removed. An axis that is not given keeps its value,
+     * so callers fill both with the configured threshold and window first.
+     *
+     * @param spec The grid
+     * @param thresholds Receives the thresholds
+     * @param windows Receives the windows in minutes
+     * @return false for unknown keys, values below 1 or more than
+     *         kMaxValues values on an axis
+     */
+    static bool parseGrid(const std::string& spec, std::vector<int>& thresholds,
+                          std::vector<int>& windows);
+
+    /**
+     * @brief Adds the failures of complete user histories
+     *
+     * @param entries Entries of any users, in any order
+     */
+    void add(const std::vector<LogEntry>& entries);
+
+    /**
+     * @brief Adds the failures of one user's complete history
+     *
+     * @param entries Entries of a single user, in any order
+     */
+    void addUser(const std::vector<LogEntry>& entries);
+
+    /**
+     * @brief Checks whether the sweep is enabled
+     *
+     * @return true if the grid has at least one threshold and window
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Gets the thresholds (rows), ascending
+     */
+    const std::vector<int>& thresholds() const;
+
+    /**
+     * @brief Gets the windows in minutes (columns), ascending
+     */
+    const std::vector<int>& windows() const;
+
+    /**
+     * @brief Gets the brute-force events at one grid point
+     *
+     * @param threshold_index Index into thresholds()
+     * @param window_index Index into windows()
+     */
+    std::uint64_t eventCount(std::size_t threshold_index, std::size_t window_index) const;
+
+    /**
+     * @brief Gets the users with at least one event at one grid point
+     *
+     * @param threshold_index Index into thresholds()
+     * @param window_index Index into windows()
+     */
+    std::uint64_t userCount(std::size_t threshold_index, std::size_t window_index) const;
+
+    /**
+     * @brief Writes the event and user count matrices
+     *
+     * @param output Stream to write the matrices to
+     */
+    void writeMatrix(std::ostream& output) const;
+
+private:
+    /**
+     * @brief Counts the events of one user's failure timestamps
+     *
+     * @param failures Timestamps in system_clock ticks (sorted in place)
+     */
+    void addTimeline(std::vector<std::int64_t>& failures);
+
+    /**
+     * @brief Writes one matrix
+     */
+    void writeCounts(const std::string& title, const std::vector<std::uint64_t>& counts,
+                     std::ostream& output) const;
+
+    std::vector<int> thresholds_;            // Rows, ascending
+    std::vector<int> windows_;               // Columns, ascending
+    std::vector<std::uint64_t> events_;      // Events by window * rows + threshold
+    std::vector<std::uint64_t> users_;       // Users with events, same layout
+    std::vector<std::uint32_t> window_counts_;  // Failures in the window at each failure (scratch)
+    std::vector<std::int64_t> timeline_;     // One user's failures (scratch)
+};
+
+#endif // THRESHOLD_SWEEP_H
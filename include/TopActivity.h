@@ -0,0 +1,85 @@
+#ifndef TOP_ACTIVITY_H
+#define TOP_ACTIVITY_H
+
+#include "HeavyHitters.h"
+#include "LogEntry.h"
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief Class ranking the most active IP addresses and users of a log
+ *
+ * Entries are counted while they are loaded, so the ranking costs nothing
+ * in the detection phase. Three HeavyHitters sketches are kept:
+ * - IP addresses with the most failed logins
+ * - Usernames with the most failed logins (most targeted users)
+ * - Usernames with the most entries (most active users)
+ *
+ * Each sketch tracks kTrackingFactor * k keys, which keeps the memory
+ * at O(k). Only keys that are certainly more frequent than every dropped
+ * key are listed, so a nearly flat distribution lists nothing rather than
+ * arbitrary keys; counts that may be overestimated are marked.
+ */
+class TopActivity
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param k Number of keys to rank in each list (0 disables ranking)
+     */
+    explicit TopActivity(std::size_t k);
+
+    /**
+     * @brief Counts one entry
+     *
+     * @param entry The analyzed entry
+     */
+    void add(const LogEntry& entry);
+
+    /**
+     * @brief Checks whether ranking is enabled
+     *
+     * @return true if k is greater than 0
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Gets the IP addresses with the most failed logins
+     */
+    const HeavyHitters& failingIps() const;
+
+    /**
+     * @brief Gets the usernames with the most failed logins
+     */
+    const HeavyHitters& targetedUsers() const;
+
+    /**
+     * @brief Gets the usernames with the most entries
+     */
+    const HeavyHitters& activeUsers() const;
+
+    /**
+     * @brief Writes the three rankings
+     *
+     * @param output Stream to write the summary to
+     */
+    void writeSummary(std::ostream& output) const;
+
+    static constexpr std::size_t kTrackingFactor = 4;   // Keys tracked per ranked key
+
+private:
+    /**
+     * @brief Writes one ranking
+     */
+    void writeRanking(const std::string& title, const HeavyHitters& hitters,
+                      std::ostream& output) const;
+
+    std::size_t k_;                  // Keys ranked per list
+    HeavyHitters failing_ips_;       // Failed logins per IP address
+    HeavyHitters targeted_users_;    // Failed logins per username
+    HeavyHitters active_users_;      // Entries per username
+};
+
+#endif // TOP_ACTIVITY_H
@@ -0,0 +1,110 @@
+#ifndef USER_TIMELINES_H
+#define USER_TIMELINES_H
+
+#include "LogEntry.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Class grouping log entries into one timeline per user
+ *
+ * Entries are appended to their user's timeline in the order they are
+ * added, so time-ordered input gives timelines that are already sorted.
+ * The per-user detection rules (see DetectionRules) all run on these
+ * timelines, so the entries are grouped once however many rules and
+ * rule profiles run, and the grouping can be done while the input is
+ * still being loaded. Each entry's arrival number is kept beside it, so
+ * sorted timelines can be merged back into the input's time order.
+ */
+class UserTimelines
+{
+public:
+    /**
+     * @brief Default constructor - starts without users
+     */
+    UserTimelines();
+
+    /**
+     * @brief Appends a copy of an entry to its user's timeline
+     */
+    void add(const LogEntry& entry);
+
+    /**
+     * @brief Moves an entry to the end of its user's timeline
+     */
+    void add(LogEntry&& entry);
+
+    /**
+     * @brief Gets the number of users with at least one entry
+     */
+    std::size_t userCount() const;
+
+    /**
+     * @brief Gets the number of entries in all timelines
+     */
+    std::size_t entryCount() const;
+
+    /**
+     * @brief Takes the timelines out and leaves no users behind
+     *
+     * @return One timeline per user, ordered by username; each timeline
+     *         keeps the order in which its entries were added
+     */
+    std::vector<std::vector<LogEntry>> release();
+
+    /**
+     * @brief Takes the timelines out with the arrival number of every entry
+     *
+     * @param arrivals Receives, for each timeline, the position of each of
+     *        its entries in the order they were added
+     * @return The timelines, as with release()
+     */
+    std::vector<std::vector<LogEntry>> release(std::vector<std::vector<std::uint64_t>>& arrivals);
+
+    /**
+     * @brief Puts the arrival numbers of released timelines in time order
+     *
+     * Reorders each timeline's arrivals as a stable sort of its entries by
+     * timestamp (such as EventDetector::sortTimelines()) reorders the
+     * entries, so call it before the timelines themselves are sorted.
+     *
+     * @param timelines Timelines of single users, not yet sorted
+     * @param arrivals Arrival numbers of the timelines' entries
+     */
+    static void sortArrivals(const std::vector<std::vector<LogEntry>>& timelines,
+                             std::vector<std::vector<std::uint64_t>>& arrivals);
+
+    /**
+     * @brief Visits the entries of sorted timelines in timestamp order
+     *
+     * A k-way merge over a min-heap of the timelines' next entries, for
+     * feeding stream detectors (such as PasswordSprayTracker) after the
+     * timelines had to be sorted. Entries with equal timestamps are
+     * visited in arrival order, so the stream detectors see the entries
+     * as after a stable sort of the whole input.
+     *
+     * @param timelines Timelines of single users, each in timestamp order
+     * @param arrivals Arrival numbers of the timelines' entries
+     * @param visit Called once per entry
+     */
+    static void forEachInTimeOrder(const std::vector<std::vector<LogEntry>>& timelines,
+                                   const std::vector<std::vector<std::uint64_t>>& arrivals,
+                                   const std::function<void(const LogEntry&)>& visit);
+
+private:
+    /**
+     * @brief Gets the position of a user's timeline, creating it on the first entry
+     */
+    std::size_t timelineOf(const std::string& username);
+
+    std::unordered_map<std::string, std::size_t> positions_;   // Username to timeline
+    std::vector<std::vector<LogEntry>> timelines_;             // Timelines by first appearance
+    std::vector<std::vector<std::uint64_t>> arrivals_;         // Arrival numbers per timeline
+    std::size_t entry_count_;                                   // Entries in all timelines
+};
+
+#endif // USER_TIMELINES_H
@@ -0,0 +1,294 @@
+#include "AsyncFileReader.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LOG_ANALYZER_POSIX_IO 1
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+AsyncFileReader::AsyncFileReader()
+    : fd_(-1),
+      fallback_(),
+      direct_io_(false),
+      capacity_(0),
+      buffers_{{nullptr, 0, false}, {nullptr, 0, false}},
+      consume_index_(0),
+      holding_(false),
+      consume_offset_(0),
+      finished_(false),
+      stop_(false),
+      error_(false)
+{
+}
+
+AsyncFileReader::~AsyncFileReader()
+{
+    close();
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+bool AsyncFileReader::open(const std::string& path, const ReaderOptions& options)
+{
+    close();
+
+    // Round the block size up to the alignment required by O_DIRECT
+    capacity_ = std::max<std::size_t>(options.block_bytes, kAlignment);
+    capacity_ = (capacity_ + kAlignment - 1) / kAlignment * kAlignment;
+
+#ifdef LOG_ANALYZER_POSIX_IO
+    int flags = O_RDONLY;
+#ifdef O_DIRECT
+    if (options.direct_io)
+    {
+        fd_ = ::open(path.c_str(), flags | O_DIRECT);
+        direct_io_ = (fd_ >= 0);
+    }
+#endif
+    if (fd_ < 0)
+    {
+        // Either direct I/O was not requested or the filesystem refused it
+        fd_ = ::open(path.c_str(), flags);
+    }
+    if (fd_ < 0)
+    {
+        return false;
+    }
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+    if (options.sequential_hint)
+    {
+        // Let the kernel read ahead aggressively; failure is harmless
+        ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+#endif
+#else
+    (void)options;
+    fallback_.open(path, std::ios::binary);
+    if (!fallback_.is_open())
+    {
+        return false;
+    }
+#endif
+
+    for (auto& buffer : buffers_)
+    {
+        buffer.data = static_cast<char*>(::operator new(capacity_, std::align_val_t(kAlignment)));
+        buffer.size = 0;
+        buffer.full = false;
+    }
+
+    consume_index_ = 0;
+    holding_ = false;
+    consume_offset_ = 0;
+    finished_ = false;
+    stop_ = false;
+    error_ = false;
+
+    thread_ = std::thread(&AsyncFileReader::readerLoop, this);
+    return true;
+}
+
+bool AsyncFileReader::nextBlock(std::string_view& block)
+{
+    if (finished_ || buffers_[0].data == nullptr)
+    {
+        return false;
+    }
+
+    releaseCurrent();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    Buffer& buffer = buffers_[consume_index_];
+    changed_.wait(lock, [&buffer]() { return buffer.full; });
+
+    if (buffer.size == 0)
+    {
+        // End-of-file marker; leave it owned so the reader stays stopped
+        finished_ = true;
+        return false;
+    }
+
+    holding_ = true;
+    consume_offset_ = 0;
+    block = std::string_view(buffer.data, buffer.size);
+    return true;
+}
+
+std::size_t AsyncFileReader::read(char* destination, std::size_t size)
+{
+    std::size_t copied = 0;
+
+    while (copied < size)
+    {
+        // Fetch the next block once the current one is used up
+        if (!holding_ || consume_offset_ == buffers_[consume_index_].size)
+        {
+            std::string_view block;
+            if (!nextBlock(block))
+            {
+                break;
+            }
+        }
+
+        const Buffer& buffer = buffers_[consume_index_];
+        std::size_t available = std::min(size - copied, buffer.size - consume_offset_);
+        std::memcpy(destination + copied, buffer.data + consume_offset_, available);
+        consume_offset_ += available;
+        copied += available;
+    }
+
+    return copied;
+}
+
+bool AsyncFileReader::failed() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return error_;
+}
+
+void AsyncFileReader::close()
+{
+    if (thread_.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        changed_.notify_all();
+        thread_.join();
+    }
+
+#ifdef LOG_ANALYZER_POSIX_IO
+    if (fd_ >= 0)
+    {
+        ::close(fd_);
+        fd_ = -1;
+    }
+#endif
+    if (fallback_.is_open())
+    {
+        fallback_.close();
+    }
+
+    for (auto& buffer : buffers_)
+    {
+        if (buffer.data != nullptr)
+        {
+            ::operator delete(buffer.data, std::align_val_t(kAlignment));
+            buffer.data = nullptr;
+        }
+    }
+
+    direct_io_ = false;
+}
+
+bool AsyncFileReader::usingDirectIo() const
+{
+    return direct_io_;
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+void AsyncFileReader::readerLoop()
+{
+    std::size_t index = 0;
+
+    while (true)
+    {
+        Buffer& buffer = buffers_[index];
+
+        // Wait until the consumer has handed this buffer back
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            changed_.wait(lock, [this, &buffer]() { return stop_ || !buffer.full; });
+            if (stop_)
+            {
+                return;
+            }
+        }
+
+        // Read outside the lock so the consumer can keep parsing
+        std::size_t bytes_read = fill(buffer.data, capacity_);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            buffer.size = bytes_read;
+            buffer.full = true;
+        }
+        changed_.notify_all();
+
+        if (bytes_read == 0)
+        {
+            return;   // End of file (or error) has been published
+        }
+
+        index ^= 1;
+    }
+}
+
+std::size_t AsyncFileReader::fill(char* data, std::size_t capacity)
+{
+    std::size_t filled = 0;
+
+#ifdef LOG_ANALYZER_POSIX_IO
+    while (filled < capacity)
+    {
+        ssize_t result = ::read(fd_, data + filled, capacity - filled);
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            error_ = true;
+            break;
+        }
+        if (result == 0)
+        {
+            break;   // End of file
+        }
+        filled += static_cast<std::size_t>(result);
+    }
+#else
+    fallback_.read(data, static_cast<std::streamsize>(capacity));
+    filled = static_cast<std::size_t>(fallback_.gcount());
+    if (fallback_.bad())
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        error_ = true;
+    }
+#endif
+
+    return filled;
+}
+
+void AsyncFileReader::releaseCurrent()
+{
+    if (!holding_)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffers_[consume_index_].full = false;
+    }
+    changed_.notify_all();
+
+    holding_ = false;
+    consume_index_ ^= 1;
+}
@@ -0,0 +1,78 @@
+#include "BatchStage.h"
+#include <utility>
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+BatchStage::BatchStage(const Consumer& consumer, std::size_t depth)
+    : consumer_(consumer),
+      queue_(depth),
+      error_(),
+      finished_(false),
+      thread_(&BatchStage::run, this)
+{
+}
+
+BatchStage::~BatchStage()
+{
+    if (!finished_)
+    {
+        queue_.close();
+        thread_.join();
+    }
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+void BatchStage::push(std::vector<LogEntry>&& batch)
+{
+    if (!batch.empty())
+    {
+        queue_.push(std::move(batch));
+    }
+}
+
+void BatchStage::finish()
+{
+    if (finished_)
+    {
+        return;
+    }
+
+    queue_.close();
+    thread_.join();
+    finished_ = true;
+
+    if (error_)
+    {
+        std::rethrow_exception(error_);
+    }
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+void BatchStage::run()
+{
+    std::vector<LogEntry> batch;
+    while (queue_.pop(batch))
+    {
+        // After a failure the rest is drained so push() cannot block
+        if (error_)
+        {
+            continue;
+        }
+        try
+        {
+            consumer_(batch);
+        }
+        catch (...)
+        {
+            error_ = std::current_exception();
+        }
+    }
+}
@@ -0,0 +1,476 @@
+#include "CidrTrie.h"
+#include <fstream>
+
+namespace
+{
+
+using Address = CidrTrie::Address;
+
+/**
+ * @brief Gets bit i of an address (0 = most significant)
+ */
+int bitAt(const Address& address, int i)
+{
+    if (i < 64)
+    {
+        return static_cast<int>((address.high >> (63 - i)) & 1u);
+    }
+    return static_cast<int>((address.low >> (127 - i)) & 1u);
+}
+
+/**
+ * @brief Clears the bits of an address beyond a prefix length
+ */
+Address maskTo(const Address& address, int length)
+{
+    Address masked = {0, 0};
+    if (length >= 64)
+    {
+        masked.high = address.high;
+        if (length >= 128)
+        {
+            masked.low = address.low;
+        }
+        else if (length > 64)
+        {
+            masked.low = address.low & (~0ULL << (128 - length));
+        }
+    }
+    else if (length > 0)
+    {
+        masked.high = address.high & (~0ULL << (64 - length));
+    }
+    return masked;
+}
+
+/**
+ * @brief Checks whether an address starts with a prefix
+ */
+bool startsWith(const Address& address, const Address& prefix, int length)
+{
+    Address masked = maskTo(address, length);
+    return masked.high == prefix.high && masked.low == prefix.low;
+}
+
+/**
+ * @brief Counts the leading zero bits of a 64-bit value
+ */
+int leadingZeros(std::uint64_t value)
+{
+    if (value == 0)
+    {
+        return 64;
+    }
+    int count = 0;
+    for (int shift = 32; shift > 0; shift /= 2)
+    {
+        if ((value >> (64 - shift)) == 0)
+        {
+            count += shift;
+            value <<= shift;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Gets the number of leading bits two addresses share, up to a limit
+ */
+int commonLength(const Address& a, const Address& b, int limit)
+{
+    int common = leadingZeros(a.high ^ b.high);
+    if (common == 64)
+    {
+        common += leadingZeros(a.low ^ b.low);
+    }
+    return (common < limit) ? common : limit;
+}
+
+/**
+ * @brief Parses a dotted-quad IPv4 address into 32 bits
+ */
+std::optional<std::uint32_t> parseIPv4Bits(std::string_view text)
+{
+    std::uint32_t value = 0;
+    std::size_t pos = 0;
+
+    for (int octet_index = 0; octet_index < 4; ++octet_index)
+    {
+        std::uint32_t octet = 0;
+        std::size_t digits = 0;
+        while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9' && digits < 3)
+        {
+            octet = octet * 10 + static_cast<std::uint32_t>(text[pos] - '0');
+            pos++;
+            digits++;
+        }
+        if (digits == 0 || octet > 255)
+        {
+            return std::nullopt;
+        }
+        value = (value << 8) | octet;
+
+        if (octet_index < 3)
+        {
+            if (pos >= text.size() || text[pos] != '.')
+            {
+                return std::nullopt;
+            }
+            pos++;
+        }
+    }
+
+    if (pos != text.size())
+    {
+        return std::nullopt;
+    }
+    return value;
+}
+
+/**
+ * @brief Parses colon-separated hex groups, optionally ending in an IPv4 address
+ *
+ * @return Number of 16-bit groups written, or -1 if invalid
+ */
+int parseGroups(std::string_view text, std::uint16_t* groups, int max_groups)
+{
+    if (text.empty())
+    {
+        return 0;
+    }
+
+    int count = 0;
+    std::size_t start = 0;
+    for (;;)
+    {
+        std::size_t colon = text.find(':', start);
+        std::string_view group = text.substr(start, colon - start);
+
+        // An IPv4 tail fills the last two groups
+        if (colon == std::string_view::npos && group.find('.') != std::string_view::npos)
+        {
+            std::optional<std::uint32_t> ipv4 = parseIPv4Bits(group);
+            if (!ipv4 || count + 2 > max_groups)
+            {
+                return -1;
+            }
+            groups[count++] = static_cast<std::uint16_t>(*ipv4 >> 16);
+            groups[count++] = static_cast<std::uint16_t>(*ipv4 & 0xFFFFu);
+            return count;
+        }
+
+        if (group.empty() || group.size() > 4 || count >= max_groups)
+        {
+            return -1;
+        }
+        std::uint16_t value = 0;
+        for (char c : group)
+        {
+            int digit;
+            if (c >= '0' && c <= '9')
+            {
+                digit = c - '0';
+            }
+            else if (c >= 'a' && c <= 'f')
+            {
+                digit = c - 'a' + 10;
+            }
+            else if (c >= 'A' && c <= 'F')
+            {
+                digit = c - 'A' + 10;
+            }
+            else
+            {
+                return -1;
+            }
+            value = static_cast<std::uint16_t>((value << 4) | digit);
+        }
+        groups[count++] = value;
+
+        if (colon == std::string_view::npos)
+        {
+            return count;
+        }
+        start = colon + 1;
+    }
+}
+
+/**
+ * @brief Parses an IPv6 address, with or without "::"
+ */
+std::optional<Address> parseIPv6(std::string_view text)
+{
+    std::uint16_t groups[8] = {};
+    std::size_t gap = text.find("::");
+
+    if (gap == std::string_view::npos)
+    {
+        if (parseGroups(text, groups, 8) != 8)
+        {
+            return std::nullopt;
+        }
+    }
+    else
+    {
+        std::uint16_t tail[8] = {};
+        int head_count = parseGroups(text.substr(0, gap), groups, 7);
+        int tail_count = parseGroups(text.substr(gap + 2), tail, 7);
+        if (head_count < 0 || tail_count < 0 || head_count + tail_count > 7)
+        {
+            return std::nullopt;
+        }
+        for (int i = 0; i < tail_count; ++i)
+        {
+            groups[8 - tail_count + i] = tail[i];
+        }
+    }
+
+    Address address = {0, 0};
+    for (int i = 0; i < 4; ++i)
+    {
+        address.high = (address.high << 16) | groups[i];
+        address.low = (address.low << 16) | groups[i + 4];
+    }
+    return address;
+}
+
+} // namespace
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+CidrTrie::CidrTrie()
+    : nodes_(),
+      prefix_count_(0),
+      failed_line_(0)
+{
+    addNode(Address{0, 0}, 0, false);
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+bool CidrTrie::insert(std::string_view cidr)
+{
+    std::size_t slash = cidr.find('/');
+    std::optional<Address> address = parseAddress(cidr.substr(0, slash));
+    if (!address)
+    {
+        return false;
+    }
+
+    // IPv4 prefix lengths count from the start of the mapped address
+    bool is_ipv4 = cidr.substr(0, slash).find(':') == std::string_view::npos;
+    int max_length = is_ipv4 ? 32 : 128;
+    int length = max_length;
+
+    if (slash != std::string_view::npos)
+    {
+        std::string_view digits = cidr.substr(slash + 1);
+        if (digits.empty() || digits.size() > 3)
+        {
+            return false;
+        }
+        length = 0;
+        for (char c : digits)
+        {
+            if (c < '0' || c > '9')
+            {
+                return false;
+            }
+            length = length * 10 + (c - '0');
+        }
+        if (length > max_length)
+        {
+            return false;
+        }
+    }
+
+    insertPrefix(*address, is_ipv4 ? length + 96 : length);
+    prefix_count_++;
+    return true;
+}
+
+bool CidrTrie::load(const std::string& path)
+{
+    failed_line_ = 0;
+
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    std::string line;
+    std::size_t line_number = 0;
+    while (std::getline(file, line))
+    {
+        line_number++;
+        std::string_view text = line;
+
+        std::size_t comment = text.find('#');
+        if (comment != std::string_view::npos)
+        {
+            text = text.substr(0, comment);
+        }
+        while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+        {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r'))
+        {
+            text.remove_suffix(1);
+        }
+        if (text.empty())
+        {
+            continue;
+        }
+
+        if (!insert(text))
+        {
+            failed_line_ = line_number;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CidrTrie::contains(std::string_view ip_address) const
+{
+    if (prefix_count_ == 0)
+    {
+        return false;
+    }
+
+    std::optional<Address> address = parseAddress(ip_address);
+    return address && contains(*address);
+}
+
+bool CidrTrie::contains(const Address& address) const
+{
+    const Node* node = &nodes_[0];
+    for (;;)
+    {
+        if (node->terminal)
+        {
+            return true;
+        }
+        if (node->length >= 128)
+        {
+            return false;
+        }
+
+        std::uint32_t child = node->children[bitAt(address, node->length)];
+        if (child == kNoChild)
+        {
+            return false;
+        }
+        node = &nodes_[child];
+        if (!startsWith(address, node->prefix, node->length))
+        {
+            return false;
+        }
+    }
+}
+
+std::size_t CidrTrie::size() const
+{
+    return prefix_count_;
+}
+
+std::size_t CidrTrie::failedLine() const
+{
+    return failed_line_;
+}
+
+std::optional<CidrTrie::Address> CidrTrie::parseAddress(std::string_view text)
+{
+    if (text.find(':') != std::string_view::npos)
+    {
+        return parseIPv6(text);
+    }
+
+    std::optional<std::uint32_t> ipv4 = parseIPv4Bits(text);
+    if (!ipv4)
+    {
+        return std::nullopt;
+    }
+    return Address{0, 0x0000FFFF00000000ULL | *ipv4};
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+void CidrTrie::insertPrefix(const Address& address, int length)
+{
+    Address prefix = maskTo(address, length);
+    std::uint32_t current = 0;
+
+    for (;;)
+    {
+        // Invariant: the current node's prefix is a prefix of the new one
+        if (nodes_[current].terminal)
+        {
+            return;   // Already covered
+        }
+        if (nodes_[current].length == length)
+        {
+            nodes_[current].terminal = true;
+            nodes_[current].children[0] = kNoChild;
+            nodes_[current].children[1] = kNoChild;
+            return;
+        }
+
+        int bit = bitAt(prefix, nodes_[current].length);
+        std::uint32_t child = nodes_[current].children[bit];
+        if (child == kNoChild)
+        {
+            std::uint32_t leaf = addNode(prefix, length, true);
+            nodes_[current].children[bit] = leaf;
+            return;
+        }
+
+        const Node& child_node = nodes_[child];
+        int child_length = child_node.length;
+        int common = commonLength(prefix, child_node.prefix,
+                                  (length < child_length) ? length : child_length);
+        if (common == child_length)
+        {
+            current = child;
+            continue;
+        }
+
+        if (common == length)
+        {
+            // The new prefix covers the child's whole subtree
+            std::uint32_t leaf = addNode(prefix, length, true);
+            nodes_[current].children[bit] = leaf;
+            return;
+        }
+
+        // Split: a branch node where the new prefix and the child diverge
+        Address child_prefix = child_node.prefix;
+        std::uint32_t branch = addNode(prefix, common, false);
+        std::uint32_t leaf = addNode(prefix, length, true);
+        nodes_[branch].children[bitAt(child_prefix, common)] = child;
+        nodes_[branch].children[bitAt(prefix, common)] = leaf;
+        nodes_[current].children[bit] = branch;
+        return;
+    }
+}
+
+std::uint32_t CidrTrie::addNode(const Address& prefix, int length, bool terminal)
+{
+    Node node;
+    node.prefix = maskTo(prefix, length);
+    node.length = static_cast<std::uint8_t>(length);
+    node.terminal = terminal;
+    node.children[0] = kNoChild;
+    node.children[1] = kNoChild;
+    nodes_.push_back(node);
+    return static_cast<std::uint32_t>(nodes_.size() - 1);
+}
@@ -1,4 +1,10 @@
 #include "ConfigManager.h"
+#include "DetectionRules.h"
+#include "LogFormats.h"
+#include "PatternMatcher.h"
+#include "RuleProfiles.h"
+#include "ThresholdSweep.h"
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <cctype>
@@ -47,6 +53,17 @@ bool ConfigManager::parseCommandLineArgs(int argc, char* argv[])
             config_.log_file_path = argv[++i];
         }
         
+        // Check for further input file argument
+        else if (arg == "--add-input") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --add-input requires a file path\n";
+                return false;
+            }
+            config_.additional_log_file_paths.push_back(argv[++i]);
+        }
+        
         // Check for output file argument
         else if (arg == "--output" || arg == "-o") 
         {
@@ -58,6 +75,52 @@ bool ConfigManager::parseCommandLineArgs(int argc, char* argv[])
             config_.report_output_path = argv[++i];
         }
         
+        // Check for input format argument
+        else if (arg == "--format-in") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --format-in requires a format name\n";
+                return false;
+            }
+            config_.input_format = argv[++i];
+        }
+        
+        // Check for line template argument
+        else if (arg == "--pattern") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --pattern requires a template\n";
+                return false;
+            }
+            config_.line_pattern = argv[++i];
+            
+            std::string error_message;
+            if (!PatternMatcher::compile(config_.line_pattern, error_message).has_value()) 
+            {
+                std::cerr << "Error: Invalid --pattern: " << error_message << "\n";
+                return false;
+            }
+        }
+        
+        // Check for syslog year argument
+        else if (arg == "--syslog-year") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --syslog-year requires a year\n";
+                return false;
+            }
+            int year;
+            if (!parseInteger(argv[++i], year)) 
+            {
+                std::cerr << "Error: Invalid syslog year\n";
+                return false;
+            }
+            config_.syslog_year = year;
+        }
+        
         // Check for threshold argument
         else if (arg == "--threshold" || arg == "-t") 
         {
@@ -75,6 +138,40 @@ bool ConfigManager::parseCommandLineArgs(int argc, char* argv[])
             config_.failed_login_threshold = threshold;
         }
         
+        // Check for password spraying threshold argument
+        else if (arg == "--spray-threshold") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --spray-threshold requires a number\n";
+                return false;
+            }
+            int threshold;
+            if (!parseInteger(argv[++i], threshold)) 
+            {
+                std::cerr << "Error: Invalid spraying threshold value\n";
+                return false;
+            }
+            config_.spray_user_threshold = threshold;
+        }
+        
+        // Check for distributed brute-force threshold argument
+        else if (arg == "--distributed-threshold") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --distributed-threshold requires a number\n";
+                return false;
+            }
+            int threshold;
+            if (!parseInteger(argv[++i], threshold)) 
+            {
+                std::cerr << "Error: Invalid distributed threshold value\n";
+                return false;
+            }
+            config_.distributed_ip_threshold = threshold;
+        }
+        
         // Check for time window argument
         else if (arg == "--window" || arg == "-w") 
         {
@@ -92,6 +189,100 @@ bool ConfigManager::parseCommandLineArgs(int argc, char* argv[])
             config_.time_window_minutes = window;
         }
         
+        // Check for GeoIP table argument
+        else if (arg == "--geoip") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --geoip requires a file path\n";
+                return false;
+            }
+            config_.geoip_path = argv[++i];
+        }
+        
+        // Check for GeoIP binary output argument
+        else if (arg == "--geoip-save") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --geoip-save requires a file path\n";
+                return false;
+            }
+            config_.geoip_save_path = argv[++i];
+        }
+        
+        // Check for maximum travel speed argument
+        else if (arg == "--max-speed") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --max-speed requires a speed in km/h\n";
+                return false;
+            }
+            int speed;
+            if (!parseInteger(argv[++i], speed)) 
+            {
+                std::cerr << "Error: Invalid maximum speed value\n";
+                return false;
+            }
+            config_.max_travel_speed_kmh = speed;
+        }
+        
+        // Check for detection rules argument
+        else if (arg == "--rules") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --rules requires a list of rule names\n";
+                return false;
+            }
+            config_.rules = argv[++i];
+        }
+        
+        // Check for rule profile argument (repeatable)
+        else if (arg == "--rule-profile") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --rule-profile requires a profile specification\n";
+                return false;
+            }
+            config_.rule_profiles.push_back(argv[++i]);
+        }
+        
+        // Check for allowlist argument
+        else if (arg == "--allowlist") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --allowlist requires a file path\n";
+                return false;
+            }
+            config_.allowlist_path = argv[++i];
+        }
+        
+        // Check for denylist argument
+        else if (arg == "--denylist") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --denylist requires a file path\n";
+                return false;
+            }
+            config_.denylist_path = argv[++i];
+        }
+        
+        // Check for baseline profile argument
+        else if (arg == "--baseline") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --baseline requires a file path\n";
+                return false;
+            }
+            config_.baseline_path = argv[++i];
+        }
+        
         // Check for business hours argument
         else if (arg == "--hours") 
         {
@@ -110,6 +301,218 @@ bool ConfigManager::parseCommandLineArgs(int argc, char* argv[])
             config_.business_hour_end = end;
         }
         
+        // Check for username filter argument
+        else if (arg == "--user") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --user requires a username\n";
+                return false;
+            }
+            config_.filter_user = argv[++i];
+        }
+        
+        // Check for IP address filter argument
+        else if (arg == "--ip") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --ip requires an IP address\n";
+                return false;
+            }
+            config_.filter_ip = argv[++i];
+        }
+        
+        // Check for status filter argument
+        else if (arg == "--status") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --status requires SUCCESS or FAILED\n";
+                return false;
+            }
+            config_.filter_status = argv[++i];
+        }
+        
+        // Check for verbose invalid-line diagnostics flag
+        else if (arg == "--verbose-errors") 
+        {
+            config_.verbose_errors = true;
+        }
+        
+        // Check for error sample count argument
+        else if (arg == "--error-samples") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --error-samples requires a number\n";
+                return false;
+            }
+            int samples;
+            if (!parseInteger(argv[++i], samples)) 
+            {
+                std::cerr << "Error: Invalid error sample count\n";
+                return false;
+            }
+            config_.max_error_samples = samples;
+        }
+        
+        // Check for top-activity ranking length argument
+        else if (arg == "--top-k") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --top-k requires a number\n";
+                return false;
+            }
+            int top_k;
+            if (!parseInteger(argv[++i], top_k)) 
+            {
+                std::cerr << "Error: Invalid top-k value\n";
+                return false;
+            }
+            config_.top_k = top_k;
+        }
+        
+        // Check for rate spike threshold argument
+        else if (arg == "--spike-z") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --spike-z requires a number\n";
+                return false;
+            }
+            int threshold;
+            if (!parseInteger(argv[++i], threshold)) 
+            {
+                std::cerr << "Error: Invalid spike z-score value\n";
+                return false;
+            }
+            config_.spike_z_threshold = threshold;
+        }
+        
+        // Check for risk ranking length argument
+        else if (arg == "--top") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --top requires a number\n";
+                return false;
+            }
+            int risk_top;
+            if (!parseInteger(argv[++i], risk_top)) 
+            {
+                std::cerr << "Error: Invalid top value\n";
+                return false;
+            }
+            config_.risk_top = risk_top;
+        }
+        
+        // Check for threshold sweep argument
+        else if (arg == "--sweep") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --sweep requires a grid such as threshold=3..10 window=1,5,10\n";
+                return false;
+            }
+            config_.sweep = argv[++i];
+            
+            // The grid may continue in the next arguments (threshold=... window=...)
+            while (i + 1 < argc && argv[i + 1][0] != '-' && 
+                   std::string(argv[i + 1]).find('=') != std::string::npos) 
+            {
+                config_.sweep += " ";
+                config_.sweep += argv[++i];
+            }
+        }
+        
+        // Check for parser thread count argument
+        else if (arg == "--threads") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --threads requires a number\n";
+                return false;
+            }
+            int threads;
+            if (!parseInteger(argv[++i], threads)) 
+            {
+                std::cerr << "Error: Invalid thread count\n";
+                return false;
+            }
+            config_.parser_threads = threads;
+        }
+        
+        // Check for prefetch disable flag
+        else if (arg == "--no-prefetch") 
+        {
+            config_.prefetch_input = false;
+        }
+        
+        // Check for direct I/O flag
+        else if (arg == "--direct-io") 
+        {
+            config_.direct_io = true;
+        }
+        
+        // Check for io_uring flag
+        else if (arg == "--io-uring") 
+        {
+            config_.use_io_uring = true;
+        }
+        
+        // Check for I/O queue depth argument
+        else if (arg == "--io-depth") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --io-depth requires a number\n";
+                return false;
+            }
+            int depth;
+            if (!parseInteger(argv[++i], depth)) 
+            {
+                std::cerr << "Error: Invalid I/O queue depth\n";
+                return false;
+            }
+            config_.io_queue_depth = depth;
+        }
+        
+        // Check for memory limit argument
+        else if (arg == "--memory-limit") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --memory-limit requires a size in MB\n";
+                return false;
+            }
+            int limit;
+            if (!parseInteger(argv[++i], limit)) 
+            {
+                std::cerr << "Error: Invalid memory limit\n";
+                return false;
+            }
+            config_.memory_limit_mb = limit;
+        }
+        
+        // Check for lateness watermark argument
+        else if (arg == "--lateness") 
+        {
+            if (i + 1 >= argc) 
+            {
+                std::cerr << "Error: --lateness requires a number of seconds\n";
+                return false;
+            }
+            int lateness;
+            if (!parseInteger(argv[++i], lateness)) 
+            {
+                std::cerr << "Error: Invalid lateness\n";
+                return false;
+            }
+            config_.lateness_seconds = lateness;
+        }
+        
         // Unknown argument
         else 
         {
@@ -164,6 +567,49 @@ bool ConfigManager::validateConfiguration() const
         return false;
     }
     
+    // Validate password spraying threshold (one user is not spraying)
+    if (config_.spray_user_threshold < 2) 
+    {
+        return false;
+    }
+    
+    // Validate distributed brute-force threshold (one IP is not distributed)
+    if (config_.distributed_ip_threshold < 2) 
+    {
+        return false;
+    }
+    
+    // Validate impossible-travel settings
+    if (config_.max_travel_speed_kmh <= 0) 
+    {
+        return false;
+    }
+    
+    if (!config_.geoip_save_path.empty() && config_.geoip_path.empty()) 
+    {
+        return false;
+    }
+    
+    // Validate the rule list
+    RuleSet rules;
+    if (!DetectionRules::parseRuleList(config_.rules, rules)) 
+    {
+        return false;
+    }
+    
+    // Validate rule profiles; their names tag the events, so they must differ
+    std::vector<std::string> profile_names;
+    for (const auto& spec : config_.rule_profiles) 
+    {
+        RuleProfile profile;
+        if (!parseRuleProfile(spec, profile) || 
+            std::find(profile_names.begin(), profile_names.end(), profile.name) != profile_names.end()) 
+        {
+            return false;
+        }
+        profile_names.push_back(profile.name);
+    }
+    
     // Validate business hour start
     if (config_.business_hour_start < 0 || config_.business_hour_start > 23) 
     {
@@ -193,6 +639,109 @@ bool ConfigManager::validateConfiguration() const
         return false;
     }
     
+    // Validate error sample count
+    if (config_.max_error_samples < 0) 
+    {
+        return false;
+    }
+    
+    // Validate top-activity ranking length
+    if (config_.top_k < 0 || config_.top_k > 1000) 
+    {
+        return false;
+    }
+    
+    // Validate rate spike threshold
+    if (config_.spike_z_threshold < 0 || config_.spike_z_threshold > 100) 
+    {
+        return false;
+    }
+    
+    // Validate risk ranking length
+    if (config_.risk_top < 0 || config_.risk_top > 1000) 
+    {
+        return false;
+    }
+    
+    // Validate the sweep grid
+    std::vector<int> sweep_thresholds = {config_.failed_login_threshold};
+    std::vector<int> sweep_windows = {config_.time_window_minutes};
+    if (!config_.sweep.empty() && 
+        !ThresholdSweep::parseGrid(config_.sweep, sweep_thresholds, sweep_windows)) 
+    {
+        return false;
+    }
+    
+    // Validate parser thread count
+    if (config_.parser_threads < 0 || config_.parser_threads > 256) 
+    {
+        return false;
+    }
+    
+    // Validate input format
+    if (!LogFormats::parseInputFormat(config_.input_format).has_value()) 
+    {
+        return false;
+    }
+    
+    // Validate line template
+    if (!config_.line_pattern.empty()) 
+    {
+        std::string error_message;
+        if (!PatternMatcher::compile(config_.line_pattern, error_message).has_value()) 
+        {
+            return false;
+        }
+    }
+    
+    // Validate syslog year (0 infers it from each file)
+    if (config_.syslog_year != 0 && (config_.syslog_year < 1970 || config_.syslog_year > 9999)) 
+    {
+        return false;
+    }
+    
+    // Validate I/O queue depth
+    if (config_.io_queue_depth < 1 || config_.io_queue_depth > 256) 
+    {
+        return false;
+    }
+    
+    // Validate memory limit (0 disables the external mode)
+    if (config_.memory_limit_mb < 0) 
+    {
+        return false;
+    }
+    
+    // Validate lateness watermark (0 disables reordering, at most one day)
+    if (config_.lateness_seconds < 0 || config_.lateness_seconds > 86400) 
+    {
+        return false;
+    }
+    
+    // Validate additional input paths
+    for (const auto& path : config_.additional_log_file_paths) 
+    {
+        if (path.empty()) 
+        {
+            return false;
+        }
+    }
+    
+    // Validate status filter (empty means no filtering)
+    if (!config_.filter_status.empty()) 
+    {
+        std::string status_upper = config_.filter_status;
+        for (auto& c : status_upper) 
+        {
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+        
+        if (status_upper != "SUCCESS" && status_upper != "FAILED") 
+        {
+            return false;
+        }
+    }
+    
     return true;
 }
 
@@ -209,18 +758,98 @@ void ConfigManager::displayUsage() const
     std::cout << "Options:\n";
     std::cout << "  --input, -i <path>        Path to input log file\n";
     std::cout << "                            Default: logs/sample.log\n\n";
+    std::cout << "  --add-input <path>        Further log file analyzed after --input\n";
+    std::cout << "                            (repeat for more files)\n\n";
     std::cout << "  --output, -o <path>       Path to output report file\n";
     std::cout << "                            Default: reports/report.txt\n\n";
+    std::cout << "  --format-in <format>      Input line format: pipe, syslog, json, csv\n";
+    std::cout << "                            Default: pipe\n\n";
+    std::cout << "  --pattern <template>      Custom line template using %ts, %user, %ip,\n";
+    std::cout << "                            %status and %* (overrides --format-in)\n\n";
+    std::cout << "  --syslog-year <year>      Year of syslog timestamps\n";
+    std::cout << "                            Default: year each file was last modified\n";
+    std::cout << "                            (earlier entries in later months: year before)\n\n";
     std::cout << "  --threshold, -t <number>  Failed login threshold\n";
     std::cout << "                            Default: 5\n\n";
     std::cout << "  --window, -w <minutes>    Time window for event clustering\n";
     std::cout << "                            Default: 10\n\n";
+    std::cout << "  --spray-threshold <n>     Distinct users failing from one IP within\n";
+    std::cout << "                            the window to report password spraying\n";
+    std::cout << "                            Default: 20\n\n";
+    std::cout << "  --distributed-threshold <n>  Distinct IPs failing for one user within\n";
+    std::cout << "                            the window to report distributed brute force\n";
+    std::cout << "                            Default: 10\n\n";
+    std::cout << "  --geoip <path>            GeoIP table (CSV: first_ip,last_ip,lat,lon[,country]\n";
+    std::cout << "                            or binary) enabling impossible-travel detection\n\n";
+    std::cout << "  --geoip-save <path>       Write the loaded GeoIP table in binary form,\n";
+    std::cout << "                            which --geoip maps into memory without parsing\n\n";
+    std::cout << "  --max-speed <km/h>        Fastest plausible travel between two logins\n";
+    std::cout << "                            Default: 900\n\n";
+    std::cout << "  --rules <list>            Comma-separated detection rules to run; '-name'\n";
+    std::cout << "                            removes a rule (e.g. \"-after-hours\"). Rules:\n";
+    std::cout << "                            failed-logins, after-hours, unusual-hours,\n";
+    std::cout << "                            multiple-ips, distributed, success-after-failures,\n";
+    std::cout << "                            impossible-travel, denylist, spraying\n";
+    std::cout << "                            Default: all\n\n";
+    std::cout << "  --rule-profile <spec>     Named thresholds evaluated in the same pass and\n";
+    std::cout << "                            tagged on their events; repeat for more profiles.\n";
+    std::cout << "                            <spec> is name[:key=value,...] with the keys\n";
+    std::cout << "                            threshold, window, hours, spray, distributed\n";
+    std::cout << "                            (e.g. \"pci:threshold=3,window=5,hours=9-17\");\n";
+    std::cout << "                            other settings come from the options above\n\n";
+    std::cout << "  --allowlist <path>        File of IPv4/IPv6 CIDRs, one per line; entries\n";
+    std::cout << "                            from these networks are not analyzed\n\n";
+    std::cout << "  --denylist <path>         File of IPv4/IPv6 CIDRs of known-bad networks;\n";
+    std::cout << "                            every login attempt from them is reported\n\n";
+    std::cout << "  --baseline <path>         Per-user login-hour profiles: logins at hours a\n";
+    std::cout << "                            user rarely uses are reported, then this run is\n";
+    std::cout << "                            added to the file (created on the first run)\n\n";
     std::cout << "  --hours <start-end>       Business hours (e.g., 9-17)\n";
     std::cout << "                            Default: 8-18\n\n";
+    std::cout << "  --user <name>             Only analyze entries for this username\n\n";
+    std::cout << "  --ip <address>            Only analyze entries from this IP address\n\n";
+    std::cout << "  --status <status>         Only analyze SUCCESS or FAILED entries\n\n";
+    std::cout << "  --verbose-errors          Print a warning for every invalid line\n\n";
+    std::cout << "  --error-samples <n>       Invalid lines kept as samples in the summary\n";
+    std::cout << "                            Default: 10\n\n";
+    std::cout << "  --top-k <n>               Most failing IPs, most targeted and most active\n";
+    std::cout << "                            users listed in the report (0 = none, max 1000)\n";
+    std::cout << "                            Default: 10\n\n";
+    std::cout << "  --spike-z <n>             z-score at which failed logins per minute count\n";
+    std::cout << "                            as a spike, for all entries and for the top-k\n";
+    std::cout << "                            failing IPs and users (0 = off, max 100)\n";
+    std::cout << "                            Default: 4\n\n";
+    std::cout << "  --top <n>                 Users and IPs with the highest risk scores over\n";
+    std::cout << "                            all detected events (0 = none, max 1000)\n";
+    std::cout << "                            Default: 10\n\n";
+    std::cout << "  --sweep <grid>            Count brute-force events for every threshold and\n";
+    std::cout << "                            window of a grid in one pass, e.g.\n";
+    std::cout << "                            --sweep threshold=3..10 window=1,5,10,30\n";
+    std::cout << "                            (an axis left out uses --threshold or --window)\n\n";
+    std::cout << "  --threads <n>             Pipelined parser worker threads (0 = off)\n";
+    std::cout << "                            Default: 1\n\n";
+    std::cout << "  --no-prefetch             Do not read ahead on a background thread\n\n";
+    std::cout << "  --direct-io               Bypass the page cache when reading (O_DIRECT)\n\n";
+    std::cout << "  --io-uring                Keep several reads in flight across input files\n";
+    std::cout << "                            (io_uring if built with liburing, else pread\n";
+    std::cout << "                            without reads in flight)\n\n";
+    std::cout << "  --io-depth <n>            Reads in flight with --io-uring\n";
+    std::cout << "                            Default: 8\n\n";
+    std::cout << "  --memory-limit <MB>       Spill parsed entries to sorted runs on disk\n";
+    std::cout << "                            above this size (0 = keep in memory)\n";
+    std::cout << "                            Default: 0\n\n";
+    std::cout << "  --lateness <seconds>      Put entries arriving up to this late back in\n";
+    std::cout << "                            time order; later entries are skipped and\n";
+    std::cout << "                            counted (0 = off, max 86400)\n";
+    std::cout << "                            Default: 0\n\n";
     std::cout << "  --help, -h                Display this help message\n\n";
     std::cout << "Examples:\n";
     std::cout << "  log-analyzer --input auth.log --output security_report.txt\n";
     std::cout << "  log-analyzer --threshold 3 --window 5 --hours 9-17\n";
+    std::cout << "  log-analyzer --user admin --status FAILED\n";
+    std::cout << "  log-analyzer --input /var/log/auth.log --format-in syslog\n";
+    std::cout << "  log-analyzer --pattern \"%ts [%user] from %ip: %status\"\n";
+    std::cout << "  log-analyzer -i auth.log.2 --add-input auth.log.1 --add-input auth.log --io-uring\n";
     std::cout << "  log-analyzer --help\n";
 }
 
@@ -0,0 +1,302 @@
+#include "DetectionRules.h"
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <utility>
+
+namespace DetectionRules
+{
+
+/**
+ * @brief Moves a detector's events into the bucket of their type
+ */
+static void appendEvents(EventBuckets& buckets, SuspiciousEventType type,
+                         std::vector<SuspiciousEvent>&& events)
+{
+    std::vector<SuspiciousEvent>& bucket = bucketOf(buckets, type);
+    if (bucket.empty())
+    {
+        bucket = std::move(events);
+        return;
+    }
+    bucket.insert(bucket.end(),
+                  std::make_move_iterator(events.begin()),
+                  std::make_move_iterator(events.end()));
+}
+
+/**
+ * @brief Compares a rule name with a lowercase name, ignoring case
+ */
+static bool equalsName(std::string_view text, std::string_view name)
+{
+    if (text.size() != name.size())
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < text.size(); ++i)
+    {
+        if (std::tolower(static_cast<unsigned char>(text[i])) != name[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Strips spaces around a list item
+ */
+static std::string_view trim(std::string_view text)
+{
+    while (!text.empty() && text.front() == ' ')
+    {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && text.back() == ' ')
+    {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+// ============================================================================
+// Rules
+// ============================================================================
+
+void FailureSequenceRule::detectUser(const EventDetector& detector, const std::vector<LogEntry>& timeline,
+                                     RuleSet enabled, EventBuckets& buckets)
+{
+    // One walk over the timeline serves both types; a disabled type is not collected
+    bool brute_force = (enabled & ruleBit(SuspiciousEventType::MULTIPLE_FAILED_LOGINS)) != 0;
+    bool compromises = (enabled & ruleBit(SuspiciousEventType::SUCCESS_AFTER_FAILURES)) != 0;
+    detector.scanUserFailures(
+        timeline,
+        brute_force ? &bucketOf(buckets, SuspiciousEventType::MULTIPLE_FAILED_LOGINS) : nullptr,
+        compromises ? &bucketOf(buckets, SuspiciousEventType::SUCCESS_AFTER_FAILURES) : nullptr);
+}
+
+void AfterHoursRule::detectUser(const EventDetector& detector, const std::vector<LogEntry>& timeline,
+                                RuleSet /*enabled*/, EventBuckets& buckets)
+{
+    appendEvents(buckets, SuspiciousEventType::LOGIN_OUTSIDE_BUSINESS_HOURS,
+                 detector.detectLoginsOutsideBusinessHours(timeline));
+}
+
+void UnusualHourRule::detectUser(const EventDetector& detector, const std::vector<LogEntry>& timeline,
+                                 RuleSet /*enabled*/, EventBuckets& buckets)
+{
+    appendEvents(buckets, SuspiciousEventType::UNUSUAL_LOGIN_HOUR,
+                 detector.detectUnusualLoginHours(timeline));
+}
+
+void MultipleIpRule::detectUser(const EventDetector& detector, const std::vector<LogEntry>& timeline,
+                                RuleSet /*enabled*/, EventBuckets& buckets)
+{
+    detector.detectUserMultipleIPAddresses(
+        timeline, bucketOf(buckets, SuspiciousEventType::MULTIPLE_IP_ADDRESSES));
+}
+
+void DistributedBruteForceRule::detectUser(const EventDetector& detector,
+                                           const std::vector<LogEntry>& timeline,
+                                           RuleSet /*enabled*/, EventBuckets& buckets)
+{
+    detector.detectUserDistributedBruteForce(
+        timeline, bucketOf(buckets, SuspiciousEventType::DISTRIBUTED_BRUTE_FORCE));
+}
+
+void ImpossibleTravelRule::detectUser(const EventDetector& detector, const std::vector<LogEntry>& timeline,
+                                      RuleSet /*enabled*/, EventBuckets& buckets)
+{
+    detector.detectUserImpossibleTravel(
+        timeline, bucketOf(buckets, SuspiciousEventType::IMPOSSIBLE_TRAVEL));
+}
+
+void DenylistRule::detectUser(const EventDetector& detector, const std::vector<LogEntry>& timeline,
+                              RuleSet /*enabled*/, EventBuckets& buckets)
+{
+    detector.detectUserDenylisted(
+        timeline, bucketOf(buckets, SuspiciousEventType::DENYLISTED_IP));
+}
+
+void IpFailureSequenceRule::detect(const EventDetector& detector, const std::vector<LogEntry>& entries,
+                                   RuleSet /*enabled*/, EventBuckets& buckets)
+{
+    appendEvents(buckets, SuspiciousEventType::SUCCESS_AFTER_FAILURES,
+                 detector.detectSuccessAfterIpFailures(entries));
+}
+
+void PasswordSprayingRule::detect(const EventDetector& detector, const std::vector<LogEntry>& entries,
+                                  RuleSet /*enabled*/, EventBuckets& buckets)
+{
+    appendEvents(buckets, SuspiciousEventType::PASSWORD_SPRAYING,
+                 detector.detectPasswordSpraying(entries));
+}
+
+// ============================================================================
+// Event Order
+// ============================================================================
+
+std::vector<SuspiciousEvent> collectEvents(EventBuckets& buckets)
+{
+    std::size_t total = 0;
+    for (const auto& bucket : buckets)
+    {
+        total += bucket.size();
+    }
+
+    std::vector<SuspiciousEvent> events;
+    events.reserve(total);
+    for (std::size_t type = 0; type < buckets.size(); ++type)
+    {
+        std::vector<SuspiciousEvent>& bucket = buckets[type];
+        auto event_type = static_cast<SuspiciousEventType>(type);
+        if (event_type == SuspiciousEventType::LOGIN_OUTSIDE_BUSINESS_HOURS ||
+            event_type == SuspiciousEventType::UNUSUAL_LOGIN_HOUR)
+        {
+            std::stable_sort(bucket.begin(), bucket.end(),
+                             [](const SuspiciousEvent& a, const SuspiciousEvent& b)
+                             {
+                                 return a.first_occurrence < b.first_occurrence;
+                             });
+        }
+        events.insert(events.end(),
+                      std::make_move_iterator(bucket.begin()),
+                      std::make_move_iterator(bucket.end()));
+        bucket.clear();
+    }
+    return events;
+}
+
+void sortEventsByType(std::vector<SuspiciousEvent>& events)
+{
+    std::stable_sort(events.begin(), events.end(),
+                     [](const SuspiciousEvent& a, const SuspiciousEvent& b)
+                     {
+                         if (a.type != b.type)
+                         {
+                             return a.type < b.type;
+                         }
+                         bool by_time = a.type == SuspiciousEventType::LOGIN_OUTSIDE_BUSINESS_HOURS ||
+                                        a.type == SuspiciousEventType::UNUSUAL_LOGIN_HOUR;
+                         if (by_time && a.first_occurrence != b.first_occurrence)
+                         {
+                             return a.first_occurrence < b.first_occurrence;
+                         }
+                         return a.username < b.username;
+                     });
+}
+
+// ============================================================================
+// Rule Selection
+// ============================================================================
+
+const char* ruleName(SuspiciousEventType type)
+{
+    switch (type)
+    {
+        case SuspiciousEventType::MULTIPLE_FAILED_LOGINS:
+            return "failed-logins";
+        case SuspiciousEventType::LOGIN_OUTSIDE_BUSINESS_HOURS:
+            return "after-hours";
+        case SuspiciousEventType::UNUSUAL_LOGIN_HOUR:
+            return "unusual-hours";
+        case SuspiciousEventType::MULTIPLE_IP_ADDRESSES:
+            return "multiple-ips";
+        case SuspiciousEventType::DISTRIBUTED_BRUTE_FORCE:
+            return "distributed";
+        case SuspiciousEventType::SUCCESS_AFTER_FAILURES:
+            return "success-after-failures";
+        case SuspiciousEventType::IMPOSSIBLE_TRAVEL:
+            return "impossible-travel";
+        case SuspiciousEventType::DENYLISTED_IP:
+            return "denylist";
+        case SuspiciousEventType::PASSWORD_SPRAYING:
+            return "spraying";
+        default:
+            return "unknown";
+    }
+}
+
+bool parseRuleList(std::string_view list, RuleSet& rules)
+{
+    RuleSet selected = 0;
+    bool first = true;
+
+    while (true)
+    {
+        std::size_t comma = list.find(',');
+        std::string_view item = trim(list.substr(0, comma));
+
+        bool remove = !item.empty() && item.front() == '-';
+        if (remove)
+        {
+            item.remove_prefix(1);
+        }
+        if (item.empty())
+        {
+            return false;
+        }
+
+        // A list starting with a removal removes from all rules
+        if (first && remove)
+        {
+            selected = kAllRules;
+        }
+        first = false;
+
+        RuleSet named = 0;
+        if (equalsName(item, "all"))
+        {
+            named = kAllRules;
+        }
+        for (std::size_t type = 0; type < kSuspiciousEventTypeCount && named == 0; ++type)
+        {
+            auto event_type = static_cast<SuspiciousEventType>(type);
+            if (equalsName(item, ruleName(event_type)))
+            {
+                named = ruleBit(event_type);
+            }
+        }
+        if (named == 0)
+        {
+            return false;
+        }
+
+        selected = remove ? (selected & ~named) : (selected | named);
+
+        if (comma == std::string_view::npos)
+        {
+            break;
+        }
+        list.remove_prefix(comma + 1);
+    }
+
+    rules = selected;
+    return true;
+}
+
+std::string formatRuleList(RuleSet rules)
+{
+    if ((rules & kAllRules) == kAllRules)
+    {
+        return "all";
+    }
+
+    std::string list;
+    for (std::size_t type = 0; type < kSuspiciousEventTypeCount; ++type)
+    {
+        auto event_type = static_cast<SuspiciousEventType>(type);
+        if ((rules & ruleBit(event_type)) == 0)
+        {
+            continue;
+        }
+        if (!list.empty())
+        {
+            list += ",";
+        }
+        list += ruleName(event_type);
+    }
+    return list.empty() ? "none" : list;
+}
+
+} // namespace DetectionRules
@@ -1,7 +1,15 @@
 #include "EventDetector.h"
+#include "DetectionRules.h"
+#include "PasswordSprayTracker.h"
+#include "IpFailureTracker.h"
+#include "SlidingDistinctCounter.h"
+#include "UserTimelines.h"
 #include <map>
 #include <set>
 #include <algorithm>
+#include <cstdint>
+#include <ctime>
+#include <unordered_map>
 
 // ============================================================================
 // Constructors
@@ -11,7 +19,15 @@ EventDetector::EventDetector()
     : failed_login_threshold_(5),
       time_window_minutes_(10),
       business_hour_start_(8),
-      business_hour_end_(18)
+      business_hour_end_(18),
+      spray_user_threshold_(20),
+      distributed_ip_threshold_(10),
+      geo_ip_table_(nullptr),
+      max_travel_speed_kmh_(900.0),
+      deny_list_(nullptr),
+      login_hour_profiles_(nullptr),
+      input_time_ordered_(false),
+      enabled_rules_(kAllRules)
 {
 }
 
@@ -22,14 +38,379 @@ EventDetector::EventDetector(int failed_login_threshold,
     : failed_login_threshold_(failed_login_threshold),
       time_window_minutes_(time_window_minutes),
       business_hour_start_(business_hour_start),
-      business_hour_end_(business_hour_end)
+      business_hour_end_(business_hour_end),
+      spray_user_threshold_(20),
+      distributed_ip_threshold_(10),
+      geo_ip_table_(nullptr),
+      max_travel_speed_kmh_(900.0),
+      deny_list_(nullptr),
+      login_hour_profiles_(nullptr),
+      input_time_ordered_(false),
+      enabled_rules_(kAllRules)
 {
 }
 
+void EventDetector::setInputTimeOrdered(bool ordered)
+{
+    input_time_ordered_ = ordered;
+}
+
+void EventDetector::setSprayingThreshold(int threshold)
+{
+    spray_user_threshold_ = threshold;
+}
+
+void EventDetector::setDistributedThreshold(int threshold)
+{
+    distributed_ip_threshold_ = threshold;
+}
+
+void EventDetector::setGeoIpTable(const GeoIpTable* table)
+{
+    geo_ip_table_ = table;
+}
+
+void EventDetector::setMaxTravelSpeed(double speed_kmh)
+{
+    max_travel_speed_kmh_ = speed_kmh;
+}
+
+void EventDetector::setDenylist(const CidrTrie* deny_list)
+{
+    deny_list_ = deny_list;
+}
+
+void EventDetector::setLoginHourProfiles(const LoginHourProfiles* profiles)
+{
+    login_hour_profiles_ = profiles;
+}
+
+void EventDetector::setEnabledRules(RuleSet rules)
+{
+    enabled_rules_ = rules & kAllRules;
+}
+
+RuleSet EventDetector::enabledRules() const
+{
+    return enabled_rules_;
+}
+
 // ============================================================================
 // Private Helper Functions
 // ============================================================================
 
+/**
+ * @brief Insertion sort that gives up after a number of element moves
+ * 
+ * @return true if the entries are sorted, false if the budget ran out
+ *         (the entries are then partially sorted)
+ */
+static bool insertionSortWithBudget(std::vector<LogEntry>& entries, std::size_t budget)
+{
+    for (std::size_t i = 1; i < entries.size(); ++i) 
+    {
+        if (!(entries[i].timestamp < entries[i - 1].timestamp)) 
+        {
+            continue;
+        }
+        
+        LogEntry moving = std::move(entries[i]);
+        std::size_t j = i;
+        while (j > 0 && moving.timestamp < entries[j - 1].timestamp) 
+        {
+            entries[j] = std::move(entries[j - 1]);
+            j--;
+            if (budget-- == 0) 
+            {
+                entries[j] = std::move(moving);
+                return false;
+            }
+        }
+        entries[j] = std::move(moving);
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Stable LSD radix sort of entries by integer timestamp
+ * 
+ * Sorts (key, index) pairs one byte at a time, skipping the high bytes
+ * that are equal for every key, then moves the entries into place.
+ */
+static void radixSortByTimestamp(std::vector<LogEntry>& entries)
+{
+    struct Key
+    {
+        std::uint64_t value;   // Timestamp relative to the earliest one
+        std::size_t index;     // Position in entries
+    };
+    
+    auto ticks = [](const LogEntry& entry) 
+    {
+        return static_cast<std::int64_t>(entry.timestamp.time_since_epoch().count());
+    };
+    
+    std::int64_t minimum = ticks(entries[0]);
+    for (const auto& entry : entries) 
+    {
+        minimum = std::min(minimum, ticks(entry));
+    }
+    
+    std::vector<Key> keys(entries.size());
+    std::uint64_t maximum = 0;
+    for (std::size_t i = 0; i < entries.size(); ++i) 
+    {
+        keys[i].value = static_cast<std::uint64_t>(ticks(entries[i])) - 
+                        static_cast<std::uint64_t>(minimum);
+        keys[i].index = i;
+        maximum = std::max(maximum, keys[i].value);
+    }
+    
+    std::vector<Key> scratch(keys.size());
+    for (int shift = 0; shift < 64 && (maximum >> shift) != 0; shift += 8) 
+    {
+        std::size_t counts[257] = {};
+        for (const auto& key : keys) 
+        {
+            counts[((key.value >> shift) & 0xFF) + 1]++;
+        }
+        for (int digit = 0; digit < 256; ++digit) 
+        {
+            counts[digit + 1] += counts[digit];
+        }
+        for (const auto& key : keys) 
+        {
+            scratch[counts[(key.value >> shift) & 0xFF]++] = key;
+        }
+        keys.swap(scratch);
+    }
+    
+    std::vector<LogEntry> sorted;
+    sorted.reserve(entries.size());
+    for (const auto& key : keys) 
+    {
+        sorted.push_back(std::move(entries[key.index]));
+    }
+    entries.swap(sorted);
+}
+
+/**
+ * @brief Gets the number of a local calendar date, counted in days
+ * 
+ * Consecutive dates get consecutive numbers (days since 1970-01-01 of
+ * the proleptic Gregorian calendar), also across month and year ends.
+ */
+static std::int64_t localDayNumber(const std::tm& local)
+{
+    std::int64_t year = local.tm_year + 1900;
+    std::int64_t month = local.tm_mon + 1;
+    year -= month <= 2 ? 1 : 0;
+    std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+    std::int64_t year_of_era = year - era * 400;
+    std::int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + local.tm_mday - 1;
+    std::int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+/**
+ * @brief Adds an IP address to an event's examples, keeping at most five
+ */
+static void addSampleAddress(SuspiciousEvent& event, const std::string& ip_address)
+{
+    if (event.ip_addresses.size() < 5 &&
+        std::find(event.ip_addresses.begin(), event.ip_addresses.end(), ip_address) ==
+        event.ip_addresses.end()) 
+    {
+        event.ip_addresses.push_back(ip_address);
+    }
+}
+
+/**
+ * @brief Groups the entries that pass a filter by username
+ * 
+ * @return One timeline per user in input order, ordered by username
+ */
+template <typename Predicate>
+static std::vector<std::vector<LogEntry>> groupByUser(const std::vector<LogEntry>& entries, 
+                                                      Predicate keep)
+{
+    UserTimelines timelines;
+    for (const auto& entry : entries) 
+    {
+        if (keep(entry)) 
+        {
+            timelines.add(entry);
+        }
+    }
+    return timelines.release();
+}
+
+void EventDetector::sortByTimestamp(std::vector<LogEntry>& entries) const
+{
+    if (input_time_ordered_ || entries.size() < 2) 
+    {
+        return;
+    }
+    
+    // A few late entries cost O(n) moves; beyond that radix sort is cheaper
+    std::size_t budget = 8 * entries.size();
+    if (!insertionSortWithBudget(entries, budget)) 
+    {
+        radixSortByTimestamp(entries);
+    }
+}
+
+void EventDetector::scanFailureSequences(
+    const std::vector<LogEntry>& entries,
+    std::vector<SuspiciousEvent>* brute_force,
+    std::vector<SuspiciousEvent>* compromises) const
+{
+    // Step 1: Group failed (and, if needed, successful) logins by username
+    auto timelines = groupByUser(entries, [compromises](const LogEntry& entry) 
+    {
+        return entry.status == LoginStatus::FAILED || 
+               (compromises != nullptr && entry.status == LoginStatus::SUCCESS);
+    });
+    sortTimelines(timelines);
+    
+    // Step 2: Walk each user's timeline once
+    for (const auto& timeline : timelines) 
+    {
+        scanUserFailures(timeline, brute_force, compromises);
+    }
+}
+
+void EventDetector::scanUserFailures(
+    const std::vector<LogEntry>& timeline,
+    std::vector<SuspiciousEvent>* brute_force,
+    std::vector<SuspiciousEvent>* compromises) const
+{
+    if (timeline.empty()) 
+    {
+        return;
+    }
+    const std::string& username = timeline.front().username;
+    
+    std::vector<const LogEntry*> user_failed_logins;
+    user_failed_logins.reserve(timeline.size());
+    size_t burst_start_idx = 0;   // First failure not yet reported with a success
+    
+    for (const auto& entry : timeline) 
+    {
+        if (entry.status == LoginStatus::FAILED) 
+        {
+            user_failed_logins.push_back(&entry);
+            continue;
+        }
+        if (entry.status != LoginStatus::SUCCESS || compromises == nullptr) 
+        {
+            continue;
+        }
+        
+        // Step 3: On success, drop failures that left the window
+        while (burst_start_idx < user_failed_logins.size() && 
+               !isWithinTimeWindow(user_failed_logins[burst_start_idx]->timestamp, 
+                                   entry.timestamp)) 
+        {
+            burst_start_idx++;
+        }
+        
+        int count = static_cast<int>(user_failed_logins.size() - burst_start_idx);
+        if (count < failed_login_threshold_) 
+        {
+            continue;
+        }
+        
+        int same_ip_count = 0;
+        for (size_t j = burst_start_idx; j < user_failed_logins.size(); ++j) 
+        {
+            if (user_failed_logins[j]->ip_address == entry.ip_address) 
+            {
+                same_ip_count++;
+            }
+        }
+        
+        SuspiciousEvent event(
+            SuspiciousEventType::SUCCESS_AFTER_FAILURES,
+            username,
+            entry.ip_address,
+            user_failed_logins[burst_start_idx]->timestamp,
+            entry.timestamp,
+            count
+        );
+        
+        event.description = "User '" + username + "' logged in from IP '" + 
+                            entry.ip_address + "' after " + std::to_string(count) + 
+                            " failed login attempts within " + 
+                            std::to_string(time_window_minutes_) + " minutes (" + 
+                            std::to_string(same_ip_count) + " from the same IP)";
+        
+        compromises->push_back(event);
+        
+        // The burst is reported; later successes need new failures
+        burst_start_idx = user_failed_logins.size();
+    }
+    
+    if (brute_force == nullptr) 
+    {
+        return;
+    }
+    
+    // Step 4: Use sliding window to find clusters of failed attempts
+    for (size_t i = 0; i < user_failed_logins.size(); ++i) 
+    {
+        const LogEntry& window_start = *user_failed_logins[i];
+        
+        // Count failed attempts within time window from this entry
+        int count = 1;  // Current entry counts
+        size_t window_end_idx = i;
+        
+        // Scan forward to find all entries within time window
+        for (size_t j = i + 1; j < user_failed_logins.size(); ++j) 
+        {
+            if (isWithinTimeWindow(window_start.timestamp, 
+                                  user_failed_logins[j]->timestamp)) 
+            {
+                count++;
+                window_end_idx = j;
+            } 
+            else 
+            {
+                // Entries are sorted, so we can break early
+                break;
+            }
+        }
+        
+        // Step 5: If cluster meets threshold, report it
+        if (count >= failed_login_threshold_) 
+        {
+            const LogEntry& window_end = *user_failed_logins[window_end_idx];
+            
+            // Create suspicious event
+            SuspiciousEvent event(
+                SuspiciousEventType::MULTIPLE_FAILED_LOGINS,
+                username,
+                window_start.ip_address,
+                window_start.timestamp,
+                window_end.timestamp,
+                count
+            );
+            
+            // Add description
+            event.description = "User '" + username + "' had " + 
+                               std::to_string(count) + 
+                               " failed login attempts within " +
+                               std::to_string(time_window_minutes_) + " minutes";
+            
+            brute_force->push_back(event);
+            
+            // Skip to end of cluster to avoid overlapping detections
+            i = window_end_idx;
+        }
+    }
+}
+
 bool EventDetector::isWithinTimeWindow(
     std::chrono::system_clock::time_point time1,
     std::chrono::system_clock::time_point time2) const
@@ -64,84 +445,15 @@ std::vector<SuspiciousEvent> EventDetector::detectMultipleFailedLogins(
     const std::vector<LogEntry>& entries) const
 {
     std::vector<SuspiciousEvent> detected_events;
-    
-    // Step 1: Group failed login attempts by username
-    // Map: username -> vector of failed login entries
-    std::map<std::string, std::vector<LogEntry>> failed_logins_by_user;
-    
-    for (const auto& entry : entries) 
-    {
-        // Only consider failed login attempts
-        if (entry.status == LoginStatus::FAILED) 
-        {
-            failed_logins_by_user[entry.username].push_back(entry);
-        }
-    }
-    
-    // Step 2: For each user, analyze their failed login attempts
-    for (auto& [username, user_failed_logins] : failed_logins_by_user) 
-    {
-        // Sort the failed logins by timestamp (earliest first)
-        std::sort(user_failed_logins.begin(), user_failed_logins.end(),
-                  [](const LogEntry& a, const LogEntry& b) 
-                  {
-                      return a.timestamp < b.timestamp;
-                  });
-        
-        // Step 3: Use sliding window to find clusters of failed attempts
-        for (size_t i = 0; i < user_failed_logins.size(); ++i) 
-        {
-            const LogEntry& window_start = user_failed_logins[i];
-            
-            // Count failed attempts within time window from this entry
-            int count = 1;  // Current entry counts
-            size_t window_end_idx = i;
-            
-            // Scan forward to find all entries within time window
-            for (size_t j = i + 1; j < user_failed_logins.size(); ++j) 
-            {
-                if (isWithinTimeWindow(window_start.timestamp, 
-                                      user_failed_logins[j].timestamp)) 
-                {
-                    count++;
-                    window_end_idx = j;
-                } 
-                else 
-                {
-                    // Entries are sorted, so we can break early
-                    break;
-                }
-            }
-            
-            // Step 4: If cluster meets threshold, report it
-            if (count >= failed_login_threshold_) 
-            {
-                const LogEntry& window_end = user_failed_logins[window_end_idx];
-                
-                // Create suspicious event
-                SuspiciousEvent event(
-                    SuspiciousEventType::MULTIPLE_FAILED_LOGINS,
-                    username,
-                    window_start.ip_address,
-                    window_start.timestamp,
-                    window_end.timestamp,
-                    count
-                );
-                
-                // Add description
-                event.description = "User '" + username + "' had " + 
-                                   std::to_string(count) + 
-                                   " failed login attempts within " +
-                                   std::to_string(time_window_minutes_) + " minutes";
-                
-                detected_events.push_back(event);
-                
-                // Skip to end of cluster to avoid overlapping detections
-                i = window_end_idx;
-            }
-        }
-    }
-    
+    scanFailureSequences(entries, &detected_events, nullptr);
+    return detected_events;
+}
+
+std::vector<SuspiciousEvent> EventDetector::detectSuccessAfterFailures(
+    const std::vector<LogEntry>& entries) const
+{
+    std::vector<SuspiciousEvent> detected_events;
+    scanFailureSequences(entries, nullptr, &detected_events);
     return detected_events;
 }
 
@@ -150,6 +462,11 @@ std::vector<SuspiciousEvent> EventDetector::detectLoginsOutsideBusinessHours(
 {
     std::vector<SuspiciousEvent> detected_events;
     
+    // Open event per user, IP address and night. The key is built in a
+    // reused buffer, so only the first login of an event allocates.
+    std::unordered_map<std::string, std::size_t> event_index;
+    std::string key;
+    
     // Analyze each entry
     for (const auto& entry : entries) 
     {
@@ -159,148 +476,679 @@ std::vector<SuspiciousEvent> EventDetector::detectLoginsOutsideBusinessHours(
             continue;
         }
         
-        // Get hour of day for this login
-        int hour = getHourOfDay(entry.timestamp);
+        // Users with an established baseline are judged by their own hours
+        if (login_hour_profiles_ != nullptr) 
+        {
+            const HourProfile* profile = login_hour_profiles_->find(entry.username);
+            if (profile != nullptr && profile->total >= kMinProfileLogins) 
+            {
+                continue;
+            }
+        }
+        
+        // Get local time for this login
+        std::time_t time = std::chrono::system_clock::to_time_t(entry.timestamp);
+        std::tm local = *std::localtime(&time);
+        int hour = local.tm_hour;
         
         // Check if outside business hours
         // Business hours are inclusive: [start, end)
         // For example: 8-18 means 08:00:00 to 17:59:59
         bool outside_hours = (hour < business_hour_start_ || hour >= business_hour_end_);
+        if (!outside_hours) 
+        {
+            continue;
+        }
+        
+        // Logins before business hours belong to the night that began the day before
+        std::int64_t night = localDayNumber(local) - (hour < business_hour_start_ ? 1 : 0);
         
-        if (outside_hours) 
+        key.assign(entry.username);
+        key.push_back('\0');
+        key.append(entry.ip_address);
+        key.push_back('\0');
+        key.append(reinterpret_cast<const char*>(&night), sizeof(night));
+        
+        auto found = event_index.find(key);
+        if (found == event_index.end()) 
         {
-            // Create suspicious event for this after-hours login
-            SuspiciousEvent event(
+            event_index.emplace(key, detected_events.size());
+            detected_events.emplace_back(
                 SuspiciousEventType::LOGIN_OUTSIDE_BUSINESS_HOURS,
                 entry.username,
                 entry.ip_address,
                 entry.timestamp,
-                entry.timestamp,  // Single event, so first = last
+                entry.timestamp,  // Single login so far, so first = last
                 1
             );
-            
-            // Add description
-            event.description = "User '" + entry.username + 
-                               "' logged in at hour " + std::to_string(hour) +
-                               " (outside business hours: " +
-                               std::to_string(business_hour_start_) + ":00-" +
-                               std::to_string(business_hour_end_) + ":00)";
-            
-            detected_events.push_back(event);
+            continue;
+        }
+        
+        // Merge into the night's event; entries may be out of order
+        SuspiciousEvent& event = detected_events[found->second];
+        event.first_occurrence = std::min(event.first_occurrence, entry.timestamp);
+        event.last_occurrence = std::max(event.last_occurrence, entry.timestamp);
+        event.event_count++;
+    }
+    
+    // Add descriptions once per event rather than per login
+    std::string hours = std::to_string(business_hour_start_) + ":00-" +
+                        std::to_string(business_hour_end_) + ":00";
+    for (auto& event : detected_events) 
+    {
+        if (event.event_count == 1) 
+        {
+            event.description = "User '" + event.username + 
+                               "' logged in at hour " + 
+                               std::to_string(getHourOfDay(event.first_occurrence)) +
+                               " (outside business hours: " + hours + ")";
+        }
+        else 
+        {
+            event.description = "User '" + event.username + "' logged in " + 
+                               std::to_string(event.event_count) + 
+                               " times from hour " + 
+                               std::to_string(getHourOfDay(event.first_occurrence)) + 
+                               " to hour " + 
+                               std::to_string(getHourOfDay(event.last_occurrence)) +
+                               " of one night (outside business hours: " + hours + ")";
         }
     }
     
     return detected_events;
 }
 
+std::vector<SuspiciousEvent> EventDetector::detectUnusualLoginHours(
+    const std::vector<LogEntry>& entries) const
+{
+    static const char* const kDayNames[] = 
+    {
+        "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"
+    };
+    
+    std::vector<SuspiciousEvent> detected_events;
+    if (login_hour_profiles_ == nullptr) 
+    {
+        return detected_events;
+    }
+    
+    // Entries of one user usually come in runs; look each profile up once per run
+    const std::string* profile_user = nullptr;
+    const HourProfile* profile = nullptr;
+    
+    for (const auto& entry : entries) 
+    {
+        if (entry.status != LoginStatus::SUCCESS) 
+        {
+            continue;
+        }
+        
+        if (profile_user == nullptr || *profile_user != entry.username) 
+        {
+            profile_user = &entry.username;
+            profile = login_hour_profiles_->find(entry.username);
+        }
+        if (profile == nullptr || profile->total < kMinProfileLogins) 
+        {
+            continue;
+        }
+        
+        // Logins within an hour of this one, so that shifted arrivals still count
+        const std::size_t buckets = LoginHourProfiles::kBuckets;
+        std::size_t hour = LoginHourProfiles::hourOfWeek(entry.timestamp);
+        std::uint64_t nearby = static_cast<std::uint64_t>(profile->counts[(hour + buckets - 1) % buckets]) +
+                               profile->counts[hour] +
+                               profile->counts[(hour + 1) % buckets];
+        
+        if (static_cast<double>(nearby) >= kRareHourShare * profile->total) 
+        {
+            continue;
+        }
+        
+        SuspiciousEvent event(
+            SuspiciousEventType::UNUSUAL_LOGIN_HOUR,
+            entry.username,
+            entry.ip_address,
+            entry.timestamp,
+            entry.timestamp,
+            1
+        );
+        event.description = "User '" + entry.username + "' logged in on " + 
+                            kDayNames[hour / 24] + " at hour " + std::to_string(hour % 24) + 
+                            " (" + std::to_string(nearby) + " of " + 
+                            std::to_string(profile->total) + 
+                            " baseline logins within an hour of that time)";
+        
+        detected_events.push_back(event);
+    }
+    
+    return detected_events;
+}
+
 std::vector<SuspiciousEvent> EventDetector::detectMultipleIPAddresses(
     const std::vector<LogEntry>& entries) const
 {
     std::vector<SuspiciousEvent> detected_events;
     
     // Step 1: Group successful logins by username
-    std::map<std::string, std::vector<LogEntry>> logins_by_user;
+    auto timelines = groupByUser(entries, [](const LogEntry& entry) 
+    {
+        return entry.status == LoginStatus::SUCCESS;
+    });
+    sortTimelines(timelines);
     
-    for (const auto& entry : entries) 
+    // Step 2: For each user, check for multiple IPs in time windows
+    for (const auto& timeline : timelines) 
+    {
+        detectUserMultipleIPAddresses(timeline, detected_events);
+    }
+    
+    return detected_events;
+}
+
+void EventDetector::detectUserMultipleIPAddresses(
+    const std::vector<LogEntry>& timeline,
+    std::vector<SuspiciousEvent>& events) const
+{
+    // Only consider successful logins
+    std::vector<const LogEntry*> user_logins;
+    for (const auto& entry : timeline) 
     {
-        // Only consider successful logins
         if (entry.status == LoginStatus::SUCCESS) 
         {
-            logins_by_user[entry.username].push_back(entry);
+            user_logins.push_back(&entry);
         }
     }
     
-    // Step 2: For each user, check for multiple IPs in time windows
-    for (auto& [username, user_logins] : logins_by_user) 
+    // Step 3: Use sliding window to find multiple distinct IPs
+    for (size_t i = 0; i < user_logins.size(); ++i) 
     {
-        // Sort by timestamp
-        std::sort(user_logins.begin(), user_logins.end(),
-                  [](const LogEntry& a, const LogEntry& b) 
-                  {
-                      return a.timestamp < b.timestamp;
-                  });
+        const LogEntry& window_start = *user_logins[i];
         
-        // Step 3: Use sliding window to find multiple distinct IPs
-        for (size_t i = 0; i < user_logins.size(); ++i) 
+        // Collect all distinct IPs within time window
+        std::set<std::string> ip_addresses;
+        ip_addresses.insert(window_start.ip_address);
+        
+        size_t window_end_idx = i;
+        
+        // Scan forward to find all entries within time window
+        for (size_t j = i + 1; j < user_logins.size(); ++j) 
         {
-            const LogEntry& window_start = user_logins[i];
-            
-            // Collect all distinct IPs within time window
-            std::set<std::string> ip_addresses;
-            ip_addresses.insert(window_start.ip_address);
+            if (isWithinTimeWindow(window_start.timestamp,
+                                  user_logins[j]->timestamp)) 
+            {
+                ip_addresses.insert(user_logins[j]->ip_address);
+                window_end_idx = j;
+            } 
+            else 
+            {
+                break;
+            }
+        }
+        
+        // Step 4: If multiple distinct IPs found, report it
+        // We consider 2 or more distinct IPs as suspicious
+        if (ip_addresses.size() >= 2) 
+        {
+            const LogEntry& window_end = *user_logins[window_end_idx];
+            const std::string& username = window_start.username;
             
-            size_t window_end_idx = i;
+            // Create suspicious event
+            SuspiciousEvent event(
+                SuspiciousEventType::MULTIPLE_IP_ADDRESSES,
+                username,
+                "", // Will fill ip_addresses vector instead
+                window_start.timestamp,
+                window_end.timestamp,
+                static_cast<int>(ip_addresses.size())
+            );
             
-            // Scan forward to find all entries within time window
-            for (size_t j = i + 1; j < user_logins.size(); ++j) 
+            // Add all IP addresses to the event
+            event.ip_addresses.clear();
+            for (const auto& ip : ip_addresses) 
             {
-                if (isWithinTimeWindow(window_start.timestamp,
-                                      user_logins[j].timestamp)) 
-                {
-                    ip_addresses.insert(user_logins[j].ip_address);
-                    window_end_idx = j;
-                } 
-                else 
-                {
-                    break;
-                }
+                event.ip_addresses.push_back(ip);
             }
             
-            // Step 4: If multiple distinct IPs found, report it
-            // We consider 2 or more distinct IPs as suspicious
-            if (ip_addresses.size() >= 2) 
+            // Add description
+            event.description = "User '" + username + 
+                               "' logged in from " + 
+                               std::to_string(ip_addresses.size()) + 
+                               " different IP addresses within " +
+                               std::to_string(time_window_minutes_) + " minutes";
+            
+            events.push_back(event);
+            
+            // Skip to end of window
+            i = window_end_idx;
+        }
+    }
+}
+
+std::vector<SuspiciousEvent> EventDetector::detectImpossibleTravel(
+    const std::vector<LogEntry>& entries) const
+{
+    std::vector<SuspiciousEvent> detected_events;
+    if (geo_ip_table_ == nullptr) 
+    {
+        return detected_events;
+    }
+    
+    // Step 1: Group successful logins by username
+    auto timelines = groupByUser(entries, [](const LogEntry& entry) 
+    {
+        return entry.status == LoginStatus::SUCCESS;
+    });
+    sortTimelines(timelines);
+    
+    for (const auto& timeline : timelines) 
+    {
+        detectUserImpossibleTravel(timeline, detected_events);
+    }
+    
+    return detected_events;
+}
+
+void EventDetector::detectUserImpossibleTravel(
+    const std::vector<LogEntry>& timeline,
+    std::vector<SuspiciousEvent>& events) const
+{
+    if (geo_ip_table_ == nullptr) 
+    {
+        return;
+    }
+    
+    // Step 2: Compare each located success with the previous located one
+    const LogEntry* previous = nullptr;
+    const GeoIpRange* previous_location = nullptr;
+    
+    for (const auto& login : timeline) 
+    {
+        if (login.status != LoginStatus::SUCCESS) 
+        {
+            continue;
+        }
+        
+        // Same address, same place: skip the lookup
+        if (previous != nullptr && login.ip_address == previous->ip_address) 
+        {
+            previous = &login;
+            continue;
+        }
+        
+        const GeoIpRange* location = geo_ip_table_->lookup(login.ip_address);
+        if (location == nullptr) 
+        {
+            continue;
+        }
+        
+        if (previous_location != nullptr) 
+        {
+            double distance_km = GeoIpTable::distanceKm(*previous_location, *location);
+            auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
+                login.timestamp - previous->timestamp).count();
+            double hours = static_cast<double>(elapsed) / 3600.0;
+            
+            // Step 3: Report travel faster than the maximum speed
+            if (distance_km >= kMinTravelKm && 
+                (hours <= 0.0 || distance_km / hours > max_travel_speed_kmh_)) 
             {
-                const LogEntry& window_end = user_logins[window_end_idx];
-                
-                // Create suspicious event
+                const std::string& username = login.username;
                 SuspiciousEvent event(
-                    SuspiciousEventType::MULTIPLE_IP_ADDRESSES,
+                    SuspiciousEventType::IMPOSSIBLE_TRAVEL,
                     username,
-                    "", // Will fill ip_addresses vector instead
-                    window_start.timestamp,
-                    window_end.timestamp,
-                    static_cast<int>(ip_addresses.size())
+                    previous->ip_address,
+                    previous->timestamp,
+                    login.timestamp,
+                    2
                 );
+                event.ip_addresses.push_back(login.ip_address);
                 
-                // Add all IP addresses to the event
-                event.ip_addresses.clear();
-                for (const auto& ip : ip_addresses) 
-                {
-                    event.ip_addresses.push_back(ip);
-                }
+                std::string speed = (hours <= 0.0) 
+                    ? "at the same time" 
+                    : "within " + std::to_string(elapsed / 60) + " minutes (" + 
+                      std::to_string(static_cast<long long>(distance_km / hours)) + " km/h)";
+                event.description = "User '" + username + "' logged in from places " + 
+                                    std::to_string(static_cast<long long>(distance_km)) + 
+                                    " km apart " + speed;
                 
-                // Add description
-                event.description = "User '" + username + 
-                                   "' logged in from " + 
-                                   std::to_string(ip_addresses.size()) + 
-                                   " different IP addresses within " +
-                                   std::to_string(time_window_minutes_) + " minutes";
-                
-                detected_events.push_back(event);
-                
-                // Skip to end of window
-                i = window_end_idx;
+                events.push_back(event);
             }
         }
+        
+        previous = &login;
+        previous_location = location;
+    }
+}
+
+std::vector<SuspiciousEvent> EventDetector::detectDenylisted(
+    const std::vector<LogEntry>& entries) const
+{
+    std::vector<SuspiciousEvent> detected_events;
+    if (deny_list_ == nullptr || deny_list_->size() == 0) 
+    {
+        return detected_events;
+    }
+    
+    // Step 1: Group attempts by username
+    auto timelines = groupByUser(entries, [](const LogEntry&) 
+    {
+        return true;
+    });
+    
+    for (const auto& timeline : timelines) 
+    {
+        detectUserDenylisted(timeline, detected_events);
     }
     
     return detected_events;
 }
 
-std::vector<SuspiciousEvent> EventDetector::detectAll(
+void EventDetector::detectUserDenylisted(
+    const std::vector<LogEntry>& timeline,
+    std::vector<SuspiciousEvent>& events) const
+{
+    if (deny_list_ == nullptr || deny_list_->size() == 0 || timeline.empty()) 
+    {
+        return;
+    }
+    const std::string& username = timeline.front().username;
+    
+    // Step 2: Group the user's denylisted attempts by IP address,
+    // looking each distinct address up only once
+    std::map<std::string, bool> denied_by_ip;
+    std::map<std::string, std::vector<const LogEntry*>> attempts;
+    for (const auto& entry : timeline) 
+    {
+        auto found = denied_by_ip.find(entry.ip_address);
+        if (found == denied_by_ip.end()) 
+        {
+            found = denied_by_ip.emplace(entry.ip_address, 
+                                         deny_list_->contains(entry.ip_address)).first;
+        }
+        if (found->second) 
+        {
+            attempts[entry.ip_address].push_back(&entry);
+        }
+    }
+    
+    // Step 3: Report each address once
+    for (const auto& [ip_address, user_attempts] : attempts) 
+    {
+        auto first = user_attempts.front()->timestamp;
+        auto last = first;
+        int successes = 0;
+        for (const LogEntry* attempt : user_attempts) 
+        {
+            first = std::min(first, attempt->timestamp);
+            last = std::max(last, attempt->timestamp);
+            if (attempt->status == LoginStatus::SUCCESS) 
+            {
+                successes++;
+            }
+        }
+        
+        SuspiciousEvent event(
+            SuspiciousEventType::DENYLISTED_IP,
+            username,
+            ip_address,
+            first,
+            last,
+            static_cast<int>(user_attempts.size())
+        );
+        event.description = "User '" + username + "' had " + 
+                            std::to_string(user_attempts.size()) + 
+                            (user_attempts.size() == 1 ? " login attempt (" : " login attempts (") + 
+                            std::to_string(successes) + 
+                            " successful) from denylisted IP '" + ip_address + "'";
+        
+        events.push_back(event);
+    }
+}
+
+std::vector<SuspiciousEvent> EventDetector::detectDistributedBruteForce(
     const std::vector<LogEntry>& entries) const
 {
-    std::vector<SuspiciousEvent> all_events;
+    std::vector<SuspiciousEvent> detected_events;
+    
+    // Step 1: Group failed login attempts by username
+    auto timelines = groupByUser(entries, [](const LogEntry& entry) 
+    {
+        return entry.status == LoginStatus::FAILED;
+    });
+    sortTimelines(timelines);
     
-    // Run all detection methods
-    auto failed_logins = detectMultipleFailedLogins(entries);
-    auto outside_hours = detectLoginsOutsideBusinessHours(entries);
-    auto multiple_ips = detectMultipleIPAddresses(entries);
+    for (const auto& timeline : timelines) 
+    {
+        detectUserDistributedBruteForce(timeline, detected_events);
+    }
+    
+    return detected_events;
+}
+
+void EventDetector::detectUserDistributedBruteForce(
+    const std::vector<LogEntry>& timeline,
+    std::vector<SuspiciousEvent>& events) const
+{
+    std::vector<const LogEntry*> user_failed_logins;
+    for (const auto& entry : timeline) 
+    {
+        if (entry.status == LoginStatus::FAILED) 
+        {
+            user_failed_logins.push_back(&entry);
+        }
+    }
+    if (user_failed_logins.empty()) 
+    {
+        return;
+    }
+    const std::string& username = timeline.front().username;
+    
+    // Entries are within the window while less than one more minute apart
+    // (see isWithinTimeWindow())
+    const auto window = std::chrono::minutes(time_window_minutes_ + 1);
+    const std::size_t threshold = static_cast<std::size_t>(distributed_ip_threshold_);
+    
+    // Step 2: Slide over the failures, counting distinct source IPs
+    SlidingDistinctCounter distinct_ips(window);
+    std::size_t window_start_idx = 0;
+    bool in_attack = false;
+    SuspiciousEvent event;
+    
+    for (size_t i = 0; i < user_failed_logins.size(); ++i) 
+    {
+        const LogEntry& failure = *user_failed_logins[i];
+        distinct_ips.add(failure.ip_address, failure.timestamp);
+        while (!isWithinTimeWindow(user_failed_logins[window_start_idx]->timestamp,
+                                   failure.timestamp)) 
+        {
+            window_start_idx++;
+        }
+        
+        std::size_t ip_count = distinct_ips.estimate();
+        
+        // Step 3: Close a detection once the count falls below the threshold
+        if (in_attack && ip_count < threshold) 
+        {
+            events.push_back(event);
+            in_attack = false;
+        }
+        
+        if (ip_count < threshold) 
+        {
+            continue;
+        }
+        
+        // Step 4: Open a detection starting at the oldest failure in the window
+        if (!in_attack) 
+        {
+            in_attack = true;
+            event = SuspiciousEvent(
+                SuspiciousEventType::DISTRIBUTED_BRUTE_FORCE,
+                username,
+                "",
+                user_failed_logins[window_start_idx]->timestamp,
+                failure.timestamp,
+                0
+            );
+            
+            event.ip_addresses.clear();
+            for (size_t j = window_start_idx; j < i; ++j) 
+            {
+                addSampleAddress(event, user_failed_logins[j]->ip_address);
+            }
+        }
+        
+        // Keep a few of the participating addresses as examples
+        addSampleAddress(event, failure.ip_address);
+        event.last_occurrence = failure.timestamp;
+        if (static_cast<int>(ip_count) > event.event_count) 
+        {
+            event.event_count = static_cast<int>(ip_count);
+            event.description = "User '" + username + "' had failed logins from " +
+                                std::string(distinct_ips.isExact() ? "" : "about ") +
+                                std::to_string(ip_count) +
+                                " different IP addresses within " +
+                                std::to_string(time_window_minutes_) + " minutes";
+        }
+    }
     
-    // Combine all results
-    all_events.insert(all_events.end(), failed_logins.begin(), failed_logins.end());
-    all_events.insert(all_events.end(), outside_hours.begin(), outside_hours.end());
-    all_events.insert(all_events.end(), multiple_ips.begin(), multiple_ips.end());
+    if (in_attack) 
+    {
+        events.push_back(event);
+    }
+}
+
+std::vector<SuspiciousEvent> EventDetector::detectPasswordSpraying(
+    const std::vector<LogEntry>& entries) const
+{
+    // Step 1: Collect failed logins, in timestamp order
+    std::vector<const LogEntry*> failed_logins;
+    for (const auto& entry : entries) 
+    {
+        if (entry.status == LoginStatus::FAILED) 
+        {
+            failed_logins.push_back(&entry);
+        }
+    }
     
-    return all_events;
-}
\ No newline at end of file
+    if (!input_time_ordered_) 
+    {
+        std::stable_sort(failed_logins.begin(), failed_logins.end(),
+                         [](const LogEntry* a, const LogEntry* b) 
+                         {
+                             return a->timestamp < b->timestamp;
+                         });
+    }
+    
+    // Step 2: Stream them through per-IP windows of distinct usernames
+    PasswordSprayTracker tracker(time_window_minutes_, spray_user_threshold_);
+    for (const LogEntry* entry : failed_logins) 
+    {
+        tracker.observe(*entry);
+    }
+    
+    return tracker.finish();
+}
+
+std::vector<SuspiciousEvent> EventDetector::detectSuccessAfterIpFailures(
+    const std::vector<LogEntry>& entries) const
+{
+    // Step 1: Collect failed and successful logins, in timestamp order
+    std::vector<const LogEntry*> logins;
+    for (const auto& entry : entries) 
+    {
+        if (entry.status == LoginStatus::FAILED || entry.status == LoginStatus::SUCCESS) 
+        {
+            logins.push_back(&entry);
+        }
+    }
+    
+    if (!input_time_ordered_) 
+    {
+        std::stable_sort(logins.begin(), logins.end(),
+                         [](const LogEntry* a, const LogEntry* b) 
+                         {
+                             return a->timestamp < b->timestamp;
+                         });
+    }
+    
+    // Step 2: Stream them through per-IP windows of unreported failures
+    IpFailureTracker tracker(time_window_minutes_, failed_login_threshold_);
+    for (const LogEntry* entry : logins) 
+    {
+        tracker.observe(*entry);
+    }
+    
+    return tracker.finish();
+}
+
+std::vector<SuspiciousEvent> EventDetector::detectPerUser(
+    const std::vector<LogEntry>& entries) const
+{
+    // Run the enabled per-user rules on timelines grouped and sorted once
+    return DetectionRules::BuiltInRules::run<true>(*this, entries, enabled_rules_);
+}
+
+std::vector<SuspiciousEvent> EventDetector::detectAll(
+    const std::vector<LogEntry>& entries) const
+{
+    // Per-user rules plus those that compare entries across users
+    return DetectionRules::BuiltInRules::run<false>(*this, entries, enabled_rules_);
+}
+
+std::vector<std::vector<LogEntry>> EventDetector::groupTimelines(
+    const std::vector<LogEntry>& entries) const
+{
+    auto timelines = groupByUser(entries, [](const LogEntry&) 
+    {
+        return true;
+    });
+    sortTimelines(timelines);
+    return timelines;
+}
+
+void EventDetector::sortTimelines(std::vector<std::vector<LogEntry>>& timelines) const
+{
+    for (auto& timeline : timelines) 
+    {
+        sortByTimestamp(timeline);
+    }
+}
+
+std::vector<SuspiciousEvent> EventDetector::detectTimelines(
+    const std::vector<std::vector<LogEntry>>& timelines) const
+{
+    DetectionRules::EventBuckets buckets;
+    for (const auto& timeline : timelines) 
+    {
+        DetectionRules::BuiltInRules::runUser(*this, timeline, enabled_rules_, buckets);
+    }
+    return DetectionRules::collectEvents(buckets);
+}
+
+std::vector<SuspiciousEvent> EventDetector::detectTimelines(
+    const std::vector<std::vector<LogEntry>>& timelines, 
+    std::vector<SuspiciousEvent> cross_user_events) const
+{
+    DetectionRules::EventBuckets buckets;
+    for (const auto& timeline : timelines) 
+    {
+        DetectionRules::BuiltInRules::runUser(*this, timeline, enabled_rules_, buckets);
+    }
+    
+    // Cross-user events follow the per-user ones of their type, as in detectAll()
+    for (auto& event : cross_user_events) 
+    {
+        DetectionRules::bucketOf(buckets, event.type).push_back(std::move(event));
+    }
+    return DetectionRules::collectEvents(buckets);
+}
+
+std::vector<SuspiciousEvent> EventDetector::detectTimeline(
+    const std::vector<LogEntry>& timeline) const
+{
+    DetectionRules::EventBuckets buckets;
+    DetectionRules::BuiltInRules::runUser(*this, timeline, enabled_rules_, buckets);
+    return DetectionRules::collectEvents(buckets);
+}
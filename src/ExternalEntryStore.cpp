@@ -0,0 +1,644 @@
+#include "ExternalEntryStore.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <queue>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+// Number of run buffers that share the memory limit during a merge
+static constexpr std::size_t kMergeBuffers = 64;
+
+// Bounds of the read buffer of each run during a merge
+static constexpr std::size_t kMinRunBufferBytes = 4 * 1024;
+static constexpr std::size_t kMaxRunBufferBytes = 1024 * 1024;
+
+// File descriptors a merge may use where the limit cannot be queried
+static constexpr std::size_t kDefaultDescriptorBudget = 256;
+
+/**
+ * @brief Gets the number of files a merge may open at once
+ *
+ * Half of the open file limit, leaving the rest to the input files and
+ * the remainder of the process.
+ */
+static std::size_t descriptorBudget()
+{
+#if defined(__unix__) || defined(__APPLE__)
+    struct rlimit limit;
+    if (::getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY)
+    {
+        return static_cast<std::size_t>(limit.rlim_cur / 2);
+    }
+#endif
+    return kDefaultDescriptorBudget;
+}
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+ExternalEntryStore::ExternalEntryStore(std::size_t memory_limit_bytes,
+                                       const std::string& directory,
+                                       std::size_t partitions,
+                                       std::size_t max_fan_in)
+    : memory_limit_(memory_limit_bytes),
+      run_buffer_bytes_(std::clamp(memory_limit_bytes / kMergeBuffers,
+                                   kMinRunBufferBytes, kMaxRunBufferBytes)),
+      fan_in_(0),
+      directory_(directory),
+      partitions_(std::max<std::size_t>(partitions, 1)),
+      buffered_bytes_(0),
+      size_(0),
+      run_count_(0)
+{
+    // A merge reads as many runs as have buffers within the memory limit
+    // and descriptors within the budget
+    fan_in_ = std::min(memory_limit_ / run_buffer_bytes_, descriptorBudget());
+    if (max_fan_in > 0)
+    {
+        fan_in_ = std::min(fan_in_, max_fan_in);
+    }
+    fan_in_ = std::max<std::size_t>(fan_in_, 2);
+
+    if (directory_.empty())
+    {
+        std::error_code error;
+        directory_ = std::filesystem::temp_directory_path(error).string();
+        if (error)
+        {
+            directory_ = ".";
+        }
+    }
+
+    // Spill file names are unique per process and per store
+    static std::atomic<unsigned> store_counter(0);
+    auto clock = std::chrono::steady_clock::now().time_since_epoch().count();
+    std::string prefix = "log-analyzer-" + std::to_string(clock) + "-" +
+                         std::to_string(store_counter++) + "-";
+
+    for (std::size_t i = 0; i < partitions_.size(); ++i)
+    {
+        partitions_[i].file_size = 0;
+        partitions_[i].path = (std::filesystem::path(directory_) /
+                               (prefix + std::to_string(i) + ".spill")).string();
+    }
+    ordered_path_ = (std::filesystem::path(directory_) / (prefix + "ordered.spill")).string();
+}
+
+ExternalEntryStore::~ExternalEntryStore()
+{
+    for (const auto& partition : partitions_)
+    {
+        if (!partition.runs.empty())
+        {
+            std::remove(partition.path.c_str());
+        }
+    }
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+bool ExternalEntryStore::add(const LogEntry& entry)
+{
+    std::size_t index = std::hash<std::string>()(entry.username) % partitions_.size();
+    partitions_[index].buffer.push_back(Record{entry, size_});
+    buffered_bytes_ += recordBytes(partitions_[index].buffer.back());
+    size_++;
+
+    if (buffered_bytes_ >= memory_limit_)
+    {
+        return spill();
+    }
+    return true;
+}
+
+bool ExternalEntryStore::forEachUser(const std::function<void(std::vector<LogEntry>&)>& visit)
+{
+    bool success = true;
+
+    for (std::size_t i = 0; i < partitions_.size(); ++i)
+    {
+        Partition& partition = partitions_[i];
+
+        // Partitions that were spilled before get their remainder as a last run
+        if (!partition.runs.empty() && !partition.buffer.empty())
+        {
+            if (!spillPartition(i))
+            {
+                success = false;
+                continue;
+            }
+        }
+
+        if (partition.runs.empty())
+        {
+            // Everything fit into memory: sort and visit in place
+            std::sort(partition.buffer.begin(), partition.buffer.end(), userOrderLess);
+
+            std::vector<LogEntry> user_entries;
+            for (auto& record : partition.buffer)
+            {
+                if (!user_entries.empty() && user_entries.back().username != record.entry.username)
+                {
+                    visit(user_entries);
+                    user_entries.clear();
+                }
+                user_entries.push_back(std::move(record.entry));
+            }
+            if (!user_entries.empty())
+            {
+                visit(user_entries);
+            }
+
+            partition.buffer.clear();
+            partition.buffer.shrink_to_fit();
+        }
+        else if (!mergePartition(partition, visit))
+        {
+            success = false;
+        }
+    }
+
+    buffered_bytes_ = 0;
+    return success;
+}
+
+bool ExternalEntryStore::forEachInTimeOrder(const std::function<void(const LogEntry&)>& visit)
+{
+    bool spilled = false;
+    for (const auto& partition : partitions_)
+    {
+        spilled = spilled || !partition.runs.empty();
+    }
+
+    if (!spilled)
+    {
+        // Everything fit into memory: sort references to the buffered entries
+        std::vector<const Record*> records;
+        records.reserve(size_);
+        for (const auto& partition : partitions_)
+        {
+            for (const auto& record : partition.buffer)
+            {
+                records.push_back(&record);
+            }
+        }
+        std::sort(records.begin(), records.end(),
+                  [](const Record* a, const Record* b) { return timeOrderLess(*a, *b); });
+        for (const Record* record : records)
+        {
+            visit(record->entry);
+        }
+        return true;
+    }
+
+    // Put every entry on disk, so that only the time-sorted copy is buffered
+    if (!spill())
+    {
+        return false;
+    }
+
+    Partition ordered;
+    ordered.file_size = 0;
+    ordered.path = ordered_path_;
+    std::size_t ordered_bytes = 0;
+
+    auto collect = [this, &ordered, &ordered_bytes](const Record& record)
+    {
+        ordered.buffer.push_back(record);
+        ordered_bytes += recordBytes(record);
+        if (ordered_bytes < memory_limit_)
+        {
+            return true;
+        }
+        ordered_bytes = 0;
+        return spillRun(ordered, timeOrderLess);
+    };
+
+    bool success = true;
+    for (const auto& partition : partitions_)
+    {
+        if (!readAll(partition, collect))
+        {
+            success = false;
+            break;
+        }
+    }
+
+    if (success && ordered.runs.empty())
+    {
+        std::sort(ordered.buffer.begin(), ordered.buffer.end(), timeOrderLess);
+        for (const auto& record : ordered.buffer)
+        {
+            visit(record.entry);
+        }
+    }
+    else if (success)
+    {
+        success = spillRun(ordered, timeOrderLess);
+        while (success && ordered.runs.size() > fan_in_)
+        {
+            success = mergePass(ordered, timeOrderLess);
+        }
+        success = success &&
+                  mergeRuns(ordered.path, ordered.runs, 0, ordered.runs.size(), timeOrderLess,
+                            [&visit](Record& record)
+                            {
+                                visit(record.entry);
+                                return true;
+                            });
+    }
+
+    std::remove(ordered.path.c_str());
+    return success;
+}
+
+std::size_t ExternalEntryStore::size() const
+{
+    return size_;
+}
+
+std::size_t ExternalEntryStore::runCount() const
+{
+    return run_count_;
+}
+
+std::size_t ExternalEntryStore::fanIn() const
+{
+    return fan_in_;
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+bool ExternalEntryStore::spill()
+{
+    for (std::size_t i = 0; i < partitions_.size(); ++i)
+    {
+        if (!spillPartition(i))
+        {
+            return false;
+        }
+    }
+
+    buffered_bytes_ = 0;
+    return true;
+}
+
+bool ExternalEntryStore::spillPartition(std::size_t index)
+{
+    Partition& partition = partitions_[index];
+    if (partition.buffer.empty())
+    {
+        return true;
+    }
+
+    if (!spillRun(partition, userOrderLess))
+    {
+        return false;
+    }
+    run_count_++;
+    return true;
+}
+
+bool ExternalEntryStore::spillRun(Partition& partition, RecordLess less) const
+{
+    if (partition.buffer.empty())
+    {
+        return true;
+    }
+
+    std::sort(partition.buffer.begin(), partition.buffer.end(), less);
+
+    std::ofstream file(partition.path, std::ios::binary | std::ios::app);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    for (const auto& record : partition.buffer)
+    {
+        writeRecord(file, record);
+    }
+
+    file.flush();
+    if (!file)
+    {
+        return false;
+    }
+
+    Run run;
+    run.offset = partition.file_size;
+    run.count = partition.buffer.size();
+    partition.runs.push_back(run);
+    partition.file_size = static_cast<std::uint64_t>(file.tellp());
+
+    // Release the memory rather than keeping the capacity around
+    std::vector<Record>().swap(partition.buffer);
+    return true;
+}
+
+bool ExternalEntryStore::readAll(const Partition& partition,
+                                 const std::function<bool(const Record&)>& consume) const
+{
+    if (partition.runs.empty())
+    {
+        return true;
+    }
+
+    // Runs follow each other from the start of the file
+    std::size_t count = 0;
+    for (const auto& run : partition.runs)
+    {
+        count += run.count;
+    }
+
+    std::vector<char> buffer(run_buffer_bytes_);
+    std::ifstream file;
+    file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.open(partition.path, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    Record record;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (!readRecord(file, record) || !consume(record))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ExternalEntryStore::mergePartition(
+    Partition& partition,
+    const std::function<void(std::vector<LogEntry>&)>& visit)
+{
+    // Combine runs into longer ones until a single merge can read them all
+    while (partition.runs.size() > fan_in_)
+    {
+        if (!mergePass(partition, userOrderLess))
+        {
+            return false;
+        }
+    }
+
+    std::vector<LogEntry> user_entries;
+    bool success = mergeRuns(partition.path, partition.runs, 0, partition.runs.size(),
+                             userOrderLess,
+                             [&user_entries, &visit](Record& record)
+                             {
+                                 if (!user_entries.empty() &&
+                                     user_entries.back().username != record.entry.username)
+                                 {
+                                     visit(user_entries);
+                                     user_entries.clear();
+                                 }
+                                 user_entries.push_back(std::move(record.entry));
+                                 return true;
+                             });
+    if (!success)
+    {
+        return false;
+    }
+
+    if (!user_entries.empty())
+    {
+        visit(user_entries);
+    }
+
+    partition.runs.clear();
+    partition.file_size = 0;
+    std::remove(partition.path.c_str());
+    return true;
+}
+
+bool ExternalEntryStore::mergePass(Partition& partition, RecordLess less) const
+{
+    std::string pass_path = partition.path + ".pass";
+    std::vector<Run> merged_runs;
+    std::uint64_t file_size = 0;
+
+    {
+        std::vector<char> buffer(run_buffer_bytes_);
+        std::ofstream output;
+        output.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        output.open(pass_path, std::ios::binary | std::ios::trunc);
+        if (!output.is_open())
+        {
+            return false;
+        }
+
+        for (std::size_t first = 0; first < partition.runs.size(); first += fan_in_)
+        {
+            Run run;
+            run.offset = static_cast<std::uint64_t>(output.tellp());
+            run.count = 0;
+
+            std::size_t count = std::min(fan_in_, partition.runs.size() - first);
+            bool success = mergeRuns(partition.path, partition.runs, first, count, less,
+                                     [&output, &run](Record& record)
+                                     {
+                                         writeRecord(output, record);
+                                         run.count++;
+                                         return static_cast<bool>(output);
+                                     });
+            if (!success)
+            {
+                output.close();
+                std::remove(pass_path.c_str());
+                return false;
+            }
+            merged_runs.push_back(run);
+        }
+
+        output.flush();
+        if (!output)
+        {
+            output.close();
+            std::remove(pass_path.c_str());
+            return false;
+        }
+        file_size = static_cast<std::uint64_t>(output.tellp());
+    }
+
+    // The merged runs replace the partition's spill file
+    std::remove(partition.path.c_str());
+    if (std::rename(pass_path.c_str(), partition.path.c_str()) != 0)
+    {
+        std::remove(pass_path.c_str());
+        partition.runs.clear();
+        return false;
+    }
+
+    partition.runs.swap(merged_runs);
+    partition.file_size = file_size;
+    return true;
+}
+
+bool ExternalEntryStore::mergeRuns(const std::string& path, const std::vector<Run>& runs,
+                                   std::size_t first, std::size_t count, RecordLess less,
+                                   const std::function<bool(Record&)>& consume) const
+{
+    /**
+     * @brief Read position inside one run
+     */
+    struct Source
+    {
+        std::vector<char> buffer;   // Stream buffer
+        std::ifstream file;         // Spill file positioned inside the run
+        std::size_t remaining;      // Records not yet read
+        Record head;                // Smallest unconsumed record
+    };
+
+    std::vector<Source> sources(count);
+    for (std::size_t i = 0; i < sources.size(); ++i)
+    {
+        Source& source = sources[i];
+        source.buffer.resize(run_buffer_bytes_);
+        source.file.rdbuf()->pubsetbuf(source.buffer.data(),
+                                       static_cast<std::streamsize>(source.buffer.size()));
+        source.file.open(path, std::ios::binary);
+        source.file.seekg(static_cast<std::streamoff>(runs[first + i].offset));
+        source.remaining = runs[first + i].count;
+        if (!source.file)
+        {
+            return false;
+        }
+    }
+
+    // Min-heap of run indices keyed by each run's head record
+    auto greater = [&sources, less](std::size_t a, std::size_t b)
+    {
+        return less(sources[b].head, sources[a].head);
+    };
+    std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(greater)> heap(greater);
+
+    // Reads the next record of a run and queues it
+    auto advance = [&sources, &heap](std::size_t index)
+    {
+        Source& source = sources[index];
+        if (source.remaining == 0)
+        {
+            return true;
+        }
+        if (!readRecord(source.file, source.head))
+        {
+            return false;
+        }
+        source.remaining--;
+        heap.push(index);
+        return true;
+    };
+
+    for (std::size_t i = 0; i < sources.size(); ++i)
+    {
+        if (!advance(i))
+        {
+            return false;
+        }
+    }
+
+    while (!heap.empty())
+    {
+        std::size_t index = heap.top();
+        heap.pop();
+
+        if (!consume(sources[index].head) || !advance(index))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ExternalEntryStore::userOrderLess(const Record& a, const Record& b)
+{
+    int order = a.entry.username.compare(b.entry.username);
+    if (order != 0)
+    {
+        return order < 0;
+    }
+    if (a.entry.timestamp != b.entry.timestamp)
+    {
+        return a.entry.timestamp < b.entry.timestamp;
+    }
+    return a.arrival < b.arrival;
+}
+
+bool ExternalEntryStore::timeOrderLess(const Record& a, const Record& b)
+{
+    if (a.entry.timestamp != b.entry.timestamp)
+    {
+        return a.entry.timestamp < b.entry.timestamp;
+    }
+    return a.arrival < b.arrival;
+}
+
+std::size_t ExternalEntryStore::recordBytes(const Record& record)
+{
+    return sizeof(Record) + record.entry.username.size() + record.entry.ip_address.size();
+}
+
+void ExternalEntryStore::writeRecord(std::ostream& output, const Record& record)
+{
+    // Layout: ticks (int64), arrival (uint64), status (uint8), username
+    // and IP lengths (uint32 each), then the username and IP bytes
+    const LogEntry& entry = record.entry;
+    std::int64_t ticks = static_cast<std::int64_t>(entry.timestamp.time_since_epoch().count());
+    std::uint64_t arrival = record.arrival;
+    std::uint8_t status = static_cast<std::uint8_t>(entry.status);
+    std::uint32_t user_length = static_cast<std::uint32_t>(entry.username.size());
+    std::uint32_t ip_length = static_cast<std::uint32_t>(entry.ip_address.size());
+
+    output.write(reinterpret_cast<const char*>(&ticks), sizeof(ticks));
+    output.write(reinterpret_cast<const char*>(&arrival), sizeof(arrival));
+    output.write(reinterpret_cast<const char*>(&status), sizeof(status));
+    output.write(reinterpret_cast<const char*>(&user_length), sizeof(user_length));
+    output.write(reinterpret_cast<const char*>(&ip_length), sizeof(ip_length));
+    output.write(entry.username.data(), static_cast<std::streamsize>(user_length));
+    output.write(entry.ip_address.data(), static_cast<std::streamsize>(ip_length));
+}
+
+bool ExternalEntryStore::readRecord(std::istream& input, Record& record)
+{
+    std::int64_t ticks = 0;
+    std::uint64_t arrival = 0;
+    std::uint8_t status = 0;
+    std::uint32_t user_length = 0;
+    std::uint32_t ip_length = 0;
+
+    input.read(reinterpret_cast<char*>(&ticks), sizeof(ticks));
+    input.read(reinterpret_cast<char*>(&arrival), sizeof(arrival));
+    input.read(reinterpret_cast<char*>(&status), sizeof(status));
+    input.read(reinterpret_cast<char*>(&user_length), sizeof(user_length));
+    input.read(reinterpret_cast<char*>(&ip_length), sizeof(ip_length));
+    if (!input)
+    {
+        return false;
+    }
+
+    LogEntry& entry = record.entry;
+    entry.username.resize(user_length);
+    entry.ip_address.resize(ip_length);
+    input.read(&entry.username[0], static_cast<std::streamsize>(user_length));
+    input.read(&entry.ip_address[0], static_cast<std::streamsize>(ip_length));
+
+    entry.timestamp = std::chrono::system_clock::time_point(
+        std::chrono::system_clock::duration(ticks));
+    entry.status = static_cast<LoginStatus>(status);
+    record.arrival = arrival;
+    return static_cast<bool>(input);
+}
@@ -0,0 +1,439 @@
+#include "GeoIpTable.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LOG_ANALYZER_POSIX_IO 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+/**
+ * @brief Header in front of the ranges of the binary form
+ */
+struct BinaryHeader
+{
+    char magic[8];         // kBinaryMagic
+    std::uint64_t count;   // Number of ranges that follow
+};
+
+const char kBinaryMagic[8] = {'L', 'A', 'G', 'E', 'O', 'I', 'P', '1'};
+
+/**
+ * @brief Removes surrounding blanks and quotes from a CSV field
+ */
+std::string_view trimField(std::string_view field)
+{
+    while (!field.empty() && (field.front() == ' ' || field.front() == '\t' || field.front() == '"'))
+    {
+        field.remove_prefix(1);
+    }
+    while (!field.empty() && (field.back() == ' ' || field.back() == '\t' ||
+                              field.back() == '"' || field.back() == '\r'))
+    {
+        field.remove_suffix(1);
+    }
+    return field;
+}
+
+/**
+ * @brief Parses a dotted-quad or plain 32-bit integer address
+ */
+std::optional<std::uint32_t> parseAddress(std::string_view text)
+{
+    if (text.find('.') != std::string_view::npos)
+    {
+        return GeoIpTable::parseIPv4(text);
+    }
+
+    if (text.empty() || text.size() > 10)
+    {
+        return std::nullopt;
+    }
+    std::uint64_t value = 0;
+    for (char c : text)
+    {
+        if (c < '0' || c > '9')
+        {
+            return std::nullopt;
+        }
+        value = value * 10 + static_cast<std::uint64_t>(c - '0');
+    }
+    if (value > 0xFFFFFFFFULL)
+    {
+        return std::nullopt;
+    }
+    return static_cast<std::uint32_t>(value);
+}
+
+/**
+ * @brief Parses a coordinate within [-limit, limit]
+ */
+std::optional<float> parseCoordinate(std::string_view text, double limit)
+{
+    std::string copy(text);
+    char* end = nullptr;
+    double value = std::strtod(copy.c_str(), &end);
+    if (copy.empty() || end != copy.c_str() + copy.size() || !(std::fabs(value) <= limit))
+    {
+        return std::nullopt;
+    }
+    return static_cast<float>(value);
+}
+
+/**
+ * @brief Checks that ranges are valid, sorted and do not overlap
+ *
+ * lookup() relies on this; a binary file is not trusted to provide it.
+ */
+bool isOrdered(const GeoIpRange* ranges, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (ranges[i].first > ranges[i].last ||
+            (i > 0 && ranges[i].first <= ranges[i - 1].last))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+GeoIpTable::GeoIpTable()
+    : owned_(),
+      ranges_(nullptr),
+      count_(0),
+      mapping_(nullptr),
+      mapping_size_(0),
+      failed_line_(0)
+{
+}
+
+GeoIpTable::~GeoIpTable()
+{
+    clear();
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+bool GeoIpTable::load(const std::string& path)
+{
+    clear();
+    failed_line_ = 0;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    char magic[sizeof(kBinaryMagic)] = {};
+    file.read(magic, sizeof(magic));
+    bool is_binary = file.gcount() == static_cast<std::streamsize>(sizeof(magic)) &&
+                     std::memcmp(magic, kBinaryMagic, sizeof(magic)) == 0;
+    file.close();
+
+    return is_binary ? loadBinary(path) : loadCsv(path);
+}
+
+bool GeoIpTable::saveBinary(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    BinaryHeader header;
+    std::memcpy(header.magic, kBinaryMagic, sizeof(header.magic));
+    header.count = count_;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (count_ > 0)
+    {
+        file.write(reinterpret_cast<const char*>(ranges_),
+                   static_cast<std::streamsize>(count_ * sizeof(GeoIpRange)));
+    }
+    return static_cast<bool>(file);
+}
+
+const GeoIpRange* GeoIpTable::lookup(std::string_view ip_address) const
+{
+    std::optional<std::uint32_t> address = parseIPv4(ip_address);
+    if (!address || count_ == 0)
+    {
+        return nullptr;
+    }
+
+    // Last range starting at or before the address
+    const GeoIpRange* end = ranges_ + count_;
+    const GeoIpRange* found = std::upper_bound(ranges_, end, *address,
+                                               [](std::uint32_t value, const GeoIpRange& range)
+                                               {
+                                                   return value < range.first;
+                                               });
+    if (found == ranges_)
+    {
+        return nullptr;
+    }
+    --found;
+    return (*address <= found->last) ? found : nullptr;
+}
+
+std::size_t GeoIpTable::size() const
+{
+    return count_;
+}
+
+std::size_t GeoIpTable::failedLine() const
+{
+    return failed_line_;
+}
+
+std::optional<std::uint32_t> GeoIpTable::parseIPv4(std::string_view text)
+{
+    std::uint32_t address = 0;
+    int octets = 0;
+    std::size_t pos = 0;
+
+    while (octets < 4)
+    {
+        std::uint32_t octet = 0;
+        std::size_t digits = 0;
+        while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9' && digits < 3)
+        {
+            octet = octet * 10 + static_cast<std::uint32_t>(text[pos] - '0');
+            pos++;
+            digits++;
+        }
+        if (digits == 0 || octet > 255)
+        {
+            return std::nullopt;
+        }
+
+        address = (address << 8) | octet;
+        octets++;
+
+        if (octets < 4)
+        {
+            if (pos >= text.size() || text[pos] != '.')
+            {
+                return std::nullopt;
+            }
+            pos++;
+        }
+    }
+
+    if (pos != text.size())
+    {
+        return std::nullopt;
+    }
+    return address;
+}
+
+double GeoIpTable::distanceKm(const GeoIpRange& from, const GeoIpRange& to)
+{
+    constexpr double kEarthRadiusKm = 6371.0;
+    constexpr double kRadians = 3.14159265358979323846 / 180.0;
+
+    double lat1 = from.latitude * kRadians;
+    double lat2 = to.latitude * kRadians;
+    double dlat = lat2 - lat1;
+    double dlon = (to.longitude - from.longitude) * kRadians;
+
+    double a = std::sin(dlat / 2) * std::sin(dlat / 2) +
+               std::cos(lat1) * std::cos(lat2) * std::sin(dlon / 2) * std::sin(dlon / 2);
+    return 2.0 * kEarthRadiusKm * std::asin(std::min(1.0, std::sqrt(a)));
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+bool GeoIpTable::loadCsv(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    std::string line;
+    std::size_t line_number = 0;
+    bool seen_data = false;
+
+    while (std::getline(file, line))
+    {
+        line_number++;
+        std::string_view text = trimField(line);
+        if (text.empty() || text.front() == '#')
+        {
+            continue;
+        }
+
+        // Split into at most five fields
+        std::string_view fields[5];
+        std::size_t field_count = 0;
+        std::size_t start = 0;
+        while (field_count < 5)
+        {
+            std::size_t comma = text.find(',', start);
+            fields[field_count++] = trimField(text.substr(start, comma - start));
+            if (comma == std::string_view::npos)
+            {
+                break;
+            }
+            start = comma + 1;
+        }
+
+        std::optional<std::uint32_t> first = parseAddress(fields[0]);
+
+        // A header line names the columns instead
+        if (!seen_data && !first)
+        {
+            seen_data = true;
+            continue;
+        }
+        seen_data = true;
+
+        std::optional<std::uint32_t> last = (field_count >= 4) ? parseAddress(fields[1]) : std::nullopt;
+        std::optional<float> latitude = (field_count >= 4) ? parseCoordinate(fields[2], 90.0) : std::nullopt;
+        std::optional<float> longitude = (field_count >= 4) ? parseCoordinate(fields[3], 180.0) : std::nullopt;
+
+        if (!first || !last || !latitude || !longitude || *last < *first ||
+            (field_count == 5 && fields[4].size() > 3))
+        {
+            failed_line_ = line_number;
+            owned_.clear();
+            return false;
+        }
+
+        GeoIpRange range = {};
+        range.first = *first;
+        range.last = *last;
+        range.latitude = *latitude;
+        range.longitude = *longitude;
+        if (field_count == 5)
+        {
+            std::memcpy(range.country, fields[4].data(), fields[4].size());
+        }
+        owned_.push_back(range);
+    }
+
+    return compile();
+}
+
+bool GeoIpTable::loadBinary(const std::string& path)
+{
+#ifdef LOG_ANALYZER_POSIX_IO
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    if (::fstat(descriptor, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(BinaryHeader)))
+    {
+        ::close(descriptor);
+        return false;
+    }
+
+    std::size_t size = static_cast<std::size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+
+    BinaryHeader header;
+    std::memcpy(&header, mapping, sizeof(header));
+    const GeoIpRange* ranges = reinterpret_cast<const GeoIpRange*>(
+        static_cast<const char*>(mapping) + sizeof(header));
+    if (header.count > (size - sizeof(header)) / sizeof(GeoIpRange) ||
+        sizeof(header) + header.count * sizeof(GeoIpRange) != size ||
+        !isOrdered(ranges, static_cast<std::size_t>(header.count)))
+    {
+        ::munmap(mapping, size);
+        return false;
+    }
+
+    mapping_ = mapping;
+    mapping_size_ = size;
+    ranges_ = ranges;
+    count_ = static_cast<std::size_t>(header.count);
+    return true;
+#else
+    std::ifstream file(path, std::ios::binary);
+    BinaryHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        return false;
+    }
+
+    owned_.resize(static_cast<std::size_t>(header.count));
+    if (!file.read(reinterpret_cast<char*>(owned_.data()),
+                   static_cast<std::streamsize>(owned_.size() * sizeof(GeoIpRange))) ||
+        !isOrdered(owned_.data(), owned_.size()))
+    {
+        owned_.clear();
+        return false;
+    }
+    ranges_ = owned_.data();
+    count_ = owned_.size();
+    return true;
+#endif
+}
+
+bool GeoIpTable::compile()
+{
+    std::sort(owned_.begin(), owned_.end(),
+              [](const GeoIpRange& a, const GeoIpRange& b)
+              {
+                  return a.first < b.first;
+              });
+
+    for (std::size_t i = 1; i < owned_.size(); ++i)
+    {
+        if (owned_[i].first <= owned_[i - 1].last)
+        {
+            owned_.clear();
+            return false;
+        }
+    }
+
+    ranges_ = owned_.data();
+    count_ = owned_.size();
+    return true;
+}
+
+void GeoIpTable::clear()
+{
+#ifdef LOG_ANALYZER_POSIX_IO
+    if (mapping_ != nullptr)
+    {
+        ::munmap(mapping_, mapping_size_);
+    }
+#endif
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    owned_.clear();
+    ranges_ = nullptr;
+    count_ = 0;
+}
@@ -0,0 +1,153 @@
+#include "HeavyHitters.h"
+#include <algorithm>
+#include <utility>
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+HeavyHitters::HeavyHitters(std::size_t capacity)
+    : capacity_(capacity),
+      total_(0),
+      heap_(),
+      positions_()
+{
+    heap_.reserve(capacity_);
+    positions_.reserve(capacity_);
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+void HeavyHitters::add(const std::string& key)
+{
+    if (capacity_ == 0)
+    {
+        return;
+    }
+    total_++;
+
+    auto found = positions_.find(key);
+    if (found != positions_.end())
+    {
+        heap_[found->second].count++;
+        siftDown(found->second);
+        return;
+    }
+
+    if (heap_.size() < capacity_)
+    {
+        auto entry = positions_.emplace(key, heap_.size()).first;
+        heap_.push_back(Counter{1, 0, entry});
+        siftUp(heap_.size() - 1);
+        return;
+    }
+
+    // Replace the smallest counter; the new key inherits its count as error.
+    // The map node is reused, and positions_ never exceeds its reserved size,
+    // so the iterators held by the other counters stay valid.
+    Counter& smallest = heap_.front();
+    auto node = positions_.extract(smallest.entry);
+    node.key() = key;
+    smallest.entry = positions_.insert(std::move(node)).position;
+    smallest.error = smallest.count;
+    smallest.count++;
+    siftDown(0);
+}
+
+std::vector<HeavyHitter> HeavyHitters::top(std::size_t k) const
+{
+    std::vector<HeavyHitter> result;
+    result.reserve(heap_.size());
+    for (const auto& counter : heap_)
+    {
+        result.push_back(HeavyHitter{counter.entry->first, counter.count, counter.error});
+    }
+
+    auto by_count = [](const HeavyHitter& a, const HeavyHitter& b)
+    {
+        if (a.count != b.count)
+        {
+            return a.count > b.count;
+        }
+        return a.key < b.key;
+    };
+
+    k = std::min(k, result.size());
+    std::partial_sort(result.begin(), result.begin() + static_cast<std::ptrdiff_t>(k),
+                      result.end(), by_count);
+    result.resize(k);
+    return result;
+}
+
+std::uint64_t HeavyHitters::maxUntrackedCount() const
+{
+    if (capacity_ == 0 || heap_.size() < capacity_)
+    {
+        return 0;
+    }
+    return heap_.front().count;
+}
+
+std::uint64_t HeavyHitters::total() const
+{
+    return total_;
+}
+
+void HeavyHitters::clear()
+{
+    total_ = 0;
+    heap_.clear();
+    positions_.clear();
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+void HeavyHitters::siftUp(std::size_t index)
+{
+    while (index > 0)
+    {
+        std::size_t parent = (index - 1) / 2;
+        if (heap_[parent].count <= heap_[index].count)
+        {
+            return;
+        }
+        swapCounters(parent, index);
+        index = parent;
+    }
+}
+
+void HeavyHitters::siftDown(std::size_t index)
+{
+    for (;;)
+    {
+        std::size_t smallest = index;
+        std::size_t left = 2 * index + 1;
+        std::size_t right = left + 1;
+
+        if (left < heap_.size() && heap_[left].count < heap_[smallest].count)
+        {
+            smallest = left;
+        }
+        if (right < heap_.size() && heap_[right].count < heap_[smallest].count)
+        {
+            smallest = right;
+        }
+        if (smallest == index)
+        {
+            return;
+        }
+        swapCounters(smallest, index);
+        index = smallest;
+    }
+}
+
+void HeavyHitters::swapCounters(std::size_t a, std::size_t b)
+{
+    std::swap(heap_[a], heap_[b]);
+    heap_[a].entry->second = a;
+    heap_[b].entry->second = b;
+}
@@ -0,0 +1,63 @@
+#include "HyperLogLog.h"
+#include <cmath>
+#include <functional>
+
+namespace HyperLogLog
+{
+
+std::uint64_t hash(std::string_view value)
+{
+    // std::hash quality varies between libraries; finish with the
+    // splitmix64 mixer so every bit depends on every input bit
+    std::uint64_t x = static_cast<std::uint64_t>(std::hash<std::string_view>()(value));
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+std::uint8_t rank(std::uint64_t hash_value, int precision)
+{
+    // A sentinel bit below the used bits bounds the loop
+    std::uint64_t rest = (hash_value << precision) | (1ULL << (precision - 1));
+
+    std::uint8_t result = 1;
+    while ((rest & (1ULL << 63)) == 0)
+    {
+        rest <<= 1;
+        result++;
+    }
+    return result;
+}
+
+std::size_t harmonicEstimate(double register_sum, std::size_t zero_registers,
+                             std::size_t register_count)
+{
+    const double m = static_cast<double>(register_count);
+
+    // Raw estimate with the bias constants of Flajolet et al.
+    double alpha = 0.7213 / (1.0 + 1.079 / m);
+    if (register_count == 16)
+    {
+        alpha = 0.673;
+    }
+    else if (register_count == 32)
+    {
+        alpha = 0.697;
+    }
+    else if (register_count == 64)
+    {
+        alpha = 0.709;
+    }
+    double raw = alpha * m * m / register_sum;
+
+    // Small-range correction: linear counting while registers are empty
+    if (raw <= 2.5 * m && zero_registers > 0)
+    {
+        raw = m * std::log(m / static_cast<double>(zero_registers));
+    }
+
+    return static_cast<std::size_t>(raw + 0.5);
+}
+
+} // namespace HyperLogLog
@@ -0,0 +1,168 @@
+#include "IpFailureTracker.h"
+#include <algorithm>
+#include <functional>
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+IpFailureTracker::IpFailureTracker(int time_window_minutes, int failure_threshold)
+    : time_window_minutes_(time_window_minutes),
+      failure_threshold_(failure_threshold),
+      open_(),
+      latest_(),
+      last_sweep_(),
+      events_()
+{
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+void IpFailureTracker::observe(const LogEntry& entry)
+{
+    if (entry.status != LoginStatus::FAILED && entry.status != LoginStatus::SUCCESS)
+    {
+        return;
+    }
+
+    // Entries are within the window while less than one more minute apart
+    // (see isWithinWindow())
+    const auto window_length = std::chrono::minutes(time_window_minutes_ + 1);
+
+    if (entry.timestamp > latest_)
+    {
+        latest_ = entry.timestamp;
+        if (latest_ - last_sweep_ >= window_length)
+        {
+            expireIdle();
+        }
+    }
+
+    if (entry.status == LoginStatus::SUCCESS)
+    {
+        auto found = open_.find(entry.ip_address);
+        if (found == open_.end())
+        {
+            return;
+        }
+
+        // Failures that left the window no longer belong to the burst
+        std::deque<Failure>& failures = found->second;
+        while (!failures.empty() && !isWithinWindow(failures.front().timestamp, entry.timestamp))
+        {
+            failures.pop_front();
+        }
+        if (failures.size() < static_cast<std::size_t>(failure_threshold_))
+        {
+            return;
+        }
+
+        // Failures of only this user are the per-user scan's to report
+        std::size_t user_hash = std::hash<std::string>{}(entry.username);
+        bool other_users = std::any_of(failures.begin(), failures.end(),
+                                       [user_hash](const Failure& failure)
+                                       {
+                                           return failure.user_hash != user_hash;
+                                       });
+        if (!other_users)
+        {
+            return;
+        }
+
+        // The burst is reported; later successes need new failures
+        report(entry, failures);
+        open_.erase(found);
+        return;
+    }
+
+    std::deque<Failure>& failures = open_[entry.ip_address];
+
+    // A late entry counts as the newest, keeping the failures in time order
+    TimePoint timestamp = entry.timestamp;
+    if (!failures.empty())
+    {
+        timestamp = std::max(timestamp, failures.back().timestamp);
+    }
+    failures.push_back({timestamp, std::hash<std::string>{}(entry.username)});
+    while (!isWithinWindow(failures.front().timestamp, timestamp))
+    {
+        failures.pop_front();
+    }
+}
+
+std::vector<SuspiciousEvent> IpFailureTracker::finish()
+{
+    open_.clear();
+
+    std::stable_sort(events_.begin(), events_.end(),
+                     [](const SuspiciousEvent& a, const SuspiciousEvent& b)
+                     {
+                         if (a.last_occurrence != b.last_occurrence)
+                         {
+                             return a.last_occurrence < b.last_occurrence;
+                         }
+                         return a.username < b.username;
+                     });
+
+    std::vector<SuspiciousEvent> events;
+    events.swap(events_);
+    return events;
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+bool IpFailureTracker::isWithinWindow(TimePoint start, TimePoint timestamp) const
+{
+    // Same rule as EventDetector::isWithinTimeWindow()
+    auto duration = (timestamp > start) ? (timestamp - start) : (start - timestamp);
+    auto minutes = std::chrono::duration_cast<std::chrono::minutes>(duration);
+    return minutes.count() <= time_window_minutes_;
+}
+
+void IpFailureTracker::report(const LogEntry& success, const std::deque<Failure>& failures)
+{
+    std::vector<std::size_t> users;
+    users.reserve(failures.size());
+    for (const auto& failure : failures)
+    {
+        users.push_back(failure.user_hash);
+    }
+    std::sort(users.begin(), users.end());
+    std::size_t user_count = static_cast<std::size_t>(
+        std::unique(users.begin(), users.end()) - users.begin());
+
+    SuspiciousEvent event(
+        SuspiciousEventType::SUCCESS_AFTER_FAILURES,
+        success.username,
+        success.ip_address,
+        failures.front().timestamp,
+        success.timestamp,
+        static_cast<int>(failures.size())
+    );
+
+    event.description = "User '" + success.username + "' logged in from IP '" +
+                        success.ip_address + "' after " + std::to_string(failures.size()) +
+                        " failed login attempts from that IP for " +
+                        std::to_string(user_count) + " users within " +
+                        std::to_string(time_window_minutes_) + " minutes";
+
+    events_.push_back(event);
+}
+
+void IpFailureTracker::expireIdle()
+{
+    for (auto it = open_.begin(); it != open_.end();)
+    {
+        if (!it->second.empty() && isWithinWindow(it->second.back().timestamp, latest_))
+        {
+            ++it;
+            continue;
+        }
+        it = open_.erase(it);
+    }
+    last_sweep_ = latest_;
+}
@@ -0,0 +1,395 @@
+#include "LogFormats.h"
+
+namespace LogFormats
+{
+
+using LogParser::LogFields;
+using LogParser::ParseError;
+
+// Status text handed to parseStatus() for formats that do not spell it out
+static constexpr std::string_view kFailedStatus = "FAILED";
+static constexpr std::string_view kSuccessStatus = "SUCCESS";
+
+/**
+ * @brief Checks whether a view starts with a prefix
+ */
+static bool startsWith(std::string_view str, std::string_view prefix)
+{
+    return str.substr(0, prefix.size()) == prefix;
+}
+
+/**
+ * @brief Sets error to EMPTY_FIELD if any located field is empty
+ *
+ * @return true if all four fields are non-empty
+ */
+static bool checkFields(const LogFields& fields, ParseError& error)
+{
+    if (fields.timestamp.empty() || fields.username.empty() ||
+        fields.ip_address.empty() || fields.status.empty())
+    {
+        error = ParseError::EMPTY_FIELD;
+        return false;
+    }
+
+    error = ParseError::NONE;
+    return true;
+}
+
+/**
+ * @brief Parses "YYYY-MM-DD HH:MM:SS" or the ISO 8601 form with a 'T'
+ *
+ * The 'T' form is rewritten into a stack buffer so both share
+ * LogParser::parseTimestamp() and its per-thread hour cache.
+ */
+static std::optional<TimePoint> parseDateTime(std::string_view text)
+{
+    if (text.size() == 19 && text[10] == 'T')
+    {
+        char canonical[19];
+        text.copy(canonical, sizeof(canonical));
+        canonical[10] = ' ';
+        return LogParser::parseTimestamp(std::string_view(canonical, sizeof(canonical)));
+    }
+
+    return LogParser::parseTimestamp(text);
+}
+
+// ============================================================================
+// Format Selection
+// ============================================================================
+
+std::optional<InputFormat> parseInputFormat(std::string_view name)
+{
+    if (LogParser::equalsIgnoreCase(name, "PIPE"))
+    {
+        return InputFormat::PIPE;
+    }
+    if (LogParser::equalsIgnoreCase(name, "SYSLOG"))
+    {
+        return InputFormat::SYSLOG;
+    }
+    if (LogParser::equalsIgnoreCase(name, "JSON"))
+    {
+        return InputFormat::JSON;
+    }
+    if (LogParser::equalsIgnoreCase(name, "CSV"))
+    {
+        return InputFormat::CSV;
+    }
+    return std::nullopt;
+}
+
+const char* inputFormatName(InputFormat format)
+{
+    switch (format)
+    {
+        case InputFormat::PIPE:    return "pipe";
+        case InputFormat::SYSLOG:  return "syslog";
+        case InputFormat::JSON:    return "json";
+        case InputFormat::CSV:     return "csv";
+        case InputFormat::PATTERN: return "pattern";
+    }
+    return "unknown";
+}
+
+// ============================================================================
+// PipeFormat
+// ============================================================================
+
+bool PipeFormat::locate(std::string_view line, LogFields& fields, ParseError& error) const
+{
+    auto fields_opt = LogParser::locateFields(line, error);
+    if (!fields_opt.has_value())
+    {
+        return false;
+    }
+
+    fields = fields_opt.value();
+    return true;
+}
+
+std::optional<TimePoint> PipeFormat::parseTimestamp(std::string_view text) const
+{
+    return LogParser::parseTimestamp(text);
+}
+
+// ============================================================================
+// SyslogFormat
+// ============================================================================
+
+bool SyslogFormat::locate(std::string_view line, LogFields& fields, ParseError& error) const
+{
+    // Header: "Mmm dd HH:MM:SS host program[pid]: message"
+    error = ParseError::FIELD_COUNT;
+    if (line.size() < 16 || line[15] != ' ')
+    {
+        return false;
+    }
+
+    std::string_view rest = line.substr(16);
+    size_t host_end = rest.find(' ');
+    if (host_end == std::string_view::npos)
+    {
+        return false;
+    }
+
+    rest = rest.substr(host_end + 1);
+    size_t program_end = rest.find(": ");
+    if (program_end == std::string_view::npos)
+    {
+        return false;
+    }
+
+    // Only sshd authentication results are login events; skip the rest
+    error = ParseError::NONE;
+    std::string_view program = rest.substr(0, program_end);
+    if (!startsWith(program, "sshd") || (program.size() > 4 && program[4] != '['))
+    {
+        return false;
+    }
+
+    std::string_view message = rest.substr(program_end + 2);
+    if (startsWith(message, "Failed "))
+    {
+        fields.status = kFailedStatus;
+    }
+    else if (startsWith(message, "Accepted "))
+    {
+        fields.status = kSuccessStatus;
+    }
+    else
+    {
+        return false;
+    }
+
+    // "... for [invalid user ]<user> from <ip>[ port <n> ...]"
+    error = ParseError::FIELD_COUNT;
+    size_t for_pos = message.find(" for ");
+    if (for_pos == std::string_view::npos)
+    {
+        return false;
+    }
+
+    std::string_view user = message.substr(for_pos + 5);
+    if (startsWith(user, "invalid user "))
+    {
+        user = user.substr(13);
+    }
+
+    size_t from_pos = user.find(" from ");
+    if (from_pos == std::string_view::npos)
+    {
+        return false;
+    }
+
+    std::string_view ip = user.substr(from_pos + 6);
+    fields.username = user.substr(0, from_pos);
+    fields.ip_address = ip.substr(0, ip.find(' '));
+    fields.timestamp = line.substr(0, 15);
+
+    return checkFields(fields, error);
+}
+
+std::optional<TimePoint> SyslogFormat::parseTimestamp(std::string_view text) const
+{
+    // "Mmm dd HH:MM:SS" with a space-padded day, e.g. "Jan  8 08:45:12"
+    static constexpr std::string_view kMonths = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+    if (text.size() != 15 || text[3] != ' ' || text[6] != ' ' || year < 0 || year > 9999)
+    {
+        return std::nullopt;
+    }
+
+    size_t month_index = kMonths.find(text.substr(0, 3));
+    if (month_index == std::string_view::npos || month_index % 3 != 0)
+    {
+        return std::nullopt;
+    }
+    int month = static_cast<int>(month_index / 3) + 1;
+
+    // Months after the last written one are from before the rollover
+    int entry_year = (month > last_month && year > 0) ? year - 1 : year;
+
+    // Rewrite as "YYYY-MM-DD HH:MM:SS" and reuse the cached conversion
+    char canonical[19];
+    canonical[0] = static_cast<char>('0' + entry_year / 1000);
+    canonical[1] = static_cast<char>('0' + entry_year / 100 % 10);
+    canonical[2] = static_cast<char>('0' + entry_year / 10 % 10);
+    canonical[3] = static_cast<char>('0' + entry_year % 10);
+    canonical[4] = '-';
+    canonical[5] = static_cast<char>('0' + month / 10);
+    canonical[6] = static_cast<char>('0' + month % 10);
+    canonical[7] = '-';
+    canonical[8] = (text[4] == ' ') ? '0' : text[4];
+    canonical[9] = text[5];
+    text.substr(6).copy(canonical + 10, 9);
+
+    return LogParser::parseTimestamp(std::string_view(canonical, sizeof(canonical)));
+}
+
+// ============================================================================
+// JsonFormat
+// ============================================================================
+
+/**
+ * @brief Finds the string value of a key in a flat JSON object
+ *
+ * @param object The JSON text
+ * @param key The key without quotes
+ * @param value Receives a view of the value without quotes
+ * @return true if the key was found with a plain (unescaped) string value
+ */
+static bool findJsonString(std::string_view object, std::string_view key, std::string_view& value)
+{
+    size_t pos = 0;
+    while ((pos = object.find(key, pos)) != std::string_view::npos)
+    {
+        size_t end = pos + key.size();
+        bool quoted = pos > 0 && object[pos - 1] == '"' &&
+                      end < object.size() && object[end] == '"';
+        pos = end;
+        if (!quoted)
+        {
+            continue;
+        }
+
+        // Skip to the value: optional spaces, ':', optional spaces, '"'
+        std::string_view rest = LogParser::trim(object.substr(end + 1));
+        if (rest.empty() || rest[0] != ':')
+        {
+            continue;
+        }
+        rest = LogParser::trim(rest.substr(1));
+        if (rest.empty() || rest[0] != '"')
+        {
+            return false;
+        }
+
+        size_t close = rest.find('"', 1);
+        if (close == std::string_view::npos)
+        {
+            return false;
+        }
+
+        value = rest.substr(1, close - 1);
+        return value.find('\\') == std::string_view::npos;
+    }
+
+    return false;
+}
+
+bool JsonFormat::locate(std::string_view line, LogFields& fields, ParseError& error) const
+{
+    error = ParseError::FIELD_COUNT;
+
+    std::string_view object = LogParser::trim(line);
+    if (object.size() < 2 || object.front() != '{' || object.back() != '}')
+    {
+        return false;
+    }
+
+    if (!findJsonString(object, "timestamp", fields.timestamp) ||
+        (!findJsonString(object, "user", fields.username) &&
+         !findJsonString(object, "username", fields.username)) ||
+        (!findJsonString(object, "ip", fields.ip_address) &&
+         !findJsonString(object, "ip_address", fields.ip_address)) ||
+        !findJsonString(object, "status", fields.status))
+    {
+        return false;
+    }
+
+    fields.timestamp = LogParser::trim(fields.timestamp);
+    fields.username = LogParser::trim(fields.username);
+    fields.ip_address = LogParser::trim(fields.ip_address);
+    fields.status = LogParser::trim(fields.status);
+
+    return checkFields(fields, error);
+}
+
+std::optional<TimePoint> JsonFormat::parseTimestamp(std::string_view text) const
+{
+    return parseDateTime(text);
+}
+
+// ============================================================================
+// CsvFormat
+// ============================================================================
+
+/**
+ * @brief Trims a CSV field and removes enclosing double quotes
+ */
+static std::string_view unquote(std::string_view field)
+{
+    field = LogParser::trim(field);
+    if (field.size() >= 2 && field.front() == '"' && field.back() == '"')
+    {
+        field = LogParser::trim(field.substr(1, field.size() - 2));
+    }
+    return field;
+}
+
+bool CsvFormat::locate(std::string_view line, LogFields& fields, ParseError& error) const
+{
+    error = ParseError::FIELD_COUNT;
+
+    size_t first_comma = line.find(',');
+    if (first_comma == std::string_view::npos)
+    {
+        return false;
+    }
+
+    size_t second_comma = line.find(',', first_comma + 1);
+    if (second_comma == std::string_view::npos)
+    {
+        return false;
+    }
+
+    size_t third_comma = line.find(',', second_comma + 1);
+    if (third_comma == std::string_view::npos ||
+        line.find(',', third_comma + 1) != std::string_view::npos)
+    {
+        return false;
+    }
+
+    fields.timestamp = unquote(line.substr(0, first_comma));
+    fields.username = unquote(line.substr(first_comma + 1, second_comma - first_comma - 1));
+    fields.ip_address = unquote(line.substr(second_comma + 1, third_comma - second_comma - 1));
+    fields.status = unquote(line.substr(third_comma + 1));
+
+    // Header row
+    if (LogParser::equalsIgnoreCase(fields.timestamp, "TIMESTAMP"))
+    {
+        error = ParseError::NONE;
+        return false;
+    }
+
+    return checkFields(fields, error);
+}
+
+std::optional<TimePoint> CsvFormat::parseTimestamp(std::string_view text) const
+{
+    return parseDateTime(text);
+}
+
+// ============================================================================
+// PatternFormat
+// ============================================================================
+
+bool PatternFormat::locate(std::string_view line, LogFields& fields, ParseError& error) const
+{
+    if (matcher == nullptr)
+    {
+        error = ParseError::FIELD_COUNT;
+        return false;
+    }
+
+    return matcher->match(line, fields, error);
+}
+
+std::optional<TimePoint> PatternFormat::parseTimestamp(std::string_view text) const
+{
+    return parseDateTime(text);
+}
+
+} // namespace LogFormats
@@ -0,0 +1,550 @@
+#include "LogLoader.h"
+#include "BoundedQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <sys/stat.h>
+
+namespace
+{
+
+// Number of chunks that may wait between two pipeline stages per worker
+constexpr std::size_t kQueueDepth = 4;
+
+/**
+ * @brief Gets the syslog format of a log last written at a point in time
+ */
+LogFormats::SyslogFormat syslogFormatAt(std::time_t time)
+{
+    std::tm* local = std::localtime(&time);
+    return LogFormats::SyslogFormat(local->tm_year + 1900, local->tm_mon + 1);
+}
+
+} // namespace
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+LogLoader::LogLoader(const LoaderOptions& options, std::ostream& warnings)
+    : options_(options),
+      warnings_(warnings),
+      statistics_(),
+      diagnostics_(options.max_error_samples),
+      pattern_matcher_(),
+      syslog_default_(options.syslog_year),
+      syslog_formats_(),
+      next_line_(1),
+      file_index_(0),
+      last_timestamp_(),
+      has_last_timestamp_(false),
+      failed_path_()
+{
+    // A zero chunk size would never make progress
+    if (options_.chunk_bytes == 0)
+    {
+        options_.chunk_bytes = LoaderOptions().chunk_bytes;
+    }
+
+    // Compile the user template once
+    if (options_.format == LogFormats::InputFormat::PATTERN)
+    {
+        std::string error_message;
+        pattern_matcher_ = PatternMatcher::compile(options_.pattern, error_message);
+        if (!pattern_matcher_.has_value())
+        {
+            warnings_ << "Error: Invalid line pattern: " << error_message << "\n";
+        }
+    }
+
+    // Syslog timestamps carry no year; without one given, a stream is
+    // assumed to end now (files use their modification time)
+    if (options_.syslog_year == 0)
+    {
+        syslog_default_ = syslogFormatAt(std::time(nullptr));
+    }
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+bool LogLoader::loadFile(const std::string& path, const BatchSink& sink)
+{
+    return loadFiles({path}, sink);
+}
+
+bool LogLoader::loadFiles(const std::vector<std::string>& paths, const BatchSink& sink)
+{
+    reset();
+
+    // Each syslog file ends in the year and month it was last written
+    if (options_.format == LogFormats::InputFormat::SYSLOG)
+    {
+        for (const auto& path : paths)
+        {
+            syslog_formats_.push_back(syslogFormatOf(path));
+        }
+    }
+
+    if (options_.prefetch && options_.reader.io_uring)
+    {
+        return loadWithRing(paths, sink);
+    }
+
+    for (file_index_ = 0; file_index_ < paths.size(); ++file_index_)
+    {
+        const std::string& path = paths[file_index_];
+        if (!options_.prefetch)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open())
+            {
+                failed_path_ = path;
+                return false;
+            }
+
+            load([&file](char* destination, std::size_t size)
+                 {
+                     file.read(destination, static_cast<std::streamsize>(size));
+                     return static_cast<std::size_t>(file.gcount());
+                 },
+                 sink);
+            if (file.bad())
+            {
+                failed_path_ = path;
+                return false;
+            }
+            continue;
+        }
+
+        // Prefetch the next block on a background thread while this one is parsed
+        AsyncFileReader reader;
+        if (!reader.open(path, options_.reader))
+        {
+            failed_path_ = path;
+            return false;
+        }
+
+        load([&reader](char* destination, std::size_t size)
+             {
+                 return reader.read(destination, size);
+             },
+             sink);
+
+        if (reader.failed())
+        {
+            failed_path_ = path;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void LogLoader::loadStream(std::istream& input, const BatchSink& sink)
+{
+    reset();
+    load([&input](char* destination, std::size_t size)
+         {
+             input.read(destination, static_cast<std::streamsize>(size));
+             return static_cast<std::size_t>(input.gcount());
+         },
+         sink);
+}
+
+const LoadStatistics& LogLoader::statistics() const
+{
+    return statistics_;
+}
+
+const ParseDiagnostics& LogLoader::diagnostics() const
+{
+    return diagnostics_;
+}
+
+const std::string& LogLoader::failedPath() const
+{
+    return failed_path_;
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+void LogLoader::reset()
+{
+    statistics_ = LoadStatistics();
+    diagnostics_ = ParseDiagnostics(options_.max_error_samples);
+    next_line_ = 1;
+    file_index_ = 0;
+    has_last_timestamp_ = false;
+    failed_path_.clear();
+    syslog_formats_.clear();
+}
+
+LogFormats::SyslogFormat LogLoader::syslogFormatOf(const std::string& path) const
+{
+    struct stat status;
+    if (options_.syslog_year != 0 || ::stat(path.c_str(), &status) != 0)
+    {
+        return syslog_default_;
+    }
+    return syslogFormatAt(status.st_mtime);
+}
+
+void LogLoader::load(const ReadFunction& read, const BatchSink& sink)
+{
+    if (options_.worker_threads == 0)
+    {
+        loadSequential(read, sink);
+    }
+    else
+    {
+        loadPipelined(read, sink);
+    }
+}
+
+bool LogLoader::loadWithRing(const std::vector<std::string>& paths, const BatchSink& sink)
+{
+    // One reader for all files keeps reads in flight across file boundaries
+    MultiFileReader reader;
+    if (!reader.open(paths, options_.reader))
+    {
+        failed_path_ = reader.failedPath();
+        return false;
+    }
+
+    file_index_ = 0;
+    while (reader.nextFile())
+    {
+        load([&reader](char* destination, std::size_t size)
+             {
+                 return reader.read(destination, size);
+             },
+             sink);
+
+        if (reader.failed())
+        {
+            failed_path_ = paths[file_index_];
+            return false;
+        }
+        file_index_++;
+    }
+
+    return true;
+}
+
+bool LogLoader::readChunk(const ReadFunction& read, std::string& carry,
+                          std::size_t& next_line, Chunk& chunk) const
+{
+    // Start with the partial line left over from the previous read
+    chunk.text = std::move(carry);
+    carry.clear();
+
+    while (true)
+    {
+        std::size_t old_size = chunk.text.size();
+        chunk.text.resize(old_size + options_.chunk_bytes);
+        std::size_t bytes_read = read(&chunk.text[old_size], options_.chunk_bytes);
+        chunk.text.resize(old_size + bytes_read);
+
+        if (bytes_read == 0)
+        {
+            // End of input: whatever is left is the final (unterminated) line
+            if (chunk.text.empty())
+            {
+                return false;
+            }
+            break;
+        }
+
+        // Cut after the last complete line and carry the rest over
+        std::size_t last_newline = chunk.text.rfind('\n');
+        if (last_newline != std::string::npos)
+        {
+            carry.assign(chunk.text, last_newline + 1, std::string::npos);
+            chunk.text.resize(last_newline + 1);
+            break;
+        }
+
+        // A single line longer than the chunk size: keep reading
+    }
+
+    chunk.first_line = next_line;
+    next_line += static_cast<std::size_t>(
+        std::count(chunk.text.begin(), chunk.text.end(), '\n'));
+    if (chunk.text.back() != '\n')
+    {
+        next_line++;
+    }
+    chunk.file = file_index_;
+
+    return true;
+}
+
+void LogLoader::parseChunk(const Chunk& chunk, ParsedChunk& parsed) const
+{
+    // Select the specialized loop once per chunk, not once per line
+    switch (options_.format)
+    {
+        case LogFormats::InputFormat::PIPE:
+            parseChunkAs(LogFormats::PipeFormat(), chunk, parsed);
+            break;
+        case LogFormats::InputFormat::SYSLOG:
+            parseChunkAs(chunk.file < syslog_formats_.size() ? syslog_formats_[chunk.file]
+                                                             : syslog_default_,
+                         chunk, parsed);
+            break;
+        case LogFormats::InputFormat::JSON:
+            parseChunkAs(LogFormats::JsonFormat(), chunk, parsed);
+            break;
+        case LogFormats::InputFormat::CSV:
+            parseChunkAs(LogFormats::CsvFormat(), chunk, parsed);
+            break;
+        case LogFormats::InputFormat::PATTERN:
+            parseChunkAs(LogFormats::PatternFormat(pattern_matcher_ ? &pattern_matcher_.value() : nullptr),
+                         chunk, parsed);
+            break;
+    }
+}
+
+template <typename Format>
+void LogLoader::parseChunkAs(const Format& format, const Chunk& chunk, ParsedChunk& parsed) const
+{
+    parsed.entries.clear();
+    parsed.statistics = LoadStatistics();
+    parsed.diagnostics = ParseDiagnostics(options_.max_error_samples);
+    parsed.warnings.clear();
+
+    std::string_view text(chunk.text);
+    std::size_t line_number = chunk.first_line;
+    std::size_t position = 0;
+
+    while (position < text.size())
+    {
+        std::size_t newline = text.find('\n', position);
+        if (newline == std::string_view::npos)
+        {
+            newline = text.size();
+        }
+
+        parseLine(format, text.substr(position, newline - position), line_number, parsed);
+
+        position = newline + 1;
+        line_number++;
+    }
+}
+
+template <typename Format>
+void LogLoader::parseLine(const Format& format, std::string_view line,
+                          std::size_t line_number, ParsedChunk& parsed) const
+{
+    parsed.statistics.lines_processed++;
+
+    // Skip empty lines
+    if (line.empty())
+    {
+        return;
+    }
+
+    // Locate the fields without building an entry yet
+    LogParser::ParseError error = LogParser::ParseError::NONE;
+    LogParser::LogFields fields;
+    bool located = format.locate(line, fields, error);
+
+    // Valid line without a login event (e.g. another syslog message)
+    if (!located && error == LogParser::ParseError::NONE)
+    {
+        parsed.statistics.skipped_lines++;
+        return;
+    }
+
+    // Apply filters on the raw fields so that irrelevant lines
+    // never pay for allocation and timestamp parsing
+    if (located && !options_.filter.matches(fields))
+    {
+        parsed.statistics.filtered_entries++;
+        return;
+    }
+
+    // Materialize the entry
+    std::optional<LogEntry> entry_opt;
+    if (located)
+    {
+        entry_opt = LogFormats::materialize(format, fields, error);
+    }
+
+    if (entry_opt.has_value() && error == LogParser::ParseError::NONE)
+    {
+        if (!parsed.entries.empty() && entry_opt->timestamp < parsed.entries.back().timestamp)
+        {
+            parsed.statistics.out_of_order_entries++;
+        }
+        parsed.entries.push_back(std::move(entry_opt.value()));
+        parsed.statistics.valid_entries++;
+        return;
+    }
+
+    // Invalid entry - aggregate and continue
+    parsed.statistics.invalid_entries++;
+    parsed.diagnostics.record(error, line_number, line);
+
+    if (options_.verbose_errors)
+    {
+        parsed.warnings += "Warning: Skipping invalid log entry at line " +
+                           std::to_string(line_number) + " (" +
+                           ParseDiagnostics::reasonToString(error) + ")\n";
+    }
+}
+
+void LogLoader::deliver(ParsedChunk& parsed, const BatchSink& sink)
+{
+    statistics_.lines_processed += parsed.statistics.lines_processed;
+    statistics_.valid_entries += parsed.statistics.valid_entries;
+    statistics_.invalid_entries += parsed.statistics.invalid_entries;
+    statistics_.filtered_entries += parsed.statistics.filtered_entries;
+    statistics_.skipped_lines += parsed.statistics.skipped_lines;
+    statistics_.out_of_order_entries += parsed.statistics.out_of_order_entries;
+
+    if (parsed.diagnostics.totalErrors() > 0)
+    {
+        diagnostics_.merge(parsed.diagnostics);
+    }
+
+    if (!parsed.warnings.empty())
+    {
+        warnings_ << parsed.warnings;
+    }
+
+    if (!parsed.entries.empty())
+    {
+        // Order inside the chunk was checked by the parser; check the seam
+        if (has_last_timestamp_ && parsed.entries.front().timestamp < last_timestamp_)
+        {
+            statistics_.out_of_order_entries++;
+        }
+        last_timestamp_ = parsed.entries.back().timestamp;
+        has_last_timestamp_ = true;
+
+        sink(parsed.entries);
+    }
+}
+
+void LogLoader::loadSequential(const ReadFunction& read, const BatchSink& sink)
+{
+    std::string carry;
+    Chunk chunk;
+    ParsedChunk parsed;
+
+    while (readChunk(read, carry, next_line_, chunk))
+    {
+        parseChunk(chunk, parsed);
+        deliver(parsed, sink);
+    }
+}
+
+void LogLoader::loadPipelined(const ReadFunction& read, const BatchSink& sink)
+{
+    const std::size_t worker_count = options_.worker_threads;
+
+    // One input and one output queue per worker keeps every queue
+    // single-producer/single-consumer and preserves input order
+    std::vector<std::unique_ptr<BoundedQueue<Chunk>>> chunk_queues;
+    std::vector<std::unique_ptr<BoundedQueue<ParsedChunk>>> parsed_queues;
+    for (std::size_t i = 0; i < worker_count; ++i)
+    {
+        chunk_queues.push_back(std::make_unique<BoundedQueue<Chunk>>(kQueueDepth));
+        parsed_queues.push_back(std::make_unique<BoundedQueue<ParsedChunk>>(kQueueDepth));
+    }
+
+    // Set when stage 3 is left early, so the reader stops reading
+    std::atomic<bool> stop_reading(false);
+
+    // Stage 1: reader distributes chunks round-robin
+    std::thread reader([&]()
+    {
+        std::string carry;
+        std::size_t worker = 0;
+        Chunk chunk;
+
+        while (!stop_reading && readChunk(read, carry, next_line_, chunk))
+        {
+            chunk_queues[worker]->push(std::move(chunk));
+            chunk = Chunk();
+            worker = (worker + 1) % worker_count;
+        }
+
+        for (auto& queue : chunk_queues)
+        {
+            queue->close();
+        }
+    });
+
+    // Stage 2: parser workers
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i < worker_count; ++i)
+    {
+        workers.emplace_back([&, i]()
+        {
+            Chunk chunk;
+            while (chunk_queues[i]->pop(chunk))
+            {
+                ParsedChunk parsed;
+                parseChunk(chunk, parsed);
+                parsed_queues[i]->push(std::move(parsed));
+            }
+            parsed_queues[i]->close();
+        });
+    }
+
+    /**
+     * @brief Joins the reader and workers when stage 3 is left
+     *
+     * If the sink throws, the reader is stopped and the chunks still in
+     * flight are drained, so every thread finishes before the exception
+     * leaves loadPipelined().
+     */
+    struct PipelineJoiner
+    {
+        std::atomic<bool>& stop_reading;                                     // Stops the reader
+        std::vector<std::unique_ptr<BoundedQueue<ParsedChunk>>>& queues;     // Parsed chunk queues
+        std::size_t& worker;                                                 // Next queue to pop
+        std::thread& reader;                                                 // Stage 1 thread
+        std::vector<std::thread>& workers;                                   // Stage 2 threads
+        bool completed;                                                      // Stage 3 finished normally
+
+        ~PipelineJoiner()
+        {
+            if (!completed)
+            {
+                stop_reading = true;
+                ParsedChunk unused;
+                while (queues[worker]->pop(unused))
+                {
+                    worker = (worker + 1) % queues.size();
+                }
+            }
+            reader.join();
+            for (auto& thread : workers)
+            {
+                thread.join();
+            }
+        }
+    };
+
+    // Stage 3: collect in the same round-robin order on this thread
+    std::size_t worker = 0;
+    PipelineJoiner joiner{stop_reading, parsed_queues, worker, reader, workers, false};
+    ParsedChunk parsed;
+    while (parsed_queues[worker]->pop(parsed))
+    {
+        // Advance first, so a throwing sink leaves the next queue to drain
+        worker = (worker + 1) % worker_count;
+        deliver(parsed, sink);
+    }
+    joiner.completed = true;
+}
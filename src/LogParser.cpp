@@ -1,34 +1,90 @@
 #include "LogParser.h"
-#include <sstream>
-#include <iomanip>
 #include <algorithm>
 #include <cctype>
+#include <ctime>
 
 namespace LogParser 
 {
 
+std::string_view trim(std::string_view str) 
+{
+    // Skip leading whitespace
+    size_t start = 0;
+    while (start < str.size() && std::isspace(static_cast<unsigned char>(str[start]))) 
+    {
+        start++;
+    }
+    
+    // Skip trailing whitespace
+    size_t end = str.size();
+    while (end > start && std::isspace(static_cast<unsigned char>(str[end - 1]))) 
+    {
+        end--;
+    }
+    
+    return str.substr(start, end - start);
+}
+
+bool equalsIgnoreCase(std::string_view str, std::string_view upper) 
+{
+    if (str.size() != upper.size()) 
+    {
+        return false;
+    }
+    
+    for (size_t i = 0; i < str.size(); ++i) 
+    {
+        if (std::toupper(static_cast<unsigned char>(str[i])) != upper[i]) 
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
 /**
- * @brief Helper function to trim whitespace from both ends of a string
+ * @brief Decodes a fixed-width run of ASCII digits
  * 
- * @param str The string to trim
- * @return A new string with leading and trailing whitespace removed
+ * @param str The string containing the digits
+ * @param pos Position of the first digit
+ * @param count Number of digits
+ * @param value Receives the decoded number
+ * @return true if every character was a digit
  */
-static std::string trim(const std::string& str) 
+static bool decodeDigits(std::string_view str, size_t pos, size_t count, int& value) 
 {
-    // Find first non-whitespace character
-    auto start = std::find_if(str.begin(), str.end(), 
-                              [](unsigned char ch) { return !std::isspace(ch); });
-    
-    // Find last non-whitespace character
-    auto end = std::find_if(str.rbegin(), str.rend(),
-                            [](unsigned char ch) { return !std::isspace(ch); }).base();
-    
-    // Return substring between first and last non-whitespace
-    return (start < end) ? std::string(start, end) : std::string();
+    value = 0;
+    for (size_t i = pos; i < pos + count; ++i) 
+    {
+        unsigned digit = static_cast<unsigned char>(str[i]) - static_cast<unsigned>('0');
+        if (digit > 9) 
+        {
+            return false;
+        }
+        value = value * 10 + static_cast<int>(digit);
+    }
+    return true;
 }
 
+/**
+ * @brief Epoch of the most recently converted "YYYY-MM-DD HH" prefix
+ * 
+ * Consecutive log lines nearly always fall into the same hour, so the
+ * expensive mktime() conversion is done once per hour and cached. The
+ * cache is thread-local so parallel parser workers never share it.
+ */
+struct HourCache 
+{
+    char prefix[13];      // "YYYY-MM-DD HH" of the cached hour
+    std::time_t epoch;    // Local time of HH:00:00
+    bool valid;           // prefix/epoch hold a successful conversion
+};
+
+static thread_local HourCache hour_cache = {};
+
 std::optional<std::chrono::system_clock::time_point> 
-parseTimestamp(const std::string& timestamp_str) 
+parseTimestamp(std::string_view timestamp_str) 
 {
     // Expected format: "YYYY-MM-DD HH:MM:SS" - exactly 19 characters
     // First validate the length to ensure complete format
@@ -47,47 +103,64 @@ parseTimestamp(const std::string& timestamp_str)
         return std::nullopt;
     }
     
-    std::tm tm = {};
-    std::istringstream ss(timestamp_str);
-    
-    // Parse the timestamp in format "YYYY-MM-DD HH:MM:SS"
-    // %Y = year, %m = month, %d = day, %H = hour, %M = minute, %S = second
-    ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
-    
-    // Check if parsing was successful
-    if (ss.fail())
+    // Minutes and seconds are decoded for every line (60 allows a leap second)
+    int minute = 0;
+    int second = 0;
+    if (!decodeDigits(timestamp_str, 14, 2, minute) || minute > 59 || 
+        !decodeDigits(timestamp_str, 17, 2, second) || second > 60) 
     {
         return std::nullopt;
     }
     
-    // Convert std::tm to time_t, then to system_clock::time_point
-    std::time_t time = std::mktime(&tm);
-    
-    // Check if mktime failed (returns -1 on error)
-    if (time == -1) 
+    // Same date and hour as the previous line: reuse its epoch
+    if (!hour_cache.valid || 
+        timestamp_str.compare(0, sizeof(hour_cache.prefix), 
+                              std::string_view(hour_cache.prefix, sizeof(hour_cache.prefix))) != 0) 
     {
-        return std::nullopt;
+        int year = 0;
+        int month = 0;
+        int day = 0;
+        int hour = 0;
+        if (!decodeDigits(timestamp_str, 0, 4, year) || 
+            !decodeDigits(timestamp_str, 5, 2, month) || month < 1 || month > 12 || 
+            !decodeDigits(timestamp_str, 8, 2, day) || day < 1 || day > 31 || 
+            !decodeDigits(timestamp_str, 11, 2, hour) || hour > 23) 
+        {
+            return std::nullopt;
+        }
+        
+        // Convert the start of the hour with the same rules as before
+        // (local time, no daylight saving adjustment)
+        std::tm tm = {};
+        tm.tm_year = year - 1900;
+        tm.tm_mon = month - 1;
+        tm.tm_mday = day;
+        tm.tm_hour = hour;
+        std::time_t epoch = std::mktime(&tm);
+        
+        // Check if mktime failed (returns -1 on error)
+        if (epoch == -1) 
+        {
+            return std::nullopt;
+        }
+        
+        std::copy(timestamp_str.begin(), timestamp_str.begin() + sizeof(hour_cache.prefix), 
+                  hour_cache.prefix);
+        hour_cache.epoch = epoch;
+        hour_cache.valid = true;
     }
     
-    return std::chrono::system_clock::from_time_t(time);
+    return std::chrono::system_clock::from_time_t(hour_cache.epoch + minute * 60 + second);
 }
 
-LoginStatus parseStatus(const std::string& status_str) 
+LoginStatus parseStatus(std::string_view status_str) 
 {
-    // Create a copy of the string for case-insensitive comparison
-    std::string status_upper = status_str;
-    
-    // Convert to uppercase for comparison
-    std::transform(status_upper.begin(), status_upper.end(), 
-                   status_upper.begin(),
-                   [](unsigned char c) { return std::toupper(c); });
-    
-    // Check against known status values
-    if (status_upper == "SUCCESS") 
+    // Compare case-insensitively without copying the input
+    if (equalsIgnoreCase(status_str, "SUCCESS")) 
     {
         return LoginStatus::SUCCESS;
     } 
-    else if (status_upper == "FAILED") 
+    else if (equalsIgnoreCase(status_str, "FAILED")) 
     {
         return LoginStatus::FAILED;
     } 
@@ -97,59 +170,126 @@ LoginStatus parseStatus(const std::string& status_str)
     }
 }
 
-std::optional<LogEntry> parseLogLine(const std::string& line) 
+std::optional<LogFields> locateFields(std::string_view line) 
+{
+    ParseError error = ParseError::NONE;
+    return locateFields(line, error);
+}
+
+std::optional<LogFields> locateFields(std::string_view line, ParseError& error) 
 {
-    // Use stringstream to split the line by '|' delimiter
-    std::istringstream ss(line);
-    std::string timestamp_str, username, ip_address, status_str;
-    
-    // Extract the four fields separated by '|'
     // Expected format: TIMESTAMP | USERNAME | IP | STATUS
-    if (!std::getline(ss, timestamp_str, '|')) 
-    {
-        return std::nullopt;  // Failed to read timestamp
-    }
-    if (!std::getline(ss, username, '|')) 
+    // The first three fields end at a '|'; the status runs to end of line
+    error = ParseError::FIELD_COUNT;
+    
+    size_t first_pipe = line.find('|');
+    if (first_pipe == std::string_view::npos) 
     {
-        return std::nullopt;  // Failed to read username
+        return std::nullopt;  // Failed to find end of timestamp
     }
-    if (!std::getline(ss, ip_address, '|')) 
+    
+    size_t second_pipe = line.find('|', first_pipe + 1);
+    if (second_pipe == std::string_view::npos) 
     {
-        return std::nullopt;  // Failed to read IP address
+        return std::nullopt;  // Failed to find end of username
     }
-    if (!std::getline(ss, status_str)) 
+    
+    size_t third_pipe = line.find('|', second_pipe + 1);
+    if (third_pipe == std::string_view::npos) 
     {
-        return std::nullopt;  // Failed to read status
+        return std::nullopt;  // Failed to find end of IP address
     }
     
-    // Trim whitespace from all fields
-    timestamp_str = trim(timestamp_str);
-    username = trim(username);
-    ip_address = trim(ip_address);
-    status_str = trim(status_str);
+    // Slice and trim all fields
+    LogFields fields;
+    fields.timestamp = trim(line.substr(0, first_pipe));
+    fields.username = trim(line.substr(first_pipe + 1, second_pipe - first_pipe - 1));
+    fields.ip_address = trim(line.substr(second_pipe + 1, third_pipe - second_pipe - 1));
+    fields.status = trim(line.substr(third_pipe + 1));
     
     // Validate that no field is empty after trimming
-    if (timestamp_str.empty() || username.empty() || 
-        ip_address.empty() || status_str.empty()) 
+    if (fields.timestamp.empty() || fields.username.empty() || 
+        fields.ip_address.empty() || fields.status.empty()) 
     {
+        error = ParseError::EMPTY_FIELD;
         return std::nullopt;
     }
     
+    error = ParseError::NONE;
+    return fields;
+}
+
+std::optional<LogEntry> materializeEntry(const LogFields& fields) 
+{
+    ParseError error = ParseError::NONE;
+    return materializeEntry(fields, error);
+}
+
+std::optional<LogEntry> materializeEntry(const LogFields& fields, ParseError& error) 
+{
     // Parse the timestamp
-    auto timestamp_opt = parseTimestamp(timestamp_str);
+    auto timestamp_opt = parseTimestamp(fields.timestamp);
     if (!timestamp_opt.has_value()) 
     {
+        error = ParseError::BAD_TIMESTAMP;
         return std::nullopt;  // Timestamp parsing failed
     }
     
     // Parse the status
-    LoginStatus status = parseStatus(status_str);
+    LoginStatus status = parseStatus(fields.status);
     
-    // Note: We don't reject UNKNOWN status here - we create the entry
-    // and let the caller decide how to handle it
+    // Note: We don't reject UNKNOWN status here - we create the entry,
+    // flag it, and let the caller decide how to handle it
+    error = (status == LoginStatus::UNKNOWN) ? ParseError::UNKNOWN_STATUS 
+                                             : ParseError::NONE;
     
     // Construct and return the LogEntry
-    return LogEntry(timestamp_opt.value(), username, ip_address, status);
+    return LogEntry(timestamp_opt.value(), 
+                    std::string(fields.username), 
+                    std::string(fields.ip_address), 
+                    status);
+}
+
+std::optional<LogEntry> parseLogLine(const std::string& line) 
+{
+    // Cheap step: locate the field boundaries
+    auto fields_opt = locateFields(line);
+    if (!fields_opt.has_value()) 
+    {
+        return std::nullopt;
+    }
+    
+    // Expensive step: build the entry
+    return materializeEntry(fields_opt.value());
+}
+
+// ============================================================================
+// FieldFilter
+// ============================================================================
+
+bool FieldFilter::isActive() const 
+{
+    return !username.empty() || !ip_address.empty() || status.has_value();
+}
+
+bool FieldFilter::matches(const LogFields& fields) const 
+{
+    if (!username.empty() && fields.username != username) 
+    {
+        return false;
+    }
+    
+    if (!ip_address.empty() && fields.ip_address != ip_address) 
+    {
+        return false;
+    }
+    
+    if (status.has_value() && parseStatus(fields.status) != status.value()) 
+    {
+        return false;
+    }
+    
+    return true;
 }
 
-} // namespace LogParser
\ No newline at end of file
+} // namespace LogParser
@@ -0,0 +1,314 @@
+#include "LoginHourProfiles.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LOG_ANALYZER_POSIX_IO 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+/**
+ * @brief Header in front of the profiles of a profile file
+ */
+struct ProfileHeader
+{
+    char magic[8];              // kProfileMagic
+    std::uint64_t count;        // Number of profiles that follow
+    std::uint64_t names_size;   // Size of the name block after the profiles
+};
+
+const char kProfileMagic[8] = {'L', 'A', 'H', 'O', 'U', 'R', 'S', '1'};
+
+/**
+ * @brief Splits a timestamp into the start of its local hour and its hour of the week
+ */
+std::size_t localHourOfWeek(std::time_t time, std::int64_t* hour_start)
+{
+    std::tm* tm = std::localtime(&time);
+    if (hour_start != nullptr)
+    {
+        *hour_start = static_cast<std::int64_t>(time) - tm->tm_min * 60 - tm->tm_sec;
+    }
+    return static_cast<std::size_t>(tm->tm_wday * 24 + tm->tm_hour);
+}
+
+} // namespace
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+LoginHourProfiles::LoginHourProfiles()
+    : owned_(),
+      profiles_(nullptr),
+      count_(0),
+      names_(nullptr),
+      mapping_(nullptr),
+      mapping_size_(0),
+      learned_(),
+      cached_hour_start_(std::numeric_limits<std::int64_t>::min()),
+      cached_bucket_(0)
+{
+}
+
+LoginHourProfiles::~LoginHourProfiles()
+{
+    clear();
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+bool LoginHourProfiles::load(const std::string& path)
+{
+    clear();
+
+#ifdef LOG_ANALYZER_POSIX_IO
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+    {
+        // No baseline yet: this run starts one
+        return errno == ENOENT;
+    }
+
+    struct stat info;
+    if (::fstat(descriptor, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(ProfileHeader)))
+    {
+        ::close(descriptor);
+        return false;
+    }
+
+    std::size_t size = static_cast<std::size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+
+    mapping_ = mapping;
+    mapping_size_ = size;
+    if (!attach(static_cast<const char*>(mapping), size))
+    {
+        clear();
+        return false;
+    }
+    return true;
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        return true;   // No baseline yet
+    }
+    owned_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (!attach(owned_.data(), owned_.size()))
+    {
+        clear();
+        return false;
+    }
+    return true;
+#endif
+}
+
+bool LoginHourProfiles::save(const std::string& path) const
+{
+    // Merge the baseline and the learned logins, ordered by username
+    std::map<std::string_view, Histogram> merged;
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+        Histogram& counts = merged[nameOf(profiles_[i])];
+        std::copy(profiles_[i].counts, profiles_[i].counts + kBuckets, counts.begin());
+    }
+    for (const auto& [username, learned] : learned_)
+    {
+        auto inserted = merged.try_emplace(username, Histogram{});
+        Histogram& counts = inserted.first->second;
+        for (std::size_t bucket = 0; bucket < kBuckets; ++bucket)
+        {
+            std::uint32_t room = std::numeric_limits<std::uint32_t>::max() - counts[bucket];
+            counts[bucket] += std::min(room, learned[bucket]);
+        }
+    }
+
+    std::vector<HourProfile> profiles;
+    std::string names;
+    profiles.reserve(merged.size());
+    for (auto& [username, counts] : merged)
+    {
+        HourProfile profile = {};
+        profile.name_offset = static_cast<std::uint32_t>(names.size());
+        profile.name_length = static_cast<std::uint32_t>(username.size());
+        names.append(username);
+
+        std::uint64_t total = 0;
+        for (std::uint32_t count : counts)
+        {
+            total += count;
+        }
+
+        // Old habits fade: halve profiles that have grown too large
+        while (total > kMaxProfileLogins)
+        {
+            total = 0;
+            for (std::uint32_t& count : counts)
+            {
+                count /= 2;
+                total += count;
+            }
+        }
+
+        profile.total = static_cast<std::uint32_t>(total);
+        std::copy(counts.begin(), counts.end(), profile.counts);
+        profiles.push_back(profile);
+    }
+
+    ProfileHeader header;
+    std::memcpy(header.magic, kProfileMagic, sizeof(header.magic));
+    header.count = profiles.size();
+    header.names_size = names.size();
+
+    // Write beside the target, then replace it in one step
+    std::string temporary_path = path + ".tmp";
+    {
+        std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(profiles.data()),
+                   static_cast<std::streamsize>(profiles.size() * sizeof(HourProfile)));
+        file.write(names.data(), static_cast<std::streamsize>(names.size()));
+        if (!file)
+        {
+            std::remove(temporary_path.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(temporary_path.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temporary_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+void LoginHourProfiles::add(const LogEntry& entry)
+{
+    if (entry.status != LoginStatus::SUCCESS)
+    {
+        return;
+    }
+
+    // Consecutive entries mostly fall into the same hour; convert once per hour
+    std::int64_t time = static_cast<std::int64_t>(std::chrono::system_clock::to_time_t(entry.timestamp));
+    if (time < cached_hour_start_ || time >= cached_hour_start_ + 3600)
+    {
+        cached_bucket_ = localHourOfWeek(static_cast<std::time_t>(time), &cached_hour_start_);
+    }
+
+    std::uint32_t& count = learned_[entry.username][cached_bucket_];
+    if (count < std::numeric_limits<std::uint32_t>::max())
+    {
+        count++;
+    }
+}
+
+const HourProfile* LoginHourProfiles::find(std::string_view username) const
+{
+    const HourProfile* end = profiles_ + count_;
+    const HourProfile* found = std::lower_bound(profiles_, end, username,
+                                                [this](const HourProfile& profile, std::string_view name)
+                                                {
+                                                    return nameOf(profile) < name;
+                                                });
+    if (found == end || nameOf(*found) != username)
+    {
+        return nullptr;
+    }
+    return found;
+}
+
+std::size_t LoginHourProfiles::size() const
+{
+    return count_;
+}
+
+std::size_t LoginHourProfiles::hourOfWeek(std::chrono::system_clock::time_point timestamp)
+{
+    return localHourOfWeek(std::chrono::system_clock::to_time_t(timestamp), nullptr);
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+std::string_view LoginHourProfiles::nameOf(const HourProfile& profile) const
+{
+    return std::string_view(names_ + profile.name_offset, profile.name_length);
+}
+
+bool LoginHourProfiles::attach(const char* data, std::size_t size)
+{
+    if (size < sizeof(ProfileHeader))
+    {
+        return false;
+    }
+
+    ProfileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    std::size_t body_size = size - sizeof(header);
+    if (std::memcmp(header.magic, kProfileMagic, sizeof(header.magic)) != 0 ||
+        header.count > body_size / sizeof(HourProfile) ||
+        header.names_size != body_size - header.count * sizeof(HourProfile))
+    {
+        return false;
+    }
+
+    profiles_ = reinterpret_cast<const HourProfile*>(data + sizeof(header));
+    count_ = static_cast<std::size_t>(header.count);
+    names_ = data + sizeof(header) + count_ * sizeof(HourProfile);
+
+    // Every name must lie inside the name block, in sorted order
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+        const HourProfile& profile = profiles_[i];
+        if (static_cast<std::uint64_t>(profile.name_offset) + profile.name_length > header.names_size ||
+            (i > 0 && !(nameOf(profiles_[i - 1]) < nameOf(profile))))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LoginHourProfiles::clear()
+{
+#ifdef LOG_ANALYZER_POSIX_IO
+    if (mapping_ != nullptr)
+    {
+        ::munmap(mapping_, mapping_size_);
+    }
+#endif
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    owned_.clear();
+    profiles_ = nullptr;
+    count_ = 0;
+    names_ = nullptr;
+}
@@ -0,0 +1,503 @@
+#include "MultiFileReader.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LOG_ANALYZER_POSIX_IO 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+MultiFileReader::MultiFileReader()
+    : paths_(),
+      descriptors_(),
+      direct_(),
+      buffered_(),
+      streams_(),
+      blocks_(),
+      slots_(),
+      capacity_(0),
+      current_file_(kNoFile),
+      next_block_(0),
+      consume_offset_(0),
+      holding_(false),
+      error_(false),
+      failed_path_()
+#ifdef LOG_ANALYZER_HAVE_URING
+      , ring_(),
+      ring_ready_(false),
+      queued_(0)
+#endif
+{
+}
+
+MultiFileReader::~MultiFileReader()
+{
+    close();
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+bool MultiFileReader::open(const std::vector<std::string>& paths, const ReaderOptions& options)
+{
+    close();
+    failed_path_.clear();
+    error_ = false;
+
+    // Round the block size up to the alignment required by O_DIRECT
+    capacity_ = std::max<std::size_t>(options.block_bytes, kAlignment);
+    capacity_ = (capacity_ + kAlignment - 1) / kAlignment * kAlignment;
+
+    // Open every file and split it into blocks
+    for (std::size_t file = 0; file < paths.size(); ++file)
+    {
+        const std::string& path = paths[file];
+        std::uint64_t size = 0;
+
+#ifdef LOG_ANALYZER_POSIX_IO
+        int fd = -1;
+        bool direct = false;
+#ifdef O_DIRECT
+        if (options.direct_io)
+        {
+            fd = ::open(path.c_str(), O_RDONLY | O_DIRECT);
+            direct = (fd >= 0);
+        }
+#endif
+        if (fd < 0)
+        {
+            fd = ::open(path.c_str(), O_RDONLY);
+        }
+        if (fd < 0)
+        {
+            failed_path_ = path;
+            close();
+            return false;
+        }
+        paths_.push_back(path);
+        descriptors_.push_back(fd);
+        direct_.push_back(direct);
+        buffered_.push_back(-1);
+
+        struct stat info;
+        if (::fstat(fd, &info) == 0)
+        {
+            size = static_cast<std::uint64_t>(info.st_size);
+        }
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+        if (options.sequential_hint)
+        {
+            ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        }
+#endif
+#else
+        streams_.emplace_back(path, std::ios::binary | std::ios::ate);
+        if (!streams_.back().is_open())
+        {
+            failed_path_ = path;
+            close();
+            return false;
+        }
+        size = static_cast<std::uint64_t>(streams_.back().tellg());
+#endif
+
+        for (std::uint64_t offset = 0; offset < size; offset += capacity_)
+        {
+            std::size_t length = static_cast<std::size_t>(
+                std::min<std::uint64_t>(capacity_, size - offset));
+            blocks_.push_back(Block{file, offset, length});
+        }
+    }
+
+    // Never allocate more buffers than there are blocks
+    std::size_t depth = std::max<std::size_t>(options.queue_depth, 1);
+    depth = std::min(depth, std::max<std::size_t>(blocks_.size(), 1));
+
+#ifdef LOG_ANALYZER_HAVE_URING
+    ring_ready_ = (io_uring_queue_init(static_cast<unsigned>(depth), &ring_, 0) == 0);
+#endif
+
+    slots_.resize(depth);
+    for (auto& slot : slots_)
+    {
+        slot.data = static_cast<char*>(::operator new(capacity_, std::align_val_t(kAlignment)));
+        slot.size = 0;
+        slot.block = 0;
+        slot.pending = false;
+        slot.ready = false;
+    }
+
+    // Fill the ring
+    for (std::size_t block = 0; block < blocks_.size() && block < slots_.size(); ++block)
+    {
+        startRead(slots_[block], block);
+    }
+    submitPending();
+
+    current_file_ = kNoFile;
+    next_block_ = 0;
+    consume_offset_ = 0;
+    holding_ = false;
+    return true;
+}
+
+bool MultiFileReader::nextFile()
+{
+    std::size_t file_count = std::max(descriptors_.size(), streams_.size());
+
+    if (current_file_ != kNoFile)
+    {
+        if (current_file_ >= file_count)
+        {
+            return false;
+        }
+
+        // Skip whatever the caller did not read of the current file
+        while (next_block_ < blocks_.size() && blocks_[next_block_].file == current_file_)
+        {
+            if (!holding_)
+            {
+                waitFor(slots_[next_block_ % slots_.size()]);
+                holding_ = true;
+            }
+            releaseCurrent();
+        }
+    }
+
+    current_file_ = (current_file_ == kNoFile) ? 0 : current_file_ + 1;
+    return current_file_ < file_count;
+}
+
+std::size_t MultiFileReader::read(char* destination, std::size_t size)
+{
+    std::size_t copied = 0;
+
+    while (copied < size)
+    {
+        if (!holding_)
+        {
+            // Stop at the end of the current file
+            if (next_block_ >= blocks_.size() || blocks_[next_block_].file != current_file_)
+            {
+                break;
+            }
+            if (!waitFor(slots_[next_block_ % slots_.size()]))
+            {
+                break;
+            }
+            holding_ = true;
+            consume_offset_ = 0;
+        }
+
+        const Slot& slot = slots_[next_block_ % slots_.size()];
+        std::size_t available = std::min(size - copied, slot.size - consume_offset_);
+        std::memcpy(destination + copied, slot.data + consume_offset_, available);
+        consume_offset_ += available;
+        copied += available;
+
+        if (consume_offset_ == slot.size)
+        {
+            releaseCurrent();
+        }
+    }
+
+    return copied;
+}
+
+bool MultiFileReader::failed() const
+{
+    return error_;
+}
+
+const std::string& MultiFileReader::failedPath() const
+{
+    return failed_path_;
+}
+
+void MultiFileReader::close()
+{
+#ifdef LOG_ANALYZER_HAVE_URING
+    if (ring_ready_)
+    {
+        // The kernel may still write into the buffers; wait for every read
+        submitPending();
+        for (auto& slot : slots_)
+        {
+            if (slot.pending && !slot.ready)
+            {
+                waitFor(slot);
+            }
+        }
+        io_uring_queue_exit(&ring_);
+        ring_ready_ = false;
+    }
+#endif
+
+#ifdef LOG_ANALYZER_POSIX_IO
+    for (int fd : descriptors_)
+    {
+        ::close(fd);
+    }
+    for (int fd : buffered_)
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+    }
+#endif
+    paths_.clear();
+    descriptors_.clear();
+    direct_.clear();
+    buffered_.clear();
+    streams_.clear();
+
+    for (auto& slot : slots_)
+    {
+        ::operator delete(slot.data, std::align_val_t(kAlignment));
+    }
+    slots_.clear();
+    blocks_.clear();
+
+    current_file_ = kNoFile;
+    next_block_ = 0;
+    consume_offset_ = 0;
+    holding_ = false;
+}
+
+bool MultiFileReader::usingIoUring() const
+{
+#ifdef LOG_ANALYZER_HAVE_URING
+    return ring_ready_;
+#else
+    return false;
+#endif
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+void MultiFileReader::startRead(Slot& slot, std::size_t block_index)
+{
+    slot.block = block_index;
+    slot.size = 0;
+    slot.pending = false;
+    slot.ready = false;
+
+#ifdef LOG_ANALYZER_HAVE_URING
+    if (ring_ready_)
+    {
+        const Block& block = blocks_[block_index];
+        struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+        if (sqe == nullptr)
+        {
+            // Submission queue full: flush and retry once
+            submitPending();
+            sqe = io_uring_get_sqe(&ring_);
+        }
+        if (sqe != nullptr)
+        {
+            // Request the whole (aligned) buffer so O_DIRECT reads stay aligned
+            io_uring_prep_read(sqe, descriptors_[block.file], slot.data,
+                               static_cast<unsigned>(capacity_), block.offset);
+            io_uring_sqe_set_data(sqe, &slot);
+            slot.pending = true;
+            queued_++;
+            return;
+        }
+        // No submission entry available: read synchronously in waitFor()
+    }
+#endif
+}
+
+void MultiFileReader::submitPending()
+{
+#ifdef LOG_ANALYZER_HAVE_URING
+    if (ring_ready_ && queued_ > 0)
+    {
+        int result = io_uring_submit(&ring_);
+        if (result >= 0)
+        {
+            queued_ -= std::min<std::size_t>(queued_, static_cast<std::size_t>(result));
+        }
+        else if (result != -EINTR && result != -EAGAIN && result != -EBUSY)
+        {
+            error_ = true;
+        }
+    }
+#endif
+}
+
+bool MultiFileReader::waitFor(Slot& slot)
+{
+#ifdef LOG_ANALYZER_HAVE_URING
+    if (ring_ready_ && slot.pending)
+    {
+        submitPending();
+        while (!slot.ready)
+        {
+            struct io_uring_cqe* cqe = nullptr;
+            int result = io_uring_wait_cqe(&ring_, &cqe);
+            if (result == -EINTR)
+            {
+                continue;
+            }
+            if (result < 0)
+            {
+                error_ = true;
+                return false;
+            }
+
+            Slot* done = static_cast<Slot*>(io_uring_cqe_get_data(cqe));
+            long bytes = cqe->res;
+            io_uring_cqe_seen(&ring_, cqe);
+            if (done != nullptr)
+            {
+                complete(*done, bytes);
+            }
+        }
+        return true;
+    }
+#endif
+
+    if (!slot.ready)
+    {
+        // pread backend: the block is read now, nothing was in flight
+        const Block& block = blocks_[slot.block];
+        slot.size = readAt(block.file, block.offset, slot.data, block.length);
+        slot.ready = true;
+    }
+    return true;
+}
+
+void MultiFileReader::complete(Slot& slot, long result)
+{
+    const Block& block = blocks_[slot.block];
+
+    if (result < 0)
+    {
+        // Retry synchronously; readAt() flags the error if it fails as well
+        result = 0;
+    }
+
+    slot.size = std::min(static_cast<std::size_t>(result), block.length);
+    if (slot.size < block.length)
+    {
+        // Short read: finish the block synchronously (see readAt() for O_DIRECT)
+        slot.size += readAt(block.file, block.offset + slot.size,
+                            slot.data + slot.size, block.length - slot.size);
+    }
+    slot.ready = true;
+}
+
+std::size_t MultiFileReader::readAt(std::size_t file, std::uint64_t offset,
+                                    char* data, std::size_t length)
+{
+    std::size_t filled = 0;
+
+#ifdef LOG_ANALYZER_POSIX_IO
+    while (filled < length)
+    {
+        // O_DIRECT needs an aligned offset, buffer and length: read whole
+        // units while aligned (the tail of a file ends the read early) and
+        // the rest without O_DIRECT
+        std::uint64_t position = offset + filled;
+        std::size_t wanted = length - filled;
+        int fd = descriptors_[file];
+        if (direct_[file])
+        {
+            bool aligned = position % kAlignment == 0 &&
+                           reinterpret_cast<std::uintptr_t>(data + filled) % kAlignment == 0;
+            if (aligned)
+            {
+                wanted = (wanted + kAlignment - 1) / kAlignment * kAlignment;
+            }
+            else
+            {
+                fd = bufferedDescriptor(file);
+                if (fd < 0)
+                {
+                    error_ = true;
+                    break;
+                }
+            }
+        }
+
+        ssize_t result = ::pread(fd, data + filled, wanted, static_cast<off_t>(position));
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            error_ = true;
+            break;
+        }
+        if (result == 0)
+        {
+            break;   // File shrank since it was opened
+        }
+        filled += std::min(static_cast<std::size_t>(result), length - filled);
+    }
+#else
+    std::ifstream& stream = streams_[file];
+    stream.clear();
+    stream.seekg(static_cast<std::streamoff>(offset));
+    stream.read(data, static_cast<std::streamsize>(length));
+    filled = static_cast<std::size_t>(stream.gcount());
+    if (stream.bad())
+    {
+        error_ = true;
+    }
+#endif
+
+    return filled;
+}
+
+int MultiFileReader::bufferedDescriptor(std::size_t file)
+{
+#ifdef LOG_ANALYZER_POSIX_IO
+    if (!direct_[file])
+    {
+        return descriptors_[file];
+    }
+    if (buffered_[file] < 0)
+    {
+        buffered_[file] = ::open(paths_[file].c_str(), O_RDONLY);
+    }
+    return buffered_[file];
+#else
+    (void)file;
+    return -1;
+#endif
+}
+
+void MultiFileReader::releaseCurrent()
+{
+    Slot& slot = slots_[next_block_ % slots_.size()];
+    slot.pending = false;
+    slot.ready = false;
+
+    // Reuse the buffer for the block that is queue_depth blocks ahead
+    std::size_t refill = next_block_ + slots_.size();
+    if (refill < blocks_.size())
+    {
+        startRead(slot, refill);
+        submitPending();
+    }
+
+    next_block_++;
+    consume_offset_ = 0;
+    holding_ = false;
+}
@@ -0,0 +1,129 @@
+#include "ParseDiagnostics.h"
+#include <algorithm>
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+ParseDiagnostics::ParseDiagnostics(std::size_t max_samples)
+    : max_samples_(max_samples),
+      counts_(),
+      samples_()
+{
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+void ParseDiagnostics::record(LogParser::ParseError reason,
+                              std::size_t line_number,
+                              std::string_view line)
+{
+    counts_[static_cast<std::size_t>(reason)]++;
+
+    // Only keep the first few lines as examples
+    if (samples_.size() < max_samples_)
+    {
+        std::string_view kept = line.substr(0, kMaxSampleLength);
+        std::string text(kept);
+        if (line.size() > kMaxSampleLength)
+        {
+            text += "...";
+        }
+        samples_.push_back(ParseErrorSample{line_number, reason, std::move(text)});
+    }
+}
+
+void ParseDiagnostics::merge(const ParseDiagnostics& other)
+{
+    for (std::size_t i = 0; i < kReasonCount; ++i)
+    {
+        counts_[i] += other.counts_[i];
+    }
+
+    // Keep the earliest lines overall
+    samples_.insert(samples_.end(), other.samples_.begin(), other.samples_.end());
+    std::sort(samples_.begin(), samples_.end(),
+              [](const ParseErrorSample& a, const ParseErrorSample& b)
+              {
+                  return a.line_number < b.line_number;
+              });
+
+    if (samples_.size() > max_samples_)
+    {
+        samples_.resize(max_samples_);
+    }
+}
+
+std::size_t ParseDiagnostics::count(LogParser::ParseError reason) const
+{
+    return counts_[static_cast<std::size_t>(reason)];
+}
+
+std::size_t ParseDiagnostics::totalErrors() const
+{
+    std::size_t total = 0;
+    for (std::size_t value : counts_)
+    {
+        total += value;
+    }
+    return total;
+}
+
+const std::vector<ParseErrorSample>& ParseDiagnostics::samples() const
+{
+    return samples_;
+}
+
+void ParseDiagnostics::writeSummary(std::ostream& output) const
+{
+    std::size_t total = totalErrors();
+    output << "Invalid Lines: " << total << "\n";
+
+    if (total == 0)
+    {
+        return;
+    }
+
+    // Per-reason counters (skip NONE)
+    for (std::size_t i = 1; i < kReasonCount; ++i)
+    {
+        if (counts_[i] > 0)
+        {
+            output << "  - " << reasonToString(static_cast<LogParser::ParseError>(i))
+                   << ": " << counts_[i] << "\n";
+        }
+    }
+
+    // Retained samples
+    if (!samples_.empty())
+    {
+        output << "First " << samples_.size() << " invalid line(s):\n";
+        for (const auto& sample : samples_)
+        {
+            output << "  line " << sample.line_number << " ("
+                   << reasonToString(sample.reason) << "): "
+                   << sample.line << "\n";
+        }
+    }
+}
+
+std::string ParseDiagnostics::reasonToString(LogParser::ParseError reason)
+{
+    switch (reason)
+    {
+        case LogParser::ParseError::NONE:
+            return "No error";
+        case LogParser::ParseError::FIELD_COUNT:
+            return "Wrong field count";
+        case LogParser::ParseError::EMPTY_FIELD:
+            return "Empty field";
+        case LogParser::ParseError::BAD_TIMESTAMP:
+            return "Bad timestamp";
+        case LogParser::ParseError::UNKNOWN_STATUS:
+            return "Unknown status";
+        default:
+            return "Unknown error";
+    }
+}
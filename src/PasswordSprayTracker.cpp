@@ -0,0 +1,163 @@
+#include "PasswordSprayTracker.h"
+#include <algorithm>
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+PasswordSprayTracker::PasswordSprayTracker(int time_window_minutes, int user_threshold)
+    : time_window_minutes_(time_window_minutes),
+      user_threshold_(user_threshold),
+      open_(),
+      latest_(),
+      last_sweep_(),
+      events_()
+{
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+void PasswordSprayTracker::observe(const LogEntry& entry)
+{
+    if (entry.status != LoginStatus::FAILED)
+    {
+        return;
+    }
+
+    // Entries are within the window while less than one more minute apart
+    // (see isWithinWindow())
+    const auto window_length = std::chrono::minutes(time_window_minutes_ + 1);
+
+    if (entry.timestamp > latest_)
+    {
+        latest_ = entry.timestamp;
+        if (latest_ - last_sweep_ >= window_length)
+        {
+            expireIdle();
+        }
+    }
+
+    IpWindow& window = open_.try_emplace(entry.ip_address, window_length).first->second;
+
+    // The counter needs non-decreasing times; a late entry counts as the newest
+    TimePoint timestamp = entry.timestamp;
+    if (!window.failures.empty())
+    {
+        timestamp = std::max(timestamp, window.failures.back());
+    }
+    window.usernames.add(entry.username, timestamp);
+    if (window.failures.empty() || window.failures.back() != timestamp)
+    {
+        window.failures.push_back(timestamp);
+    }
+    while (!isWithinWindow(window.failures.front(), timestamp))
+    {
+        window.failures.pop_front();
+    }
+
+    std::size_t user_count = window.usernames.estimate();
+    const std::size_t threshold = static_cast<std::size_t>(user_threshold_);
+
+    // A spray ends once the count falls below the threshold
+    if (window.spraying && user_count < threshold)
+    {
+        closeSpray(entry.ip_address, window);
+    }
+    if (user_count < threshold)
+    {
+        return;
+    }
+
+    // A spray starts at the oldest failure in the window
+    if (!window.spraying)
+    {
+        window.spraying = true;
+        window.spray_first = window.failures.front();
+        window.peak_users = 0;
+    }
+    window.spray_last = timestamp;
+    if (user_count > window.peak_users)
+    {
+        window.peak_users = user_count;
+        window.peak_exact = window.usernames.isExact();
+    }
+}
+
+std::vector<SuspiciousEvent> PasswordSprayTracker::finish()
+{
+    for (auto& [ip_address, window] : open_)
+    {
+        if (window.spraying)
+        {
+            closeSpray(ip_address, window);
+        }
+    }
+    open_.clear();
+
+    std::stable_sort(events_.begin(), events_.end(),
+                     [](const SuspiciousEvent& a, const SuspiciousEvent& b)
+                     {
+                         if (a.first_occurrence != b.first_occurrence)
+                         {
+                             return a.first_occurrence < b.first_occurrence;
+                         }
+                         return a.ip_addresses < b.ip_addresses;
+                     });
+
+    std::vector<SuspiciousEvent> events;
+    events.swap(events_);
+    return events;
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+bool PasswordSprayTracker::isWithinWindow(TimePoint start, TimePoint timestamp) const
+{
+    // Same rule as EventDetector::isWithinTimeWindow()
+    auto duration = (timestamp > start) ? (timestamp - start) : (start - timestamp);
+    auto minutes = std::chrono::duration_cast<std::chrono::minutes>(duration);
+    return minutes.count() <= time_window_minutes_;
+}
+
+void PasswordSprayTracker::closeSpray(const std::string& ip_address, IpWindow& window)
+{
+    window.spraying = false;
+
+    SuspiciousEvent event(
+        SuspiciousEventType::PASSWORD_SPRAYING,
+        "",   // Many users; the IP address identifies the event
+        ip_address,
+        window.spray_first,
+        window.spray_last,
+        static_cast<int>(window.peak_users)
+    );
+
+    event.description = "IP '" + ip_address + "' failed logins for " +
+                        std::string(window.peak_exact ? "" : "about ") +
+                        std::to_string(window.peak_users) + " different users within " +
+                        std::to_string(time_window_minutes_) + " minutes";
+
+    events_.push_back(event);
+}
+
+void PasswordSprayTracker::expireIdle()
+{
+    for (auto it = open_.begin(); it != open_.end();)
+    {
+        if (isWithinWindow(it->second.failures.back(), latest_))
+        {
+            ++it;
+            continue;
+        }
+        if (it->second.spraying)
+        {
+            closeSpray(it->first, it->second);
+        }
+        it = open_.erase(it);
+    }
+    last_sweep_ = latest_;
+}
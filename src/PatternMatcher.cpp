@@ -0,0 +1,241 @@
+#include "PatternMatcher.h"
+
+// Width of "YYYY-MM-DD HH:MM:SS"
+static constexpr std::size_t kTimestampWidth = 19;
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+std::optional<PatternMatcher> PatternMatcher::compile(std::string_view pattern,
+                                                      std::string& error_message)
+{
+    PatternMatcher matcher;
+    int counts[4] = {0, 0, 0, 0};
+    std::string literal;
+
+    // Appends a literal step for the text collected so far
+    auto flushLiteral = [&matcher, &literal]()
+    {
+        if (literal.empty())
+        {
+            return;
+        }
+
+        Step step;
+        step.is_literal = true;
+        step.field = Field::IGNORED;
+        step.literal = literal;
+
+        // KMP failure function: longest proper prefix that is also a suffix
+        step.failure.assign(literal.size(), 0);
+        int k = 0;
+        for (std::size_t i = 1; i < literal.size(); ++i)
+        {
+            while (k > 0 && literal[i] != literal[static_cast<std::size_t>(k)])
+            {
+                k = step.failure[static_cast<std::size_t>(k) - 1];
+            }
+            if (literal[i] == literal[static_cast<std::size_t>(k)])
+            {
+                k++;
+            }
+            step.failure[i] = k;
+        }
+
+        matcher.steps_.push_back(std::move(step));
+        literal.clear();
+    };
+
+    std::size_t i = 0;
+    while (i < pattern.size())
+    {
+        if (pattern[i] != '%')
+        {
+            literal += pattern[i++];
+            continue;
+        }
+
+        std::string_view rest = pattern.substr(i + 1);
+        Field field;
+        std::size_t length;
+        if (rest.substr(0, 1) == "%")
+        {
+            literal += '%';
+            i += 2;
+            continue;
+        }
+        else if (rest.substr(0, 2) == "ts")
+        {
+            field = Field::TIMESTAMP;
+            length = 2;
+        }
+        else if (rest.substr(0, 4) == "user")
+        {
+            field = Field::USERNAME;
+            length = 4;
+        }
+        else if (rest.substr(0, 2) == "ip")
+        {
+            field = Field::IP_ADDRESS;
+            length = 2;
+        }
+        else if (rest.substr(0, 6) == "status")
+        {
+            field = Field::STATUS;
+            length = 6;
+        }
+        else if (rest.substr(0, 1) == "*")
+        {
+            field = Field::IGNORED;
+            length = 1;
+        }
+        else
+        {
+            error_message = "unknown placeholder at position " + std::to_string(i);
+            return std::nullopt;
+        }
+
+        flushLiteral();
+
+        // A variable-width field needs literal text to tell where it ends
+        if (!matcher.steps_.empty() && !matcher.steps_.back().is_literal &&
+            matcher.steps_.back().field != Field::TIMESTAMP)
+        {
+            error_message = "placeholders at position " + std::to_string(i) +
+                            " must be separated by literal text";
+            return std::nullopt;
+        }
+
+        if (field != Field::IGNORED)
+        {
+            counts[static_cast<int>(field)]++;
+        }
+
+        Step step;
+        step.is_literal = false;
+        step.field = field;
+        matcher.steps_.push_back(std::move(step));
+        i += length + 1;
+    }
+    flushLiteral();
+
+    static const char* const kNames[4] = {"%ts", "%user", "%ip", "%status"};
+    for (int field = 0; field < 4; ++field)
+    {
+        if (counts[field] != 1)
+        {
+            error_message = std::string(kNames[field]) + " must appear exactly once";
+            return std::nullopt;
+        }
+    }
+
+    return matcher;
+}
+
+bool PatternMatcher::match(std::string_view line, LogParser::LogFields& fields,
+                           LogParser::ParseError& error) const
+{
+    error = LogParser::ParseError::FIELD_COUNT;
+    std::size_t position = 0;
+
+    for (std::size_t s = 0; s < steps_.size(); ++s)
+    {
+        const Step& step = steps_[s];
+
+        if (step.is_literal)
+        {
+            if (line.compare(position, step.literal.size(), step.literal) != 0)
+            {
+                return false;
+            }
+            position += step.literal.size();
+            continue;
+        }
+
+        // Determine where the field ends
+        std::size_t end;
+        std::size_t next = position;
+        if (step.field == Field::TIMESTAMP)
+        {
+            end = position + kTimestampWidth;
+            if (end > line.size())
+            {
+                return false;
+            }
+            next = end;
+        }
+        else if (s + 1 < steps_.size())
+        {
+            // The following step is a literal: search for it and consume it
+            const Step& terminator = steps_[s + 1];
+            end = find(terminator, line, position);
+            if (end == std::string_view::npos)
+            {
+                return false;
+            }
+            next = end + terminator.literal.size();
+            s++;
+        }
+        else
+        {
+            end = line.size();
+            next = end;
+        }
+
+        std::string_view value = LogParser::trim(line.substr(position, end - position));
+        switch (step.field)
+        {
+            case Field::TIMESTAMP:  fields.timestamp = value; break;
+            case Field::USERNAME:   fields.username = value; break;
+            case Field::IP_ADDRESS: fields.ip_address = value; break;
+            case Field::STATUS:     fields.status = value; break;
+            case Field::IGNORED:    break;
+        }
+        position = next;
+    }
+
+    // Trailing text after the last literal does not match
+    if (!LogParser::trim(line.substr(position)).empty())
+    {
+        return false;
+    }
+
+    if (fields.timestamp.empty() || fields.username.empty() ||
+        fields.ip_address.empty() || fields.status.empty())
+    {
+        error = LogParser::ParseError::EMPTY_FIELD;
+        return false;
+    }
+
+    error = LogParser::ParseError::NONE;
+    return true;
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+std::size_t PatternMatcher::find(const Step& step, std::string_view line, std::size_t position)
+{
+    const std::string& literal = step.literal;
+    std::size_t matched = 0;
+
+    for (std::size_t i = position; i < line.size(); ++i)
+    {
+        while (matched > 0 && line[i] != literal[matched])
+        {
+            matched = static_cast<std::size_t>(step.failure[matched - 1]);
+        }
+        if (line[i] == literal[matched])
+        {
+            matched++;
+        }
+        if (matched == literal.size())
+        {
+            return i + 1 - literal.size();
+        }
+    }
+
+    return std::string_view::npos;
+}
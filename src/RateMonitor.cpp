@@ -0,0 +1,147 @@
+#include "RateMonitor.h"
+#include <algorithm>
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+RateMonitor::RateMonitor(std::size_t tracked_keys, double z_threshold)
+    : tracked_keys_(tracked_keys),
+      z_threshold_(z_threshold),
+      global_(z_threshold),
+      ips_(),
+      users_()
+{
+    ips_.positions.reserve(tracked_keys);
+    users_.positions.reserve(tracked_keys);
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+void RateMonitor::add(const LogEntry& entry)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    std::int64_t minute = RateSeries::minuteOf(entry.timestamp);
+    bool failed = entry.status == LoginStatus::FAILED;
+
+    global_.add(minute, failed);
+    addToTable(ips_, entry.ip_address, minute, failed);
+    addToTable(users_, entry.username, minute, failed);
+}
+
+void RateMonitor::finish()
+{
+    global_.finish();
+    for (KeyTable* table : {&ips_, &users_})
+    {
+        for (RateSeries& series : table->series)
+        {
+            series.finish();
+        }
+    }
+}
+
+bool RateMonitor::isEnabled() const
+{
+    return z_threshold_ > 0.0;
+}
+
+const RateSeries& RateMonitor::global() const
+{
+    return global_;
+}
+
+std::vector<KeyRateSpike> RateMonitor::ipSpikes() const
+{
+    return collectSpikes(ips_);
+}
+
+std::vector<KeyRateSpike> RateMonitor::userSpikes() const
+{
+    return collectSpikes(users_);
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+void RateMonitor::addToTable(KeyTable& table, const std::string& key, std::int64_t minute, bool failed)
+{
+    auto found = table.positions.find(key);
+    if (found != table.positions.end())
+    {
+        table.series[found->second].add(minute, failed);
+        if (failed)
+        {
+            table.weights[found->second]++;
+        }
+        return;
+    }
+
+    // Only failing keys are followed
+    if (!failed || tracked_keys_ == 0)
+    {
+        return;
+    }
+
+    if (table.keys.size() < tracked_keys_)
+    {
+        table.positions.emplace(key, table.keys.size());
+        table.keys.push_back(key);
+        table.series.emplace_back(z_threshold_);
+        table.weights.push_back(1);
+        table.series.back().add(minute, failed);
+        return;
+    }
+
+    // Take the place of the key with the smallest count
+    std::size_t weakest = static_cast<std::size_t>(
+        std::min_element(table.weights.begin(), table.weights.end()) - table.weights.begin());
+    RateSeries& series = table.series[weakest];
+
+    // Keep the windows of the displaced key; too few failures cannot have any
+    if (series.failures() >= RateSeries::kMinSpikeFailures)
+    {
+        series.finish();
+        for (const RateSpike& spike : series.spikes())
+        {
+            table.displaced_spikes.push_back(KeyRateSpike{table.keys[weakest], spike});
+        }
+    }
+    series.reset();
+
+    table.positions.erase(table.keys[weakest]);
+    table.keys[weakest] = key;
+    table.positions.emplace(key, weakest);
+    table.weights[weakest]++;
+    series.add(minute, failed);
+}
+
+std::vector<KeyRateSpike> RateMonitor::collectSpikes(const KeyTable& table)
+{
+    std::vector<KeyRateSpike> spikes = table.displaced_spikes;
+    for (std::size_t i = 0; i < table.keys.size(); ++i)
+    {
+        for (const RateSpike& spike : table.series[i].spikes())
+        {
+            spikes.push_back(KeyRateSpike{table.keys[i], spike});
+        }
+    }
+
+    std::sort(spikes.begin(), spikes.end(),
+              [](const KeyRateSpike& a, const KeyRateSpike& b)
+              {
+                  if (a.spike.first_minute != b.spike.first_minute)
+                  {
+                      return a.spike.first_minute < b.spike.first_minute;
+                  }
+                  return a.key < b.key;
+              });
+    return spikes;
+}
@@ -0,0 +1,221 @@
+#include "RateSeries.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+/**
+ * @brief Gets the ring slot of a minute (also for minutes before the epoch)
+ */
+std::size_t slotOf(std::int64_t minute)
+{
+    const std::int64_t ring = static_cast<std::int64_t>(RateSeries::kRingMinutes);
+    return static_cast<std::size_t>(((minute % ring) + ring) % ring);
+}
+
+} // namespace
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+RateSeries::RateSeries(double z_threshold)
+    : ring_(),
+      z_threshold_(z_threshold),
+      started_(false),
+      open_from_(0),
+      newest_minute_(0),
+      closed_minutes_(0),
+      mean_(0.0),
+      variance_(0.0),
+      in_spike_(false),
+      current_(),
+      spikes_(),
+      failures_(0),
+      late_entries_(0)
+{
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+bool RateSeries::add(std::int64_t minute, bool failed)
+{
+    if (!started_)
+    {
+        started_ = true;
+        open_from_ = minute;
+        newest_minute_ = minute;
+    }
+    else if (minute > newest_minute_)
+    {
+        advanceTo(minute);
+    }
+
+    if (minute < open_from_)
+    {
+        // Before anything was closed, the window can still grow backwards
+        const std::int64_t ring = static_cast<std::int64_t>(kRingMinutes);
+        if (closed_minutes_ > 0 || minute <= newest_minute_ - ring)
+        {
+            late_entries_++;
+            return false;
+        }
+        open_from_ = minute;
+    }
+
+    MinuteCount& slot = ring_[slotOf(minute)];
+    if (failed)
+    {
+        slot.failures++;
+        failures_++;
+    }
+    else
+    {
+        slot.successes++;
+    }
+    return true;
+}
+
+void RateSeries::finish()
+{
+    if (!started_)
+    {
+        return;
+    }
+
+    for (std::int64_t minute = open_from_; minute <= newest_minute_; ++minute)
+    {
+        MinuteCount& slot = ring_[slotOf(minute)];
+        closeMinute(minute, slot);
+        slot = MinuteCount{0, 0};
+    }
+    open_from_ = newest_minute_ + 1;
+
+    if (in_spike_)
+    {
+        spikes_.push_back(current_);
+        in_spike_ = false;
+    }
+}
+
+void RateSeries::reset()
+{
+    if (started_)
+    {
+        for (std::int64_t minute = open_from_; minute <= newest_minute_; ++minute)
+        {
+            ring_[slotOf(minute)] = MinuteCount{0, 0};
+        }
+    }
+
+    started_ = false;
+    open_from_ = 0;
+    newest_minute_ = 0;
+    closed_minutes_ = 0;
+    mean_ = 0.0;
+    variance_ = 0.0;
+    in_spike_ = false;
+    spikes_.clear();
+    failures_ = 0;
+    late_entries_ = 0;
+}
+
+const std::vector<RateSpike>& RateSeries::spikes() const
+{
+    return spikes_;
+}
+
+std::uint64_t RateSeries::failures() const
+{
+    return failures_;
+}
+
+std::uint64_t RateSeries::lateEntries() const
+{
+    return late_entries_;
+}
+
+std::int64_t RateSeries::minuteOf(std::chrono::system_clock::time_point timestamp)
+{
+    return std::chrono::floor<std::chrono::minutes>(timestamp.time_since_epoch()).count();
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+void RateSeries::advanceTo(std::int64_t minute)
+{
+    const std::int64_t ring = static_cast<std::int64_t>(kRingMinutes);
+    const std::int64_t new_open_from = minute - ring + 1;
+
+    // Close the counted minutes that leave the ring
+    const std::int64_t close_end = std::min(newest_minute_, new_open_from - 1);
+    for (std::int64_t closing = open_from_; closing <= close_end; ++closing)
+    {
+        MinuteCount& slot = ring_[slotOf(closing)];
+        closeMinute(closing, slot);
+        slot = MinuteCount{0, 0};
+    }
+
+    // Minutes without logins between the old newest minute and the new window
+    const std::int64_t first_empty = std::max(open_from_, newest_minute_ + 1);
+    const std::int64_t empty_minutes = std::min(new_open_from - first_empty, kMaxIdleMinutes);
+    for (std::int64_t i = 0; i < empty_minutes; ++i)
+    {
+        closeMinute(first_empty + i, MinuteCount{0, 0});
+    }
+
+    open_from_ = std::max(open_from_, new_open_from);
+    newest_minute_ = minute;
+}
+
+void RateSeries::closeMinute(std::int64_t minute, const MinuteCount& count)
+{
+    const double failures = static_cast<double>(count.failures);
+
+    // Compare with the minutes before, then let this minute into the average
+    bool spike = false;
+    double score = 0.0;
+    if (closed_minutes_ >= kWarmupMinutes)
+    {
+        score = (failures - mean_) / std::max(std::sqrt(variance_), 1.0);
+        spike = count.failures >= kMinSpikeFailures && score >= z_threshold_;
+    }
+
+    if (spike)
+    {
+        if (!in_spike_)
+        {
+            in_spike_ = true;
+            current_ = RateSpike{minute, minute, 0, 0, 0, mean_, 0.0};
+        }
+        current_.last_minute = minute;
+        current_.failures += count.failures;
+        current_.successes += count.successes;
+        current_.peak_failures = std::max(current_.peak_failures, count.failures);
+        current_.peak_score = std::max(current_.peak_score, score);
+    }
+    else if (in_spike_)
+    {
+        spikes_.push_back(current_);
+        in_spike_ = false;
+    }
+
+    if (closed_minutes_ == 0)
+    {
+        mean_ = failures;
+        variance_ = 0.0;
+    }
+    else
+    {
+        double difference = failures - mean_;
+        double increment = kSmoothing * difference;
+        mean_ += increment;
+        variance_ = (1.0 - kSmoothing) * (variance_ + difference * increment);
+    }
+    closed_minutes_++;
+}
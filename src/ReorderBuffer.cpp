@@ -0,0 +1,87 @@
+#include "ReorderBuffer.h"
+#include <algorithm>
+#include <utility>
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+ReorderBuffer::ReorderBuffer(std::chrono::seconds lateness)
+    : lateness_(std::chrono::duration_cast<std::chrono::system_clock::duration>(lateness)),
+      heap_(),
+      watermark_(),
+      has_watermark_(false),
+      next_sequence_(0),
+      late_entries_(0),
+      peak_size_(0)
+{
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+void ReorderBuffer::push(LogEntry&& entry, std::vector<LogEntry>& released)
+{
+    // Entries below the watermark would follow later ones that were
+    // already released
+    if (has_watermark_ && entry.timestamp < watermark_)
+    {
+        late_entries_++;
+        return;
+    }
+
+    auto candidate = entry.timestamp - lateness_;
+    if (!has_watermark_ || candidate > watermark_)
+    {
+        watermark_ = candidate;
+        has_watermark_ = true;
+    }
+
+    heap_.push_back(Pending{std::move(entry), next_sequence_++});
+    std::push_heap(heap_.begin(), heap_.end(), isLater);
+    peak_size_ = std::max(peak_size_, heap_.size());
+
+    while (!heap_.empty() && heap_.front().entry.timestamp <= watermark_)
+    {
+        releaseOldest(released);
+    }
+}
+
+void ReorderBuffer::flush(std::vector<LogEntry>& released)
+{
+    while (!heap_.empty())
+    {
+        releaseOldest(released);
+    }
+}
+
+std::size_t ReorderBuffer::lateEntries() const
+{
+    return late_entries_;
+}
+
+std::size_t ReorderBuffer::peakSize() const
+{
+    return peak_size_;
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+bool ReorderBuffer::isLater(const Pending& a, const Pending& b)
+{
+    if (a.entry.timestamp != b.entry.timestamp)
+    {
+        return a.entry.timestamp > b.entry.timestamp;
+    }
+    return a.sequence > b.sequence;
+}
+
+void ReorderBuffer::releaseOldest(std::vector<LogEntry>& released)
+{
+    std::pop_heap(heap_.begin(), heap_.end(), isLater);
+    released.push_back(std::move(heap_.back().entry));
+    heap_.pop_back();
+}
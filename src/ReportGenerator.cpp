@@ -1,14 +1,21 @@
 #include "ReportGenerator.h"
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <sstream>
 #include <ctime>
+#include <utility>
 
 // ============================================================================
 // Constructor
 // ============================================================================
 
 ReportGenerator::ReportGenerator()
+    : parse_diagnostics_(nullptr),
+      top_activity_(nullptr),
+      rate_monitor_(nullptr),
+      risk_scorer_(nullptr),
+      threshold_sweep_(nullptr)
 {
 }
 
@@ -20,12 +27,42 @@ void ReportGenerator::generateReport(
     const std::vector<LogEntry>& log_entries,
     const std::vector<SuspiciousEvent>& suspicious_events,
     std::ostream& output) const
+{
+    // Count successful and failed logins
+    ReportTotals totals;
+    for (const auto& entry : log_entries) 
+    {
+        totals.add(entry);
+    }
+    
+    generateReport(totals, suspicious_events, output);
+}
+
+void ReportGenerator::generateReport(
+    const ReportTotals& totals,
+    const std::vector<SuspiciousEvent>& suspicious_events,
+    std::ostream& output) const
 {
     // Generate report header
     generateHeader(output);
     
     // Generate summary statistics
-    generateSummary(log_entries, suspicious_events, output);
+    generateSummary(totals, suspicious_events, output);
+    
+    // Generate risk scores (only if attached)
+    generateRiskScores(output);
+    
+    // Generate top activity rankings (only if attached)
+    generateTopActivity(output);
+    
+    // Generate rate spikes (only if attached)
+    generateRateSpikes(output);
+    
+    // Generate threshold sweep (only if attached)
+    generateThresholdSweep(output);
+    
+    // Generate parse diagnostics (only if attached)
+    generateParseDiagnostics(output);
     
     // Generate detailed anomalies section
     generateAnomaliesDetails(suspicious_events, output);
@@ -57,6 +94,48 @@ bool ReportGenerator::generateReportToFile(
     return true;
 }
 
+bool ReportGenerator::generateReportToFile(
+    const ReportTotals& totals,
+    const std::vector<SuspiciousEvent>& suspicious_events,
+    const std::string& output_filepath) const
+{
+    std::ofstream file(output_filepath);
+    if (!file.is_open()) 
+    {
+        return false;
+    }
+    
+    generateReport(totals, suspicious_events, file);
+    file.close();
+    
+    return true;
+}
+
+void ReportGenerator::setParseDiagnostics(const ParseDiagnostics* diagnostics)
+{
+    parse_diagnostics_ = diagnostics;
+}
+
+void ReportGenerator::setTopActivity(const TopActivity* top_activity)
+{
+    top_activity_ = top_activity;
+}
+
+void ReportGenerator::setRateMonitor(const RateMonitor* rate_monitor)
+{
+    rate_monitor_ = rate_monitor;
+}
+
+void ReportGenerator::setRiskScorer(const RiskScorer* risk_scorer)
+{
+    risk_scorer_ = risk_scorer;
+}
+
+void ReportGenerator::setThresholdSweep(const ThresholdSweep* sweep)
+{
+    threshold_sweep_ = sweep;
+}
+
 // ============================================================================
 // Private Helper Methods
 // ============================================================================
@@ -74,7 +153,7 @@ void ReportGenerator::generateHeader(std::ostream& output) const
 }
 
 void ReportGenerator::generateSummary(
-    const std::vector<LogEntry>& log_entries,
+    const ReportTotals& totals,
     const std::vector<SuspiciousEvent>& suspicious_events,
     std::ostream& output) const
 {
@@ -82,35 +161,198 @@ void ReportGenerator::generateSummary(
     output << "----------------------------------------\n";
     
     // Handle empty log case
-    if (log_entries.empty()) 
+    if (totals.total_entries == 0) 
     {
         output << "WARNING: No log entries were processed.\n";
         output << "The log file may be empty or invalid.\n\n";
         return;
     }
     
-    // Count successful and failed logins
-    int total_entries = static_cast<int>(log_entries.size());
-    int successful_logins = 0;
-    int failed_logins = 0;
+    // Output statistics
+    output << "Total Log Entries: " << totals.total_entries << "\n";
+    output << "Successful Logins: " << totals.successful_logins << "\n";
+    output << "Failed Logins: " << totals.failed_logins << "\n";
+    if (totals.late_entries > 0) 
+    {
+        output << "Late Entries Skipped: " << totals.late_entries << "\n";
+    }
+    output << "Suspicious Events Detected: " << suspicious_events.size() << "\n";
     
-    for (const auto& entry : log_entries) 
+    // Events per rule profile, in report order
+    std::vector<std::pair<std::string, std::size_t>> profile_counts;
+    for (const auto& event : suspicious_events) 
     {
-        if (entry.status == LoginStatus::SUCCESS) 
+        if (event.profile.empty()) 
         {
-            successful_logins++;
-        } 
-        else if (entry.status == LoginStatus::FAILED) 
+            continue;
+        }
+        if (profile_counts.empty() || profile_counts.back().first != event.profile) 
         {
-            failed_logins++;
+            profile_counts.emplace_back(event.profile, 0);
         }
+        profile_counts.back().second++;
+    }
+    for (const auto& [profile, count] : profile_counts) 
+    {
+        output << "  Profile '" << profile << "': " << count << "\n";
+    }
+    output << "\n";
+}
+
+void ReportGenerator::generateRiskScores(std::ostream& output) const
+{
+    if (risk_scorer_ == nullptr || !risk_scorer_->isEnabled()) 
+    {
+        return;
     }
     
-    // Output statistics
-    output << "Total Log Entries: " << total_entries << "\n";
-    output << "Successful Logins: " << successful_logins << "\n";
-    output << "Failed Logins: " << failed_logins << "\n";
-    output << "Suspicious Events Detected: " << suspicious_events.size() << "\n";
+    output << "RISK SCORES\n";
+    output << "----------------------------------------\n";
+    writeRiskRanking("Riskiest users (of " + std::to_string(risk_scorer_->userCount()) + " scored):",
+                     risk_scorer_->topUsers(), output);
+    writeRiskRanking("Riskiest IP addresses (of " + std::to_string(risk_scorer_->ipCount()) + " scored):",
+                     risk_scorer_->topIps(), output);
+    output << "\n";
+}
+
+void ReportGenerator::writeRiskRanking(const std::string& title,
+                                       const std::vector<RiskScore>& scores,
+                                       std::ostream& output) const
+{
+    output << title << "\n";
+    if (scores.empty()) 
+    {
+        output << "  (none)\n";
+        return;
+    }
+    
+    std::size_t rank = 1;
+    for (const auto& score : scores) 
+    {
+        output << "  " << rank++ << ". " << score.key << ": " 
+               << std::fixed << std::setprecision(1) << score.score 
+               << std::defaultfloat << std::setprecision(6) 
+               << " (" << score.events << (score.events == 1 ? " event" : " events") 
+               << ", last " << formatTimestamp(score.last_event) << ")\n";
+        
+        // Events per type, in enum order
+        output << "     ";
+        const char* separator = "";
+        for (std::size_t type = 0; type < score.events_by_type.size(); ++type) 
+        {
+            if (score.events_by_type[type] == 0) 
+            {
+                continue;
+            }
+            output << separator << eventTypeToString(static_cast<SuspiciousEventType>(type)) 
+                   << " x" << score.events_by_type[type];
+            separator = ", ";
+        }
+        output << "\n";
+    }
+}
+
+void ReportGenerator::generateTopActivity(std::ostream& output) const
+{
+    if (top_activity_ == nullptr || !top_activity_->isEnabled()) 
+    {
+        return;
+    }
+    
+    output << "TOP ACTIVITY\n";
+    output << "----------------------------------------\n";
+    top_activity_->writeSummary(output);
+    output << "\n";
+}
+
+void ReportGenerator::generateRateSpikes(std::ostream& output) const
+{
+    if (rate_monitor_ == nullptr || !rate_monitor_->isEnabled()) 
+    {
+        return;
+    }
+    
+    output << "RATE SPIKES\n";
+    output << "----------------------------------------\n";
+    
+    std::vector<KeyRateSpike> global_spikes;
+    for (const RateSpike& spike : rate_monitor_->global().spikes()) 
+    {
+        global_spikes.push_back(KeyRateSpike{"", spike});
+    }
+    writeSpikeList("Failed logins per minute, all entries:", global_spikes, output);
+    writeSpikeList("Failed logins per minute, by IP address:", rate_monitor_->ipSpikes(), output);
+    writeSpikeList("Failed logins per minute, by username:", rate_monitor_->userSpikes(), output);
+    
+    if (rate_monitor_->global().lateEntries() > 0) 
+    {
+        output << "Entries too far out of order to count: " 
+               << rate_monitor_->global().lateEntries() << "\n";
+    }
+    output << "\n";
+}
+
+void ReportGenerator::writeSpikeList(const std::string& title,
+                                     const std::vector<KeyRateSpike>& spikes,
+                                     std::ostream& output) const
+{
+    output << title << "\n";
+    if (spikes.empty()) 
+    {
+        output << "  (no spikes)\n";
+        return;
+    }
+    
+    std::size_t listed = std::min(spikes.size(), RateMonitor::kMaxReportedSpikes);
+    for (std::size_t i = 0; i < listed; ++i) 
+    {
+        const KeyRateSpike& entry = spikes[i];
+        const RateSpike& spike = entry.spike;
+        auto start = std::chrono::system_clock::time_point(std::chrono::minutes(spike.first_minute));
+        auto end = std::chrono::system_clock::time_point(std::chrono::minutes(spike.last_minute + 1));
+        
+        output << "  ";
+        if (!entry.key.empty()) 
+        {
+            output << entry.key << ": ";
+        }
+        output << formatTimestamp(start) << " to " << formatTimestamp(end) 
+               << ", " << spike.failures << " failed and " << spike.successes 
+               << " successful logins (peak " << spike.peak_failures 
+               << "/min, expected " << std::fixed << std::setprecision(1) 
+               << spike.expected_failures << "/min, z = " << spike.peak_score 
+               << ")\n";
+        output << std::defaultfloat << std::setprecision(6);
+    }
+    if (spikes.size() > listed) 
+    {
+        output << "  ... and " << (spikes.size() - listed) << " more\n";
+    }
+}
+
+void ReportGenerator::generateParseDiagnostics(std::ostream& output) const
+{
+    if (parse_diagnostics_ == nullptr) 
+    {
+        return;
+    }
+    
+    output << "PARSE DIAGNOSTICS\n";
+    output << "----------------------------------------\n";
+    parse_diagnostics_->writeSummary(output);
+    output << "\n";
+}
+
+void ReportGenerator::generateThresholdSweep(std::ostream& output) const
+{
+    if (threshold_sweep_ == nullptr || !threshold_sweep_->isEnabled()) 
+    {
+        return;
+    }
+    
+    output << "THRESHOLD SWEEP\n";
+    output << "----------------------------------------\n";
+    threshold_sweep_->writeMatrix(output);
     output << "\n";
 }
 
@@ -136,8 +378,14 @@ void ReportGenerator::generateAnomaliesDetails(
         output << "\n[" << event_number << "] " 
                << eventTypeToString(event.type) << "\n";
         
-        // Username
-        output << "    Username: " << event.username << "\n";
+        // Rule profile that reported the event
+        if (!event.profile.empty()) 
+        {
+            output << "    Profile: " << event.profile << "\n";
+        }
+        
+        // Username (empty for events spanning many users)
+        output << "    Username: " << (event.username.empty() ? "N/A" : event.username) << "\n";
         
         // IP Address(es)
         output << "    IP Address(es): ";
@@ -195,8 +443,20 @@ std::string ReportGenerator::eventTypeToString(SuspiciousEventType type) const
             return "Multiple Failed Login Attempts";
         case SuspiciousEventType::LOGIN_OUTSIDE_BUSINESS_HOURS:
             return "Login Outside Business Hours";
+        case SuspiciousEventType::UNUSUAL_LOGIN_HOUR:
+            return "Unusual Login Hour";
         case SuspiciousEventType::MULTIPLE_IP_ADDRESSES:
             return "Multiple IP Addresses";
+        case SuspiciousEventType::DISTRIBUTED_BRUTE_FORCE:
+            return "Distributed Brute Force";
+        case SuspiciousEventType::SUCCESS_AFTER_FAILURES:
+            return "Successful Login After Failures";
+        case SuspiciousEventType::IMPOSSIBLE_TRAVEL:
+            return "Impossible Travel";
+        case SuspiciousEventType::DENYLISTED_IP:
+            return "Denylisted IP Address";
+        case SuspiciousEventType::PASSWORD_SPRAYING:
+            return "Password Spraying";
         default:
             return "Unknown Event Type";
     }
@@ -0,0 +1,282 @@
+#include "RiskScorer.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+
+constexpr std::size_t kInitialSlots = 64;   // Slots of an empty table (power of two)
+
+/**
+ * @brief Gets the factor by which a score decays over a number of seconds
+ */
+double decayFactor(std::int64_t seconds)
+{
+    return std::exp2(-static_cast<double>(seconds) / (RiskScorer::kHalfLifeHours * 3600.0));
+}
+
+/**
+ * @brief Orders scores by decreasing value, then by key
+ */
+bool byScore(const RiskScore& a, const RiskScore& b)
+{
+    if (a.score != b.score)
+    {
+        return a.score > b.score;
+    }
+    return a.key < b.key;
+}
+
+/**
+ * @brief Builds a key identifying an event regardless of its profile
+ */
+void eventKey(const SuspiciousEvent& event, std::string& key)
+{
+    key.assign(1, static_cast<char>(event.type));
+    key.append(event.username);
+    for (const auto& ip : event.ip_addresses)
+    {
+        key.push_back('\0');
+        key.append(ip);
+    }
+    key.push_back('\0');
+    std::int64_t span[2] = {
+        static_cast<std::int64_t>(event.first_occurrence.time_since_epoch().count()),
+        static_cast<std::int64_t>(event.last_occurrence.time_since_epoch().count())
+    };
+    key.append(reinterpret_cast<const char*>(span), sizeof(span));
+}
+
+} // namespace
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+RiskScorer::RiskScorer(std::size_t top_n)
+    : top_n_(top_n),
+      has_events_(false),
+      newest_second_(0),
+      users_(),
+      ips_()
+{
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+void RiskScorer::add(const SuspiciousEvent& event)
+{
+    if (top_n_ == 0)
+    {
+        return;
+    }
+
+    std::int64_t second = std::chrono::floor<std::chrono::seconds>(
+        event.last_occurrence.time_since_epoch()).count();
+    if (!has_events_ || second > newest_second_)
+    {
+        newest_second_ = second;
+        has_events_ = true;
+    }
+
+    // Larger bursts weigh more, but only logarithmically
+    double count = static_cast<double>(std::max(event.event_count, 1));
+    double points = weightOf(event.type) * (1.0 + std::log10(count));
+
+    if (!event.username.empty())
+    {
+        users_.add(event.username, event.type, points, second);
+    }
+    for (const auto& ip : event.ip_addresses)
+    {
+        ips_.add(ip, event.type, points, second);
+    }
+}
+
+void RiskScorer::add(const std::vector<SuspiciousEvent>& events)
+{
+    // Profile that first reported each tagged event
+    std::unordered_map<std::string, const std::string*> reported_by;
+    std::string key;
+
+    for (const auto& event : events)
+    {
+        if (!event.profile.empty())
+        {
+            eventKey(event, key);
+            auto found = reported_by.try_emplace(key, &event.profile).first;
+            if (*found->second != event.profile)
+            {
+                continue;
+            }
+        }
+        add(event);
+    }
+}
+
+bool RiskScorer::isEnabled() const
+{
+    return top_n_ > 0;
+}
+
+std::vector<RiskScore> RiskScorer::topUsers() const
+{
+    return users_.top(top_n_, newest_second_);
+}
+
+std::vector<RiskScore> RiskScorer::topIps() const
+{
+    return ips_.top(top_n_, newest_second_);
+}
+
+std::size_t RiskScorer::userCount() const
+{
+    return users_.size();
+}
+
+std::size_t RiskScorer::ipCount() const
+{
+    return ips_.size();
+}
+
+double RiskScorer::weightOf(SuspiciousEventType type)
+{
+    switch (type)
+    {
+        case SuspiciousEventType::MULTIPLE_FAILED_LOGINS:
+            return 15.0;
+        case SuspiciousEventType::LOGIN_OUTSIDE_BUSINESS_HOURS:
+            return 3.0;
+        case SuspiciousEventType::UNUSUAL_LOGIN_HOUR:
+            return 8.0;
+        case SuspiciousEventType::MULTIPLE_IP_ADDRESSES:
+            return 10.0;
+        case SuspiciousEventType::DISTRIBUTED_BRUTE_FORCE:
+            return 25.0;
+        case SuspiciousEventType::SUCCESS_AFTER_FAILURES:
+            return 40.0;
+        case SuspiciousEventType::IMPOSSIBLE_TRAVEL:
+            return 30.0;
+        case SuspiciousEventType::DENYLISTED_IP:
+            return 40.0;
+        case SuspiciousEventType::PASSWORD_SPRAYING:
+            return 25.0;
+        default:
+            return 0.0;
+    }
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+RiskScorer::ScoreTable::ScoreTable()
+    : slots_(kInitialSlots, kEmptySlot),
+      names_(),
+      hashes_(),
+      scores_(),
+      last_seconds_(),
+      counts_()
+{
+}
+
+void RiskScorer::ScoreTable::add(const std::string& name, SuspiciousEventType type,
+                                 double points, std::int64_t second)
+{
+    std::uint32_t id = intern(name, second);
+
+    // Keep the score as of the newest event; older events arrive pre-decayed
+    if (second >= last_seconds_[id])
+    {
+        scores_[id] = scores_[id] * decayFactor(second - last_seconds_[id]) + points;
+        last_seconds_[id] = second;
+    }
+    else
+    {
+        scores_[id] += points * decayFactor(last_seconds_[id] - second);
+    }
+    counts_[id][static_cast<std::size_t>(type)]++;
+}
+
+std::vector<RiskScore> RiskScorer::ScoreTable::top(std::size_t n, std::int64_t now_second) const
+{
+    std::vector<RiskScore> ranking;
+    ranking.reserve(names_.size());
+    for (std::size_t id = 0; id < names_.size(); ++id)
+    {
+        RiskScore score;
+        score.key = names_[id];
+        score.score = scores_[id] * decayFactor(now_second - last_seconds_[id]);
+        score.events_by_type = counts_[id];
+        score.events = 0;
+        for (std::uint32_t count : counts_[id])
+        {
+            score.events += count;
+        }
+        score.last_event = std::chrono::system_clock::time_point(
+            std::chrono::seconds(last_seconds_[id]));
+        ranking.push_back(std::move(score));
+    }
+
+    n = std::min(n, ranking.size());
+    std::partial_sort(ranking.begin(), ranking.begin() + static_cast<std::ptrdiff_t>(n),
+                      ranking.end(), byScore);
+    ranking.resize(n);
+    return ranking;
+}
+
+std::size_t RiskScorer::ScoreTable::size() const
+{
+    return names_.size();
+}
+
+std::uint32_t RiskScorer::ScoreTable::intern(const std::string& name, std::int64_t second)
+{
+    std::size_t hash = std::hash<std::string>{}(name);
+    std::size_t mask = slots_.size() - 1;
+    for (std::size_t slot = hash & mask; ; slot = (slot + 1) & mask)
+    {
+        std::uint32_t id = slots_[slot];
+        if (id == kEmptySlot)
+        {
+            id = static_cast<std::uint32_t>(names_.size());
+            slots_[slot] = id;
+            names_.push_back(name);
+            hashes_.push_back(hash);
+            scores_.push_back(0.0);
+            last_seconds_.push_back(second);
+            counts_.push_back({});
+
+            // Keep the load factor at most one half
+            if (names_.size() * 2 > slots_.size())
+            {
+                grow();
+            }
+            return id;
+        }
+        if (hashes_[id] == hash && names_[id] == name)
+        {
+            return id;
+        }
+    }
+}
+
+void RiskScorer::ScoreTable::grow()
+{
+    slots_.assign(slots_.size() * 2, kEmptySlot);
+    std::size_t mask = slots_.size() - 1;
+    for (std::uint32_t id = 0; id < names_.size(); ++id)
+    {
+        std::size_t slot = hashes_[id] & mask;
+        while (slots_[slot] != kEmptySlot)
+        {
+            slot = (slot + 1) & mask;
+        }
+        slots_[slot] = id;
+    }
+}
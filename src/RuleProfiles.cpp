@@ -0,0 +1,366 @@
+#include "RuleProfiles.h"
+#include "DetectionRules.h"
+#include "PasswordSprayTracker.h"
+#include "IpFailureTracker.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <iterator>
+#include <string_view>
+#include <utility>
+
+// ============================================================================
+// Private Helper Functions
+// ============================================================================
+
+/**
+ * @brief Parses a non-negative decimal number
+ */
+static bool parseNumber(std::string_view text, int& value)
+{
+    if (text.empty() || !std::isdigit(static_cast<unsigned char>(text.front())))
+    {
+        return false;
+    }
+    const char* end = text.data() + text.size();
+    auto result = std::from_chars(text.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+/**
+ * @brief Runs the per-user rules of every profile on one timeline
+ */
+static void foldTimeline(const std::vector<EventDetector>& detectors,
+                         const std::vector<LogEntry>& timeline,
+                         std::vector<DetectionRules::EventBuckets>& buckets_by_profile)
+{
+    for (std::size_t index = 0; index < detectors.size(); ++index)
+    {
+        DetectionRules::BuiltInRules::runUser(detectors[index], timeline,
+                                              detectors[index].enabledRules(),
+                                              buckets_by_profile[index]);
+    }
+}
+
+/**
+ * @brief Lists each profile's events in type order, tagged with its name
+ */
+static std::vector<SuspiciousEvent> tagEvents(const std::vector<RuleProfile>& profiles,
+                                              std::vector<DetectionRules::EventBuckets>& buckets_by_profile)
+{
+    std::vector<SuspiciousEvent> events;
+    for (std::size_t index = 0; index < buckets_by_profile.size(); ++index)
+    {
+        for (auto& event : DetectionRules::collectEvents(buckets_by_profile[index]))
+        {
+            event.profile = profiles[index].name;
+            events.push_back(std::move(event));
+        }
+    }
+    return events;
+}
+
+/**
+ * @brief Checks that a profile name is made of letters, digits, '-' and '_'
+ */
+static bool isValidName(std::string_view name)
+{
+    if (name.empty())
+    {
+        return false;
+    }
+    for (char c : name)
+    {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_')
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Applies one key=value setting of a profile specification
+ */
+static bool applySetting(std::string_view setting, RuleProfile& profile)
+{
+    std::size_t equals = setting.find('=');
+    if (equals == std::string_view::npos)
+    {
+        return false;
+    }
+    std::string_view key = setting.substr(0, equals);
+    std::string_view value = setting.substr(equals + 1);
+
+    if (key == "hours")
+    {
+        std::size_t dash = value.find('-');
+        int start;
+        int end;
+        if (dash == std::string_view::npos ||
+            !parseNumber(value.substr(0, dash), start) ||
+            !parseNumber(value.substr(dash + 1), end) ||
+            end > 23 || start >= end)
+        {
+            return false;
+        }
+        profile.business_hour_start = start;
+        profile.business_hour_end = end;
+        return true;
+    }
+
+    int number;
+    if (!parseNumber(value, number))
+    {
+        return false;
+    }
+    if (key == "threshold" && number > 0)
+    {
+        profile.failed_login_threshold = number;
+    }
+    else if (key == "window" && number > 0)
+    {
+        profile.time_window_minutes = number;
+    }
+    else if (key == "spray" && number >= 2)
+    {
+        profile.spray_user_threshold = number;
+    }
+    else if (key == "distributed" && number >= 2)
+    {
+        profile.distributed_ip_threshold = number;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+bool parseRuleProfile(const std::string& spec, RuleProfile& profile)
+{
+    std::string_view text = spec;
+    std::size_t colon = text.find(':');
+    std::string_view name = text.substr(0, colon);
+    if (!isValidName(name))
+    {
+        return false;
+    }
+
+    RuleProfile parsed = profile;
+    parsed.name = std::string(name);
+
+    if (colon != std::string_view::npos)
+    {
+        std::string_view settings = text.substr(colon + 1);
+        while (true)
+        {
+            std::size_t comma = settings.find(',');
+            if (!applySetting(settings.substr(0, comma), parsed))
+            {
+                return false;
+            }
+            if (comma == std::string_view::npos)
+            {
+                break;
+            }
+            settings.remove_prefix(comma + 1);
+        }
+    }
+
+    profile = std::move(parsed);
+    return true;
+}
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+ProfiledDetector::ProfiledDetector(const EventDetector& detector,
+                                   const std::vector<RuleProfile>& profiles)
+    : profiles_(profiles),
+      detectors_()
+{
+    detectors_.reserve(profiles_.size());
+    for (const auto& profile : profiles_)
+    {
+        EventDetector profile_detector = detector;
+        profile_detector.failed_login_threshold_ = profile.failed_login_threshold;
+        profile_detector.time_window_minutes_ = profile.time_window_minutes;
+        profile_detector.business_hour_start_ = profile.business_hour_start;
+        profile_detector.business_hour_end_ = profile.business_hour_end;
+        profile_detector.spray_user_threshold_ = profile.spray_user_threshold;
+        profile_detector.distributed_ip_threshold_ = profile.distributed_ip_threshold;
+        detectors_.push_back(profile_detector);
+    }
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+std::vector<SuspiciousEvent> ProfiledDetector::detectPerUser(const std::vector<LogEntry>& entries) const
+{
+    if (detectors_.empty())
+    {
+        return {};
+    }
+    return detectTimelines(detectors_.front().groupTimelines(entries));
+}
+
+std::vector<SuspiciousEvent> ProfiledDetector::detectTimelines(
+    const std::vector<std::vector<LogEntry>>& timelines) const
+{
+    std::vector<DetectionRules::EventBuckets> buckets_by_profile(detectors_.size());
+    for (const auto& timeline : timelines)
+    {
+        foldTimeline(detectors_, timeline, buckets_by_profile);
+    }
+    return tagEvents(profiles_, buckets_by_profile);
+}
+
+std::vector<SuspiciousEvent> ProfiledDetector::detectTimelines(
+    const std::vector<std::vector<LogEntry>>& timelines,
+    std::vector<std::vector<SuspiciousEvent>> cross_user_events) const
+{
+    std::vector<DetectionRules::EventBuckets> buckets_by_profile(detectors_.size());
+    for (const auto& timeline : timelines)
+    {
+        foldTimeline(detectors_, timeline, buckets_by_profile);
+    }
+
+    // Cross-user events follow the per-user ones of their type, as in detectAll()
+    for (std::size_t index = 0; index < cross_user_events.size() && index < detectors_.size(); ++index)
+    {
+        for (auto& event : cross_user_events[index])
+        {
+            DetectionRules::bucketOf(buckets_by_profile[index], event.type).push_back(std::move(event));
+        }
+    }
+    return tagEvents(profiles_, buckets_by_profile);
+}
+
+std::vector<SuspiciousEvent> ProfiledDetector::detectTimeline(const std::vector<LogEntry>& timeline) const
+{
+    std::vector<DetectionRules::EventBuckets> buckets_by_profile(detectors_.size());
+    foldTimeline(detectors_, timeline, buckets_by_profile);
+    return tagEvents(profiles_, buckets_by_profile);
+}
+
+std::vector<SuspiciousEvent> ProfiledDetector::detectAll(const std::vector<LogEntry>& entries) const
+{
+    if (detectors_.empty())
+    {
+        return {};
+    }
+    const EventDetector& base = detectors_.front();
+    std::vector<DetectionRules::EventBuckets> buckets_by_profile(detectors_.size());
+
+    // Step 1: Group and sort the entries once, then fold every profile's
+    // per-user rules over each timeline
+    if ((base.enabled_rules_ & DetectionRules::BuiltInRules::kPerUserTypes) != 0)
+    {
+        for (const auto& timeline : base.groupTimelines(entries))
+        {
+            foldTimeline(detectors_, timeline, buckets_by_profile);
+        }
+    }
+
+    // Step 2: Sort the failed (and successful) logins once and stream them
+    // through the cross-user trackers of every profile
+    bool spraying = (base.enabled_rules_ & ruleBit(SuspiciousEventType::PASSWORD_SPRAYING)) != 0;
+    bool ip_failures = (base.enabled_rules_ & ruleBit(SuspiciousEventType::SUCCESS_AFTER_FAILURES)) != 0;
+    if (spraying || ip_failures)
+    {
+        std::vector<const LogEntry*> logins;
+        for (const auto& entry : entries)
+        {
+            if (entry.status == LoginStatus::FAILED ||
+                (ip_failures && entry.status == LoginStatus::SUCCESS))
+            {
+                logins.push_back(&entry);
+            }
+        }
+        if (!base.input_time_ordered_)
+        {
+            std::stable_sort(logins.begin(), logins.end(),
+                             [](const LogEntry* a, const LogEntry* b)
+                             {
+                                 return a->timestamp < b->timestamp;
+                             });
+        }
+
+        std::vector<PasswordSprayTracker> spray_trackers;
+        std::vector<IpFailureTracker> ip_trackers;
+        for (const auto& profile : profiles_)
+        {
+            if (spraying)
+            {
+                spray_trackers.emplace_back(profile.time_window_minutes, profile.spray_user_threshold);
+            }
+            if (ip_failures)
+            {
+                ip_trackers.emplace_back(profile.time_window_minutes, profile.failed_login_threshold);
+            }
+        }
+        for (const LogEntry* entry : logins)
+        {
+            for (auto& tracker : spray_trackers)
+            {
+                tracker.observe(*entry);
+            }
+            for (auto& tracker : ip_trackers)
+            {
+                tracker.observe(*entry);
+            }
+        }
+        for (std::size_t index = 0; index < spray_trackers.size(); ++index)
+        {
+            DetectionRules::bucketOf(buckets_by_profile[index],
+                                     SuspiciousEventType::PASSWORD_SPRAYING) = spray_trackers[index].finish();
+        }
+        for (std::size_t index = 0; index < ip_trackers.size(); ++index)
+        {
+            auto successes = ip_trackers[index].finish();
+            auto& bucket = DetectionRules::bucketOf(buckets_by_profile[index],
+                                                    SuspiciousEventType::SUCCESS_AFTER_FAILURES);
+            bucket.insert(bucket.end(),
+                          std::make_move_iterator(successes.begin()),
+                          std::make_move_iterator(successes.end()));
+        }
+    }
+
+    // Step 3: Tag each profile's events and list them in report order
+    return tagEvents(profiles_, buckets_by_profile);
+}
+
+void ProfiledDetector::sortEvents(std::vector<SuspiciousEvent>& events) const
+{
+    DetectionRules::sortEventsByType(events);
+    std::stable_sort(events.begin(), events.end(),
+                     [this](const SuspiciousEvent& a, const SuspiciousEvent& b)
+                     {
+                         return profileIndex(a.profile) < profileIndex(b.profile);
+                     });
+}
+
+const std::vector<RuleProfile>& ProfiledDetector::profiles() const
+{
+    return profiles_;
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+std::size_t ProfiledDetector::profileIndex(const std::string& name) const
+{
+    for (std::size_t index = 0; index < profiles_.size(); ++index)
+    {
+        if (profiles_[index].name == name)
+        {
+            return index;
+        }
+    }
+    return profiles_.size();
+}
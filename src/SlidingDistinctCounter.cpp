@@ -0,0 +1,186 @@
+#include "SlidingDistinctCounter.h"
+#include "HyperLogLog.h"
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+SlidingDistinctCounter::SlidingDistinctCounter(Duration window, int precision)
+    : window_(window),
+      precision_(std::min(std::max(precision, 4), 16)),
+      now_(),
+      last_seen_(),
+      arrivals_(),
+      registers_(),
+      register_sum_(0.0),
+      zero_registers_(0),
+      last_sweep_()
+{
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+void SlidingDistinctCounter::add(std::string_view value, TimePoint timestamp)
+{
+    now_ = std::max(now_, timestamp);
+    std::uint64_t hash_value = HyperLogLog::hash(value);
+
+    if (!registers_.empty())
+    {
+        addToSketch(hash_value, timestamp);
+
+        // Expire the other registers from time to time
+        if (now_ - last_sweep_ >= window_ / 8)
+        {
+            for (std::size_t i = 0; i < registers_.size(); ++i)
+            {
+                expireRegister(i);
+            }
+            last_sweep_ = now_;
+        }
+        return;
+    }
+
+    expireExact();
+    last_seen_[hash_value] = timestamp;
+    arrivals_.emplace_back(timestamp, hash_value);
+
+    if (last_seen_.size() > kExactLimit || arrivals_.size() > 4 * kExactLimit)
+    {
+        convertToSketch();
+    }
+}
+
+std::size_t SlidingDistinctCounter::estimate() const
+{
+    if (registers_.empty())
+    {
+        return last_seen_.size();
+    }
+
+    return HyperLogLog::harmonicEstimate(register_sum_, zero_registers_, registers_.size());
+}
+
+bool SlidingDistinctCounter::isExact() const
+{
+    return registers_.empty();
+}
+
+void SlidingDistinctCounter::clear()
+{
+    last_seen_.clear();
+    arrivals_.clear();
+    registers_.clear();
+    register_sum_ = 0.0;
+    zero_registers_ = 0;
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+void SlidingDistinctCounter::expireExact()
+{
+    while (!arrivals_.empty() && isExpired(arrivals_.front().first))
+    {
+        auto found = last_seen_.find(arrivals_.front().second);
+
+        // Only the latest arrival of a value removes it
+        if (found != last_seen_.end() && found->second == arrivals_.front().first)
+        {
+            last_seen_.erase(found);
+        }
+        arrivals_.pop_front();
+    }
+}
+
+void SlidingDistinctCounter::convertToSketch()
+{
+    registers_.assign(static_cast<std::size_t>(1) << precision_, std::vector<Candidate>());
+    register_sum_ = static_cast<double>(registers_.size());
+    zero_registers_ = registers_.size();
+
+    // Arrivals are in time order, as addToSketch() requires
+    for (const auto& [timestamp, hash_value] : arrivals_)
+    {
+        auto found = last_seen_.find(hash_value);
+        if (found != last_seen_.end() && found->second == timestamp)
+        {
+            addToSketch(hash_value, timestamp);
+        }
+    }
+
+    last_seen_.clear();
+    arrivals_.clear();
+    arrivals_.shrink_to_fit();
+    last_sweep_ = now_;
+}
+
+void SlidingDistinctCounter::addToSketch(std::uint64_t hash_value, TimePoint timestamp)
+{
+    std::size_t index = static_cast<std::size_t>(hash_value >> (64 - precision_));
+    std::uint8_t rank = HyperLogLog::rank(hash_value, precision_);
+
+    expireRegister(index);
+
+    std::vector<Candidate>& candidates = registers_[index];
+    std::uint8_t old_maximum = candidates.empty() ? 0 : candidates.front().rank;
+
+    // Older candidates with a rank no larger can never be the maximum again
+    while (!candidates.empty() && candidates.back().rank <= rank)
+    {
+        candidates.pop_back();
+    }
+    candidates.push_back(Candidate{timestamp, rank});
+
+    replaceMaximum(old_maximum, candidates.front().rank);
+}
+
+void SlidingDistinctCounter::expireRegister(std::size_t index)
+{
+    std::vector<Candidate>& candidates = registers_[index];
+    if (candidates.empty() || !isExpired(candidates.front().timestamp))
+    {
+        return;
+    }
+
+    std::uint8_t old_maximum = candidates.front().rank;
+
+    // Candidates are in time order; the list is short, so erase from the front
+    auto first_live = std::find_if(candidates.begin(), candidates.end(),
+                                   [this](const Candidate& candidate)
+                                   {
+                                       return !isExpired(candidate.timestamp);
+                                   });
+    candidates.erase(candidates.begin(), first_live);
+
+    replaceMaximum(old_maximum, candidates.empty() ? 0 : candidates.front().rank);
+}
+
+void SlidingDistinctCounter::replaceMaximum(std::uint8_t old_rank, std::uint8_t new_rank)
+{
+    if (old_rank == new_rank)
+    {
+        return;
+    }
+
+    register_sum_ += std::ldexp(1.0, -static_cast<int>(new_rank)) -
+                     std::ldexp(1.0, -static_cast<int>(old_rank));
+    if (old_rank == 0)
+    {
+        zero_registers_--;
+    }
+    if (new_rank == 0)
+    {
+        zero_registers_++;
+    }
+}
+
+bool SlidingDistinctCounter::isExpired(TimePoint timestamp) const
+{
+    return now_ - timestamp >= window_;
+}
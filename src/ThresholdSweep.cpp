@@ -0,0 +1,332 @@
+#include "ThresholdSweep.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <iomanip>
+#include <string_view>
+#include <unordered_map>
+
+// ============================================================================
+// Private Helper Functions
+// ============================================================================
+
+/**
+ * @brief Parses a positive decimal number
+ */
+static bool parsePositive(std::string_view text, int& value)
+{
+    if (text.empty() || !std::isdigit(static_cast<unsigned char>(text.front())))
+    {
+        return false;
+    }
+    const char* end = text.data() + text.size();
+    auto result = std::from_chars(text.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end && value > 0;
+}
+
+/**
+ * @brief Parses one axis: numbers and a..b ranges separated by commas
+ */
+static bool parseAxis(std::string_view text, std::vector<int>& values)
+{
+    std::vector<int> parsed;
+    while (true)
+    {
+        std::size_t comma = text.find(',');
+        std::string_view item = text.substr(0, comma);
+
+        std::size_t dots = item.find("..");
+        int first;
+        int last;
+        if (dots == std::string_view::npos)
+        {
+            if (!parsePositive(item, first))
+            {
+                return false;
+            }
+            last = first;
+        }
+        else if (!parsePositive(item.substr(0, dots), first) ||
+                 !parsePositive(item.substr(dots + 2), last) ||
+                 last < first)
+        {
+            return false;
+        }
+
+        // Checked before expanding, so a huge range is rejected cheaply
+        if (static_cast<std::size_t>(last - first) >= ThresholdSweep::kMaxValues)
+        {
+            return false;
+        }
+        for (int value = first; value <= last; ++value)
+        {
+            parsed.push_back(value);
+        }
+
+        if (comma == std::string_view::npos)
+        {
+            break;
+        }
+        text.remove_prefix(comma + 1);
+    }
+
+    std::sort(parsed.begin(), parsed.end());
+    parsed.erase(std::unique(parsed.begin(), parsed.end()), parsed.end());
+    if (parsed.size() > ThresholdSweep::kMaxValues)
+    {
+        return false;
+    }
+    values = parsed;
+    return true;
+}
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+ThresholdSweep::ThresholdSweep(const std::vector<int>& thresholds, const std::vector<int>& windows)
+    : thresholds_(thresholds),
+      windows_(windows),
+      events_(),
+      users_(),
+      window_counts_(),
+      timeline_()
+{
+    std::sort(thresholds_.begin(), thresholds_.end());
+    std::sort(windows_.begin(), windows_.end());
+    events_.assign(thresholds_.size() * windows_.size(), 0);
+    users_.assign(events_.size(), 0);
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+bool ThresholdSweep::parseGrid(const std::string& spec, std::vector<int>& thresholds,
+                               std::vector<int>& windows)
+{
+    std::vector<int> parsed_thresholds = thresholds;
+    std::vector<int> parsed_windows = windows;
+    bool any_item = false;
+
+    std::string_view text = spec;
+    while (!text.empty())
+    {
+        std::size_t end = text.find_first_of(" ;");
+        std::string_view item = text.substr(0, end);
+        text = (end == std::string_view::npos) ? std::string_view() : text.substr(end + 1);
+        if (item.empty())
+        {
+            continue;
+        }
+
+        std::size_t equals = item.find('=');
+        if (equals == std::string_view::npos)
+        {
+            return false;
+        }
+        std::string_view key = item.substr(0, equals);
+        std::string_view values = item.substr(equals + 1);
+
+        if (key == "threshold")
+        {
+            if (!parseAxis(values, parsed_thresholds))
+            {
+                return false;
+            }
+        }
+        else if (key == "window")
+        {
+            if (!parseAxis(values, parsed_windows))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+        any_item = true;
+    }
+
+    if (!any_item)
+    {
+        return false;
+    }
+    thresholds = parsed_thresholds;
+    windows = parsed_windows;
+    return true;
+}
+
+void ThresholdSweep::add(const std::vector<LogEntry>& entries)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    std::unordered_map<std::string, std::vector<std::int64_t>> failures_by_user;
+    for (const auto& entry : entries)
+    {
+        if (entry.status == LoginStatus::FAILED)
+        {
+            failures_by_user[entry.username].push_back(entry.timestamp.time_since_epoch().count());
+        }
+    }
+
+    for (auto& [username, failures] : failures_by_user)
+    {
+        addTimeline(failures);
+    }
+}
+
+void ThresholdSweep::addUser(const std::vector<LogEntry>& entries)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    timeline_.clear();
+    for (const auto& entry : entries)
+    {
+        if (entry.status == LoginStatus::FAILED)
+        {
+            timeline_.push_back(entry.timestamp.time_since_epoch().count());
+        }
+    }
+    addTimeline(timeline_);
+}
+
+bool ThresholdSweep::isEnabled() const
+{
+    return !events_.empty();
+}
+
+const std::vector<int>& ThresholdSweep::thresholds() const
+{
+    return thresholds_;
+}
+
+const std::vector<int>& ThresholdSweep::windows() const
+{
+    return windows_;
+}
+
+std::uint64_t ThresholdSweep::eventCount(std::size_t threshold_index, std::size_t window_index) const
+{
+    return events_[window_index * thresholds_.size() + threshold_index];
+}
+
+std::uint64_t ThresholdSweep::userCount(std::size_t threshold_index, std::size_t window_index) const
+{
+    return users_[window_index * thresholds_.size() + threshold_index];
+}
+
+void ThresholdSweep::writeMatrix(std::ostream& output) const
+{
+    writeCounts("Multiple failed login events by threshold (rows) and window (columns)",
+                events_, output);
+    output << "\n";
+    writeCounts("Users with such events", users_, output);
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+void ThresholdSweep::addTimeline(std::vector<std::int64_t>& failures)
+{
+    // No threshold can be reached
+    if (failures.size() < static_cast<std::size_t>(thresholds_.front()))
+    {
+        return;
+    }
+    std::sort(failures.begin(), failures.end());
+
+    const std::size_t n = failures.size();
+    window_counts_.resize(n);
+
+    for (std::size_t w = 0; w < windows_.size(); ++w)
+    {
+        // Two timestamps are within W minutes when their difference,
+        // truncated to whole minutes, is at most W
+        std::int64_t limit = std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::minutes(windows_[w] + 1)).count();
+
+        // Failures in the window starting at each failure
+        std::uint32_t largest = 0;
+        std::size_t end = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            end = std::max(end, i + 1);
+            while (end < n && failures[end] - failures[i] < limit)
+            {
+                ++end;
+            }
+            window_counts_[i] = static_cast<std::uint32_t>(end - i);
+            largest = std::max(largest, window_counts_[i]);
+        }
+
+        // Report a window reaching the threshold, continue after it
+        for (std::size_t t = 0; t < thresholds_.size(); ++t)
+        {
+            auto threshold = static_cast<std::uint32_t>(thresholds_[t]);
+            if (threshold > largest)
+            {
+                break;   // Thresholds are ascending
+            }
+
+            std::uint64_t events = 0;
+            for (std::size_t i = 0; i < n; )
+            {
+                if (window_counts_[i] >= threshold)
+                {
+                    ++events;
+                    i += window_counts_[i];
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+
+            std::size_t cell = w * thresholds_.size() + t;
+            events_[cell] += events;
+            users_[cell] += events > 0 ? 1 : 0;
+        }
+    }
+}
+
+void ThresholdSweep::writeCounts(const std::string& title, const std::vector<std::uint64_t>& counts,
+                                 std::ostream& output) const
+{
+    output << title << ":\n";
+
+    // Column width fits the largest count and the window labels
+    std::uint64_t largest = 0;
+    for (std::uint64_t count : counts)
+    {
+        largest = std::max(largest, count);
+    }
+    int width = std::max(static_cast<int>(std::to_string(largest).size()),
+                         static_cast<int>(std::to_string(windows_.back()).size()) + 4) + 2;
+
+    output << std::setw(11) << "threshold";
+    for (int window : windows_)
+    {
+        output << std::setw(width) << (std::to_string(window) + " min");
+    }
+    output << "\n";
+
+    for (std::size_t t = 0; t < thresholds_.size(); ++t)
+    {
+        output << std::setw(11) << thresholds_[t];
+        for (std::size_t w = 0; w < windows_.size(); ++w)
+        {
+            output << std::setw(width) << counts[w * thresholds_.size() + t];
+        }
+        output << "\n";
+    }
+}
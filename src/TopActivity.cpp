@@ -0,0 +1,104 @@
+#include "TopActivity.h"
+#include <vector>
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+TopActivity::TopActivity(std::size_t k)
+    : k_(k),
+      failing_ips_(k * kTrackingFactor),
+      targeted_users_(k * kTrackingFactor),
+      active_users_(k * kTrackingFactor)
+{
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+void TopActivity::add(const LogEntry& entry)
+{
+    if (k_ == 0)
+    {
+        return;
+    }
+
+    active_users_.add(entry.username);
+    if (entry.status == LoginStatus::FAILED)
+    {
+        failing_ips_.add(entry.ip_address);
+        targeted_users_.add(entry.username);
+    }
+}
+
+bool TopActivity::isEnabled() const
+{
+    return k_ > 0;
+}
+
+const HeavyHitters& TopActivity::failingIps() const
+{
+    return failing_ips_;
+}
+
+const HeavyHitters& TopActivity::targetedUsers() const
+{
+    return targeted_users_;
+}
+
+const HeavyHitters& TopActivity::activeUsers() const
+{
+    return active_users_;
+}
+
+void TopActivity::writeSummary(std::ostream& output) const
+{
+    writeRanking("Most Failing IP Addresses", failing_ips_, output);
+    writeRanking("Most Targeted Users", targeted_users_, output);
+    writeRanking("Most Active Users", active_users_, output);
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+void TopActivity::writeRanking(const std::string& title, const HeavyHitters& hitters,
+                               std::ostream& output) const
+{
+    output << title << ":\n";
+
+    std::vector<HeavyHitter> ranking = hitters.top(k_ * kTrackingFactor);
+    if (ranking.empty())
+    {
+        output << "  (none)\n";
+        return;
+    }
+
+    // Keys that may be no more frequent than a dropped key are not ranked;
+    // on a flat distribution that leaves nothing to report
+    std::uint64_t untracked = hitters.maxUntrackedCount();
+    std::size_t rank = 1;
+    for (const auto& hitter : ranking)
+    {
+        if (rank > k_)
+        {
+            break;
+        }
+        if (hitter.count - hitter.error <= untracked)
+        {
+            continue;
+        }
+        output << "  " << rank++ << ". " << hitter.key << ": " << hitter.count;
+        if (hitter.error > 0)
+        {
+            output << " (at most " << hitter.error << " too high)";
+        }
+        output << "\n";
+    }
+
+    if (rank == 1)
+    {
+        output << "  (no key stands out from the rest)\n";
+    }
+}
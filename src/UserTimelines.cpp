@@ -0,0 +1,163 @@
+#include "UserTimelines.h"
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <queue>
+#include <utility>
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+UserTimelines::UserTimelines()
+    : positions_(),
+      timelines_(),
+      arrivals_(),
+      entry_count_(0)
+{
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+void UserTimelines::add(const LogEntry& entry)
+{
+    std::size_t position = timelineOf(entry.username);
+    timelines_[position].push_back(entry);
+    arrivals_[position].push_back(entry_count_);
+    entry_count_++;
+}
+
+void UserTimelines::add(LogEntry&& entry)
+{
+    std::size_t position = timelineOf(entry.username);
+    timelines_[position].push_back(std::move(entry));
+    arrivals_[position].push_back(entry_count_);
+    entry_count_++;
+}
+
+std::size_t UserTimelines::userCount() const
+{
+    return timelines_.size();
+}
+
+std::size_t UserTimelines::entryCount() const
+{
+    return entry_count_;
+}
+
+std::vector<std::vector<LogEntry>> UserTimelines::release()
+{
+    std::vector<std::vector<std::uint64_t>> arrivals;
+    return release(arrivals);
+}
+
+std::vector<std::vector<LogEntry>> UserTimelines::release(std::vector<std::vector<std::uint64_t>>& arrivals)
+{
+    // Order by username so that events come out as with a std::map grouping
+    std::vector<std::size_t> order(timelines_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [this](std::size_t a, std::size_t b)
+              {
+                  return timelines_[a].front().username < timelines_[b].front().username;
+              });
+
+    std::vector<std::vector<LogEntry>> timelines;
+    timelines.reserve(order.size());
+    arrivals.clear();
+    arrivals.reserve(order.size());
+    for (std::size_t position : order)
+    {
+        timelines.push_back(std::move(timelines_[position]));
+        arrivals.push_back(std::move(arrivals_[position]));
+    }
+
+    timelines_.clear();
+    arrivals_.clear();
+    positions_.clear();
+    entry_count_ = 0;
+    return timelines;
+}
+
+void UserTimelines::sortArrivals(const std::vector<std::vector<LogEntry>>& timelines,
+                                 std::vector<std::vector<std::uint64_t>>& arrivals)
+{
+    // Arrivals grow along each timeline, so ordering by timestamp and then
+    // arrival matches a stable sort of the entries
+    std::vector<std::pair<std::chrono::system_clock::time_point, std::uint64_t>> keys;
+    for (std::size_t index = 0; index < timelines.size(); ++index)
+    {
+        const std::vector<LogEntry>& timeline = timelines[index];
+        keys.clear();
+        for (std::size_t position = 0; position < timeline.size(); ++position)
+        {
+            keys.emplace_back(timeline[position].timestamp, arrivals[index][position]);
+        }
+        if (std::is_sorted(keys.begin(), keys.end()))
+        {
+            continue;
+        }
+
+        std::sort(keys.begin(), keys.end());
+        for (std::size_t position = 0; position < keys.size(); ++position)
+        {
+            arrivals[index][position] = keys[position].second;
+        }
+    }
+}
+
+void UserTimelines::forEachInTimeOrder(const std::vector<std::vector<LogEntry>>& timelines,
+                                       const std::vector<std::vector<std::uint64_t>>& arrivals,
+                                       const std::function<void(const LogEntry&)>& visit)
+{
+    // Min-heap of (timeline, position) keyed by timestamp, then arrival
+    using Cursor = std::pair<std::size_t, std::size_t>;
+    auto later = [&timelines, &arrivals](const Cursor& a, const Cursor& b)
+    {
+        const LogEntry& left = timelines[a.first][a.second];
+        const LogEntry& right = timelines[b.first][b.second];
+        if (left.timestamp != right.timestamp)
+        {
+            return left.timestamp > right.timestamp;
+        }
+        return arrivals[a.first][a.second] > arrivals[b.first][b.second];
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(later)> heap(later);
+
+    for (std::size_t index = 0; index < timelines.size(); ++index)
+    {
+        if (!timelines[index].empty())
+        {
+            heap.push(Cursor(index, 0));
+        }
+    }
+
+    while (!heap.empty())
+    {
+        Cursor cursor = heap.top();
+        heap.pop();
+        visit(timelines[cursor.first][cursor.second]);
+
+        if (cursor.second + 1 < timelines[cursor.first].size())
+        {
+            heap.push(Cursor(cursor.first, cursor.second + 1));
+        }
+    }
+}
+
+// ============================================================================
+// Private Helper Methods
+// ============================================================================
+
+std::size_t UserTimelines::timelineOf(const std::string& username)
+{
+    auto inserted = positions_.try_emplace(username, timelines_.size());
+    if (inserted.second)
+    {
+        timelines_.emplace_back();
+        arrivals_.emplace_back();
+    }
+    return inserted.first->second;
+}
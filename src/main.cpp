@@ -1,10 +1,32 @@
 #include "ConfigManager.h"
 #include "LogParser.h"
+#include "LogFormats.h"
 #include "EventDetector.h"
+#include "DetectionRules.h"
+#include "RuleProfiles.h"
 #include "ReportGenerator.h"
+#include "ParseDiagnostics.h"
+#include "LogLoader.h"
+#include "BatchStage.h"
+#include "UserTimelines.h"
+#include "ExternalEntryStore.h"
+#include "PasswordSprayTracker.h"
+#include "IpFailureTracker.h"
+#include "TopActivity.h"
+#include "RateMonitor.h"
+#include "RiskScorer.h"
+#include "ThresholdSweep.h"
+#include "ReorderBuffer.h"
+#include "GeoIpTable.h"
+#include "CidrTrie.h"
+#include "LoginHourProfiles.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
-#include <fstream>
+#include <sstream>
 #include <vector>
+#include <iterator>
+#include <utility>
 
 /**
  * @brief Main entry point for the Log Analyzer application
@@ -51,13 +73,187 @@ int main(int argc, char* argv[])
     
     std::cout << "Log Analyzer - Suspicious Event Detection\n";
     std::cout << "==========================================\n";
-    std::cout << "Input file: " << config.log_file_path << "\n";
+    std::vector<std::string> input_paths = {config.log_file_path};
+    input_paths.insert(input_paths.end(),
+                       config.additional_log_file_paths.begin(),
+                       config.additional_log_file_paths.end());
+    
+    if (input_paths.size() == 1) 
+    {
+        std::cout << "Input file: " << config.log_file_path << "\n";
+    }
+    else 
+    {
+        std::cout << "Input files: " << input_paths.size() << "\n";
+        for (const auto& path : input_paths) 
+        {
+            std::cout << "  - " << path << "\n";
+        }
+    }
     std::cout << "Output file: " << config.report_output_path << "\n";
+    
+    LogFormats::InputFormat input_format = 
+        LogFormats::parseInputFormat(config.input_format).value_or(LogFormats::InputFormat::PIPE);
+    if (!config.line_pattern.empty()) 
+    {
+        input_format = LogFormats::InputFormat::PATTERN;
+        std::cout << "Input pattern: " << config.line_pattern << "\n";
+    }
+    else if (input_format != LogFormats::InputFormat::PIPE) 
+    {
+        std::cout << "Input format: " << LogFormats::inputFormatName(input_format) << "\n";
+    }
     std::cout << "Configuration:\n";
     std::cout << "  - Failed login threshold: " << config.failed_login_threshold << "\n";
     std::cout << "  - Time window: " << config.time_window_minutes << " minutes\n";
+    std::cout << "  - Password spraying threshold: " << config.spray_user_threshold << " users\n";
+    std::cout << "  - Distributed brute-force threshold: " << config.distributed_ip_threshold << " IPs\n";
     std::cout << "  - Business hours: " << config.business_hour_start 
               << ":00 - " << config.business_hour_end << ":00\n";
+    if (config.memory_limit_mb > 0) 
+    {
+        std::cout << "  - Memory limit: " << config.memory_limit_mb << " MB (external mode)\n";
+    }
+    if (!config.geoip_path.empty()) 
+    {
+        std::cout << "  - Impossible travel: " << config.geoip_path 
+                  << " (max " << config.max_travel_speed_kmh << " km/h)\n";
+    }
+    
+    // The list was validated with the configuration
+    RuleSet enabled_rules = kAllRules;
+    DetectionRules::parseRuleList(config.rules, enabled_rules);
+    if (enabled_rules != kAllRules) 
+    {
+        std::cout << "  - Rules: " << DetectionRules::formatRuleList(enabled_rules) << "\n";
+    }
+    bool track_spraying = (enabled_rules & ruleBit(SuspiciousEventType::PASSWORD_SPRAYING)) != 0;
+    bool track_ip_failures = (enabled_rules & ruleBit(SuspiciousEventType::SUCCESS_AFTER_FAILURES)) != 0;
+    
+    // Rule profiles inherit the settings they do not override
+    std::vector<RuleProfile> rule_profiles;
+    for (const auto& spec : config.rule_profiles) 
+    {
+        RuleProfile profile;
+        profile.failed_login_threshold = config.failed_login_threshold;
+        profile.time_window_minutes = config.time_window_minutes;
+        profile.business_hour_start = config.business_hour_start;
+        profile.business_hour_end = config.business_hour_end;
+        profile.spray_user_threshold = config.spray_user_threshold;
+        profile.distributed_ip_threshold = config.distributed_ip_threshold;
+        parseRuleProfile(spec, profile);
+        rule_profiles.push_back(profile);
+        
+        std::cout << "  - Rule profile '" << profile.name << "': threshold " 
+                  << profile.failed_login_threshold << ", window " 
+                  << profile.time_window_minutes << " minutes, hours " 
+                  << profile.business_hour_start << ":00 - " 
+                  << profile.business_hour_end << ":00\n";
+    }
+    
+    // Load the CIDR lists before the log so that allowlisted entries
+    // can be dropped while loading
+    CidrTrie allow_list;
+    CidrTrie deny_list;
+    const std::pair<const std::string*, CidrTrie*> cidr_lists[] = {
+        {&config.allowlist_path, &allow_list},
+        {&config.denylist_path, &deny_list}
+    };
+    for (const auto& [path, trie] : cidr_lists) 
+    {
+        if (path->empty()) 
+        {
+            continue;
+        }
+        if (!trie->load(*path)) 
+        {
+            std::cerr << "Error: Cannot load CIDR list '" << *path << "'";
+            if (trie->failedLine() > 0) 
+            {
+                std::cerr << " (invalid line " << trie->failedLine() << ")";
+            }
+            std::cerr << "\n";
+            std::cerr << "Expected one IPv4 or IPv6 address or CIDR prefix per line.\n";
+            return 2;
+        }
+    }
+    if (!config.allowlist_path.empty()) 
+    {
+        std::cout << "  - Allowlist: " << config.allowlist_path 
+                  << " (" << allow_list.size() << " prefixes)\n";
+    }
+    if (!config.denylist_path.empty()) 
+    {
+        std::cout << "  - Denylist: " << config.denylist_path 
+                  << " (" << deny_list.size() << " prefixes)\n";
+    }
+    
+    // Impossible travel needs the GeoIP table; a bad table fails before
+    // the log is read rather than after
+    GeoIpTable geo_ip_table;
+    if (!config.geoip_path.empty()) 
+    {
+        if (!geo_ip_table.load(config.geoip_path)) 
+        {
+            std::cerr << "Error: Cannot load GeoIP table '" << config.geoip_path << "'";
+            if (geo_ip_table.failedLine() > 0) 
+            {
+                std::cerr << " (invalid line " << geo_ip_table.failedLine() << ")";
+            }
+            std::cerr << "\n";
+            std::cerr << "Expected lines of first_ip,last_ip,latitude,longitude[,country]\n";
+            std::cerr << "with non-overlapping ranges, or a file written by --geoip-save.\n";
+            return 2;
+        }
+        std::cout << "  - GeoIP ranges loaded: " << geo_ip_table.size() << "\n";
+        
+        if (!config.geoip_save_path.empty() && !geo_ip_table.saveBinary(config.geoip_save_path)) 
+        {
+            std::cerr << "Error: Cannot write GeoIP table to '" << config.geoip_save_path << "'\n";
+            return 3;
+        }
+    }
+    
+    // The baseline must be in place before loading, which learns from every entry
+    LoginHourProfiles login_hour_profiles;
+    if (!config.baseline_path.empty()) 
+    {
+        if (!login_hour_profiles.load(config.baseline_path)) 
+        {
+            std::cerr << "Error: Cannot load baseline profiles '" << config.baseline_path << "'\n";
+            std::cerr << "Expected a file written by an earlier run with --baseline.\n";
+            return 2;
+        }
+        std::cout << "  - Baseline: " << config.baseline_path 
+                  << " (" << login_hour_profiles.size() << " user profiles)\n";
+    }
+    
+    // Build the parse-time filter from configuration
+    LogParser::FieldFilter filter;
+    filter.username = config.filter_user;
+    filter.ip_address = config.filter_ip;
+    if (!config.filter_status.empty()) 
+    {
+        filter.status = LogParser::parseStatus(config.filter_status);
+    }
+    
+    if (filter.isActive()) 
+    {
+        std::cout << "  - Filters:";
+        if (!filter.username.empty()) 
+        {
+            std::cout << " user=" << filter.username;
+        }
+        if (!filter.ip_address.empty()) 
+        {
+            std::cout << " ip=" << filter.ip_address;
+        }
+        if (!config.filter_status.empty()) 
+        {
+            std::cout << " status=" << config.filter_status;
+        }
+        std::cout << "\n";
+    }
     std::cout << "\n";
     
     // ========================================================================
@@ -66,57 +262,228 @@ int main(int argc, char* argv[])
     
     std::cout << "Loading log file...\n";
     
-    // Open log file
-    std::ifstream log_file(config.log_file_path);
-    if (!log_file.is_open()) 
+    LoaderOptions loader_options;
+    loader_options.format = input_format;
+    loader_options.syslog_year = config.syslog_year;
+    loader_options.pattern = config.line_pattern;
+    loader_options.filter = filter;
+    loader_options.worker_threads = static_cast<std::size_t>(config.parser_threads);
+    loader_options.max_error_samples = static_cast<std::size_t>(config.max_error_samples);
+    loader_options.verbose_errors = config.verbose_errors;
+    loader_options.prefetch = config.prefetch_input;
+    loader_options.reader.direct_io = config.direct_io;
+    loader_options.reader.io_uring = config.use_io_uring;
+    loader_options.reader.queue_depth = static_cast<std::size_t>(config.io_queue_depth);
+    
+    LogLoader loader(loader_options, std::cerr);
+    
+    // Read and parse the log files; batches arrive in input order and are
+    // analyzed on a detection stage thread while the next ones are parsed.
+    // Entries are grouped into per-user timelines in memory, or spilled to
+    // sorted runs on disk when a memory limit is configured.
+    UserTimelines user_timelines;
+    ReportTotals totals;
+    TopActivity top_activity(static_cast<std::size_t>(config.top_k));
+    RateMonitor rate_monitor(static_cast<std::size_t>(config.top_k), config.spike_z_threshold);
+    bool external_mode = config.memory_limit_mb > 0;
+    ExternalEntryStore entry_store(static_cast<std::size_t>(config.memory_limit_mb) << 20);
+    
+    // Rules comparing entries across users are streamed while loading
+    std::vector<PasswordSprayTracker> spray_trackers;   // One per rule profile, or the global one
+    std::vector<IpFailureTracker> ip_failure_trackers;   // Likewise
+    auto create_trackers = [&]()
     {
-        std::cerr << "Error: Cannot open log file '" << config.log_file_path << "'\n";
-        std::cerr << "Please check that the file exists and is readable.\n";
-        return 2;
-    }
+        spray_trackers.clear();
+        ip_failure_trackers.clear();
+        if (rule_profiles.empty()) 
+        {
+            spray_trackers.emplace_back(config.time_window_minutes, config.spray_user_threshold);
+            ip_failure_trackers.emplace_back(config.time_window_minutes, config.failed_login_threshold);
+        }
+        for (const auto& profile : rule_profiles) 
+        {
+            spray_trackers.emplace_back(profile.time_window_minutes, profile.spray_user_threshold);
+            ip_failure_trackers.emplace_back(profile.time_window_minutes, profile.failed_login_threshold);
+        }
+    };
+    auto observe_cross_user = [&](const LogEntry& entry)
+    {
+        if (track_spraying) 
+        {
+            for (auto& spray_tracker : spray_trackers) 
+            {
+                spray_tracker.observe(entry);
+            }
+        }
+        if (track_ip_failures) 
+        {
+            for (auto& ip_failure_tracker : ip_failure_trackers) 
+            {
+                ip_failure_tracker.observe(entry);
+            }
+        }
+    };
+    create_trackers();
+    bool spill_success = true;
+    std::size_t allowlisted_entries = 0;
     
-    // Parse log entries
-    std::vector<LogEntry> log_entries;
-    std::string line;
-    int line_number = 0;
-    int invalid_entries = 0;
+    // With a lateness watermark, entries to analyze are put back in time
+    // order as they stream in; entries later than the watermark are dropped
+    bool reorder_input = config.lateness_seconds > 0;
+    ReorderBuffer reorder_buffer(std::chrono::seconds(config.lateness_seconds));
+    std::vector<LogEntry> ordered_batch;
     
-    while (std::getline(log_file, line)) 
+    // Hands entries to analyze to the detectors' inputs; runs on the
+    // detection stage thread, in input order
+    auto analyze = [&](std::vector<LogEntry>& batch)
     {
-        line_number++;
-        
-        // Skip empty lines
-        if (line.empty()) 
+        if (!config.baseline_path.empty()) 
         {
-            continue;
+            for (const auto& entry : batch) 
+            {
+                login_hour_profiles.add(entry);
+            }
         }
         
-        // Parse the log line
-        auto entry_opt = LogParser::parseLogLine(line);
+        // Cross-user detectors need all users at once; track them now
+        for (const auto& entry : batch) 
+        {
+            observe_cross_user(entry);
+        }
         
-        if (entry_opt.has_value()) 
+        if (external_mode) 
         {
-            log_entries.push_back(entry_opt.value());
-        } 
-        else 
+            for (const auto& entry : batch) 
+            {
+                spill_success = entry_store.add(entry) && spill_success;
+            }
+            return;
+        }
+        
+        // Per-user rules run on each user's timeline once the input is read
+        for (auto& entry : batch) 
         {
-            // Invalid entry - log internally and continue
-            invalid_entries++;
-            std::cerr << "Warning: Skipping invalid log entry at line " 
-                      << line_number << "\n";
+            user_timelines.add(std::move(entry));
         }
+    };
+    
+    // Detection stage of the loading pipeline (read -> parse -> analyze)
+    BatchStage detection_stage(analyze);
+    
+    bool load_success = loader.loadFiles(
+        input_paths,
+        [&](std::vector<LogEntry>& batch)
+        {
+            for (const auto& entry : batch) 
+            {
+                totals.add(entry);
+                top_activity.add(entry);
+            }
+            
+            // Trusted networks are counted but not analyzed, unless denylisted
+            if (allow_list.size() > 0) 
+            {
+                auto allowed = std::remove_if(batch.begin(), batch.end(),
+                                              [&](const LogEntry& entry)
+                                              {
+                                                  return allow_list.contains(entry.ip_address) &&
+                                                         !deny_list.contains(entry.ip_address);
+                                              });
+                allowlisted_entries += static_cast<std::size_t>(std::distance(allowed, batch.end()));
+                batch.erase(allowed, batch.end());
+            }
+            
+            // Rate alerts follow the analyzed entries, so trusted scanners cannot raise them
+            for (const auto& entry : batch) 
+            {
+                rate_monitor.add(entry);
+            }
+            
+            if (reorder_input) 
+            {
+                ordered_batch.clear();
+                for (auto& entry : batch) 
+                {
+                    reorder_buffer.push(std::move(entry), ordered_batch);
+                }
+            }
+            detection_stage.push(std::move(reorder_input ? ordered_batch : batch));
+        });
+    
+    if (!load_success) 
+    {
+        std::cerr << "Error: Cannot read log file '" << loader.failedPath() << "'\n";
+        std::cerr << "Please check that the file exists and is readable.\n";
+        return 2;
     }
     
-    log_file.close();
+    if (reorder_input) 
+    {
+        ordered_batch.clear();
+        reorder_buffer.flush(ordered_batch);
+        detection_stage.push(std::move(ordered_batch));
+        totals.late_entries = reorder_buffer.lateEntries();
+    }
+    
+    // Wait for the detection stage to take in the last entries
+    detection_stage.finish();
+    
+    rate_monitor.finish();
+    
+    const LoadStatistics& load_stats = loader.statistics();
+    const ParseDiagnostics& diagnostics = loader.diagnostics();
     
     std::cout << "Log file loaded successfully.\n";
-    std::cout << "  - Total lines processed: " << line_number << "\n";
-    std::cout << "  - Valid entries: " << log_entries.size() << "\n";
-    std::cout << "  - Invalid entries: " << invalid_entries << "\n";
+    std::cout << "  - Total lines processed: " << load_stats.lines_processed << "\n";
+    std::cout << "  - Valid entries: " << totals.total_entries << "\n";
+    std::cout << "  - Invalid entries: " << load_stats.invalid_entries << "\n";
+    if (filter.isActive()) 
+    {
+        std::cout << "  - Filtered out: " << load_stats.filtered_entries << "\n";
+    }
+    if (load_stats.skipped_lines > 0) 
+    {
+        std::cout << "  - Other messages skipped: " << load_stats.skipped_lines << "\n";
+    }
+    if (!config.allowlist_path.empty()) 
+    {
+        std::cout << "  - Allowlisted entries skipped: " << allowlisted_entries << "\n";
+    }
+    if (load_stats.out_of_order_entries > 0) 
+    {
+        std::cout << "  - Out-of-order entries: " << load_stats.out_of_order_entries << "\n";
+    }
+    if (reorder_input) 
+    {
+        std::cout << "  - Late entries skipped: " << reorder_buffer.lateEntries() 
+                  << " (watermark " << config.lateness_seconds << " s behind, at most " 
+                  << reorder_buffer.peakSize() << " entries buffered)\n";
+    }
+    if (external_mode) 
+    {
+        std::cout << "  - Sorted runs on disk: " << entry_store.runCount() << "\n";
+    }
     std::cout << "\n";
     
+    // Write a single aggregated warning instead of one per invalid line
+    if (diagnostics.totalErrors() > 0) 
+    {
+        std::ostringstream summary;
+        summary << "Warning: Skipped invalid log entries\n";
+        diagnostics.writeSummary(summary);
+        summary << "\n";
+        std::cerr << summary.str();
+    }
+    
+    if (!spill_success) 
+    {
+        std::cerr << "Error: Cannot write temporary spill files for --memory-limit\n";
+        std::cerr << "Please check that the temporary directory is writable.\n";
+        return 2;
+    }
+    
     // Check if log file was empty
-    if (log_entries.empty()) 
+    if (totals.total_entries == 0) 
     {
         std::cout << "Warning: No valid log entries found.\n";
         std::cout << "Generating empty report...\n";
@@ -136,8 +503,165 @@ int main(int argc, char* argv[])
         config.business_hour_end
     );
     
+    // Time-ordered input (the usual case) needs no per-user sorting;
+    // merged runs of the external store and reordered input are always
+    // in time order
+    bool arrived_in_time_order = reorder_input || load_stats.out_of_order_entries == 0;
+    bool input_time_ordered = external_mode || arrived_in_time_order;
+    detector.setInputTimeOrdered(input_time_ordered);
+    
+    // The cross-user trackers saw the entries in arrival order while loading
+    bool replay_trackers = !arrived_in_time_order && (track_spraying || track_ip_failures);
+    detector.setSprayingThreshold(config.spray_user_threshold);
+    detector.setDistributedThreshold(config.distributed_ip_threshold);
+    detector.setEnabledRules(enabled_rules);
+    
+    if (!config.geoip_path.empty()) 
+    {
+        detector.setGeoIpTable(&geo_ip_table);
+        detector.setMaxTravelSpeed(config.max_travel_speed_kmh);
+    }
+    
+    if (deny_list.size() > 0) 
+    {
+        detector.setDenylist(&deny_list);
+    }
+    if (!config.baseline_path.empty()) 
+    {
+        detector.setLoginHourProfiles(&login_hour_profiles);
+    }
+    
+    // The sweep grid was validated with the configuration
+    std::vector<int> sweep_thresholds;
+    std::vector<int> sweep_windows;
+    if (!config.sweep.empty()) 
+    {
+        sweep_thresholds = {config.failed_login_threshold};
+        sweep_windows = {config.time_window_minutes};
+        ThresholdSweep::parseGrid(config.sweep, sweep_thresholds, sweep_windows);
+        std::cout << "  - Threshold sweep: " << sweep_thresholds.size() << " thresholds x " 
+                  << sweep_windows.size() << " windows\n";
+    }
+    ThresholdSweep threshold_sweep(sweep_thresholds, sweep_windows);
+    
+    // Rule profiles are evaluated together, sharing each user's grouping and sort
+    ProfiledDetector profiled_detector(detector, rule_profiles);
+    bool use_profiles = !rule_profiles.empty();
+    
+    // Events of the cross-user trackers, per profile in report order
+    auto finish_trackers = [&]()
+    {
+        std::vector<std::vector<SuspiciousEvent>> cross_user_events;
+        for (std::size_t index = 0; index < spray_trackers.size(); ++index) 
+        {
+            auto events = ip_failure_trackers[index].finish();
+            auto spraying = spray_trackers[index].finish();
+            events.insert(events.end(),
+                          std::make_move_iterator(spraying.begin()),
+                          std::make_move_iterator(spraying.end()));
+            cross_user_events.push_back(std::move(events));
+        }
+        return cross_user_events;
+    };
+    
     // Run all detection methods
-    std::vector<SuspiciousEvent> suspicious_events = detector.detectAll(log_entries);
+    std::vector<SuspiciousEvent> suspicious_events;
+    if (!external_mode) 
+    {
+        // The entries were grouped per user and streamed through the
+        // cross-user trackers while loading; fold the per-user rules over
+        // each timeline now that every user is complete
+        std::vector<std::vector<std::uint64_t>> arrivals;
+        auto timelines = user_timelines.release(arrivals);
+        if (replay_trackers) 
+        {
+            UserTimelines::sortArrivals(timelines, arrivals);
+        }
+        detector.sortTimelines(timelines);
+        
+        // Trackers need time order; replay out-of-order input once sorted
+        if (replay_trackers) 
+        {
+            create_trackers();
+            UserTimelines::forEachInTimeOrder(timelines, arrivals, observe_cross_user);
+        }
+        
+        auto cross_user_events = finish_trackers();
+        suspicious_events = use_profiles 
+            ? profiled_detector.detectTimelines(timelines, std::move(cross_user_events)) 
+            : detector.detectTimelines(timelines, std::move(cross_user_events.front()));
+        for (const auto& timeline : timelines) 
+        {
+            threshold_sweep.addUser(timeline);
+        }
+    }
+    else 
+    {
+        // Trackers need time order; replay out-of-order input from a
+        // merge of the spilled entries by timestamp before the per-user
+        // merge empties the store
+        bool merge_success = true;
+        if (replay_trackers) 
+        {
+            create_trackers();
+            merge_success = entry_store.forEachInTimeOrder(observe_cross_user);
+        }
+        
+        // Every detector works per user, so feed one user's merged history at a time
+        merge_success = merge_success && entry_store.forEachUser(
+            [&detector, &profiled_detector, use_profiles, &threshold_sweep, 
+             &suspicious_events](std::vector<LogEntry>& user_entries)
+            {
+                threshold_sweep.addUser(user_entries);
+                auto user_events = use_profiles ? profiled_detector.detectTimeline(user_entries) 
+                                                : detector.detectTimeline(user_entries);
+                suspicious_events.insert(suspicious_events.end(),
+                                         std::make_move_iterator(user_events.begin()),
+                                         std::make_move_iterator(user_events.end()));
+            });
+        
+        if (!merge_success) 
+        {
+            std::cerr << "Error: Cannot read temporary spill files for --memory-limit\n";
+            return 2;
+        }
+        
+        auto cross_user_events = finish_trackers();
+        for (std::size_t index = 0; index < cross_user_events.size(); ++index) 
+        {
+            for (auto& event : cross_user_events[index]) 
+            {
+                if (use_profiles) 
+                {
+                    event.profile = rule_profiles[index].name;
+                }
+                suspicious_events.push_back(std::move(event));
+            }
+        }
+        
+        // Group by profile and event type as detectAll() does; within a type
+        // by user, except after-hours and unusual-hour logins which are listed by time
+        if (use_profiles) 
+        {
+            profiled_detector.sortEvents(suspicious_events);
+        }
+        else 
+        {
+            DetectionRules::sortEventsByType(suspicious_events);
+        }
+    }
+    
+    // Aggregate the events into per-user and per-IP risk for the report;
+    // behaviour reported by several profiles is scored once
+    RiskScorer risk_scorer(static_cast<std::size_t>(config.risk_top));
+    risk_scorer.add(suspicious_events);
+    
+    // This run's logins become part of the baseline for the next run
+    if (!config.baseline_path.empty() && !login_hour_profiles.save(config.baseline_path)) 
+    {
+        std::cerr << "Error: Cannot write baseline profiles to '" << config.baseline_path << "'\n";
+        return 3;
+    }
     
     std::cout << "Detection complete.\n";
     std::cout << "  - Suspicious events detected: " << suspicious_events.size() << "\n";
@@ -151,10 +675,15 @@ int main(int argc, char* argv[])
     
     // Create report generator
     ReportGenerator report_generator;
+    report_generator.setParseDiagnostics(&diagnostics);
+    report_generator.setTopActivity(&top_activity);
+    report_generator.setRateMonitor(&rate_monitor);
+    report_generator.setRiskScorer(&risk_scorer);
+    report_generator.setThresholdSweep(&threshold_sweep);
     
     // Generate report to file
     bool report_success = report_generator.generateReportToFile(
-        log_entries,
+        totals,
         suspicious_events,
         config.report_output_path
     );
@@ -0,0 +1,161 @@
+#include <catch2/catch_test_macros.hpp>
+#include "AsyncFileReader.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+/**
+ * Unit tests for AsyncFileReader class
+ * 
+ * These tests verify:
+ * - Byte-exact reads across many small blocks
+ * - Zero-copy block access
+ * - End-of-file and error handling
+ * - Direct I/O option (with fallback where unsupported)
+ */
+
+/**
+ * Helper function to write a test file and return its contents
+ */
+std::string writeTestFile(const std::string& path, size_t size) 
+{
+    std::string contents;
+    for (size_t i = 0; i < size; ++i) 
+    {
+        contents += static_cast<char>('a' + (i * 7) % 26);
+    }
+    
+    std::ofstream file(path, std::ios::binary);
+    file << contents;
+    return contents;
+}
+
+// ============================================================================
+// Tests for read()
+// ============================================================================
+
+TEST_CASE("AsyncFileReader - Reads whole file across many blocks", "[AsyncFileReader][read]") 
+{
+    std::string path = "test_async_reader.bin";
+    std::string expected = writeTestFile(path, 50000);
+    
+    ReaderOptions options;
+    options.block_bytes = 4096;   // Forces the double buffer to cycle
+    
+    AsyncFileReader reader;
+    REQUIRE(reader.open(path, options));
+    
+    std::string result;
+    char buffer[1000];
+    size_t bytes_read = 0;
+    while ((bytes_read = reader.read(buffer, sizeof(buffer))) > 0) 
+    {
+        result.append(buffer, bytes_read);
+    }
+    
+    REQUIRE(result == expected);
+    REQUIRE_FALSE(reader.failed());
+    
+    reader.close();
+    std::remove(path.c_str());
+}
+
+TEST_CASE("AsyncFileReader - Empty file returns no data", "[AsyncFileReader][read]") 
+{
+    std::string path = "test_async_empty.bin";
+    writeTestFile(path, 0);
+    
+    AsyncFileReader reader;
+    REQUIRE(reader.open(path, ReaderOptions()));
+    
+    char buffer[16];
+    REQUIRE(reader.read(buffer, sizeof(buffer)) == 0);
+    
+    reader.close();
+    std::remove(path.c_str());
+}
+
+TEST_CASE("AsyncFileReader - Missing file cannot be opened", "[AsyncFileReader][open]") 
+{
+    AsyncFileReader reader;
+    REQUIRE_FALSE(reader.open("/nonexistent/path/file.log", ReaderOptions()));
+}
+
+// ============================================================================
+// Tests for nextBlock()
+// ============================================================================
+
+TEST_CASE("AsyncFileReader - Blocks are delivered in order", "[AsyncFileReader][nextBlock]") 
+{
+    std::string path = "test_async_blocks.bin";
+    std::string expected = writeTestFile(path, 10000);
+    
+    ReaderOptions options;
+    options.block_bytes = 4096;
+    
+    AsyncFileReader reader;
+    REQUIRE(reader.open(path, options));
+    
+    std::string result;
+    std::string_view block;
+    int blocks = 0;
+    while (reader.nextBlock(block)) 
+    {
+        result.append(block);
+        blocks++;
+    }
+    
+    REQUIRE(result == expected);
+    REQUIRE(blocks == 3);   // 4096 + 4096 + 1808
+    
+    // Further calls keep reporting end of file
+    REQUIRE_FALSE(reader.nextBlock(block));
+    
+    reader.close();
+    std::remove(path.c_str());
+}
+
+TEST_CASE("AsyncFileReader - Direct I/O request still reads correctly", "[AsyncFileReader][directIo]") 
+{
+    std::string path = "test_async_direct.bin";
+    std::string expected = writeTestFile(path, 20000);
+    
+    ReaderOptions options;
+    options.block_bytes = 8192;
+    options.direct_io = true;   // Falls back to buffered I/O if unsupported
+    
+    AsyncFileReader reader;
+    REQUIRE(reader.open(path, options));
+    
+    std::string result;
+    char buffer[3000];
+    size_t bytes_read = 0;
+    while ((bytes_read = reader.read(buffer, sizeof(buffer))) > 0) 
+    {
+        result.append(buffer, bytes_read);
+    }
+    
+    REQUIRE(result == expected);
+    
+    reader.close();
+    std::remove(path.c_str());
+}
+
+TEST_CASE("AsyncFileReader - Closing before reading everything", "[AsyncFileReader][close]") 
+{
+    std::string path = "test_async_close.bin";
+    writeTestFile(path, 100000);
+    
+    ReaderOptions options;
+    options.block_bytes = 4096;
+    
+    AsyncFileReader reader;
+    REQUIRE(reader.open(path, options));
+    
+    char buffer[100];
+    REQUIRE(reader.read(buffer, sizeof(buffer)) == sizeof(buffer));
+    
+    // Must not hang while the background thread waits for a free buffer
+    reader.close();
+    std::remove(path.c_str());
+}
@@ -0,0 +1,95 @@
+#include <catch2/catch_test_macros.hpp>
+#include "BatchStage.h"
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Unit tests for BatchStage class
+ *
+ * These tests verify:
+ * - Batches are consumed in push order on the stage thread
+ * - A full queue holds the producer back without losing batches
+ * - Consumer exceptions are rethrown by finish()
+ */
+
+/**
+ * Helper function to build a batch of entries numbered from first
+ */
+std::vector<LogEntry> createBatch(int first, int count)
+{
+    std::vector<LogEntry> batch;
+    for (int i = first; i < first + count; ++i)
+    {
+        batch.emplace_back(std::chrono::system_clock::from_time_t(1768000000) + std::chrono::seconds(i),
+                           "user" + std::to_string(i), "10.0.0.1", LoginStatus::FAILED);
+    }
+    return batch;
+}
+
+// ============================================================================
+// Tests for push() and finish()
+// ============================================================================
+
+TEST_CASE("BatchStage - Consumes batches in order", "[BatchStage][push]")
+{
+    std::vector<std::string> consumed;
+    BatchStage stage([&consumed](std::vector<LogEntry>& batch)
+    {
+        for (const auto& entry : batch)
+        {
+            consumed.push_back(entry.username);
+        }
+    }, 2);
+
+    // Many more batches than the queue holds
+    for (int i = 0; i < 100; ++i)
+    {
+        stage.push(createBatch(i * 3, 3));
+    }
+    stage.push(std::vector<LogEntry>());
+    stage.finish();
+
+    REQUIRE(consumed.size() == 300);
+    for (int i = 0; i < 300; ++i)
+    {
+        REQUIRE(consumed[i] == "user" + std::to_string(i));
+    }
+}
+
+TEST_CASE("BatchStage - Rethrows a consumer exception from finish", "[BatchStage][finish]")
+{
+    int batches = 0;
+    BatchStage stage([&batches](std::vector<LogEntry>&)
+    {
+        if (++batches == 2)
+        {
+            throw std::runtime_error("consumer failed");
+        }
+    }, 2);
+
+    // Batches after the failure are discarded without blocking the producer
+    for (int i = 0; i < 20; ++i)
+    {
+        stage.push(createBatch(i, 1));
+    }
+
+    REQUIRE_THROWS_AS(stage.finish(), std::runtime_error);
+    REQUIRE(batches == 2);
+}
+
+TEST_CASE("BatchStage - Destructor waits for pending batches", "[BatchStage][finish]")
+{
+    std::size_t consumed = 0;
+    {
+        BatchStage stage([&consumed](std::vector<LogEntry>& batch)
+        {
+            consumed += batch.size();
+        });
+        stage.push(createBatch(0, 5));
+        stage.push(createBatch(5, 5));
+    }
+
+    REQUIRE(consumed == 10);
+}
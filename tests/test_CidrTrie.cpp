@@ -0,0 +1,244 @@
+#include <catch2/catch_test_macros.hpp>
+#include "CidrTrie.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+/**
+ * Unit tests for CidrTrie class
+ *
+ * These tests verify:
+ * - IPv4 and IPv6 address parsing (including "::" and IPv4 tails)
+ * - Prefix coverage for IPv4 and IPv6 prefixes
+ * - Shorter prefixes covering longer ones in either insertion order
+ * - Splitting of compressed nodes
+ * - Loading files with comments and rejecting invalid lines
+ */
+
+/**
+ * Helper function to write a text file
+ */
+void writeFile(const std::string& path, const std::string& content)
+{
+    std::ofstream file(path);
+    file << content;
+}
+
+// ============================================================================
+// Tests for parseAddress()
+// ============================================================================
+
+TEST_CASE("CidrTrie - Parses IPv4 addresses as mapped addresses", "[CidrTrie][parseAddress]")
+{
+    auto address = CidrTrie::parseAddress("10.1.2.3");
+    REQUIRE(address.has_value());
+    REQUIRE(address->high == 0);
+    REQUIRE(address->low == 0x0000FFFF0A010203ULL);
+
+    REQUIRE_FALSE(CidrTrie::parseAddress("256.0.0.1").has_value());
+    REQUIRE_FALSE(CidrTrie::parseAddress("10.0.0").has_value());
+    REQUIRE_FALSE(CidrTrie::parseAddress("").has_value());
+}
+
+TEST_CASE("CidrTrie - Parses IPv6 addresses", "[CidrTrie][parseAddress]")
+{
+    auto full = CidrTrie::parseAddress("2001:0db8:0000:0000:0000:0000:0000:0001");
+    auto compressed = CidrTrie::parseAddress("2001:db8::1");
+    REQUIRE(full.has_value());
+    REQUIRE(compressed.has_value());
+    REQUIRE(full->high == 0x20010DB800000000ULL);
+    REQUIRE(full->low == 1);
+    REQUIRE(compressed->high == full->high);
+    REQUIRE(compressed->low == full->low);
+
+    auto loopback = CidrTrie::parseAddress("::1");
+    REQUIRE(loopback.has_value());
+    REQUIRE(loopback->high == 0);
+    REQUIRE(loopback->low == 1);
+
+    // An IPv4 tail gives the same address as the plain IPv4 form
+    auto mapped = CidrTrie::parseAddress("::ffff:10.1.2.3");
+    REQUIRE(mapped.has_value());
+    REQUIRE(mapped->low == CidrTrie::parseAddress("10.1.2.3")->low);
+
+    REQUIRE_FALSE(CidrTrie::parseAddress("2001:db8::1::2").has_value());
+    REQUIRE_FALSE(CidrTrie::parseAddress("1:2:3:4:5:6:7").has_value());
+    REQUIRE_FALSE(CidrTrie::parseAddress("1:2:3:4:5:6:7:8:9").has_value());
+    REQUIRE_FALSE(CidrTrie::parseAddress("2001:db8::12345").has_value());
+    REQUIRE_FALSE(CidrTrie::parseAddress("fe80::g").has_value());
+}
+
+// ============================================================================
+// Tests for insert() and contains()
+// ============================================================================
+
+TEST_CASE("CidrTrie - Empty trie contains nothing", "[CidrTrie][contains]")
+{
+    CidrTrie trie;
+
+    REQUIRE(trie.size() == 0);
+    REQUIRE_FALSE(trie.contains("10.0.0.1"));
+    REQUIRE_FALSE(trie.contains("::1"));
+}
+
+TEST_CASE("CidrTrie - Matches IPv4 prefixes", "[CidrTrie][contains]")
+{
+    CidrTrie trie;
+    REQUIRE(trie.insert("10.0.0.0/8"));
+    REQUIRE(trie.insert("192.168.1.0/24"));
+    REQUIRE(trie.insert("203.0.113.7"));
+    REQUIRE(trie.size() == 3);
+
+    REQUIRE(trie.contains("10.0.0.0"));
+    REQUIRE(trie.contains("10.255.255.255"));
+    REQUIRE(trie.contains("192.168.1.200"));
+    REQUIRE(trie.contains("203.0.113.7"));
+
+    REQUIRE_FALSE(trie.contains("11.0.0.1"));
+    REQUIRE_FALSE(trie.contains("192.168.2.1"));
+    REQUIRE_FALSE(trie.contains("203.0.113.8"));
+    REQUIRE_FALSE(trie.contains("not-an-ip"));
+}
+
+TEST_CASE("CidrTrie - Matches IPv6 prefixes", "[CidrTrie][contains]")
+{
+    CidrTrie trie;
+    REQUIRE(trie.insert("2001:db8::/32"));
+    REQUIRE(trie.insert("fe80::1/128"));
+
+    REQUIRE(trie.contains("2001:db8::1"));
+    REQUIRE(trie.contains("2001:db8:ffff:ffff::"));
+    REQUIRE(trie.contains("fe80::1"));
+
+    REQUIRE_FALSE(trie.contains("2001:db9::1"));
+    REQUIRE_FALSE(trie.contains("fe80::2"));
+
+    // IPv4 addresses live in their own part of the address space
+    REQUIRE_FALSE(trie.contains("10.0.0.1"));
+}
+
+TEST_CASE("CidrTrie - Mapped IPv6 prefix covers IPv4 addresses", "[CidrTrie][contains]")
+{
+    CidrTrie trie;
+    REQUIRE(trie.insert("::ffff:10.0.0.0/104"));
+
+    REQUIRE(trie.contains("10.20.30.40"));
+    REQUIRE_FALSE(trie.contains("11.0.0.1"));
+}
+
+TEST_CASE("CidrTrie - Zero-length prefix covers everything", "[CidrTrie][contains]")
+{
+    CidrTrie trie;
+    REQUIRE(trie.insert("0.0.0.0/0"));
+
+    REQUIRE(trie.contains("1.2.3.4"));
+    REQUIRE(trie.contains("255.255.255.255"));
+    REQUIRE_FALSE(trie.contains("2001:db8::1"));
+}
+
+TEST_CASE("CidrTrie - Host bits of a prefix are ignored", "[CidrTrie][contains]")
+{
+    CidrTrie trie;
+    REQUIRE(trie.insert("10.1.2.3/16"));
+
+    REQUIRE(trie.contains("10.1.200.1"));
+    REQUIRE_FALSE(trie.contains("10.2.0.1"));
+}
+
+TEST_CASE("CidrTrie - Shorter prefix covers longer prefixes", "[CidrTrie][insert]")
+{
+    // Longer prefixes first: the shorter one replaces them
+    CidrTrie narrow_first;
+    REQUIRE(narrow_first.insert("10.1.1.0/24"));
+    REQUIRE(narrow_first.insert("10.1.2.0/24"));
+    REQUIRE(narrow_first.insert("10.0.0.0/8"));
+
+    // Shorter prefix first: the longer ones are already covered
+    CidrTrie wide_first;
+    REQUIRE(wide_first.insert("10.0.0.0/8"));
+    REQUIRE(wide_first.insert("10.1.1.0/24"));
+
+    for (const CidrTrie* trie : {&narrow_first, &wide_first})
+    {
+        REQUIRE(trie->contains("10.1.1.1"));
+        REQUIRE(trie->contains("10.1.2.1"));
+        REQUIRE(trie->contains("10.99.0.1"));
+        REQUIRE_FALSE(trie->contains("11.1.1.1"));
+    }
+}
+
+TEST_CASE("CidrTrie - Splits compressed nodes", "[CidrTrie][insert]")
+{
+    CidrTrie trie;
+    REQUIRE(trie.insert("192.168.0.0/24"));
+    REQUIRE(trie.insert("192.168.128.0/24"));
+    REQUIRE(trie.insert("192.160.0.0/16"));
+    REQUIRE(trie.insert("192.168.0.128/25"));   // Already covered
+
+    REQUIRE(trie.contains("192.168.0.1"));
+    REQUIRE(trie.contains("192.168.0.200"));
+    REQUIRE(trie.contains("192.168.128.1"));
+    REQUIRE(trie.contains("192.160.5.5"));
+
+    REQUIRE_FALSE(trie.contains("192.168.1.1"));
+    REQUIRE_FALSE(trie.contains("192.168.64.1"));
+    REQUIRE_FALSE(trie.contains("192.161.0.1"));
+}
+
+TEST_CASE("CidrTrie - Rejects invalid prefixes", "[CidrTrie][insert]")
+{
+    CidrTrie trie;
+
+    REQUIRE_FALSE(trie.insert("10.0.0.0/33"));
+    REQUIRE_FALSE(trie.insert("2001:db8::/129"));
+    REQUIRE_FALSE(trie.insert("10.0.0.0/"));
+    REQUIRE_FALSE(trie.insert("10.0.0.0/8x"));
+    REQUIRE_FALSE(trie.insert("10.0.0/8"));
+    REQUIRE(trie.size() == 0);
+}
+
+// ============================================================================
+// Tests for load()
+// ============================================================================
+
+TEST_CASE("CidrTrie - Loads a file with comments and blank lines", "[CidrTrie][load]")
+{
+    std::string path = "test_cidr_list.txt";
+    writeFile(path, "# Known scanners\n"
+                    "198.51.100.0/24\n"
+                    "\n"
+                    "  2001:db8::/48   # lab network\n"
+                    "203.0.113.9\r\n");
+
+    CidrTrie trie;
+    REQUIRE(trie.load(path));
+    REQUIRE(trie.size() == 3);
+    REQUIRE(trie.contains("198.51.100.20"));
+    REQUIRE(trie.contains("2001:db8:0:1::5"));
+    REQUIRE(trie.contains("203.0.113.9"));
+    REQUIRE_FALSE(trie.contains("2001:db8:1::5"));
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("CidrTrie - Reports the invalid line", "[CidrTrie][load]")
+{
+    std::string path = "test_cidr_invalid.txt";
+    writeFile(path, "10.0.0.0/8\n"
+                    "# comment\n"
+                    "10.0.0.0/40\n");
+
+    CidrTrie trie;
+    REQUIRE_FALSE(trie.load(path));
+    REQUIRE(trie.failedLine() == 3);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("CidrTrie - Fails on a missing file", "[CidrTrie][load]")
+{
+    CidrTrie trie;
+
+    REQUIRE_FALSE(trie.load("does_not_exist_cidr.txt"));
+    REQUIRE(trie.failedLine() == 0);
+}
@@ -366,6 +366,48 @@ TEST_CASE("ConfigManager - Parse short argument forms", "[ConfigManager][parseAr
     freeArgv(argv, static_cast<int>(args.size()));
 }
 
+TEST_CASE("ConfigManager - Parse filter arguments", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = 
+    {
+        "log-analyzer",
+        "--user", "admin",
+        "--ip", "10.0.0.1",
+        "--status", "failed"
+    };
+    char** argv = createArgv(args);
+    
+    bool success = manager.parseCommandLineArgs(static_cast<int>(args.size()), argv);
+    
+    REQUIRE(success);
+    
+    const Configuration& config = manager.getConfiguration();
+    REQUIRE(config.filter_user == "admin");
+    REQUIRE(config.filter_ip == "10.0.0.1");
+    REQUIRE(config.filter_status == "failed");
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Parse diagnostics arguments", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    REQUIRE_FALSE(manager.getConfiguration().verbose_errors);
+    REQUIRE(manager.getConfiguration().max_error_samples == 10);
+    
+    std::vector<std::string> args = {"log-analyzer", "--verbose-errors", "--error-samples", "3"};
+    char** argv = createArgv(args);
+    
+    bool success = manager.parseCommandLineArgs(static_cast<int>(args.size()), argv);
+    
+    REQUIRE(success);
+    REQUIRE(manager.getConfiguration().verbose_errors);
+    REQUIRE(manager.getConfiguration().max_error_samples == 3);
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
 // ============================================================================
 // Tests for error handling in argument parsing
 // ============================================================================
@@ -435,6 +477,19 @@ TEST_CASE("ConfigManager - Error on unknown argument", "[ConfigManager][parseArg
     freeArgv(argv, static_cast<int>(args.size()));
 }
 
+TEST_CASE("ConfigManager - Error on invalid status filter", "[ConfigManager][parseArgs][errors]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = {"log-analyzer", "--status", "PENDING"};
+    char** argv = createArgv(args);
+    
+    bool success = manager.parseCommandLineArgs(static_cast<int>(args.size()), argv);
+    
+    REQUIRE_FALSE(success);
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
 TEST_CASE("ConfigManager - Error on invalid configuration after parsing", "[ConfigManager][parseArgs][errors]") 
 {
     ConfigManager manager;
@@ -447,4 +502,456 @@ TEST_CASE("ConfigManager - Error on invalid configuration after parsing", "[Conf
     REQUIRE_FALSE(success);
     
     freeArgv(argv, static_cast<int>(args.size()));
-}
\ No newline at end of file
+}
+
+TEST_CASE("ConfigManager - Add-input adds files", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = {
+        "log-analyzer",
+        "--input", "auth.log.1",
+        "--add-input", "auth.log",
+        "--io-uring",
+        "--io-depth", "16"
+    };
+    char** argv = createArgv(args);
+    
+    bool success = manager.parseCommandLineArgs(static_cast<int>(args.size()), argv);
+    
+    REQUIRE(success);
+    const Configuration& config = manager.getConfiguration();
+    REQUIRE(config.log_file_path == "auth.log.1");
+    REQUIRE(config.additional_log_file_paths.size() == 1);
+    REQUIRE(config.additional_log_file_paths[0] == "auth.log");
+    REQUIRE(config.use_io_uring);
+    REQUIRE(config.io_queue_depth == 16);
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Repeated input replaces the path", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = {
+        "log-analyzer",
+        "--input", "default.log",
+        "-i", "override.log"
+    };
+    char** argv = createArgv(args);
+    
+    bool success = manager.parseCommandLineArgs(static_cast<int>(args.size()), argv);
+    
+    REQUIRE(success);
+    const Configuration& config = manager.getConfiguration();
+    REQUIRE(config.log_file_path == "override.log");
+    REQUIRE(config.additional_log_file_paths.empty());
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Error on invalid I/O queue depth", "[ConfigManager][parseArgs][errors]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = {"log-analyzer", "--io-depth", "0"};
+    char** argv = createArgv(args);
+    
+    bool success = manager.parseCommandLineArgs(static_cast<int>(args.size()), argv);
+    
+    REQUIRE_FALSE(success);
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Parse input format", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = {"log-analyzer", "--format-in", "json"};
+    char** argv = createArgv(args);
+    
+    REQUIRE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    REQUIRE(manager.getConfiguration().input_format == "json");
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Error on unknown input format", "[ConfigManager][parseArgs][errors]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = {"log-analyzer", "--format-in", "xml"};
+    char** argv = createArgv(args);
+    
+    REQUIRE_FALSE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Parse memory limit", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    REQUIRE(manager.getConfiguration().memory_limit_mb == 0);
+    
+    std::vector<std::string> args = {"log-analyzer", "--memory-limit", "512"};
+    char** argv = createArgv(args);
+    
+    REQUIRE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    REQUIRE(manager.getConfiguration().memory_limit_mb == 512);
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Error on negative memory limit", "[ConfigManager][parseArgs][errors]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = {"log-analyzer", "--memory-limit", "-1"};
+    char** argv = createArgv(args);
+    
+    REQUIRE_FALSE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Parse syslog year", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    REQUIRE(manager.getConfiguration().syslog_year == 0);
+    
+    std::vector<std::string> args = {"log-analyzer", "--format-in", "syslog", "--syslog-year", "2025"};
+    char** argv = createArgv(args);
+    
+    REQUIRE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    REQUIRE(manager.getConfiguration().syslog_year == 2025);
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Error on out-of-range syslog year", "[ConfigManager][parseArgs][errors]") 
+{
+    for (const char* year : {"-1", "1969", "10000", "twenty"}) 
+    {
+        ConfigManager manager;
+        std::vector<std::string> args = {"log-analyzer", "--syslog-year", year};
+        char** argv = createArgv(args);
+        
+        REQUIRE_FALSE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+        
+        freeArgv(argv, static_cast<int>(args.size()));
+    }
+}
+
+TEST_CASE("ConfigManager - Parse lateness watermark", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    REQUIRE(manager.getConfiguration().lateness_seconds == 0);
+    
+    std::vector<std::string> args = {"log-analyzer", "--lateness", "90"};
+    char** argv = createArgv(args);
+    
+    REQUIRE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    REQUIRE(manager.getConfiguration().lateness_seconds == 90);
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Error on out-of-range lateness", "[ConfigManager][parseArgs][errors]") 
+{
+    for (const char* lateness : {"-1", "86401"}) 
+    {
+        ConfigManager manager;
+        std::vector<std::string> args = {"log-analyzer", "--lateness", lateness};
+        char** argv = createArgv(args);
+        
+        REQUIRE_FALSE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+        
+        freeArgv(argv, static_cast<int>(args.size()));
+    }
+}
+
+TEST_CASE("ConfigManager - Parse password spraying threshold", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    REQUIRE(manager.getConfiguration().spray_user_threshold == 20);
+    
+    std::vector<std::string> args = {"log-analyzer", "--spray-threshold", "50"};
+    char** argv = createArgv(args);
+    
+    REQUIRE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    REQUIRE(manager.getConfiguration().spray_user_threshold == 50);
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Error on password spraying threshold below 2", "[ConfigManager][parseArgs][errors]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = {"log-analyzer", "--spray-threshold", "1"};
+    char** argv = createArgv(args);
+    
+    REQUIRE_FALSE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Parse distributed brute-force threshold", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    REQUIRE(manager.getConfiguration().distributed_ip_threshold == 10);
+    
+    std::vector<std::string> args = {"log-analyzer", "--distributed-threshold", "25"};
+    char** argv = createArgv(args);
+    
+    REQUIRE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    REQUIRE(manager.getConfiguration().distributed_ip_threshold == 25);
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Error on distributed brute-force threshold below 2", "[ConfigManager][parseArgs][errors]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = {"log-analyzer", "--distributed-threshold", "1"};
+    char** argv = createArgv(args);
+    
+    REQUIRE_FALSE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Parse top-k", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    REQUIRE(manager.getConfiguration().top_k == 10);
+    
+    std::vector<std::string> args = {"log-analyzer", "--top-k", "0"};
+    char** argv = createArgv(args);
+    
+    REQUIRE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    REQUIRE(manager.getConfiguration().top_k == 0);
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Error on top-k out of range", "[ConfigManager][parseArgs][errors]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = {"log-analyzer", "--top-k", "1001"};
+    char** argv = createArgv(args);
+    
+    REQUIRE_FALSE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Parse GeoIP options", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    REQUIRE(manager.getConfiguration().geoip_path.empty());
+    REQUIRE(manager.getConfiguration().max_travel_speed_kmh == 900);
+    
+    std::vector<std::string> args = {"log-analyzer", "--geoip", "geo.csv", 
+                                     "--geoip-save", "geo.bin", "--max-speed", "1200"};
+    char** argv = createArgv(args);
+    
+    REQUIRE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    REQUIRE(manager.getConfiguration().geoip_path == "geo.csv");
+    REQUIRE(manager.getConfiguration().geoip_save_path == "geo.bin");
+    REQUIRE(manager.getConfiguration().max_travel_speed_kmh == 1200);
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Parse allowlist and denylist", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    REQUIRE(manager.getConfiguration().allowlist_path.empty());
+    REQUIRE(manager.getConfiguration().denylist_path.empty());
+    
+    std::vector<std::string> args = {"log-analyzer", "--allowlist", "trusted.txt", 
+                                     "--denylist", "blocked.txt"};
+    char** argv = createArgv(args);
+    
+    REQUIRE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    REQUIRE(manager.getConfiguration().allowlist_path == "trusted.txt");
+    REQUIRE(manager.getConfiguration().denylist_path == "blocked.txt");
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Parse baseline profile path", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    REQUIRE(manager.getConfiguration().baseline_path.empty());
+    
+    std::vector<std::string> args = {"log-analyzer", "--baseline", "profiles.bin"};
+    char** argv = createArgv(args);
+    
+    REQUIRE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    REQUIRE(manager.getConfiguration().baseline_path == "profiles.bin");
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Parse spike z-score", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    REQUIRE(manager.getConfiguration().spike_z_threshold == 4);
+    
+    std::vector<std::string> args = {"log-analyzer", "--spike-z", "0"};
+    char** argv = createArgv(args);
+    
+    REQUIRE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    REQUIRE(manager.getConfiguration().spike_z_threshold == 0);
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Error on negative spike z-score", "[ConfigManager][parseArgs][errors]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = {"log-analyzer", "--spike-z", "-1"};
+    char** argv = createArgv(args);
+    
+    REQUIRE_FALSE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Parse risk ranking length", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    REQUIRE(manager.getConfiguration().risk_top == 10);
+    
+    std::vector<std::string> args = {"log-analyzer", "--top", "25", "--top-k", "3"};
+    char** argv = createArgv(args);
+    
+    REQUIRE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    REQUIRE(manager.getConfiguration().risk_top == 25);
+    REQUIRE(manager.getConfiguration().top_k == 3);
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Error on risk ranking out of range", "[ConfigManager][parseArgs][errors]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = {"log-analyzer", "--top", "1001"};
+    char** argv = createArgv(args);
+    
+    REQUIRE_FALSE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Error on denylist without a path", "[ConfigManager][parseArgs][errors]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = {"log-analyzer", "--denylist"};
+    char** argv = createArgv(args);
+    
+    REQUIRE_FALSE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Error on maximum speed of zero", "[ConfigManager][parseArgs][errors]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = {"log-analyzer", "--max-speed", "0"};
+    char** argv = createArgv(args);
+    
+    REQUIRE_FALSE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Error on GeoIP save without a table", "[ConfigManager][parseArgs][errors]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = {"log-analyzer", "--geoip-save", "geo.bin"};
+    char** argv = createArgv(args);
+    
+    REQUIRE_FALSE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Parse detection rules", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    REQUIRE(manager.getConfiguration().rules == "all");
+    
+    std::vector<std::string> args = {"log-analyzer", "--rules", "failed-logins,spraying"};
+    char** argv = createArgv(args);
+    
+    REQUIRE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    REQUIRE(manager.getConfiguration().rules == "failed-logins,spraying");
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Error on unknown detection rule", "[ConfigManager][parseArgs][errors]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = {"log-analyzer", "--rules", "failed-logins,bogus"};
+    char** argv = createArgv(args);
+    
+    REQUIRE_FALSE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Parse rule profiles", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    REQUIRE(manager.getConfiguration().rule_profiles.empty());
+    
+    std::vector<std::string> args = {"log-analyzer", "--rule-profile", "pci:threshold=3,hours=9-17", 
+                                     "--rule-profile", "sox"};
+    char** argv = createArgv(args);
+    
+    REQUIRE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    REQUIRE(manager.getConfiguration().rule_profiles.size() == 2);
+    REQUIRE(manager.getConfiguration().rule_profiles[0] == "pci:threshold=3,hours=9-17");
+    REQUIRE(manager.getConfiguration().rule_profiles[1] == "sox");
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Error on duplicate rule profile names", "[ConfigManager][parseArgs][errors]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = {"log-analyzer", "--rule-profile", "pci:threshold=3", 
+                                     "--rule-profile", "pci:window=5"};
+    char** argv = createArgv(args);
+    
+    REQUIRE_FALSE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Parse threshold sweep grid", "[ConfigManager][parseArgs]") 
+{
+    ConfigManager manager;
+    REQUIRE(manager.getConfiguration().sweep.empty());
+    
+    // The grid may be one argument or continue in the following ones
+    std::vector<std::string> args = {"log-analyzer", "--sweep", "threshold=3..10", 
+                                     "window=1,5,10,30", "--top", "5"};
+    char** argv = createArgv(args);
+    
+    REQUIRE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    REQUIRE(manager.getConfiguration().sweep == "threshold=3..10 window=1,5,10,30");
+    REQUIRE(manager.getConfiguration().risk_top == 5);
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
+
+TEST_CASE("ConfigManager - Error on invalid threshold sweep grid", "[ConfigManager][parseArgs][errors]") 
+{
+    ConfigManager manager;
+    std::vector<std::string> args = {"log-analyzer", "--sweep", "threshold=10..3"};
+    char** argv = createArgv(args);
+    
+    REQUIRE_FALSE(manager.parseCommandLineArgs(static_cast<int>(args.size()), argv));
+    
+    freeArgv(argv, static_cast<int>(args.size()));
+}
@@ -0,0 +1,191 @@
+#include <catch2/catch_test_macros.hpp>
+#include "DetectionRules.h"
+#include "EventDetector.h"
+#include "LogEntry.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * Unit tests for the DetectionRules namespace
+ *
+ * These tests verify:
+ * - Rule names and rule lists (parseRuleList, formatRuleList)
+ * - RulePipeline runs only enabled rules of the requested scope
+ * - Pipeline output is grouped in SuspiciousEventType order
+ * - A rule reporting two types fills only the enabled one
+ */
+
+/**
+ * Helper function creating an entry a number of minutes after 2026-01-18 10:00 UTC
+ */
+LogEntry createEntry(int minutes, const std::string& username, const std::string& ip,
+                     LoginStatus status)
+{
+    auto base = std::chrono::system_clock::from_time_t(1768730400);
+    return LogEntry(base + std::chrono::minutes(minutes), username, ip, status);
+}
+
+/**
+ * Test rule reporting one event per call and counting its calls
+ */
+template <SuspiciousEventType kType, bool kIsPerUser>
+struct CountingRule
+{
+    static constexpr RuleSet kTypes = ruleBit(kType);
+    static constexpr bool kPerUser = kIsPerUser;
+    static inline int calls = 0;
+
+    static void detect(const EventDetector& /*detector*/, const std::vector<LogEntry>& entries,
+                       RuleSet /*enabled*/, DetectionRules::EventBuckets& buckets)
+    {
+        ++calls;
+        const LogEntry& entry = entries.front();
+        DetectionRules::bucketOf(buckets, kType).emplace_back(
+            kType, entry.username, entry.ip_address, entry.timestamp, entry.timestamp, 1);
+    }
+
+    static void detectUser(const EventDetector& detector, const std::vector<LogEntry>& timeline,
+                           RuleSet enabled, DetectionRules::EventBuckets& buckets)
+    {
+        detect(detector, timeline, enabled, buckets);
+    }
+};
+
+using DenylistCounter = CountingRule<SuspiciousEventType::DENYLISTED_IP, true>;
+using AfterHoursCounter = CountingRule<SuspiciousEventType::LOGIN_OUTSIDE_BUSINESS_HOURS, true>;
+using SprayingCounter = CountingRule<SuspiciousEventType::PASSWORD_SPRAYING, false>;
+
+// ============================================================================
+// Tests for parseRuleList() and formatRuleList()
+// ============================================================================
+
+TEST_CASE("DetectionRules - Parses names, all and removals", "[DetectionRules][parseRuleList]")
+{
+    RuleSet rules = 0;
+
+    REQUIRE(DetectionRules::parseRuleList("all", rules));
+    REQUIRE(rules == kAllRules);
+
+    REQUIRE(DetectionRules::parseRuleList("failed-logins, Spraying", rules));
+    REQUIRE(rules == (ruleBit(SuspiciousEventType::MULTIPLE_FAILED_LOGINS) |
+                      ruleBit(SuspiciousEventType::PASSWORD_SPRAYING)));
+
+    REQUIRE(DetectionRules::parseRuleList("-after-hours", rules));
+    REQUIRE(rules == (kAllRules & ~ruleBit(SuspiciousEventType::LOGIN_OUTSIDE_BUSINESS_HOURS)));
+
+    REQUIRE(DetectionRules::parseRuleList("denylist,-denylist", rules));
+    REQUIRE(rules == 0);
+}
+
+TEST_CASE("DetectionRules - Rejects empty and unknown names", "[DetectionRules][parseRuleList]")
+{
+    RuleSet rules = kAllRules;
+
+    REQUIRE_FALSE(DetectionRules::parseRuleList("", rules));
+    REQUIRE_FALSE(DetectionRules::parseRuleList("failed-logins,", rules));
+    REQUIRE_FALSE(DetectionRules::parseRuleList("-", rules));
+    REQUIRE_FALSE(DetectionRules::parseRuleList("brute-force", rules));
+    REQUIRE(rules == kAllRules);
+}
+
+TEST_CASE("DetectionRules - Formats rule sets", "[DetectionRules][formatRuleList]")
+{
+    REQUIRE(DetectionRules::formatRuleList(kAllRules) == "all");
+    REQUIRE(DetectionRules::formatRuleList(0) == "none");
+    REQUIRE(DetectionRules::formatRuleList(ruleBit(SuspiciousEventType::PASSWORD_SPRAYING) |
+                                           ruleBit(SuspiciousEventType::UNUSUAL_LOGIN_HOUR)) ==
+            "unusual-hours,spraying");
+
+    // Every name parses back to its own rule
+    for (std::size_t type = 0; type < kSuspiciousEventTypeCount; ++type)
+    {
+        auto event_type = static_cast<SuspiciousEventType>(type);
+        RuleSet rules = 0;
+        REQUIRE(DetectionRules::parseRuleList(DetectionRules::ruleName(event_type), rules));
+        REQUIRE(rules == ruleBit(event_type));
+    }
+}
+
+// ============================================================================
+// Tests for RulePipeline
+// ============================================================================
+
+TEST_CASE("DetectionRules - Pipeline runs enabled rules of the scope", "[DetectionRules][RulePipeline]")
+{
+    using Pipeline = DetectionRules::RulePipeline<SprayingCounter, DenylistCounter, AfterHoursCounter>;
+    static_assert(Pipeline::kPerUserTypes == (DenylistCounter::kTypes | AfterHoursCounter::kTypes));
+
+    EventDetector detector;
+    std::vector<LogEntry> entries = {createEntry(0, "alice", "10.0.0.1", LoginStatus::SUCCESS)};
+    SprayingCounter::calls = 0;
+    DenylistCounter::calls = 0;
+    AfterHoursCounter::calls = 0;
+
+    // Per-user scope skips the cross-user rule; output follows the enum order
+    auto events = Pipeline::run<true>(detector, entries, kAllRules);
+    REQUIRE(events.size() == 2);
+    REQUIRE(events[0].type == SuspiciousEventType::LOGIN_OUTSIDE_BUSINESS_HOURS);
+    REQUIRE(events[1].type == SuspiciousEventType::DENYLISTED_IP);
+    REQUIRE(SprayingCounter::calls == 0);
+
+    // Disabled rules are not called
+    events = Pipeline::run<false>(detector, entries, ruleBit(SuspiciousEventType::PASSWORD_SPRAYING));
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0].type == SuspiciousEventType::PASSWORD_SPRAYING);
+    REQUIRE(SprayingCounter::calls == 1);
+    REQUIRE(DenylistCounter::calls == 1);
+    REQUIRE(AfterHoursCounter::calls == 1);
+}
+
+TEST_CASE("DetectionRules - Per-user rules run once per sorted timeline", "[DetectionRules][RulePipeline]")
+{
+    using Pipeline = DetectionRules::RulePipeline<SprayingCounter, DenylistCounter>;
+
+    EventDetector detector;
+    std::vector<LogEntry> entries = {
+        createEntry(5, "bob", "10.0.0.2", LoginStatus::FAILED),
+        createEntry(3, "alice", "10.0.0.1", LoginStatus::FAILED),
+        createEntry(1, "alice", "10.0.0.3", LoginStatus::FAILED),
+        createEntry(2, "bob", "10.0.0.4", LoginStatus::FAILED)
+    };
+    SprayingCounter::calls = 0;
+    DenylistCounter::calls = 0;
+
+    // One call per user, each seeing its earliest entry first; the
+    // cross-user rule sees all entries once
+    auto events = Pipeline::run<false>(detector, entries, kAllRules);
+    REQUIRE(DenylistCounter::calls == 2);
+    REQUIRE(SprayingCounter::calls == 1);
+    REQUIRE(events.size() == 3);
+    REQUIRE(events[0].username == "alice");
+    REQUIRE(events[0].ip_addresses.front() == "10.0.0.3");
+    REQUIRE(events[1].username == "bob");
+    REQUIRE(events[1].ip_addresses.front() == "10.0.0.4");
+    REQUIRE(events[2].type == SuspiciousEventType::PASSWORD_SPRAYING);
+}
+
+TEST_CASE("DetectionRules - Fused failure rule fills only enabled types", "[DetectionRules][RulePipeline]")
+{
+    EventDetector detector;
+    std::vector<LogEntry> entries;
+    for (int minute = 0; minute < 5; ++minute)
+    {
+        entries.push_back(createEntry(minute, "alice", "10.0.0.1", LoginStatus::FAILED));
+    }
+    entries.push_back(createEntry(5, "alice", "10.0.0.1", LoginStatus::SUCCESS));
+
+    using Pipeline = DetectionRules::RulePipeline<DetectionRules::FailureSequenceRule>;
+
+    auto both = Pipeline::run<true>(detector, entries, kAllRules);
+    REQUIRE(both.size() == 2);
+    REQUIRE(both[0].type == SuspiciousEventType::MULTIPLE_FAILED_LOGINS);
+    REQUIRE(both[1].type == SuspiciousEventType::SUCCESS_AFTER_FAILURES);
+
+    auto compromises = Pipeline::run<true>(detector, entries,
+                                           ruleBit(SuspiciousEventType::SUCCESS_AFTER_FAILURES));
+    REQUIRE(compromises.size() == 1);
+    REQUIRE(compromises[0].type == SuspiciousEventType::SUCCESS_AFTER_FAILURES);
+
+    REQUIRE(Pipeline::run<true>(detector, entries, 0).empty());
+}
@@ -1,9 +1,14 @@
 #include <catch2/catch_test_macros.hpp>
 #include "EventDetector.h"
 #include "LogEntry.h"
+#include "IpFailureTracker.h"
+#include "PasswordSprayTracker.h"
+#include "UserTimelines.h"
 #include <chrono>
 #include <vector>
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 
 /**
  * Unit tests for EventDetector class
@@ -11,7 +16,15 @@
  * These tests verify all detection capabilities:
  * - Multiple failed login attempts (brute-force)
  * - Logins outside business hours
+ * - Logins at hours a user rarely uses (baseline profiles)
  * - Multiple IP addresses for same user
+ * - Distributed brute force against one user from many IPs
+ * - Successful logins after a burst of failures
+ * - Impossible travel between successful logins
+ * - Login attempts from denylisted networks
+ * - Password spraying across many users from one IP
+ * - Identical results for ordered, nearly ordered and shuffled input
+ * - Identical results for timelines grouped while loading
  */
 
 /**
@@ -220,6 +233,37 @@ TEST_CASE("EventDetector - Custom business hours", "[EventDetector][detectLogins
     REQUIRE(results.size() == 2);
 }
 
+TEST_CASE("EventDetector - After-hours logins of one night are merged", "[EventDetector][detectLoginsOutsideBusinessHours]") 
+{
+    EventDetector detector;  // Default: 8-18
+    
+    std::vector<LogEntry> entries;
+    for (int minute = 0; minute < 120; ++minute) 
+    {
+        // A service account logging in every minute from 22:00
+        entries.push_back(LogEntry(createTimestamp(22, minute), "svc", "10.0.0.1", LoginStatus::SUCCESS));
+    }
+    entries.push_back(LogEntry(createTimestamp(30, 0), "svc", "10.0.0.1", LoginStatus::SUCCESS));   // 06:00 next day
+    entries.push_back(LogEntry(createTimestamp(21, 0), "svc", "10.0.0.1", LoginStatus::SUCCESS));   // Out of order
+    entries.push_back(LogEntry(createTimestamp(23, 0), "svc", "10.0.0.2", LoginStatus::SUCCESS));   // Other IP
+    entries.push_back(LogEntry(createTimestamp(46, 0), "svc", "10.0.0.1", LoginStatus::SUCCESS));   // Next night
+    entries.push_back(LogEntry(createTimestamp(12, 0), "svc", "10.0.0.1", LoginStatus::SUCCESS));   // Business hours
+    
+    auto results = detector.detectLoginsOutsideBusinessHours(entries);
+    
+    REQUIRE(results.size() == 3);
+    REQUIRE(results[0].ip_addresses == std::vector<std::string>{"10.0.0.1"});
+    REQUIRE(results[0].event_count == 122);
+    REQUIRE(results[0].first_occurrence == createTimestamp(21, 0));
+    REQUIRE(results[0].last_occurrence == createTimestamp(30, 0));
+    REQUIRE(results[0].description.find("122 times from hour 21 to hour 6") != std::string::npos);
+    
+    REQUIRE(results[1].ip_addresses == std::vector<std::string>{"10.0.0.2"});
+    REQUIRE(results[1].event_count == 1);
+    REQUIRE(results[2].first_occurrence == createTimestamp(46, 0));
+    REQUIRE(results[2].event_count == 1);
+}
+
 // ============================================================================
 // Tests for detectMultipleIPAddresses()
 // ============================================================================
@@ -395,4 +439,529 @@ TEST_CASE("EventDetector - detectAll on empty entries", "[EventDetector][detectA
     
     auto results = detector.detectAll(entries);
     REQUIRE(results.empty());
-}
\ No newline at end of file
+}
+
+TEST_CASE("EventDetector - detectAll runs only the enabled rules", "[EventDetector][detectAll]")
+{
+    EventDetector detector;
+    REQUIRE(detector.enabledRules() == kAllRules);
+
+    std::vector<LogEntry> entries =
+    {
+        LogEntry(createTimestamp(10, 0), "alice", "192.168.1.1", LoginStatus::FAILED),
+        LogEntry(createTimestamp(10, 1), "alice", "192.168.1.1", LoginStatus::FAILED),
+        LogEntry(createTimestamp(10, 2), "alice", "192.168.1.1", LoginStatus::FAILED),
+        LogEntry(createTimestamp(10, 3), "alice", "192.168.1.1", LoginStatus::FAILED),
+        LogEntry(createTimestamp(10, 4), "alice", "192.168.1.1", LoginStatus::FAILED),
+        LogEntry(createTimestamp(10, 5), "alice", "192.168.1.1", LoginStatus::SUCCESS),
+        LogEntry(createTimestamp(22, 0), "bob", "10.0.0.1", LoginStatus::SUCCESS)
+    };
+
+    REQUIRE(detector.detectAll(entries).size() == 3);
+
+    detector.setEnabledRules(kAllRules & ~ruleBit(SuspiciousEventType::LOGIN_OUTSIDE_BUSINESS_HOURS)
+                                       & ~ruleBit(SuspiciousEventType::SUCCESS_AFTER_FAILURES));
+    auto results = detector.detectAll(entries);
+
+    REQUIRE(results.size() == 1);
+    REQUIRE(results[0].type == SuspiciousEventType::MULTIPLE_FAILED_LOGINS);
+
+    detector.setEnabledRules(0);
+    REQUIRE(detector.detectAll(entries).empty());
+}
+
+// ============================================================================
+// Tests for detectPasswordSpraying()
+// ============================================================================
+
+TEST_CASE("EventDetector - Password spraying detected in any input order", "[EventDetector][detectPasswordSpraying]") 
+{
+    EventDetector detector;
+    detector.setSprayingThreshold(5);
+    
+    std::vector<LogEntry> entries;
+    for (int i = 0; i < 6; ++i) 
+    {
+        entries.push_back(LogEntry(createTimestamp(9, i), "user" + std::to_string(i),
+                                   "203.0.113.5", LoginStatus::FAILED));
+    }
+    std::reverse(entries.begin(), entries.end());
+    
+    auto results = detector.detectPasswordSpraying(entries);
+    
+    REQUIRE(results.size() == 1);
+    REQUIRE(results[0].type == SuspiciousEventType::PASSWORD_SPRAYING);
+    REQUIRE(results[0].ip_addresses[0] == "203.0.113.5");
+    REQUIRE(results[0].event_count == 6);
+    REQUIRE(results[0].first_occurrence == createTimestamp(9, 0));
+    REQUIRE(results[0].last_occurrence == createTimestamp(9, 5));
+    
+    // detectAll includes it; the per-user detectors do not
+    REQUIRE(detector.detectAll(entries).size() == 1);
+    REQUIRE(detector.detectPerUser(entries).empty());
+}
+
+TEST_CASE("EventDetector - Password spraying after an early probe", "[EventDetector][detectPasswordSpraying]") 
+{
+    EventDetector detector;   // 10-minute window
+    detector.setSprayingThreshold(20);
+    
+    // One failure at 9:00, then 20 users failing between 9:08 and 9:12
+    std::vector<LogEntry> entries;
+    entries.push_back(LogEntry(createTimestamp(9, 0), "probe", "203.0.113.5", LoginStatus::FAILED));
+    for (int i = 0; i < 20; ++i) 
+    {
+        entries.push_back(LogEntry(createTimestamp(9, 8 + i / 5), "user" + std::to_string(i),
+                                   "203.0.113.5", LoginStatus::FAILED));
+    }
+    
+    auto results = detector.detectPasswordSpraying(entries);
+    
+    REQUIRE(results.size() == 1);
+    REQUIRE(results[0].ip_addresses[0] == "203.0.113.5");
+    REQUIRE(results[0].event_count == 20);
+    REQUIRE(results[0].first_occurrence == createTimestamp(9, 8));
+}
+
+TEST_CASE("EventDetector - Password spraying below threshold not detected", "[EventDetector][detectPasswordSpraying]") 
+{
+    EventDetector detector;
+    
+    std::vector<LogEntry> entries;
+    for (int i = 0; i < 19; ++i) 
+    {
+        entries.push_back(LogEntry(createTimestamp(9, 0), "user" + std::to_string(i),
+                                   "203.0.113.5", LoginStatus::FAILED));
+    }
+    
+    REQUIRE(detector.detectPasswordSpraying(entries).empty());
+}
+
+// ============================================================================
+// Tests for detectDistributedBruteForce()
+// ============================================================================
+
+TEST_CASE("EventDetector - Distributed brute force detected", "[EventDetector][detectDistributedBruteForce]") 
+{
+    EventDetector detector;
+    detector.setDistributedThreshold(4);
+    
+    // One failure per IP, so no single IP reaches the brute-force threshold
+    std::vector<LogEntry> entries;
+    for (int i = 0; i < 6; ++i) 
+    {
+        entries.push_back(LogEntry(createTimestamp(9, i), "carol",
+                                   "198.51.100." + std::to_string(i + 1), LoginStatus::FAILED));
+    }
+    std::reverse(entries.begin(), entries.end());
+    
+    auto results = detector.detectDistributedBruteForce(entries);
+    
+    REQUIRE(results.size() == 1);
+    REQUIRE(results[0].type == SuspiciousEventType::DISTRIBUTED_BRUTE_FORCE);
+    REQUIRE(results[0].username == "carol");
+    REQUIRE(results[0].event_count == 6);
+    REQUIRE(results[0].first_occurrence == createTimestamp(9, 0));
+    REQUIRE(results[0].last_occurrence == createTimestamp(9, 5));
+    REQUIRE(results[0].ip_addresses.size() == 5);   // Sample of the addresses
+    
+    // The detection is per user, so detectPerUser includes it
+    auto per_user = detector.detectPerUser(entries);
+    REQUIRE(std::count_if(per_user.begin(), per_user.end(),
+                          [](const SuspiciousEvent& event) 
+                          {
+                              return event.type == SuspiciousEventType::DISTRIBUTED_BRUTE_FORCE;
+                          }) == 1);
+}
+
+TEST_CASE("EventDetector - Distributed brute force needs IPs within the window", "[EventDetector][detectDistributedBruteForce]") 
+{
+    EventDetector detector;
+    detector.setDistributedThreshold(3);
+    
+    // Three IPs, but never more than two within ten minutes
+    std::vector<LogEntry> entries = 
+    {
+        LogEntry(createTimestamp(9, 0), "dave", "198.51.100.1", LoginStatus::FAILED),
+        LogEntry(createTimestamp(9, 5), "dave", "198.51.100.2", LoginStatus::FAILED),
+        LogEntry(createTimestamp(9, 20), "dave", "198.51.100.3", LoginStatus::FAILED),
+        LogEntry(createTimestamp(9, 21), "dave", "198.51.100.3", LoginStatus::FAILED),
+        LogEntry(createTimestamp(9, 22), "dave", "198.51.100.4", LoginStatus::SUCCESS)
+    };
+    
+    REQUIRE(detector.detectDistributedBruteForce(entries).empty());
+}
+
+// ============================================================================
+// Tests for input order handling
+// ============================================================================
+
+/**
+ * Helper function to compare two event lists field by field
+ */
+void requireSameEvents(const std::vector<SuspiciousEvent>& actual,
+                       const std::vector<SuspiciousEvent>& expected) 
+{
+    REQUIRE(actual.size() == expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) 
+    {
+        REQUIRE(actual[i].type == expected[i].type);
+        REQUIRE(actual[i].username == expected[i].username);
+        REQUIRE(actual[i].first_occurrence == expected[i].first_occurrence);
+        REQUIRE(actual[i].last_occurrence == expected[i].last_occurrence);
+        REQUIRE(actual[i].event_count == expected[i].event_count);
+        REQUIRE(actual[i].ip_addresses == expected[i].ip_addresses);
+    }
+}
+
+/**
+ * Helper function to drop after-hours events, which follow input order
+ */
+std::vector<SuspiciousEvent> windowedEvents(std::vector<SuspiciousEvent> events) 
+{
+    events.erase(std::remove_if(events.begin(), events.end(),
+                                [](const SuspiciousEvent& event) 
+                                {
+                                    return event.type == SuspiciousEventType::LOGIN_OUTSIDE_BUSINESS_HOURS;
+                                }),
+                 events.end());
+    return events;
+}
+
+/**
+ * Helper function to build a time-ordered day of logins for two users
+ */
+std::vector<LogEntry> createOrderedDay() 
+{
+    std::vector<LogEntry> entries;
+    for (int minute = 0; minute < 24 * 60; minute += 3) 
+    {
+        std::string user = (minute % 2 == 0) ? "alice" : "bob";
+        LoginStatus status = (minute % 9 < 5) ? LoginStatus::FAILED : LoginStatus::SUCCESS;
+        entries.emplace_back(createTimestamp(minute / 60, minute % 60), user,
+                             "10.0.0." + std::to_string(minute % 4), status);
+    }
+    return entries;
+}
+
+TEST_CASE("EventDetector - Declared time order gives the same results", "[EventDetector][order]") 
+{
+    auto entries = createOrderedDay();
+    EventDetector detector(3, 10, 8, 18);
+    auto expected = detector.detectAll(entries);
+    
+    detector.setInputTimeOrdered(true);
+    requireSameEvents(detector.detectAll(entries), expected);
+}
+
+TEST_CASE("EventDetector - Nearly ordered input gives the same results", "[EventDetector][order]") 
+{
+    auto entries = createOrderedDay();
+    EventDetector detector(3, 10, 8, 18);
+    auto expected = detector.detectAll(entries);
+    
+    // A few late-arriving lines of the same user
+    for (size_t i = 10; i + 4 < entries.size(); i += 50) 
+    {
+        std::swap(entries[i], entries[i + 4]);
+    }
+    
+    requireSameEvents(windowedEvents(detector.detectAll(entries)), windowedEvents(expected));
+}
+
+TEST_CASE("EventDetector - Shuffled input gives the same results", "[EventDetector][order]") 
+{
+    auto entries = createOrderedDay();
+    EventDetector detector(3, 10, 8, 18);
+    auto expected = detector.detectAll(entries);
+    
+    // Reversed input needs far more moves than insertion sort is allowed
+    std::reverse(entries.begin(), entries.end());
+    
+    requireSameEvents(windowedEvents(detector.detectAll(entries)), windowedEvents(expected));
+}
+
+TEST_CASE("EventDetector - Timelines grouped while loading give the same results", "[EventDetector][detectTimelines]") 
+{
+    auto entries = createOrderedDay();
+    
+    // A late spraying burst from one IP
+    for (int i = 0; i < 25; ++i) 
+    {
+        entries.emplace_back(createTimestamp(12, 0) + std::chrono::seconds(i * 20 + 7),
+                             "spray" + std::to_string(i), "203.0.113.9", LoginStatus::FAILED);
+    }
+    EventDetector detector(3, 10, 8, 18);
+    auto expected = detector.detectAll(entries);
+    
+    UserTimelines user_timelines;
+    for (const auto& entry : entries) 
+    {
+        user_timelines.add(entry);
+    }
+    std::vector<std::vector<std::uint64_t>> arrivals;
+    auto timelines = user_timelines.release(arrivals);
+    UserTimelines::sortArrivals(timelines, arrivals);
+    detector.sortTimelines(timelines);
+    
+    // Cross-user trackers are fed the sorted timelines in time order
+    IpFailureTracker ip_failures(10, 3);
+    PasswordSprayTracker spraying(10, 20);
+    UserTimelines::forEachInTimeOrder(timelines, arrivals, [&](const LogEntry& entry) 
+    {
+        ip_failures.observe(entry);
+        spraying.observe(entry);
+    });
+    auto cross_user_events = ip_failures.finish();
+    auto spray_events = spraying.finish();
+    REQUIRE(spray_events.size() == 1);
+    cross_user_events.insert(cross_user_events.end(), spray_events.begin(), spray_events.end());
+    
+    requireSameEvents(detector.detectTimelines(timelines, std::move(cross_user_events)), expected);
+}
+
+// ============================================================================
+// Tests for detectSuccessAfterFailures()
+// ============================================================================
+
+TEST_CASE("EventDetector - Success after failures detected", "[EventDetector][detectSuccessAfterFailures]") 
+{
+    EventDetector detector(3, 10, 0, 23);
+    
+    std::vector<LogEntry> entries = 
+    {
+        LogEntry(createTimestamp(9, 0), "erin", "203.0.113.7", LoginStatus::FAILED),
+        LogEntry(createTimestamp(9, 1), "erin", "203.0.113.7", LoginStatus::FAILED),
+        LogEntry(createTimestamp(9, 2), "erin", "203.0.113.8", LoginStatus::FAILED),
+        LogEntry(createTimestamp(9, 3), "erin", "203.0.113.7", LoginStatus::SUCCESS),
+        LogEntry(createTimestamp(9, 4), "erin", "203.0.113.7", LoginStatus::SUCCESS)
+    };
+    std::reverse(entries.begin(), entries.end());
+    
+    auto results = detector.detectSuccessAfterFailures(entries);
+    
+    // Reported once, at the first success
+    REQUIRE(results.size() == 1);
+    REQUIRE(results[0].type == SuspiciousEventType::SUCCESS_AFTER_FAILURES);
+    REQUIRE(results[0].username == "erin");
+    REQUIRE(results[0].ip_addresses[0] == "203.0.113.7");
+    REQUIRE(results[0].event_count == 3);
+    REQUIRE(results[0].first_occurrence == createTimestamp(9, 0));
+    REQUIRE(results[0].last_occurrence == createTimestamp(9, 3));
+    REQUIRE(results[0].description.find("2 from the same IP") != std::string::npos);
+    
+    // detectPerUser runs it in the same pass as the brute-force detector
+    auto per_user = detector.detectPerUser(entries);
+    REQUIRE(per_user.size() == 2);
+    requireSameEvents({per_user[0]}, detector.detectMultipleFailedLogins(entries));
+    requireSameEvents({per_user[1]}, results);
+}
+
+TEST_CASE("EventDetector - Success after old or few failures not detected", "[EventDetector][detectSuccessAfterFailures]") 
+{
+    EventDetector detector(3, 10, 0, 23);
+    
+    std::vector<LogEntry> entries = 
+    {
+        // Failures that left the window before the success
+        LogEntry(createTimestamp(9, 0), "erin", "203.0.113.7", LoginStatus::FAILED),
+        LogEntry(createTimestamp(9, 1), "erin", "203.0.113.7", LoginStatus::FAILED),
+        LogEntry(createTimestamp(9, 2), "erin", "203.0.113.7", LoginStatus::FAILED),
+        LogEntry(createTimestamp(9, 30), "erin", "203.0.113.7", LoginStatus::SUCCESS),
+        
+        // Too few failures
+        LogEntry(createTimestamp(10, 0), "frank", "203.0.113.9", LoginStatus::FAILED),
+        LogEntry(createTimestamp(10, 1), "frank", "203.0.113.9", LoginStatus::FAILED),
+        LogEntry(createTimestamp(10, 2), "frank", "203.0.113.9", LoginStatus::SUCCESS),
+        
+        // Failures of another user do not count
+        LogEntry(createTimestamp(10, 3), "gina", "203.0.113.9", LoginStatus::SUCCESS)
+    };
+    
+    REQUIRE(detector.detectSuccessAfterFailures(entries).empty());
+}
+
+TEST_CASE("EventDetector - Success after failures from the same IP detected", "[EventDetector][detectSuccessAfterIpFailures]") 
+{
+    EventDetector detector(3, 10, 0, 23);
+    
+    std::vector<LogEntry> entries = 
+    {
+        // One host guesses three accounts, then gets into a fourth
+        LogEntry(createTimestamp(9, 0), "hank", "203.0.113.7", LoginStatus::FAILED),
+        LogEntry(createTimestamp(9, 1), "ivy", "203.0.113.7", LoginStatus::FAILED),
+        LogEntry(createTimestamp(9, 2), "jack", "203.0.113.7", LoginStatus::FAILED),
+        LogEntry(createTimestamp(9, 3), "kate", "203.0.113.7", LoginStatus::SUCCESS),
+        
+        // Failures of one user only are reported by the per-user check
+        LogEntry(createTimestamp(10, 0), "erin", "203.0.113.8", LoginStatus::FAILED),
+        LogEntry(createTimestamp(10, 1), "erin", "203.0.113.8", LoginStatus::FAILED),
+        LogEntry(createTimestamp(10, 2), "erin", "203.0.113.8", LoginStatus::FAILED),
+        LogEntry(createTimestamp(10, 3), "erin", "203.0.113.8", LoginStatus::SUCCESS)
+    };
+    std::reverse(entries.begin(), entries.end());
+    
+    auto results = detector.detectSuccessAfterIpFailures(entries);
+    
+    REQUIRE(results.size() == 1);
+    REQUIRE(results[0].type == SuspiciousEventType::SUCCESS_AFTER_FAILURES);
+    REQUIRE(results[0].username == "kate");
+    REQUIRE(results[0].ip_addresses[0] == "203.0.113.7");
+    REQUIRE(results[0].event_count == 3);
+    REQUIRE(results[0].first_occurrence == createTimestamp(9, 0));
+    REQUIRE(results[0].last_occurrence == createTimestamp(9, 3));
+    REQUIRE(results[0].description.find("for 3 users") != std::string::npos);
+    
+    // detectAll reports both halves; detectPerUser only the same-user one
+    auto per_user = detector.detectSuccessAfterFailures(entries);
+    REQUIRE(per_user.size() == 1);
+    REQUIRE(per_user[0].username == "erin");
+    
+    RuleSet rules = ruleBit(SuspiciousEventType::SUCCESS_AFTER_FAILURES);
+    detector.setEnabledRules(rules);
+    auto all = detector.detectAll(entries);
+    REQUIRE(all.size() == 2);
+    requireSameEvents({all[0]}, per_user);
+    requireSameEvents({all[1]}, results);
+    REQUIRE(detector.detectPerUser(entries).size() == 1);
+}
+
+// ============================================================================
+// Tests for detectImpossibleTravel()
+// ============================================================================
+
+TEST_CASE("EventDetector - Impossible travel detected with a GeoIP table", "[EventDetector][detectImpossibleTravel]") 
+{
+    // Berlin, Potsdam (about 30 km away) and New York
+    std::string path = "test_detector_geoip.csv";
+    {
+        std::ofstream file(path);
+        file << "10.0.0.0,10.0.0.255,52.52,13.40,DE\n";
+        file << "10.0.1.0,10.0.1.255,52.39,13.06,DE\n";
+        file << "10.2.0.0,10.2.0.255,40.71,-74.01,US\n";
+    }
+    GeoIpTable table;
+    REQUIRE(table.load(path));
+    std::remove(path.c_str());
+    
+    EventDetector detector;
+    std::vector<LogEntry> entries = 
+    {
+        LogEntry(createTimestamp(9, 0), "alice", "10.0.0.1", LoginStatus::SUCCESS),
+        LogEntry(createTimestamp(9, 5), "alice", "10.0.1.7", LoginStatus::SUCCESS),     // Nearby
+        LogEntry(createTimestamp(9, 6), "alice", "192.168.0.1", LoginStatus::SUCCESS),  // Unknown
+        LogEntry(createTimestamp(10, 0), "alice", "10.2.0.9", LoginStatus::SUCCESS),    // New York
+        LogEntry(createTimestamp(10, 1), "alice", "10.2.0.9", LoginStatus::FAILED),
+        LogEntry(createTimestamp(9, 30), "bob", "10.0.0.2", LoginStatus::SUCCESS)
+    };
+    
+    // Without a table nothing is reported
+    REQUIRE(detector.detectImpossibleTravel(entries).empty());
+    
+    detector.setGeoIpTable(&table);
+    auto results = detector.detectImpossibleTravel(entries);
+    
+    REQUIRE(results.size() == 1);
+    REQUIRE(results[0].type == SuspiciousEventType::IMPOSSIBLE_TRAVEL);
+    REQUIRE(results[0].username == "alice");
+    REQUIRE(results[0].ip_addresses == std::vector<std::string>{"10.0.1.7", "10.2.0.9"});
+    REQUIRE(results[0].first_occurrence == createTimestamp(9, 5));
+    REQUIRE(results[0].last_occurrence == createTimestamp(10, 0));
+    
+    // The speed limit decides
+    detector.setMaxTravelSpeed(10.0);
+    REQUIRE(detector.detectImpossibleTravel(entries).size() == 1);
+    detector.setMaxTravelSpeed(100000.0);
+    REQUIRE(detector.detectImpossibleTravel(entries).empty());
+}
+
+TEST_CASE("EventDetector - Denylisted IP addresses detected", "[EventDetector][detectDenylisted]") 
+{
+    CidrTrie deny_list;
+    REQUIRE(deny_list.insert("203.0.113.0/24"));
+    REQUIRE(deny_list.insert("2001:db8::/32"));
+    
+    EventDetector detector;
+    std::vector<LogEntry> entries = 
+    {
+        LogEntry(createTimestamp(9, 0), "alice", "203.0.113.5", LoginStatus::FAILED),
+        LogEntry(createTimestamp(9, 2), "alice", "203.0.113.5", LoginStatus::SUCCESS),
+        LogEntry(createTimestamp(9, 1), "alice", "192.168.1.10", LoginStatus::SUCCESS),
+        LogEntry(createTimestamp(9, 3), "bob", "2001:db8::7", LoginStatus::FAILED),
+        LogEntry(createTimestamp(9, 4), "bob", "203.0.114.1", LoginStatus::FAILED)
+    };
+    
+    // Without a denylist nothing is reported
+    REQUIRE(detector.detectDenylisted(entries).empty());
+    
+    detector.setDenylist(&deny_list);
+    auto results = detector.detectDenylisted(entries);
+    
+    REQUIRE(results.size() == 2);
+    REQUIRE(results[0].type == SuspiciousEventType::DENYLISTED_IP);
+    REQUIRE(results[0].username == "alice");
+    REQUIRE(results[0].ip_addresses == std::vector<std::string>{"203.0.113.5"});
+    REQUIRE(results[0].event_count == 2);
+    REQUIRE(results[0].first_occurrence == createTimestamp(9, 0));
+    REQUIRE(results[0].last_occurrence == createTimestamp(9, 2));
+    REQUIRE(results[0].description.find("(1 successful)") != std::string::npos);
+    
+    REQUIRE(results[1].username == "bob");
+    REQUIRE(results[1].ip_addresses == std::vector<std::string>{"2001:db8::7"});
+    REQUIRE(results[1].event_count == 1);
+    
+    // The per-user detectors include the denylist
+    auto per_user = detector.detectPerUser(entries);
+    REQUIRE(std::count_if(per_user.begin(), per_user.end(),
+                          [](const SuspiciousEvent& event)
+                          {
+                              return event.type == SuspiciousEventType::DENYLISTED_IP;
+                          }) == 2);
+}
+
+TEST_CASE("EventDetector - Unusual login hours detected with baseline profiles", "[EventDetector][detectUnusualLoginHours]") 
+{
+    // Baseline: a night-shift worker logging in at 02:00 and a user with too few logins
+    std::string path = "test_detector_baseline.bin";
+    {
+        LoginHourProfiles learning;
+        for (int minute = 0; minute < 30; ++minute) 
+        {
+            learning.add(LogEntry(createTimestamp(2, minute), "nightowl", "10.0.0.1", LoginStatus::SUCCESS));
+        }
+        learning.add(LogEntry(createTimestamp(2, 0), "newbie", "10.0.0.2", LoginStatus::SUCCESS));
+        REQUIRE(learning.save(path));
+    }
+    LoginHourProfiles profiles;
+    REQUIRE(profiles.load(path));
+    std::remove(path.c_str());
+    
+    EventDetector detector;
+    std::vector<LogEntry> entries = 
+    {
+        LogEntry(createTimestamp(2, 30), "nightowl", "10.0.0.1", LoginStatus::SUCCESS),   // Usual hour
+        LogEntry(createTimestamp(3, 10), "nightowl", "10.0.0.1", LoginStatus::SUCCESS),   // Next hour
+        LogEntry(createTimestamp(12, 0), "nightowl", "10.0.0.1", LoginStatus::SUCCESS),   // Rare
+        LogEntry(createTimestamp(12, 5), "nightowl", "10.0.0.1", LoginStatus::FAILED),
+        LogEntry(createTimestamp(12, 0), "newbie", "10.0.0.2", LoginStatus::SUCCESS)      // No established profile
+    };
+    
+    // Without profiles nothing is reported
+    REQUIRE(detector.detectUnusualLoginHours(entries).empty());
+    auto before_profiles = detector.detectLoginsOutsideBusinessHours(entries);
+    REQUIRE(before_profiles.size() == 1);   // Both night logins in one event
+    REQUIRE(before_profiles[0].event_count == 2);
+    
+    detector.setLoginHourProfiles(&profiles);
+    auto results = detector.detectUnusualLoginHours(entries);
+    
+    REQUIRE(results.size() == 1);
+    REQUIRE(results[0].type == SuspiciousEventType::UNUSUAL_LOGIN_HOUR);
+    REQUIRE(results[0].username == "nightowl");
+    REQUIRE(results[0].first_occurrence == createTimestamp(12, 0));
+    REQUIRE(results[0].description.find("0 of 30 baseline logins") != std::string::npos);
+    
+    // The night-shift worker is no longer judged by the business hours
+    auto after_hours = detector.detectLoginsOutsideBusinessHours(entries);
+    REQUIRE(after_hours.empty());
+}
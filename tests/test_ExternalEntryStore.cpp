@@ -0,0 +1,399 @@
+#include <catch2/catch_test_macros.hpp>
+#include "ExternalEntryStore.h"
+#include "EventDetector.h"
+#include "IpFailureTracker.h"
+#include "PasswordSprayTracker.h"
+#include "UserTimelines.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Unit tests for ExternalEntryStore class
+ *
+ * These tests verify:
+ * - Per-user grouping and time order with and without spilling
+ * - Multi-pass merges of more runs than the fan-in
+ * - Exact round trip of entries through spill files
+ * - Detection results identical to the in-memory path
+ * - Time-ordered visits and cross-user trackers on unordered input
+ * - Cleanup of spill files and write errors
+ */
+
+/**
+ * Helper function to create a timestamp a number of seconds after a fixed base
+ */
+std::chrono::system_clock::time_point storeTimestamp(int seconds)
+{
+    return std::chrono::system_clock::from_time_t(1768000000) + std::chrono::seconds(seconds);
+}
+
+/**
+ * Helper function to build a shuffled log with several users
+ */
+std::vector<LogEntry> createStoreEntries(int count)
+{
+    std::vector<LogEntry> entries;
+    for (int i = 0; i < count; ++i)
+    {
+        // Interleave users and make timestamps run backwards in places
+        int user = (i * 7) % 13;
+        int seconds = (i * 37) % 5000;
+        LoginStatus status = (i % 3 == 0) ? LoginStatus::SUCCESS : LoginStatus::FAILED;
+        entries.emplace_back(storeTimestamp(seconds),
+                             "user" + std::to_string(user),
+                             "10.0.0." + std::to_string(i % 5),
+                             status);
+    }
+    return entries;
+}
+
+/**
+ * Helper function to collect every visited user
+ */
+std::map<std::string, std::vector<LogEntry>> collectUsers(ExternalEntryStore& store)
+{
+    std::map<std::string, std::vector<LogEntry>> users;
+    bool success = store.forEachUser([&users](std::vector<LogEntry>& user_entries)
+    {
+        // Each user must be visited exactly once
+        REQUIRE(users.count(user_entries.front().username) == 0);
+        users[user_entries.front().username] = user_entries;
+    });
+    REQUIRE(success);
+    return users;
+}
+
+/**
+ * Helper function to check that visited users are complete and sorted
+ */
+void checkUsers(const std::map<std::string, std::vector<LogEntry>>& users,
+                const std::vector<LogEntry>& entries)
+{
+    size_t visited = 0;
+    for (const auto& [username, user_entries] : users)
+    {
+        for (size_t i = 0; i < user_entries.size(); ++i)
+        {
+            REQUIRE(user_entries[i].username == username);
+            if (i > 0)
+            {
+                REQUIRE(user_entries[i - 1].timestamp <= user_entries[i].timestamp);
+            }
+        }
+        visited += user_entries.size();
+    }
+    REQUIRE(visited == entries.size());
+}
+
+// ============================================================================
+// Tests for forEachUser()
+// ============================================================================
+
+TEST_CASE("ExternalEntryStore - Groups users in memory below the limit", "[ExternalEntryStore][forEachUser]")
+{
+    auto entries = createStoreEntries(500);
+    ExternalEntryStore store(64 << 20);
+    for (const auto& entry : entries)
+    {
+        REQUIRE(store.add(entry));
+    }
+
+    REQUIRE(store.size() == entries.size());
+    REQUIRE(store.runCount() == 0);
+
+    auto users = collectUsers(store);
+    REQUIRE(users.size() == 13);
+    checkUsers(users, entries);
+}
+
+TEST_CASE("ExternalEntryStore - Merges spilled runs per user", "[ExternalEntryStore][forEachUser]")
+{
+    auto entries = createStoreEntries(2000);
+
+    // A budget of a few entries forces many runs per partition
+    ExternalEntryStore store(2000, "", 4);
+    for (const auto& entry : entries)
+    {
+        REQUIRE(store.add(entry));
+    }
+
+    REQUIRE(store.runCount() > 4);
+
+    auto users = collectUsers(store);
+    REQUIRE(users.size() == 13);
+    checkUsers(users, entries);
+}
+
+TEST_CASE("ExternalEntryStore - Merges more runs than the fan-in in passes", "[ExternalEntryStore][forEachUser]")
+{
+    auto entries = createStoreEntries(4000);
+
+    // One partition with many runs, merged three at a time
+    ExternalEntryStore store(16 * 1024, "", 1, 3);
+    for (const auto& entry : entries)
+    {
+        REQUIRE(store.add(entry));
+    }
+
+    REQUIRE(store.fanIn() == 3);
+    REQUIRE(store.runCount() > 3 * 3);
+
+    auto users = collectUsers(store);
+    REQUIRE(users.size() == 13);
+    checkUsers(users, entries);
+}
+
+TEST_CASE("ExternalEntryStore - Fan-in follows the memory limit", "[ExternalEntryStore][fanIn]")
+{
+    // Tiny limits still merge two runs at a time
+    REQUIRE(ExternalEntryStore(1).fanIn() == 2);
+
+    // Larger limits allow more runs, with bigger buffers each
+    ExternalEntryStore small(1 << 20);
+    ExternalEntryStore large(256 << 20);
+    REQUIRE(small.fanIn() > 2);
+    REQUIRE(large.fanIn() >= small.fanIn());
+}
+
+TEST_CASE("ExternalEntryStore - Spilled entries round trip exactly", "[ExternalEntryStore][forEachUser]")
+{
+    auto timestamp = storeTimestamp(42) + std::chrono::milliseconds(250);
+    LogEntry original(timestamp, "jdoe", "2001:db8::1", LoginStatus::UNKNOWN);
+
+    ExternalEntryStore store(1);
+    REQUIRE(store.add(original));
+    REQUIRE(store.runCount() == 1);
+
+    auto users = collectUsers(store);
+    REQUIRE(users.size() == 1);
+    const LogEntry& restored = users["jdoe"][0];
+    REQUIRE(restored.timestamp == original.timestamp);
+    REQUIRE(restored.username == original.username);
+    REQUIRE(restored.ip_address == original.ip_address);
+    REQUIRE(restored.status == original.status);
+}
+
+TEST_CASE("ExternalEntryStore - Per-user detection matches in-memory detection", "[ExternalEntryStore][forEachUser]")
+{
+    auto entries = createStoreEntries(3000);
+    EventDetector detector(3, 10, 8, 18);
+
+    // Cross-user rules (spraying, failures from one IP) need all users at once
+    auto expected = detector.detectPerUser(entries);
+
+    ExternalEntryStore store(4096);
+    for (const auto& entry : entries)
+    {
+        REQUIRE(store.add(entry));
+    }
+
+    std::vector<SuspiciousEvent> events;
+    REQUIRE(store.forEachUser([&detector, &events](std::vector<LogEntry>& user_entries)
+    {
+        auto user_events = detector.detectPerUser(user_entries);
+        events.insert(events.end(), user_events.begin(), user_events.end());
+    }));
+
+    REQUIRE(events.size() == expected.size());
+
+    std::map<SuspiciousEventType, int> expected_counts;
+    std::map<SuspiciousEventType, int> counts;
+    for (const auto& event : expected)
+    {
+        expected_counts[event.type] += event.event_count;
+    }
+    for (const auto& event : events)
+    {
+        counts[event.type] += event.event_count;
+    }
+    REQUIRE(counts == expected_counts);
+}
+
+// ============================================================================
+// Tests for forEachInTimeOrder()
+// ============================================================================
+
+/**
+ * Helper function to build a shuffled log in which many entries share a timestamp
+ */
+std::vector<LogEntry> createTiedEntries(int count)
+{
+    auto entries = createStoreEntries(count);
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        entries[i].timestamp = storeTimestamp(static_cast<int>((i * 37) % 5000) / 20);
+    }
+    return entries;
+}
+
+/**
+ * Helper function to check a time-ordered visit against a stable sort of the input
+ */
+void checkTimeOrder(ExternalEntryStore& store, std::vector<LogEntry> entries)
+{
+    std::vector<LogEntry> visited;
+    REQUIRE(store.forEachInTimeOrder([&visited](const LogEntry& entry)
+    {
+        visited.push_back(entry);
+    }));
+
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const LogEntry& a, const LogEntry& b) { return a.timestamp < b.timestamp; });
+    REQUIRE(visited.size() == entries.size());
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        REQUIRE(visited[i].timestamp == entries[i].timestamp);
+        REQUIRE(visited[i].username == entries[i].username);
+        REQUIRE(visited[i].ip_address == entries[i].ip_address);
+        REQUIRE(visited[i].status == entries[i].status);
+    }
+}
+
+TEST_CASE("ExternalEntryStore - Visits buffered entries in time order", "[ExternalEntryStore][forEachInTimeOrder]")
+{
+    auto entries = createTiedEntries(500);
+    ExternalEntryStore store(64 << 20);
+    for (const auto& entry : entries)
+    {
+        REQUIRE(store.add(entry));
+    }
+
+    checkTimeOrder(store, entries);
+    REQUIRE(store.runCount() == 0);
+
+    // The entries are still there for the per-user detectors
+    auto users = collectUsers(store);
+    checkUsers(users, entries);
+}
+
+TEST_CASE("ExternalEntryStore - Visits spilled entries in time order", "[ExternalEntryStore][forEachInTimeOrder]")
+{
+    auto entries = createTiedEntries(4000);
+
+    // Small runs in one partition, merged three at a time in both orders
+    ExternalEntryStore store(16 * 1024, "", 1, 3);
+    for (const auto& entry : entries)
+    {
+        REQUIRE(store.add(entry));
+    }
+    REQUIRE(store.runCount() > 3 * 3);
+
+    checkTimeOrder(store, entries);
+
+    auto users = collectUsers(store);
+    REQUIRE(users.size() == 13);
+    checkUsers(users, entries);
+}
+
+TEST_CASE("ExternalEntryStore - Cross-user trackers match the in-memory replay", "[ExternalEntryStore][forEachInTimeOrder]")
+{
+    // A success read before the failures it ends, and a spray whose
+    // first failures arrive after its later ones (two swapped dumps)
+    std::vector<LogEntry> entries;
+    entries.emplace_back(storeTimestamp(300), "eve", "1.2.3.4", LoginStatus::SUCCESS);
+    for (int i = 0; i < 5; ++i)
+    {
+        std::string user(1, static_cast<char>('a' + i));
+        entries.emplace_back(storeTimestamp(60 * i), user, "1.2.3.4", LoginStatus::FAILED);
+    }
+    for (int i = 3; i < 6; ++i)
+    {
+        entries.emplace_back(storeTimestamp(60 * i), "user" + std::to_string(i), "5.6.7.8",
+                             LoginStatus::FAILED);
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        entries.emplace_back(storeTimestamp(60 * i), "user" + std::to_string(i), "5.6.7.8",
+                             LoginStatus::FAILED);
+    }
+
+    // In memory: stable sort of the user timelines, replayed by timestamp
+    UserTimelines user_timelines;
+    for (const auto& entry : entries)
+    {
+        user_timelines.add(entry);
+    }
+    std::vector<std::vector<std::uint64_t>> arrivals;
+    auto timelines = user_timelines.release(arrivals);
+    UserTimelines::sortArrivals(timelines, arrivals);
+    EventDetector(5, 10, 8, 18).sortTimelines(timelines);
+
+    IpFailureTracker memory_failures(10, 5);
+    PasswordSprayTracker memory_spraying(10, 6);
+    UserTimelines::forEachInTimeOrder(timelines, arrivals, [&](const LogEntry& entry)
+    {
+        memory_failures.observe(entry);
+        memory_spraying.observe(entry);
+    });
+
+    // External: every entry spilled as a run of its own
+    ExternalEntryStore store(1);
+    for (const auto& entry : entries)
+    {
+        REQUIRE(store.add(entry));
+    }
+    IpFailureTracker external_failures(10, 5);
+    PasswordSprayTracker external_spraying(10, 6);
+    REQUIRE(store.forEachInTimeOrder([&](const LogEntry& entry)
+    {
+        external_failures.observe(entry);
+        external_spraying.observe(entry);
+    }));
+
+    auto expected = memory_failures.finish();
+    auto spraying = memory_spraying.finish();
+    expected.insert(expected.end(), spraying.begin(), spraying.end());
+    auto events = external_failures.finish();
+    spraying = external_spraying.finish();
+    events.insert(events.end(), spraying.begin(), spraying.end());
+
+    REQUIRE(expected.size() == 2);
+    REQUIRE(expected[0].type == SuspiciousEventType::SUCCESS_AFTER_FAILURES);
+    REQUIRE(expected[1].type == SuspiciousEventType::PASSWORD_SPRAYING);
+    REQUIRE(expected[1].first_occurrence == storeTimestamp(0));
+
+    REQUIRE(events.size() == expected.size());
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        REQUIRE(events[i].type == expected[i].type);
+        REQUIRE(events[i].username == expected[i].username);
+        REQUIRE(events[i].ip_addresses == expected[i].ip_addresses);
+        REQUIRE(events[i].first_occurrence == expected[i].first_occurrence);
+        REQUIRE(events[i].last_occurrence == expected[i].last_occurrence);
+        REQUIRE(events[i].event_count == expected[i].event_count);
+    }
+}
+
+// ============================================================================
+// Tests for spill files
+// ============================================================================
+
+TEST_CASE("ExternalEntryStore - Removes spill files", "[ExternalEntryStore][files]")
+{
+    std::filesystem::path directory = "test_spill_dir";
+    std::filesystem::create_directory(directory);
+
+    {
+        ExternalEntryStore store(100, directory.string());
+        for (const auto& entry : createStoreEntries(200))
+        {
+            REQUIRE(store.add(entry));
+        }
+        REQUIRE_FALSE(std::filesystem::is_empty(directory));
+    }
+
+    REQUIRE(std::filesystem::is_empty(directory));
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("ExternalEntryStore - Reports unwritable spill directory", "[ExternalEntryStore][files]")
+{
+    ExternalEntryStore store(1, "nonexistent_spill_dir/subdir");
+
+    LogEntry entry(storeTimestamp(0), "alice", "10.0.0.1", LoginStatus::SUCCESS);
+    REQUIRE_FALSE(store.add(entry));
+}
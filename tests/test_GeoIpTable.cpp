@@ -0,0 +1,192 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GeoIpTable.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Unit tests for GeoIpTable class
+ * 
+ * These tests verify:
+ * - IPv4 address parsing
+ * - Loading CSV tables with headers, comments, quotes and integer addresses
+ * - Lookups inside, between and outside ranges
+ * - Rejection of invalid lines and overlapping ranges
+ * - Round trip through the binary form
+ * - Rejection of binary files with unsorted ranges
+ * - Great-circle distances
+ */
+
+/**
+ * Helper function to write a text file
+ */
+void writeFile(const std::string& path, const std::string& content) 
+{
+    std::ofstream file(path);
+    file << content;
+}
+
+/**
+ * Helper function returning a small table: Berlin, New York, Sydney
+ */
+std::string createTestCsv() 
+{
+    return "first_ip,last_ip,latitude,longitude,country\n"
+           "# Europe\n"
+           "10.0.0.0,10.0.255.255,52.52,13.40,DE\n"
+           "\"10.2.0.0\",\"10.2.255.255\",40.71,-74.01,US\n"
+           "\n"
+           "169738240,169803775,-33.87,151.21,AU\n";   // 10.30.0.0 - 10.30.255.255
+}
+
+// ============================================================================
+// Tests for parseIPv4()
+// ============================================================================
+
+TEST_CASE("GeoIpTable - Parses IPv4 addresses", "[GeoIpTable][parseIPv4]") 
+{
+    REQUIRE(GeoIpTable::parseIPv4("0.0.0.0") == 0u);
+    REQUIRE(GeoIpTable::parseIPv4("10.1.2.3") == 0x0A010203u);
+    REQUIRE(GeoIpTable::parseIPv4("255.255.255.255") == 0xFFFFFFFFu);
+    
+    REQUIRE_FALSE(GeoIpTable::parseIPv4("256.0.0.1").has_value());
+    REQUIRE_FALSE(GeoIpTable::parseIPv4("10.0.0").has_value());
+    REQUIRE_FALSE(GeoIpTable::parseIPv4("10.0.0.1.5").has_value());
+    REQUIRE_FALSE(GeoIpTable::parseIPv4("10.0.0.1 ").has_value());
+    REQUIRE_FALSE(GeoIpTable::parseIPv4("::1").has_value());
+}
+
+// ============================================================================
+// Tests for load() and lookup()
+// ============================================================================
+
+TEST_CASE("GeoIpTable - Loads a CSV table and looks up addresses", "[GeoIpTable][lookup]") 
+{
+    std::string path = "test_geoip.csv";
+    writeFile(path, createTestCsv());
+    
+    GeoIpTable table;
+    REQUIRE(table.load(path));
+    REQUIRE(table.size() == 3);
+    
+    const GeoIpRange* berlin = table.lookup("10.0.12.34");
+    REQUIRE(berlin != nullptr);
+    REQUIRE(std::string(berlin->country) == "DE");
+    
+    const GeoIpRange* new_york = table.lookup("10.2.255.255");
+    REQUIRE(new_york != nullptr);
+    REQUIRE(std::string(new_york->country) == "US");
+    
+    const GeoIpRange* sydney = table.lookup("10.30.0.0");
+    REQUIRE(sydney != nullptr);
+    REQUIRE(std::string(sydney->country) == "AU");
+    
+    // Between, before and after ranges, and invalid addresses
+    REQUIRE(table.lookup("10.1.0.1") == nullptr);
+    REQUIRE(table.lookup("9.255.255.255") == nullptr);
+    REQUIRE(table.lookup("192.168.1.1") == nullptr);
+    REQUIRE(table.lookup("not-an-ip") == nullptr);
+    
+    std::remove(path.c_str());
+}
+
+TEST_CASE("GeoIpTable - Rejects invalid lines and overlapping ranges", "[GeoIpTable][load]") 
+{
+    std::string path = "test_geoip_invalid.csv";
+    GeoIpTable table;
+    
+    writeFile(path, "10.0.0.0,10.0.0.255,52.5,13.4\n10.0.1.0,10.0.1.255,95.0,13.4\n");
+    REQUIRE_FALSE(table.load(path));
+    REQUIRE(table.failedLine() == 2);
+    
+    writeFile(path, "10.0.0.0,10.0.0.255,52.5,13.4\n10.0.0.128,10.0.1.255,40.7,-74.0\n");
+    REQUIRE_FALSE(table.load(path));
+    REQUIRE(table.failedLine() == 0);
+    REQUIRE(table.size() == 0);
+    
+    REQUIRE_FALSE(table.load("no_such_geoip_file.csv"));
+    
+    std::remove(path.c_str());
+}
+
+TEST_CASE("GeoIpTable - Binary form gives the same lookups", "[GeoIpTable][saveBinary]") 
+{
+    std::string csv_path = "test_geoip_source.csv";
+    std::string binary_path = "test_geoip.bin";
+    writeFile(csv_path, createTestCsv());
+    
+    GeoIpTable source;
+    REQUIRE(source.load(csv_path));
+    REQUIRE(source.saveBinary(binary_path));
+    
+    GeoIpTable mapped;
+    REQUIRE(mapped.load(binary_path));
+    REQUIRE(mapped.size() == source.size());
+    
+    for (const char* ip : {"10.0.0.1", "10.2.3.4", "10.30.200.1", "10.1.0.1"}) 
+    {
+        const GeoIpRange* expected = source.lookup(ip);
+        const GeoIpRange* actual = mapped.lookup(ip);
+        REQUIRE((expected == nullptr) == (actual == nullptr));
+        if (expected != nullptr) 
+        {
+            REQUIRE(actual->first == expected->first);
+            REQUIRE(actual->latitude == expected->latitude);
+            REQUIRE(std::string(actual->country) == std::string(expected->country));
+        }
+    }
+    
+    std::remove(csv_path.c_str());
+    std::remove(binary_path.c_str());
+}
+
+TEST_CASE("GeoIpTable - Rejects binary files with unsorted ranges", "[GeoIpTable][load]") 
+{
+    std::string csv_path = "test_geoip_source.csv";
+    std::string binary_path = "test_geoip_unsorted.bin";
+    writeFile(csv_path, createTestCsv());
+    
+    GeoIpTable source;
+    REQUIRE(source.load(csv_path));
+    REQUIRE(source.saveBinary(binary_path));
+    
+    // Swap the last two ranges, which the binary search cannot handle
+    std::vector<char> bytes;
+    {
+        std::ifstream file(binary_path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    REQUIRE(bytes.size() >= 2 * sizeof(GeoIpRange));
+    char* last = bytes.data() + bytes.size() - sizeof(GeoIpRange);
+    std::swap_ranges(last - sizeof(GeoIpRange), last, last);
+    {
+        std::ofstream file(binary_path, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    
+    GeoIpTable mapped;
+    REQUIRE_FALSE(mapped.load(binary_path));
+    REQUIRE(mapped.size() == 0);
+    
+    std::remove(csv_path.c_str());
+    std::remove(binary_path.c_str());
+}
+
+// ============================================================================
+// Tests for distanceKm()
+// ============================================================================
+
+TEST_CASE("GeoIpTable - Computes great-circle distances", "[GeoIpTable][distanceKm]") 
+{
+    GeoIpRange berlin = {0, 0, 52.52f, 13.40f, "DE"};
+    GeoIpRange new_york = {0, 0, 40.71f, -74.01f, "US"};
+    
+    double distance = GeoIpTable::distanceKm(berlin, new_york);
+    REQUIRE(distance > 6300.0);
+    REQUIRE(distance < 6450.0);
+    REQUIRE(GeoIpTable::distanceKm(berlin, berlin) < 0.001);
+}
@@ -0,0 +1,115 @@
+#include <catch2/catch_test_macros.hpp>
+#include "HeavyHitters.h"
+#include <string>
+
+/**
+ * Unit tests for HeavyHitters class
+ * 
+ * These tests verify:
+ * - Exact counts while all keys fit
+ * - Ranking order by count, ties by key
+ * - Frequent keys survive a long tail of rare keys, with bounded error
+ * - Zero capacity tracks nothing
+ */
+
+// ============================================================================
+// Tests for add() and top()
+// ============================================================================
+
+TEST_CASE("HeavyHitters - Exact counts while all keys fit", "[HeavyHitters][top]") 
+{
+    HeavyHitters hitters(8);
+    
+    for (int i = 0; i < 5; ++i) 
+    {
+        hitters.add("alice");
+    }
+    hitters.add("bob");
+    hitters.add("bob");
+    hitters.add("carol");
+    
+    auto top = hitters.top(10);
+    REQUIRE(top.size() == 3);
+    REQUIRE(top[0].key == "alice");
+    REQUIRE(top[0].count == 5);
+    REQUIRE(top[0].error == 0);
+    REQUIRE(top[1].key == "bob");
+    REQUIRE(top[1].count == 2);
+    REQUIRE(top[2].key == "carol");
+    REQUIRE(hitters.total() == 8);
+    REQUIRE(hitters.maxUntrackedCount() == 0);
+}
+
+TEST_CASE("HeavyHitters - Ties are ordered by key", "[HeavyHitters][top]") 
+{
+    HeavyHitters hitters(8);
+    hitters.add("zed");
+    hitters.add("amy");
+    hitters.add("kim");
+    
+    auto top = hitters.top(2);
+    REQUIRE(top.size() == 2);
+    REQUIRE(top[0].key == "amy");
+    REQUIRE(top[1].key == "kim");
+}
+
+TEST_CASE("HeavyHitters - Frequent keys survive many rare keys", "[HeavyHitters][top]") 
+{
+    HeavyHitters hitters(64);
+    
+    // Three heavy keys interleaved with 10000 keys seen once; every key
+    // above total / 64 (about 184) occurrences is guaranteed to be tracked
+    for (int i = 0; i < 10000; ++i) 
+    {
+        hitters.add("rare" + std::to_string(i));
+        if (i % 10 == 0) 
+        {
+            hitters.add("10.0.0.1");
+        }
+        if (i % 20 == 0) 
+        {
+            hitters.add("10.0.0.2");
+        }
+        if (i % 40 == 0) 
+        {
+            hitters.add("10.0.0.3");
+        }
+    }
+    
+    auto top = hitters.top(3);
+    REQUIRE(top.size() == 3);
+    REQUIRE(top[0].key == "10.0.0.1");
+    REQUIRE(top[1].key == "10.0.0.2");
+    REQUIRE(top[2].key == "10.0.0.3");
+    
+    // Counts never underestimate and are within the recorded error
+    REQUIRE(top[0].count >= 1000);
+    REQUIRE(top[0].count - top[0].error <= 1000);
+    REQUIRE(top[2].count >= 250);
+    REQUIRE(top[2].count - top[2].error <= 250);
+    
+    // The heavy keys are certainly above any dropped key
+    REQUIRE(top[2].count - top[2].error > hitters.maxUntrackedCount());
+}
+
+TEST_CASE("HeavyHitters - Zero capacity tracks nothing", "[HeavyHitters][top]") 
+{
+    HeavyHitters hitters(0);
+    hitters.add("alice");
+    
+    REQUIRE(hitters.top(5).empty());
+    REQUIRE(hitters.total() == 0);
+}
+
+TEST_CASE("HeavyHitters - Clear removes all keys", "[HeavyHitters][clear]") 
+{
+    HeavyHitters hitters(4);
+    hitters.add("alice");
+    hitters.clear();
+    
+    REQUIRE(hitters.top(5).empty());
+    REQUIRE(hitters.total() == 0);
+    
+    hitters.add("bob");
+    REQUIRE(hitters.top(5)[0].key == "bob");
+}
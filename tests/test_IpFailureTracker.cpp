@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+#include "IpFailureTracker.h"
+#include <chrono>
+#include <string>
+
+/**
+ * Unit tests for IpFailureTracker class
+ *
+ * These tests verify:
+ * - Successes after failures of several users from the same IP
+ * - Threshold and time window handling
+ * - Bursts of only the successful user are left to the per-user scan
+ * - Each burst is reported once
+ */
+
+/**
+ * Helper function to create a timestamp a number of seconds after a fixed base
+ */
+std::chrono::system_clock::time_point ipTimestamp(int seconds)
+{
+    return std::chrono::system_clock::from_time_t(1768000000) + std::chrono::seconds(seconds);
+}
+
+/**
+ * Helper function to observe failures for user0 .. user<count-1> from one IP
+ */
+void observeFailures(IpFailureTracker& tracker, const std::string& ip,
+                     int count, int first_second, int step_seconds)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        tracker.observe(LogEntry(ipTimestamp(first_second + i * step_seconds),
+                                 "user" + std::to_string(i), ip, LoginStatus::FAILED));
+    }
+}
+
+// ============================================================================
+// Tests for observe() and finish()
+// ============================================================================
+
+TEST_CASE("IpFailureTracker - Reports a success after failures from its IP", "[IpFailureTracker][observe]")
+{
+    IpFailureTracker tracker(10, 5);
+    observeFailures(tracker, "203.0.113.5", 6, 0, 30);
+    tracker.observe(LogEntry(ipTimestamp(200), "user3", "203.0.113.5", LoginStatus::SUCCESS));
+
+    auto events = tracker.finish();
+
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0].type == SuspiciousEventType::SUCCESS_AFTER_FAILURES);
+    REQUIRE(events[0].username == "user3");
+    REQUIRE(events[0].ip_addresses.size() == 1);
+    REQUIRE(events[0].ip_addresses[0] == "203.0.113.5");
+    REQUIRE(events[0].event_count == 6);
+    REQUIRE(events[0].first_occurrence == ipTimestamp(0));
+    REQUIRE(events[0].last_occurrence == ipTimestamp(200));
+}
+
+TEST_CASE("IpFailureTracker - Ignores successes from other IPs and small bursts", "[IpFailureTracker][observe]")
+{
+    IpFailureTracker tracker(10, 5);
+    observeFailures(tracker, "203.0.113.5", 4, 0, 30);
+    tracker.observe(LogEntry(ipTimestamp(150), "user1", "203.0.113.5", LoginStatus::SUCCESS));
+    observeFailures(tracker, "203.0.113.6", 5, 200, 30);
+    tracker.observe(LogEntry(ipTimestamp(400), "user1", "198.51.100.7", LoginStatus::SUCCESS));
+
+    REQUIRE(tracker.finish().empty());
+}
+
+TEST_CASE("IpFailureTracker - Failures that left the window do not count", "[IpFailureTracker][observe]")
+{
+    IpFailureTracker tracker(10, 5);
+    observeFailures(tracker, "203.0.113.5", 5, 0, 60);
+
+    // Eleven minutes after the first failure only four are in the window
+    tracker.observe(LogEntry(ipTimestamp(11 * 60 + 30), "user0", "203.0.113.5", LoginStatus::SUCCESS));
+
+    REQUIRE(tracker.finish().empty());
+}
+
+TEST_CASE("IpFailureTracker - Leaves failures of only the successful user to the per-user scan", "[IpFailureTracker][observe]")
+{
+    IpFailureTracker tracker(10, 5);
+    for (int i = 0; i < 6; ++i)
+    {
+        tracker.observe(LogEntry(ipTimestamp(i * 10), "admin", "203.0.113.5", LoginStatus::FAILED));
+    }
+    tracker.observe(LogEntry(ipTimestamp(100), "admin", "203.0.113.5", LoginStatus::SUCCESS));
+
+    REQUIRE(tracker.finish().empty());
+}
+
+TEST_CASE("IpFailureTracker - Reports each burst once", "[IpFailureTracker][observe]")
+{
+    IpFailureTracker tracker(10, 5);
+    observeFailures(tracker, "203.0.113.5", 5, 0, 10);
+    tracker.observe(LogEntry(ipTimestamp(60), "user1", "203.0.113.5", LoginStatus::SUCCESS));
+    tracker.observe(LogEntry(ipTimestamp(70), "user2", "203.0.113.5", LoginStatus::SUCCESS));
+
+    // A new burst is reported again
+    observeFailures(tracker, "203.0.113.5", 5, 100, 10);
+    tracker.observe(LogEntry(ipTimestamp(200), "user4", "203.0.113.5", LoginStatus::SUCCESS));
+
+    auto events = tracker.finish();
+
+    REQUIRE(events.size() == 2);
+    REQUIRE(events[0].username == "user1");
+    REQUIRE(events[0].event_count == 5);
+    REQUIRE(events[1].username == "user4");
+    REQUIRE(events[1].first_occurrence == ipTimestamp(100));
+}
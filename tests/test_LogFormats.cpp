@@ -0,0 +1,197 @@
+#include <catch2/catch_test_macros.hpp>
+#include "LogFormats.h"
+#include <chrono>
+#include <string>
+
+/**
+ * Unit tests for the LogFormats policies
+ * 
+ * These tests verify:
+ * - Format name lookup
+ * - Field location for pipe, syslog, JSON and CSV lines
+ * - Skipping of lines that carry no login event
+ * - Error classification for malformed lines
+ * - Timestamp conversion consistent with the pipe format
+ * - Syslog year rollover
+ */
+
+using LogParser::LogFields;
+using LogParser::ParseError;
+
+// ============================================================================
+// Tests for parseInputFormat()
+// ============================================================================
+
+TEST_CASE("LogFormats - Format names", "[LogFormats][parseInputFormat]") 
+{
+    REQUIRE(LogFormats::parseInputFormat("pipe") == LogFormats::InputFormat::PIPE);
+    REQUIRE(LogFormats::parseInputFormat("SYSLOG") == LogFormats::InputFormat::SYSLOG);
+    REQUIRE(LogFormats::parseInputFormat("Json") == LogFormats::InputFormat::JSON);
+    REQUIRE(LogFormats::parseInputFormat("csv") == LogFormats::InputFormat::CSV);
+    REQUIRE_FALSE(LogFormats::parseInputFormat("xml").has_value());
+    REQUIRE(std::string(LogFormats::inputFormatName(LogFormats::InputFormat::CSV)) == "csv");
+}
+
+// ============================================================================
+// Tests for SyslogFormat
+// ============================================================================
+
+TEST_CASE("SyslogFormat - Failed and accepted logins", "[LogFormats][syslog]") 
+{
+    LogFormats::SyslogFormat format(2026);
+    LogFields fields;
+    ParseError error = ParseError::NONE;
+    
+    REQUIRE(format.locate("Jan 18 08:45:12 web1 sshd[1234]: Failed password for "
+                          "invalid user admin from 10.0.0.5 port 51234 ssh2", fields, error));
+    REQUIRE(fields.username == "admin");
+    REQUIRE(fields.ip_address == "10.0.0.5");
+    REQUIRE(fields.status == "FAILED");
+    REQUIRE(fields.timestamp == "Jan 18 08:45:12");
+    
+    REQUIRE(format.locate("Jan  8 22:01:00 web1 sshd[99]: Accepted publickey for "
+                          "alice from 192.168.1.7 port 22 ssh2: RSA SHA256:abc", fields, error));
+    REQUIRE(fields.username == "alice");
+    REQUIRE(fields.ip_address == "192.168.1.7");
+    REQUIRE(fields.status == "SUCCESS");
+    
+    auto entry = LogFormats::materialize(format, fields, error);
+    REQUIRE(entry.has_value());
+    REQUIRE(error == ParseError::NONE);
+    REQUIRE(entry->timestamp == LogParser::parseTimestamp("2026-01-08 22:01:00"));
+}
+
+TEST_CASE("SyslogFormat - Unrelated messages are skipped", "[LogFormats][syslog]") 
+{
+    LogFormats::SyslogFormat format(2026);
+    LogFields fields;
+    ParseError error = ParseError::BAD_TIMESTAMP;
+    
+    REQUIRE_FALSE(format.locate("Jan 18 08:45:12 web1 CRON[55]: pam_unix(cron:session): "
+                                "session opened for user root", fields, error));
+    REQUIRE(error == ParseError::NONE);
+    
+    REQUIRE_FALSE(format.locate("Jan 18 08:45:12 web1 sshd[1234]: Connection closed by "
+                                "10.0.0.5 port 51234", fields, error));
+    REQUIRE(error == ParseError::NONE);
+}
+
+TEST_CASE("SyslogFormat - Malformed lines are invalid", "[LogFormats][syslog]") 
+{
+    LogFormats::SyslogFormat format(2026);
+    LogFields fields;
+    ParseError error = ParseError::NONE;
+    
+    REQUIRE_FALSE(format.locate("garbage", fields, error));
+    REQUIRE(error == ParseError::FIELD_COUNT);
+    
+    REQUIRE_FALSE(format.locate("Jan 18 08:45:12 web1 sshd[1]: Failed password for bob", 
+                                fields, error));
+    REQUIRE(error == ParseError::FIELD_COUNT);
+    
+    REQUIRE_FALSE(format.parseTimestamp("Foo 18 08:45:12").has_value());
+}
+
+TEST_CASE("SyslogFormat - Months after the last one are from the year before", "[LogFormats][syslog]") 
+{
+    // A log last written in January 2026 that started in December
+    LogFormats::SyslogFormat format(2026, 1);
+    
+    REQUIRE(format.parseTimestamp("Dec 31 23:59:58") == LogParser::parseTimestamp("2025-12-31 23:59:58"));
+    REQUIRE(format.parseTimestamp("Jan  1 00:00:01") == LogParser::parseTimestamp("2026-01-01 00:00:01"));
+    
+    // Without a last month every timestamp is in the given year
+    LogFormats::SyslogFormat whole_year(2026);
+    REQUIRE(whole_year.parseTimestamp("Dec 31 23:59:58") == LogParser::parseTimestamp("2026-12-31 23:59:58"));
+}
+
+// ============================================================================
+// Tests for JsonFormat
+// ============================================================================
+
+TEST_CASE("JsonFormat - Object with ISO timestamp", "[LogFormats][json]") 
+{
+    LogFormats::JsonFormat format;
+    LogFields fields;
+    ParseError error = ParseError::NONE;
+    
+    REQUIRE(format.locate(R"({"timestamp": "2026-01-18T08:45:12", "user": "bob", )"
+                          R"("ip": "10.0.0.1", "status": "failed", "port": 22})", fields, error));
+    REQUIRE(fields.username == "bob");
+    REQUIRE(fields.ip_address == "10.0.0.1");
+    
+    auto entry = LogFormats::materialize(format, fields, error);
+    REQUIRE(entry.has_value());
+    REQUIRE(entry->status == LoginStatus::FAILED);
+    REQUIRE(entry->timestamp == LogParser::parseTimestamp("2026-01-18 08:45:12"));
+}
+
+TEST_CASE("JsonFormat - Alternative keys", "[LogFormats][json]") 
+{
+    LogFormats::JsonFormat format;
+    LogFields fields;
+    ParseError error = ParseError::NONE;
+    
+    REQUIRE(format.locate(R"({"status":"SUCCESS","ip_address":"10.0.0.2",)"
+                          R"("username":"carol","timestamp":"2026-01-18 09:00:00"})", fields, error));
+    REQUIRE(fields.username == "carol");
+    REQUIRE(fields.ip_address == "10.0.0.2");
+}
+
+TEST_CASE("JsonFormat - Missing keys and escapes are invalid", "[LogFormats][json]") 
+{
+    LogFormats::JsonFormat format;
+    LogFields fields;
+    ParseError error = ParseError::NONE;
+    
+    REQUIRE_FALSE(format.locate(R"({"timestamp":"2026-01-18 09:00:00","user":"x"})", fields, error));
+    REQUIRE(error == ParseError::FIELD_COUNT);
+    
+    REQUIRE_FALSE(format.locate(R"({"timestamp":"2026-01-18 09:00:00","user":"a\"b",)"
+                                R"("ip":"1.1.1.1","status":"FAILED"})", fields, error));
+    REQUIRE(error == ParseError::FIELD_COUNT);
+    
+    REQUIRE_FALSE(format.locate(R"({"timestamp":"2026-01-18 09:00:00","user":"",)"
+                                R"("ip":"1.1.1.1","status":"FAILED"})", fields, error));
+    REQUIRE(error == ParseError::EMPTY_FIELD);
+    
+    REQUIRE_FALSE(format.locate("not json", fields, error));
+    REQUIRE(error == ParseError::FIELD_COUNT);
+}
+
+// ============================================================================
+// Tests for CsvFormat
+// ============================================================================
+
+TEST_CASE("CsvFormat - Plain and quoted fields", "[LogFormats][csv]") 
+{
+    LogFormats::CsvFormat format;
+    LogFields fields;
+    ParseError error = ParseError::NONE;
+    
+    REQUIRE(format.locate("2026-01-18 08:45:12,dave,10.0.0.3,FAILED", fields, error));
+    REQUIRE(fields.username == "dave");
+    REQUIRE(fields.status == "FAILED");
+    
+    REQUIRE(format.locate("\"2026-01-18T08:45:12\", \"eve\" ,\"10.0.0.4\",SUCCESS", fields, error));
+    REQUIRE(fields.timestamp == "2026-01-18T08:45:12");
+    REQUIRE(fields.username == "eve");
+    REQUIRE(format.parseTimestamp(fields.timestamp) == 
+            LogParser::parseTimestamp("2026-01-18 08:45:12"));
+}
+
+TEST_CASE("CsvFormat - Header is skipped, wrong column count is invalid", "[LogFormats][csv]") 
+{
+    LogFormats::CsvFormat format;
+    LogFields fields;
+    ParseError error = ParseError::BAD_TIMESTAMP;
+    
+    REQUIRE_FALSE(format.locate("timestamp,user,ip,status", fields, error));
+    REQUIRE(error == ParseError::NONE);
+    
+    REQUIRE_FALSE(format.locate("2026-01-18 08:45:12,dave,10.0.0.3", fields, error));
+    REQUIRE(error == ParseError::FIELD_COUNT);
+    
+    REQUIRE_FALSE(format.locate("2026-01-18 08:45:12,dave,10.0.0.3,FAILED,extra", fields, error));
+    REQUIRE(error == ParseError::FIELD_COUNT);
+}
@@ -0,0 +1,512 @@
+#include <catch2/catch_test_macros.hpp>
+#include "LogLoader.h"
+#include "BoundedQueue.h"
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <utime.h>
+
+/**
+ * Unit tests for LogLoader class and the BoundedQueue it is built on
+ * 
+ * These tests verify:
+ * - Sequential and pipelined loading produce identical results
+ * - Correct line numbering across chunk boundaries
+ * - Parse-time filtering and invalid line accounting
+ * - Detection of out-of-order timestamps
+ * - Joining the pipeline threads when the sink throws
+ * - Syslog years inferred from file modification times
+ * - Queue ordering and end-of-stream handling
+ */
+
+/**
+ * Helper function to build a log with a mix of valid and invalid lines
+ */
+std::string buildTestLog(int lines) 
+{
+    std::string log;
+    for (int i = 0; i < lines; ++i) 
+    {
+        if (i % 7 == 3) 
+        {
+            log += "corrupted line " + std::to_string(i) + "\n";
+        } 
+        else if (i % 11 == 5) 
+        {
+            log += "\n";
+        } 
+        else 
+        {
+            std::string user = (i % 2 == 0) ? "alice" : "bob";
+            std::string status = (i % 3 == 0) ? "FAILED" : "SUCCESS";
+            log += "2026-01-18 10:" + std::string(i % 60 < 10 ? "0" : "") + 
+                   std::to_string(i % 60) + ":00 | " + user + 
+                   " | 10.0.0." + std::to_string(i % 5) + " | " + status + "\n";
+        }
+    }
+    return log;
+}
+
+/**
+ * Helper function to load a string and collect all entries
+ */
+std::vector<LogEntry> loadString(const std::string& text, LogLoader& loader) 
+{
+    std::istringstream input(text);
+    std::vector<LogEntry> entries;
+    loader.loadStream(input, [&entries](std::vector<LogEntry>& batch) 
+    {
+        entries.insert(entries.end(), batch.begin(), batch.end());
+    });
+    return entries;
+}
+
+// ============================================================================
+// Tests for sequential loading
+// ============================================================================
+
+TEST_CASE("LogLoader - Sequential load counts lines and entries", "[LogLoader][sequential]") 
+{
+    LoaderOptions options;
+    options.worker_threads = 0;
+    std::ostringstream warnings;
+    LogLoader loader(options, warnings);
+    
+    std::string text = 
+        "2026-01-18 08:15:30 | alice | 192.168.1.10 | SUCCESS\n"
+        "\n"
+        "garbage\n"
+        "2026-01-18 08:45:12 | bob | 192.168.1.15 | FAILED";   // No trailing newline
+    
+    auto entries = loadString(text, loader);
+    
+    REQUIRE(entries.size() == 2);
+    REQUIRE(entries[1].username == "bob");
+    REQUIRE(loader.statistics().lines_processed == 4);
+    REQUIRE(loader.statistics().invalid_entries == 1);
+    REQUIRE(loader.diagnostics().samples()[0].line_number == 3);
+    REQUIRE(warnings.str().empty());
+}
+
+TEST_CASE("LogLoader - Small chunks split lines correctly", "[LogLoader][sequential]") 
+{
+    LoaderOptions options;
+    options.worker_threads = 0;
+    options.chunk_bytes = 7;   // Smaller than a single line
+    std::ostringstream warnings;
+    LogLoader loader(options, warnings);
+    
+    std::string text = buildTestLog(50);
+    auto entries = loadString(text, loader);
+    
+    LoaderOptions reference_options;
+    reference_options.worker_threads = 0;
+    LogLoader reference(reference_options, warnings);
+    auto expected = loadString(text, reference);
+    
+    REQUIRE(entries.size() == expected.size());
+    REQUIRE(loader.statistics().lines_processed == 50);
+    REQUIRE(loader.diagnostics().samples()[0].line_number == 
+            reference.diagnostics().samples()[0].line_number);
+}
+
+TEST_CASE("LogLoader - Filter drops lines before materializing", "[LogLoader][filter]") 
+{
+    LoaderOptions options;
+    options.worker_threads = 0;
+    options.filter.username = "alice";
+    std::ostringstream warnings;
+    LogLoader loader(options, warnings);
+    
+    std::string text = 
+        "2026-01-18 08:15:30 | alice | 192.168.1.10 | SUCCESS\n"
+        "bad-timestamp | bob | 192.168.1.15 | FAILED\n";
+    
+    auto entries = loadString(text, loader);
+    
+    // bob's line is filtered before its bad timestamp is ever parsed
+    REQUIRE(entries.size() == 1);
+    REQUIRE(loader.statistics().filtered_entries == 1);
+    REQUIRE(loader.statistics().invalid_entries == 0);
+}
+
+TEST_CASE("LogLoader - Verbose mode writes one warning per invalid line", "[LogLoader][diagnostics]") 
+{
+    LoaderOptions options;
+    options.worker_threads = 0;
+    options.verbose_errors = true;
+    std::ostringstream warnings;
+    LogLoader loader(options, warnings);
+    
+    loadString("garbage\nmore garbage\n", loader);
+    
+    REQUIRE(warnings.str().find("line 1") != std::string::npos);
+    REQUIRE(warnings.str().find("line 2") != std::string::npos);
+}
+
+TEST_CASE("LogLoader - Missing file reports failure", "[LogLoader][loadFile]") 
+{
+    LoaderOptions options;
+    std::ostringstream warnings;
+    LogLoader loader(options, warnings);
+    
+    bool success = loader.loadFile("/nonexistent/file.log", [](std::vector<LogEntry>&) {});
+    
+    REQUIRE_FALSE(success);
+}
+
+// ============================================================================
+// Tests for pipelined loading
+// ============================================================================
+
+TEST_CASE("LogLoader - Pipelined load matches sequential load", "[LogLoader][pipelined]") 
+{
+    std::string text = buildTestLog(5000);
+    std::ostringstream warnings;
+    
+    LoaderOptions sequential_options;
+    sequential_options.worker_threads = 0;
+    LogLoader sequential(sequential_options, warnings);
+    auto expected = loadString(text, sequential);
+    
+    LoaderOptions pipelined_options;
+    pipelined_options.worker_threads = 4;
+    pipelined_options.chunk_bytes = 512;   // Force many chunks
+    LogLoader pipelined(pipelined_options, warnings);
+    auto entries = loadString(text, pipelined);
+    
+    REQUIRE(entries.size() == expected.size());
+    for (size_t i = 0; i < entries.size(); ++i) 
+    {
+        REQUIRE(entries[i].username == expected[i].username);
+        REQUIRE(entries[i].ip_address == expected[i].ip_address);
+        REQUIRE(entries[i].timestamp == expected[i].timestamp);
+    }
+    
+    REQUIRE(pipelined.statistics().lines_processed == sequential.statistics().lines_processed);
+    REQUIRE(pipelined.statistics().invalid_entries == sequential.statistics().invalid_entries);
+    REQUIRE(pipelined.diagnostics().samples().size() == sequential.diagnostics().samples().size());
+    for (size_t i = 0; i < pipelined.diagnostics().samples().size(); ++i) 
+    {
+        REQUIRE(pipelined.diagnostics().samples()[i].line_number == 
+                sequential.diagnostics().samples()[i].line_number);
+    }
+}
+
+TEST_CASE("LogLoader - Counts out-of-order entries across chunks", "[LogLoader][pipelined]") 
+{
+    std::string text = buildTestLog(2000);
+    std::ostringstream warnings;
+    
+    LoaderOptions options;
+    options.worker_threads = 3;
+    options.chunk_bytes = 300;   // Many chunk seams
+    LogLoader loader(options, warnings);
+    auto entries = loadString(text, loader);
+    
+    size_t expected = 0;
+    for (size_t i = 1; i < entries.size(); ++i) 
+    {
+        if (entries[i].timestamp < entries[i - 1].timestamp) 
+        {
+            expected++;
+        }
+    }
+    
+    REQUIRE(expected > 0);
+    REQUIRE(loader.statistics().out_of_order_entries == expected);
+    
+    // Time-ordered input reports none
+    LogLoader ordered(options, warnings);
+    loadString("2026-01-18 08:00:00 | alice | 10.0.0.1 | SUCCESS\n"
+               "2026-01-18 08:00:00 | bob | 10.0.0.2 | FAILED\n"
+               "2026-01-18 09:30:00 | alice | 10.0.0.1 | SUCCESS\n", ordered);
+    REQUIRE(ordered.statistics().out_of_order_entries == 0);
+}
+
+TEST_CASE("LogLoader - Pipelined load of empty input", "[LogLoader][pipelined]") 
+{
+    LoaderOptions options;
+    options.worker_threads = 3;
+    std::ostringstream warnings;
+    LogLoader loader(options, warnings);
+    
+    auto entries = loadString("", loader);
+    
+    REQUIRE(entries.empty());
+    REQUIRE(loader.statistics().lines_processed == 0);
+}
+
+TEST_CASE("LogLoader - Sink exception joins the pipeline threads", "[LogLoader][pipelined]") 
+{
+    std::string text = buildTestLog(5000);
+    
+    LoaderOptions options;
+    options.worker_threads = 3;
+    options.chunk_bytes = 256;   // Keep chunks in flight behind the failing batch
+    std::ostringstream warnings;
+    LogLoader loader(options, warnings);
+    
+    std::istringstream input(text);
+    std::size_t batches = 0;
+    REQUIRE_THROWS_AS(loader.loadStream(input, [&batches](std::vector<LogEntry>&) 
+    {
+        if (++batches == 3) 
+        {
+            throw std::runtime_error("sink failed");
+        }
+    }), std::runtime_error);
+    
+    // The loader is usable again once the threads are gone
+    auto entries = loadString(text, loader);
+    REQUIRE(loader.statistics().lines_processed == 5000);
+    REQUIRE(entries.size() == loader.statistics().valid_entries);
+}
+
+// ============================================================================
+// Tests for BoundedQueue
+// ============================================================================
+
+TEST_CASE("BoundedQueue - Rejects push when full", "[BoundedQueue]") 
+{
+    BoundedQueue<int> queue(2);
+    int a = 1, b = 2, c = 3;
+    
+    REQUIRE(queue.tryPush(a));
+    REQUIRE(queue.tryPush(b));
+    REQUIRE_FALSE(queue.tryPush(c));
+    
+    int value = 0;
+    REQUIRE(queue.tryPop(value));
+    REQUIRE(value == 1);
+}
+
+TEST_CASE("BoundedQueue - Delivers items in order across threads", "[BoundedQueue]") 
+{
+    BoundedQueue<int> queue(4);
+    const int count = 10000;
+    
+    std::thread producer([&queue]() 
+    {
+        for (int i = 0; i < count; ++i) 
+        {
+            queue.push(i);
+        }
+        queue.close();
+    });
+    
+    int expected = 0;
+    int value = 0;
+    while (queue.pop(value)) 
+    {
+        REQUIRE(value == expected);
+        expected++;
+    }
+    producer.join();
+    
+    REQUIRE(expected == count);
+}
+
+// ============================================================================
+// Tests for loadFile()
+// ============================================================================
+
+TEST_CASE("LogLoader - Prefetching and direct reads give the same result", "[LogLoader][loadFile]") 
+{
+    std::string path = "test_loader_input.log";
+    {
+        std::ofstream file(path);
+        file << buildTestLog(3000);
+    }
+    
+    std::ostringstream warnings;
+    
+    LoaderOptions prefetch_options;
+    prefetch_options.reader.block_bytes = 4096;
+    LogLoader prefetching(prefetch_options, warnings);
+    std::vector<LogEntry> prefetched;
+    REQUIRE(prefetching.loadFile(path, [&prefetched](std::vector<LogEntry>& batch) 
+    {
+        prefetched.insert(prefetched.end(), batch.begin(), batch.end());
+    }));
+    
+    LoaderOptions plain_options;
+    plain_options.prefetch = false;
+    LogLoader plain(plain_options, warnings);
+    std::vector<LogEntry> entries;
+    REQUIRE(plain.loadFile(path, [&entries](std::vector<LogEntry>& batch) 
+    {
+        entries.insert(entries.end(), batch.begin(), batch.end());
+    }));
+    
+    REQUIRE(prefetched.size() == entries.size());
+    REQUIRE(prefetching.statistics().lines_processed == 3000);
+    REQUIRE(plain.statistics().invalid_entries == prefetching.statistics().invalid_entries);
+    
+    std::remove(path.c_str());
+}
+
+TEST_CASE("LogLoader - Several files load as one input", "[LogLoader][loadFiles]") 
+{
+    std::vector<std::string> paths = {"test_loader_part1.log", "test_loader_part2.log"};
+    {
+        std::ofstream first(paths[0]);
+        first << buildTestLog(1500);
+        // Last line without a newline must not merge with the next file
+        first << "2024-01-15 08:00:00 | tail | 10.0.0.1 | SUCCESS";
+        std::ofstream second(paths[1]);
+        second << buildTestLog(1500);
+    }
+    
+    for (bool ring : {false, true}) 
+    {
+        std::ostringstream warnings;
+        LoaderOptions options;
+        options.reader.io_uring = ring;
+        options.reader.block_bytes = 4096;
+        options.reader.queue_depth = 4;
+        LogLoader loader(options, warnings);
+        
+        std::vector<LogEntry> entries;
+        REQUIRE(loader.loadFiles(paths, [&entries](std::vector<LogEntry>& batch) 
+        {
+            entries.insert(entries.end(), batch.begin(), batch.end());
+        }));
+        
+        REQUIRE(loader.statistics().lines_processed == 3001);
+        REQUIRE(entries.size() == loader.statistics().valid_entries);
+        REQUIRE(entries.size() > 1500);
+    }
+    
+    for (const auto& path : paths) 
+    {
+        std::remove(path.c_str());
+    }
+}
+
+TEST_CASE("LogLoader - Missing file among several is reported", "[LogLoader][loadFiles]") 
+{
+    for (bool ring : {false, true}) 
+    {
+        std::ostringstream warnings;
+        LoaderOptions options;
+        options.reader.io_uring = ring;
+        LogLoader loader(options, warnings);
+        
+        std::vector<std::string> paths = {"/nonexistent/a.log", "/nonexistent/b.log"};
+        REQUIRE_FALSE(loader.loadFiles(paths, [](std::vector<LogEntry>&) {}));
+        REQUIRE(loader.failedPath() == "/nonexistent/a.log");
+    }
+}
+
+TEST_CASE("LogLoader - Syslog input skips unrelated messages", "[LogLoader][format]") 
+{
+    std::string text =
+        "Jan 18 08:45:12 web1 sshd[1]: Failed password for root from 10.0.0.9 port 1 ssh2\n"
+        "Jan 18 08:45:13 web1 sshd[1]: Connection closed by 10.0.0.9 port 1\n"
+        "Jan 18 08:45:14 web1 CRON[2]: session opened for user root\n"
+        "Jan 18 08:45:15 web1 sshd[3]: Accepted password for alice from 10.0.0.1 port 2 ssh2\n"
+        "truncated\n";
+    
+    LoaderOptions options;
+    options.format = LogFormats::InputFormat::SYSLOG;
+    options.syslog_year = 2026;
+    
+    std::ostringstream warnings;
+    LogLoader loader(options, warnings);
+    std::istringstream input(text);
+    std::vector<LogEntry> entries;
+    loader.loadStream(input, [&entries](std::vector<LogEntry>& batch) 
+    {
+        entries.insert(entries.end(), batch.begin(), batch.end());
+    });
+    
+    REQUIRE(entries.size() == 2);
+    REQUIRE(entries[0].username == "root");
+    REQUIRE(entries[1].status == LoginStatus::SUCCESS);
+    REQUIRE(loader.statistics().skipped_lines == 2);
+    REQUIRE(loader.statistics().invalid_entries == 1);
+}
+
+TEST_CASE("LogLoader - Syslog year follows the file modification time", "[LogLoader][format]") 
+{
+    std::string path = "test_loader_syslog.log";
+    {
+        std::ofstream file(path);
+        file << "Dec 31 23:59:58 web1 sshd[1]: Failed password for root from 10.0.0.9 port 1 ssh2\n"
+                "Jan  1 00:00:01 web1 sshd[1]: Accepted password for root from 10.0.0.9 port 1 ssh2\n";
+    }
+    
+    // Last written on 2 January 2025 (local time)
+    std::tm written = {};
+    written.tm_year = 2025 - 1900;
+    written.tm_mon = 0;
+    written.tm_mday = 2;
+    written.tm_hour = 12;
+    written.tm_isdst = -1;
+    utimbuf times;
+    times.actime = std::mktime(&written);
+    times.modtime = times.actime;
+    REQUIRE(utime(path.c_str(), &times) == 0);
+    
+    for (int year : {0, 2026}) 
+    {
+        LoaderOptions options;
+        options.format = LogFormats::InputFormat::SYSLOG;
+        options.syslog_year = year;
+        
+        std::ostringstream warnings;
+        LogLoader loader(options, warnings);
+        std::vector<LogEntry> entries;
+        REQUIRE(loader.loadFile(path, [&entries](std::vector<LogEntry>& batch) 
+        {
+            entries.insert(entries.end(), batch.begin(), batch.end());
+        }));
+        
+        REQUIRE(entries.size() == 2);
+        if (year == 0) 
+        {
+            // The December entry was written before the rollover
+            REQUIRE(entries[0].timestamp == LogParser::parseTimestamp("2024-12-31 23:59:58"));
+            REQUIRE(entries[1].timestamp == LogParser::parseTimestamp("2025-01-01 00:00:01"));
+        }
+        else 
+        {
+            // An explicit year applies to every entry
+            REQUIRE(entries[0].timestamp == LogParser::parseTimestamp("2026-12-31 23:59:58"));
+            REQUIRE(entries[1].timestamp == LogParser::parseTimestamp("2026-01-01 00:00:01"));
+        }
+    }
+    
+    std::remove(path.c_str());
+}
+
+TEST_CASE("LogLoader - Pattern input", "[LogLoader][format]") 
+{
+    std::string text =
+        "2026-01-18 08:45:12 [alice] from 10.0.0.1: FAILED\n"
+        "2026-01-18 08:45:13 [bob] from 10.0.0.2: SUCCESS\n"
+        "2026-01-18 08:45:14 bob from 10.0.0.2: SUCCESS\n";
+    
+    LoaderOptions options;
+    options.format = LogFormats::InputFormat::PATTERN;
+    options.pattern = "%ts [%user] from %ip: %status";
+    
+    std::ostringstream warnings;
+    LogLoader loader(options, warnings);
+    std::istringstream input(text);
+    std::vector<LogEntry> entries;
+    loader.loadStream(input, [&entries](std::vector<LogEntry>& batch) 
+    {
+        entries.insert(entries.end(), batch.begin(), batch.end());
+    });
+    
+    REQUIRE(entries.size() == 2);
+    REQUIRE(entries[1].username == "bob");
+    REQUIRE(loader.statistics().invalid_entries == 1);
+}
@@ -65,6 +65,43 @@ TEST_CASE("parseTimestamp - Completely invalid string", "[LogParser][parseTimest
     REQUIRE_FALSE(result.has_value());
 }
 
+TEST_CASE("parseTimestamp - Out of range fields", "[LogParser][parseTimestamp]") 
+{
+    REQUIRE_FALSE(LogParser::parseTimestamp("2026-13-18 08:45:12").has_value());
+    REQUIRE_FALSE(LogParser::parseTimestamp("2026-01-00 08:45:12").has_value());
+    REQUIRE_FALSE(LogParser::parseTimestamp("2026-01-18 24:45:12").has_value());
+    REQUIRE_FALSE(LogParser::parseTimestamp("2026-01-18 08:60:12").has_value());
+    REQUIRE_FALSE(LogParser::parseTimestamp("2026-01-18 08:45:61").has_value());
+    REQUIRE_FALSE(LogParser::parseTimestamp("2026-01-18 08:4x:12").has_value());
+    REQUIRE_FALSE(LogParser::parseTimestamp("20a6-01-18 08:45:12").has_value());
+}
+
+TEST_CASE("parseTimestamp - Cached hour gives consistent results", "[LogParser][parseTimestamp]") 
+{
+    using std::chrono::seconds;
+    
+    auto base = LogParser::parseTimestamp("2026-01-18 08:00:00");
+    auto same_hour = LogParser::parseTimestamp("2026-01-18 08:59:59");
+    auto next_hour = LogParser::parseTimestamp("2026-01-18 09:00:00");
+    auto back = LogParser::parseTimestamp("2026-01-18 08:30:15");
+    auto next_day = LogParser::parseTimestamp("2026-01-19 08:00:00");
+    
+    REQUIRE(base.has_value());
+    REQUIRE(same_hour.has_value());
+    REQUIRE(next_hour.has_value());
+    REQUIRE(back.has_value());
+    REQUIRE(next_day.has_value());
+    
+    REQUIRE(same_hour.value() - base.value() == seconds(3599));
+    REQUIRE(next_hour.value() - base.value() == seconds(3600));
+    REQUIRE(back.value() - base.value() == seconds(1815));
+    REQUIRE(next_day.value() - base.value() == seconds(86400));
+    
+    // An invalid line in between must not disturb the cache
+    REQUIRE_FALSE(LogParser::parseTimestamp("2026-01-18 08:99:00").has_value());
+    REQUIRE(LogParser::parseTimestamp("2026-01-18 08:00:00") == base);
+}
+
 // ============================================================================
 // Tests for parseStatus()
 // ============================================================================
@@ -218,4 +255,124 @@ TEST_CASE("parseLogLine - Line with no pipes", "[LogParser][parseLogLine]")
     
     // Should fail because no pipe delimiters exist
     REQUIRE_FALSE(result.has_value());
-}
\ No newline at end of file
+}
+// ============================================================================
+// Tests for locateFields() and materializeEntry()
+// ============================================================================
+
+TEST_CASE("locateFields - Returns trimmed field views", "[LogParser][locateFields]") 
+{
+    std::string line = "  2026-01-18 08:45:12 |  jdoe | 192.168.1.10  | FAILED ";
+    auto result = LogParser::locateFields(line);
+    
+    REQUIRE(result.has_value());
+    REQUIRE(result->timestamp == "2026-01-18 08:45:12");
+    REQUIRE(result->username == "jdoe");
+    REQUIRE(result->ip_address == "192.168.1.10");
+    REQUIRE(result->status == "FAILED");
+}
+
+TEST_CASE("locateFields - Does not validate the timestamp", "[LogParser][locateFields]") 
+{
+    std::string line = "invalid-timestamp | jdoe | 192.168.1.10 | SUCCESS";
+    
+    // Locating is cheap and only checks the field structure
+    REQUIRE(LogParser::locateFields(line).has_value());
+    REQUIRE_FALSE(LogParser::parseLogLine(line).has_value());
+}
+
+TEST_CASE("locateFields - Rejects missing and empty fields", "[LogParser][locateFields]") 
+{
+    REQUIRE_FALSE(LogParser::locateFields("2026-01-18 08:45:12 | jdoe | 192.168.1.10").has_value());
+    REQUIRE_FALSE(LogParser::locateFields("2026-01-18 08:45:12 |  | 192.168.1.10 | SUCCESS").has_value());
+    REQUIRE_FALSE(LogParser::locateFields("2026-01-18 08:45:12 | jdoe | 192.168.1.10 |   ").has_value());
+}
+
+TEST_CASE("materializeEntry - Builds entry from located fields", "[LogParser][materializeEntry]") 
+{
+    std::string line = "2026-01-15 14:30:00 | admin | 10.0.0.5 | failed";
+    auto fields = LogParser::locateFields(line);
+    REQUIRE(fields.has_value());
+    
+    auto entry = LogParser::materializeEntry(fields.value());
+    
+    REQUIRE(entry.has_value());
+    REQUIRE(entry->username == "admin");
+    REQUIRE(entry->ip_address == "10.0.0.5");
+    REQUIRE(entry->status == LoginStatus::FAILED);
+}
+
+// ============================================================================
+// Tests for FieldFilter
+// ============================================================================
+
+TEST_CASE("FieldFilter - Empty filter matches everything", "[LogParser][FieldFilter]") 
+{
+    LogParser::FieldFilter filter;
+    auto fields = LogParser::locateFields("2026-01-18 08:45:12 | jdoe | 192.168.1.10 | SUCCESS");
+    
+    REQUIRE_FALSE(filter.isActive());
+    REQUIRE(filter.matches(fields.value()));
+}
+
+TEST_CASE("FieldFilter - Criteria are combined with AND", "[LogParser][FieldFilter]") 
+{
+    LogParser::FieldFilter filter;
+    filter.username = "jdoe";
+    filter.status = LoginStatus::FAILED;
+    
+    auto failed = LogParser::locateFields("2026-01-18 08:45:12 | jdoe | 192.168.1.10 | Failed");
+    auto success = LogParser::locateFields("2026-01-18 08:45:12 | jdoe | 192.168.1.10 | SUCCESS");
+    auto other_user = LogParser::locateFields("2026-01-18 08:45:12 | alice | 192.168.1.10 | FAILED");
+    
+    REQUIRE(filter.isActive());
+    REQUIRE(filter.matches(failed.value()));
+    REQUIRE_FALSE(filter.matches(success.value()));
+    REQUIRE_FALSE(filter.matches(other_user.value()));
+}
+
+TEST_CASE("FieldFilter - IP address must match exactly", "[LogParser][FieldFilter]") 
+{
+    LogParser::FieldFilter filter;
+    filter.ip_address = "10.0.0.5";
+    
+    auto match = LogParser::locateFields("2026-01-18 08:45:12 | jdoe | 10.0.0.5 | SUCCESS");
+    auto prefix = LogParser::locateFields("2026-01-18 08:45:12 | jdoe | 10.0.0.50 | SUCCESS");
+    
+    REQUIRE(filter.matches(match.value()));
+    REQUIRE_FALSE(filter.matches(prefix.value()));
+}
+
+// ============================================================================
+// Tests for ParseError classification
+// ============================================================================
+
+TEST_CASE("locateFields - Classifies layout errors", "[LogParser][ParseError]") 
+{
+    LogParser::ParseError error = LogParser::ParseError::NONE;
+    
+    REQUIRE_FALSE(LogParser::locateFields("no pipes here", error).has_value());
+    REQUIRE(error == LogParser::ParseError::FIELD_COUNT);
+    
+    REQUIRE_FALSE(LogParser::locateFields("2026-01-18 08:45:12 |  | 10.0.0.1 | FAILED", error).has_value());
+    REQUIRE(error == LogParser::ParseError::EMPTY_FIELD);
+    
+    REQUIRE(LogParser::locateFields("2026-01-18 08:45:12 | a | 10.0.0.1 | FAILED", error).has_value());
+    REQUIRE(error == LogParser::ParseError::NONE);
+}
+
+TEST_CASE("materializeEntry - Classifies timestamp and status errors", "[LogParser][ParseError]") 
+{
+    LogParser::ParseError error = LogParser::ParseError::NONE;
+    
+    auto bad_time = LogParser::locateFields("2026-13-45 99:99 | a | 10.0.0.1 | FAILED");
+    REQUIRE_FALSE(LogParser::materializeEntry(bad_time.value(), error).has_value());
+    REQUIRE(error == LogParser::ParseError::BAD_TIMESTAMP);
+    
+    // Unknown status still produces an entry but is flagged
+    auto bad_status = LogParser::locateFields("2026-01-18 08:45:12 | a | 10.0.0.1 | PENDING");
+    auto entry = LogParser::materializeEntry(bad_status.value(), error);
+    REQUIRE(entry.has_value());
+    REQUIRE(entry->status == LoginStatus::UNKNOWN);
+    REQUIRE(error == LogParser::ParseError::UNKNOWN_STATUS);
+}
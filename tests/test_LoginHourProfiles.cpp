@@ -0,0 +1,173 @@
+#include <catch2/catch_test_macros.hpp>
+#include "LoginHourProfiles.h"
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <string>
+
+/**
+ * Unit tests for LoginHourProfiles class
+ *
+ * These tests verify:
+ * - Hour-of-week buckets of timestamps
+ * - A missing profile file is an empty baseline
+ * - Learned logins only reach the baseline through save() and load()
+ * - Merging learned logins into an existing baseline
+ * - Halving of profiles above kMaxProfileLogins
+ * - Rejection of files that are not profile files
+ */
+
+/**
+ * Helper function to create a local timestamp
+ * Base: 2026-01-18 (a Sunday)
+ */
+std::chrono::system_clock::time_point createTimestamp(int day, int hour, int minute)
+{
+    std::tm tm = {};
+    tm.tm_year = 2026 - 1900;
+    tm.tm_mon = 0;
+    tm.tm_mday = 18 + day;
+    tm.tm_hour = hour;
+    tm.tm_min = minute;
+    tm.tm_sec = 0;
+    tm.tm_isdst = -1;
+    return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+}
+
+/**
+ * Helper function to create a successful login
+ */
+LogEntry createLogin(const std::string& username, int day, int hour)
+{
+    return LogEntry(createTimestamp(day, hour, 15), username, "10.0.0.1", LoginStatus::SUCCESS);
+}
+
+// ============================================================================
+// Tests for hourOfWeek()
+// ============================================================================
+
+TEST_CASE("LoginHourProfiles - Computes the hour of the week", "[LoginHourProfiles][hourOfWeek]")
+{
+    REQUIRE(LoginHourProfiles::hourOfWeek(createTimestamp(0, 0, 0)) == 0);      // Sunday 00:00
+    REQUIRE(LoginHourProfiles::hourOfWeek(createTimestamp(0, 23, 59)) == 23);
+    REQUIRE(LoginHourProfiles::hourOfWeek(createTimestamp(1, 9, 30)) == 33);    // Monday 09:30
+    REQUIRE(LoginHourProfiles::hourOfWeek(createTimestamp(6, 23, 0)) == 167);   // Saturday 23:00
+    REQUIRE(LoginHourProfiles::hourOfWeek(createTimestamp(7, 0, 0)) == 0);      // Next Sunday
+}
+
+// ============================================================================
+// Tests for load(), add() and save()
+// ============================================================================
+
+TEST_CASE("LoginHourProfiles - Missing file is an empty baseline", "[LoginHourProfiles][load]")
+{
+    LoginHourProfiles profiles;
+
+    REQUIRE(profiles.load("does_not_exist_profiles.bin"));
+    REQUIRE(profiles.size() == 0);
+    REQUIRE(profiles.find("alice") == nullptr);
+}
+
+TEST_CASE("LoginHourProfiles - Learned logins reach the next run", "[LoginHourProfiles][save]")
+{
+    std::string path = "test_profiles_round_trip.bin";
+
+    LoginHourProfiles first_run;
+    REQUIRE(first_run.load(path));
+    first_run.add(createLogin("bob", 1, 9));
+    first_run.add(createLogin("bob", 1, 9));
+    first_run.add(createLogin("bob", 2, 14));
+    first_run.add(createLogin("alice", 0, 3));
+    first_run.add(LogEntry(createTimestamp(1, 9, 0), "carol", "10.0.0.2", LoginStatus::FAILED));
+
+    // The baseline of a run does not include its own logins
+    REQUIRE(first_run.find("bob") == nullptr);
+    REQUIRE(first_run.save(path));
+
+    LoginHourProfiles second_run;
+    REQUIRE(second_run.load(path));
+    REQUIRE(second_run.size() == 2);
+    REQUIRE(second_run.find("carol") == nullptr);   // Failures are not learned
+
+    const HourProfile* bob = second_run.find("bob");
+    REQUIRE(bob != nullptr);
+    REQUIRE(bob->total == 3);
+    REQUIRE(bob->counts[24 + 9] == 2);
+    REQUIRE(bob->counts[48 + 14] == 1);
+
+    const HourProfile* alice = second_run.find("alice");
+    REQUIRE(alice != nullptr);
+    REQUIRE(alice->total == 1);
+    REQUIRE(alice->counts[3] == 1);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("LoginHourProfiles - Saving merges into the baseline", "[LoginHourProfiles][save]")
+{
+    std::string path = "test_profiles_merge.bin";
+    {
+        LoginHourProfiles first_run;
+        first_run.add(createLogin("bob", 1, 9));
+        first_run.add(createLogin("dave", 1, 22));
+        REQUIRE(first_run.save(path));
+    }
+
+    // Save over the file that is currently loaded
+    {
+        LoginHourProfiles second_run;
+        REQUIRE(second_run.load(path));
+        second_run.add(createLogin("bob", 1, 9));
+        second_run.add(createLogin("carol", 3, 8));
+        REQUIRE(second_run.save(path));
+        REQUIRE(second_run.find("bob")->total == 1);
+    }
+
+    LoginHourProfiles third_run;
+    REQUIRE(third_run.load(path));
+    REQUIRE(third_run.size() == 3);
+    REQUIRE(third_run.find("bob")->counts[24 + 9] == 2);
+    REQUIRE(third_run.find("carol")->counts[72 + 8] == 1);
+    REQUIRE(third_run.find("dave")->counts[24 + 22] == 1);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("LoginHourProfiles - Large profiles are halved", "[LoginHourProfiles][save]")
+{
+    std::string path = "test_profiles_decay.bin";
+
+    LoginHourProfiles learning;
+    for (std::uint32_t i = 0; i <= LoginHourProfiles::kMaxProfileLogins; ++i)
+    {
+        learning.add(createLogin("busy", 1, 9));
+    }
+    learning.add(createLogin("busy", 1, 10));
+    REQUIRE(learning.save(path));
+
+    LoginHourProfiles profiles;
+    REQUIRE(profiles.load(path));
+    const HourProfile* busy = profiles.find("busy");
+    REQUIRE(busy != nullptr);
+    REQUIRE(busy->total <= LoginHourProfiles::kMaxProfileLogins);
+    REQUIRE(busy->counts[24 + 9] == (LoginHourProfiles::kMaxProfileLogins + 1) / 2);
+    REQUIRE(busy->counts[24 + 10] == 0);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("LoginHourProfiles - Rejects files that are not profiles", "[LoginHourProfiles][load]")
+{
+    std::string path = "test_profiles_invalid.bin";
+    {
+        std::ofstream file(path);
+        file << "2026-01-18 09:00:00 | alice | 10.0.0.1 | SUCCESS\n";
+    }
+
+    LoginHourProfiles profiles;
+    REQUIRE_FALSE(profiles.load(path));
+    REQUIRE(profiles.size() == 0);
+
+    std::remove(path.c_str());
+}
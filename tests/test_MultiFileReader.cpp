@@ -0,0 +1,201 @@
+#include <catch2/catch_test_macros.hpp>
+#include "MultiFileReader.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * Unit tests for MultiFileReader class
+ * 
+ * These tests verify:
+ * - Byte-exact reads of several files with many blocks in flight
+ * - File boundaries and empty files
+ * - Skipping unread data when advancing to the next file
+ * - Unaligned file tails with direct I/O
+ * - Error handling for missing files
+ */
+
+/**
+ * Helper function to write a file with recognizable contents
+ */
+std::string writeInputFile(const std::string& path, size_t size, char seed) 
+{
+    std::string contents;
+    for (size_t i = 0; i < size; ++i) 
+    {
+        contents += static_cast<char>(seed + (i * 7) % 23);
+    }
+    
+    std::ofstream file(path, std::ios::binary);
+    file << contents;
+    return contents;
+}
+
+/**
+ * Helper function to read the rest of the current file
+ */
+std::string readCurrentFile(MultiFileReader& reader, size_t buffer_size) 
+{
+    std::string result;
+    std::vector<char> buffer(buffer_size);
+    size_t bytes_read = 0;
+    while ((bytes_read = reader.read(buffer.data(), buffer.size())) > 0) 
+    {
+        result.append(buffer.data(), bytes_read);
+    }
+    return result;
+}
+
+// ============================================================================
+// Tests for read() and nextFile()
+// ============================================================================
+
+TEST_CASE("MultiFileReader - Reads several files in order", "[MultiFileReader][read]") 
+{
+    std::vector<std::string> paths = {"test_multi_1.bin", "test_multi_2.bin", "test_multi_3.bin"};
+    std::vector<std::string> expected = {
+        writeInputFile(paths[0], 30000, 'a'),
+        writeInputFile(paths[1], 4096, 'A'),
+        writeInputFile(paths[2], 9999, '0')
+    };
+    
+    ReaderOptions options;
+    options.block_bytes = 4096;   // Many blocks per file
+    options.queue_depth = 3;      // Ring wraps around several times
+    
+    MultiFileReader reader;
+    REQUIRE(reader.open(paths, options));
+    
+    for (size_t file = 0; file < paths.size(); ++file) 
+    {
+        REQUIRE(reader.nextFile());
+        REQUIRE(readCurrentFile(reader, 1000) == expected[file]);
+    }
+    REQUIRE_FALSE(reader.nextFile());
+    REQUIRE_FALSE(reader.failed());
+    
+    reader.close();
+    for (const auto& path : paths) 
+    {
+        std::remove(path.c_str());
+    }
+}
+
+TEST_CASE("MultiFileReader - Empty files have no data", "[MultiFileReader][read]") 
+{
+    std::vector<std::string> paths = {"test_multi_empty.bin", "test_multi_data.bin"};
+    writeInputFile(paths[0], 0, 'a');
+    std::string expected = writeInputFile(paths[1], 5000, 'a');
+    
+    ReaderOptions options;
+    options.block_bytes = 4096;
+    
+    MultiFileReader reader;
+    REQUIRE(reader.open(paths, options));
+    
+    REQUIRE(reader.nextFile());
+    REQUIRE(readCurrentFile(reader, 512).empty());
+    REQUIRE(reader.nextFile());
+    REQUIRE(readCurrentFile(reader, 512) == expected);
+    REQUIRE_FALSE(reader.nextFile());
+    
+    reader.close();
+    for (const auto& path : paths) 
+    {
+        std::remove(path.c_str());
+    }
+}
+
+TEST_CASE("MultiFileReader - Unread data is skipped on nextFile", "[MultiFileReader][nextFile]") 
+{
+    std::vector<std::string> paths = {"test_multi_skip_1.bin", "test_multi_skip_2.bin"};
+    writeInputFile(paths[0], 20000, 'a');
+    std::string expected = writeInputFile(paths[1], 7000, 'A');
+    
+    ReaderOptions options;
+    options.block_bytes = 4096;
+    options.queue_depth = 2;
+    
+    MultiFileReader reader;
+    REQUIRE(reader.open(paths, options));
+    
+    REQUIRE(reader.nextFile());
+    char buffer[100];
+    REQUIRE(reader.read(buffer, sizeof(buffer)) == sizeof(buffer));
+    
+    REQUIRE(reader.nextFile());
+    REQUIRE(readCurrentFile(reader, 3000) == expected);
+    
+    reader.close();
+    for (const auto& path : paths) 
+    {
+        std::remove(path.c_str());
+    }
+}
+
+TEST_CASE("MultiFileReader - Direct I/O request still reads correctly", "[MultiFileReader][directIo]") 
+{
+    std::vector<std::string> paths = {"test_multi_direct.bin"};
+    std::string expected = writeInputFile(paths[0], 12345, 'a');
+    
+    ReaderOptions options;
+    options.block_bytes = 4096;
+    options.direct_io = true;   // Falls back to buffered I/O if unsupported
+    
+    MultiFileReader reader;
+    REQUIRE(reader.open(paths, options));
+    REQUIRE(reader.nextFile());
+    REQUIRE(readCurrentFile(reader, 4096) == expected);
+    
+    reader.close();
+    std::remove(paths[0].c_str());
+}
+
+TEST_CASE("MultiFileReader - Direct I/O reads unaligned file tails", "[MultiFileReader][directIo]") 
+{
+    // Sizes that end short of, just past and well inside an alignment unit
+    std::vector<std::string> paths = {"test_multi_tail1.bin", "test_multi_tail2.bin", "test_multi_tail3.bin"};
+    std::vector<std::string> expected = {
+        writeInputFile(paths[0], 100, 'a'),
+        writeInputFile(paths[1], 4097, 'b'),
+        writeInputFile(paths[2], 3 * 8192 + 1000, 'c')
+    };
+    
+    ReaderOptions options;
+    options.block_bytes = 8192;
+    options.queue_depth = 2;
+    options.direct_io = true;
+    
+    MultiFileReader reader;
+    REQUIRE(reader.open(paths, options));
+    for (const auto& contents : expected) 
+    {
+        REQUIRE(reader.nextFile());
+        REQUIRE(readCurrentFile(reader, 3000) == contents);
+    }
+    REQUIRE_FALSE(reader.nextFile());
+    REQUIRE_FALSE(reader.failed());
+    
+    reader.close();
+    for (const auto& path : paths) 
+    {
+        std::remove(path.c_str());
+    }
+}
+
+// ============================================================================
+// Tests for open()
+// ============================================================================
+
+TEST_CASE("MultiFileReader - Missing file is reported", "[MultiFileReader][open]") 
+{
+    std::vector<std::string> paths = {"test_multi_present.bin", "/nonexistent/path/file.log"};
+    writeInputFile(paths[0], 100, 'a');
+    
+    MultiFileReader reader;
+    REQUIRE_FALSE(reader.open(paths, ReaderOptions()));
+    REQUIRE(reader.failedPath() == "/nonexistent/path/file.log");
+    
+    std::remove(paths[0].c_str());
+}
@@ -0,0 +1,119 @@
+#include <catch2/catch_test_macros.hpp>
+#include "ParseDiagnostics.h"
+#include <sstream>
+#include <string>
+
+/**
+ * Unit tests for ParseDiagnostics class
+ * 
+ * These tests verify:
+ * - Per-reason error counting
+ * - Bounded sample retention
+ * - Merging of per-worker diagnostics
+ * - Summary output
+ */
+
+using LogParser::ParseError;
+
+// ============================================================================
+// Tests for counting and samples
+// ============================================================================
+
+TEST_CASE("ParseDiagnostics - Counts errors per reason", "[ParseDiagnostics][record]") 
+{
+    ParseDiagnostics diagnostics;
+    
+    diagnostics.record(ParseError::FIELD_COUNT, 1, "garbage");
+    diagnostics.record(ParseError::FIELD_COUNT, 2, "more garbage");
+    diagnostics.record(ParseError::BAD_TIMESTAMP, 5, "bad | a | b | SUCCESS");
+    
+    REQUIRE(diagnostics.count(ParseError::FIELD_COUNT) == 2);
+    REQUIRE(diagnostics.count(ParseError::BAD_TIMESTAMP) == 1);
+    REQUIRE(diagnostics.count(ParseError::EMPTY_FIELD) == 0);
+    REQUIRE(diagnostics.totalErrors() == 3);
+}
+
+TEST_CASE("ParseDiagnostics - Keeps only the first N samples", "[ParseDiagnostics][record]") 
+{
+    ParseDiagnostics diagnostics(2);
+    
+    diagnostics.record(ParseError::EMPTY_FIELD, 3, "first");
+    diagnostics.record(ParseError::EMPTY_FIELD, 7, "second");
+    diagnostics.record(ParseError::EMPTY_FIELD, 9, "third");
+    
+    REQUIRE(diagnostics.totalErrors() == 3);
+    REQUIRE(diagnostics.samples().size() == 2);
+    REQUIRE(diagnostics.samples()[0].line_number == 3);
+    REQUIRE(diagnostics.samples()[1].line == "second");
+}
+
+TEST_CASE("ParseDiagnostics - Truncates long sample lines", "[ParseDiagnostics][record]") 
+{
+    ParseDiagnostics diagnostics;
+    std::string long_line(1000, 'x');
+    
+    diagnostics.record(ParseError::FIELD_COUNT, 1, long_line);
+    
+    REQUIRE(diagnostics.samples()[0].line.size() < long_line.size());
+}
+
+TEST_CASE("ParseDiagnostics - Zero sample limit keeps counters only", "[ParseDiagnostics][record]") 
+{
+    ParseDiagnostics diagnostics(0);
+    
+    diagnostics.record(ParseError::UNKNOWN_STATUS, 1, "line");
+    
+    REQUIRE(diagnostics.totalErrors() == 1);
+    REQUIRE(diagnostics.samples().empty());
+}
+
+// ============================================================================
+// Tests for merge()
+// ============================================================================
+
+TEST_CASE("ParseDiagnostics - Merge keeps earliest samples", "[ParseDiagnostics][merge]") 
+{
+    ParseDiagnostics first(2);
+    ParseDiagnostics second(2);
+    
+    first.record(ParseError::FIELD_COUNT, 10, "ten");
+    first.record(ParseError::FIELD_COUNT, 12, "twelve");
+    second.record(ParseError::BAD_TIMESTAMP, 4, "four");
+    
+    first.merge(second);
+    
+    REQUIRE(first.totalErrors() == 3);
+    REQUIRE(first.count(ParseError::BAD_TIMESTAMP) == 1);
+    REQUIRE(first.samples().size() == 2);
+    REQUIRE(first.samples()[0].line_number == 4);
+    REQUIRE(first.samples()[1].line_number == 10);
+}
+
+// ============================================================================
+// Tests for writeSummary()
+// ============================================================================
+
+TEST_CASE("ParseDiagnostics - Summary lists reasons and samples", "[ParseDiagnostics][writeSummary]") 
+{
+    ParseDiagnostics diagnostics;
+    diagnostics.record(ParseError::UNKNOWN_STATUS, 42, "2026-01-18 08:45:12 | a | b | PENDING");
+    
+    std::ostringstream output;
+    diagnostics.writeSummary(output);
+    std::string summary = output.str();
+    
+    REQUIRE(summary.find("Invalid Lines: 1") != std::string::npos);
+    REQUIRE(summary.find("Unknown status: 1") != std::string::npos);
+    REQUIRE(summary.find("line 42") != std::string::npos);
+    REQUIRE(summary.find("PENDING") != std::string::npos);
+}
+
+TEST_CASE("ParseDiagnostics - Summary with no errors", "[ParseDiagnostics][writeSummary]") 
+{
+    ParseDiagnostics diagnostics;
+    
+    std::ostringstream output;
+    diagnostics.writeSummary(output);
+    
+    REQUIRE(output.str() == "Invalid Lines: 0\n");
+}
@@ -0,0 +1,141 @@
+#include <catch2/catch_test_macros.hpp>
+#include "PasswordSprayTracker.h"
+#include <chrono>
+#include <string>
+
+/**
+ * Unit tests for PasswordSprayTracker class
+ * 
+ * These tests verify:
+ * - Detection of many distinct users failing from one IP
+ * - Threshold, time window and status handling
+ * - Independent windows per IP address
+ * - Windows that slide past an early failure
+ */
+
+/**
+ * Helper function to create a timestamp a number of seconds after a fixed base
+ */
+std::chrono::system_clock::time_point sprayTimestamp(int seconds) 
+{
+    return std::chrono::system_clock::from_time_t(1768000000) + std::chrono::seconds(seconds);
+}
+
+/**
+ * Helper function to observe failures for user0 .. user<count-1> from one IP
+ */
+void observeSpray(PasswordSprayTracker& tracker, const std::string& ip,
+                  int count, int first_second, int step_seconds) 
+{
+    for (int i = 0; i < count; ++i) 
+    {
+        tracker.observe(LogEntry(sprayTimestamp(first_second + i * step_seconds),
+                                 "user" + std::to_string(i), ip, LoginStatus::FAILED));
+    }
+}
+
+// ============================================================================
+// Tests for observe() and finish()
+// ============================================================================
+
+TEST_CASE("PasswordSprayTracker - Detects many users failing from one IP", "[PasswordSprayTracker][observe]") 
+{
+    PasswordSprayTracker tracker(10, 20);
+    observeSpray(tracker, "203.0.113.5", 25, 0, 5);
+    
+    auto events = tracker.finish();
+    
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0].type == SuspiciousEventType::PASSWORD_SPRAYING);
+    REQUIRE(events[0].username.empty());
+    REQUIRE(events[0].ip_addresses.size() == 1);
+    REQUIRE(events[0].ip_addresses[0] == "203.0.113.5");
+    REQUIRE(events[0].event_count == 25);
+    REQUIRE(events[0].first_occurrence == sprayTimestamp(0));
+    REQUIRE(events[0].last_occurrence == sprayTimestamp(24 * 5));
+}
+
+TEST_CASE("PasswordSprayTracker - Repeated failures of one user are not spraying", "[PasswordSprayTracker][observe]") 
+{
+    PasswordSprayTracker tracker(10, 20);
+    for (int i = 0; i < 100; ++i) 
+    {
+        tracker.observe(LogEntry(sprayTimestamp(i), "admin", "203.0.113.5", LoginStatus::FAILED));
+    }
+    
+    REQUIRE(tracker.finish().empty());
+}
+
+TEST_CASE("PasswordSprayTracker - Failures spread beyond the window are not reported", "[PasswordSprayTracker][observe]") 
+{
+    PasswordSprayTracker tracker(10, 20);
+    observeSpray(tracker, "203.0.113.5", 30, 0, 60);   // One user per minute
+    
+    REQUIRE(tracker.finish().empty());
+}
+
+TEST_CASE("PasswordSprayTracker - Successful logins are ignored", "[PasswordSprayTracker][observe]") 
+{
+    PasswordSprayTracker tracker(10, 20);
+    for (int i = 0; i < 30; ++i) 
+    {
+        tracker.observe(LogEntry(sprayTimestamp(i), "user" + std::to_string(i),
+                                 "10.0.0.1", LoginStatus::SUCCESS));
+    }
+    
+    REQUIRE(tracker.finish().empty());
+}
+
+TEST_CASE("PasswordSprayTracker - IP addresses are tracked independently", "[PasswordSprayTracker][observe]") 
+{
+    PasswordSprayTracker tracker(10, 20);
+    
+    // Interleave a spraying IP with a quiet one and a second spray later
+    for (int i = 0; i < 30; ++i) 
+    {
+        tracker.observe(LogEntry(sprayTimestamp(i * 2), "user" + std::to_string(i),
+                                 "198.51.100.7", LoginStatus::FAILED));
+        tracker.observe(LogEntry(sprayTimestamp(i * 2 + 1), "user" + std::to_string(i % 3),
+                                 "10.0.0.1", LoginStatus::FAILED));
+    }
+    observeSpray(tracker, "203.0.113.5", 40, 3600, 1);
+    
+    auto events = tracker.finish();
+    
+    REQUIRE(events.size() == 2);
+    REQUIRE(events[0].ip_addresses[0] == "198.51.100.7");
+    REQUIRE(events[0].event_count == 30);
+    REQUIRE(events[1].ip_addresses[0] == "203.0.113.5");
+    REQUIRE(events[1].event_count == 40);
+}
+
+TEST_CASE("PasswordSprayTracker - Early probe does not hide a later spray", "[PasswordSprayTracker][observe]") 
+{
+    PasswordSprayTracker tracker(10, 20);
+    
+    // One probe, then 20 users between 8 and 12 minutes later
+    tracker.observe(LogEntry(sprayTimestamp(0), "probe", "203.0.113.5", LoginStatus::FAILED));
+    observeSpray(tracker, "203.0.113.5", 20, 8 * 60, 12);
+    
+    auto events = tracker.finish();
+    
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0].event_count == 20);
+    REQUIRE(events[0].first_occurrence == sprayTimestamp(8 * 60));
+    REQUIRE(events[0].last_occurrence == sprayTimestamp(8 * 60 + 19 * 12));
+}
+
+TEST_CASE("PasswordSprayTracker - A spray ends when the window slides past it", "[PasswordSprayTracker][observe]") 
+{
+    PasswordSprayTracker tracker(10, 20);
+    observeSpray(tracker, "203.0.113.5", 20, 0, 1);
+    
+    // A lone failure much later ends the first spray without joining it
+    tracker.observe(LogEntry(sprayTimestamp(3600), "late", "203.0.113.5", LoginStatus::FAILED));
+    
+    auto events = tracker.finish();
+    
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0].event_count == 20);
+    REQUIRE(events[0].last_occurrence == sprayTimestamp(19));
+}
@@ -0,0 +1,117 @@
+#include <catch2/catch_test_macros.hpp>
+#include "PatternMatcher.h"
+#include <string>
+
+/**
+ * Unit tests for PatternMatcher class
+ * 
+ * These tests verify:
+ * - Template compilation and its error messages
+ * - Field extraction with literal separators
+ * - Ignored sections and literal percent signs
+ * - Rejection of lines that do not follow the template
+ */
+
+using LogParser::LogFields;
+using LogParser::ParseError;
+
+/**
+ * Helper function to compile a template that is expected to be valid
+ */
+PatternMatcher compileValid(const std::string& pattern) 
+{
+    std::string error_message;
+    auto matcher = PatternMatcher::compile(pattern, error_message);
+    REQUIRE(matcher.has_value());
+    return matcher.value();
+}
+
+// ============================================================================
+// Tests for compile()
+// ============================================================================
+
+TEST_CASE("PatternMatcher - Invalid templates are rejected", "[PatternMatcher][compile]") 
+{
+    std::string error_message;
+    
+    REQUIRE_FALSE(PatternMatcher::compile("%ts %user %ip", error_message).has_value());
+    REQUIRE(error_message.find("%status") != std::string::npos);
+    
+    REQUIRE_FALSE(PatternMatcher::compile("%ts %user %ip %status %user", error_message).has_value());
+    REQUIRE_FALSE(PatternMatcher::compile("%ts %user%ip %status", error_message).has_value());
+    REQUIRE_FALSE(PatternMatcher::compile("%ts %user %ip %state", error_message).has_value());
+    REQUIRE(error_message.find("placeholder") != std::string::npos);
+}
+
+// ============================================================================
+// Tests for match()
+// ============================================================================
+
+TEST_CASE("PatternMatcher - Bracketed template", "[PatternMatcher][match]") 
+{
+    PatternMatcher matcher = compileValid("%ts [%user] from %ip: %status");
+    LogFields fields;
+    ParseError error = ParseError::NONE;
+    
+    REQUIRE(matcher.match("2026-01-18 08:45:12 [alice] from 10.0.0.1: FAILED", fields, error));
+    REQUIRE(error == ParseError::NONE);
+    REQUIRE(fields.timestamp == "2026-01-18 08:45:12");
+    REQUIRE(fields.username == "alice");
+    REQUIRE(fields.ip_address == "10.0.0.1");
+    REQUIRE(fields.status == "FAILED");
+}
+
+TEST_CASE("PatternMatcher - Pipe layout matches the built-in format", "[PatternMatcher][match]") 
+{
+    PatternMatcher matcher = compileValid("%ts | %user | %ip | %status");
+    LogFields fields;
+    ParseError error = ParseError::NONE;
+    
+    REQUIRE(matcher.match("2026-01-18 08:45:12 | jdoe | 192.168.1.10 | SUCCESS", fields, error));
+    auto expected = LogParser::locateFields("2026-01-18 08:45:12 | jdoe | 192.168.1.10 | SUCCESS");
+    REQUIRE(expected.has_value());
+    REQUIRE(fields.username == expected->username);
+    REQUIRE(fields.ip_address == expected->ip_address);
+    REQUIRE(fields.status == expected->status);
+}
+
+TEST_CASE("PatternMatcher - Ignored sections and percent literal", "[PatternMatcher][match]") 
+{
+    PatternMatcher matcher = compileValid("%ts host=%* 100%% user=%user ip=%ip result=%status");
+    LogFields fields;
+    ParseError error = ParseError::NONE;
+    
+    REQUIRE(matcher.match("2026-01-18T08:45:12 host=web-1 100% user=bob ip=10.1.1.1 result=SUCCESS", 
+                          fields, error));
+    REQUIRE(fields.timestamp == "2026-01-18T08:45:12");
+    REQUIRE(fields.username == "bob");
+    REQUIRE(fields.status == "SUCCESS");
+}
+
+TEST_CASE("PatternMatcher - Repeated prefixes in the separator", "[PatternMatcher][match]") 
+{
+    // The KMP search must handle partial separator matches inside a field
+    PatternMatcher matcher = compileValid("%ts u=%user ::: ip=%ip :: %status");
+    LogFields fields;
+    ParseError error = ParseError::NONE;
+    
+    REQUIRE(matcher.match("2026-01-18 08:45:12 u=a::b :: c ::: ip=10.0.0.1 :: FAILED", fields, error));
+    REQUIRE(fields.username == "a::b :: c");
+    REQUIRE(fields.ip_address == "10.0.0.1");
+}
+
+TEST_CASE("PatternMatcher - Non-matching lines", "[PatternMatcher][match]") 
+{
+    PatternMatcher matcher = compileValid("%ts [%user] from %ip: %status");
+    LogFields fields;
+    ParseError error = ParseError::NONE;
+    
+    REQUIRE_FALSE(matcher.match("2026-01-18 08:45:12 alice from 10.0.0.1: FAILED", fields, error));
+    REQUIRE(error == ParseError::FIELD_COUNT);
+    
+    REQUIRE_FALSE(matcher.match("short", fields, error));
+    REQUIRE(error == ParseError::FIELD_COUNT);
+    
+    REQUIRE_FALSE(matcher.match("2026-01-18 08:45:12 [] from 10.0.0.1: FAILED", fields, error));
+    REQUIRE(error == ParseError::EMPTY_FIELD);
+}
@@ -0,0 +1,255 @@
+#include <catch2/catch_test_macros.hpp>
+#include "RateSeries.h"
+#include "RateMonitor.h"
+#include <chrono>
+#include <string>
+
+/**
+ * Unit tests for RateSeries and RateMonitor classes
+ *
+ * These tests verify:
+ * - Conversion of timestamps to minutes
+ * - Spike windows against a steady background, merged across minutes
+ * - No spikes during warm-up or below the minimum failure count
+ * - Out-of-order entries within the ring, late entries beyond it
+ * - Long idle gaps and reset()
+ * - Per-key series following the most failing IP addresses and users
+ */
+
+/**
+ * Helper function adding the same login several times
+ */
+void addLogins(RateSeries& series, std::int64_t minute, int count, bool failed)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        series.add(minute, failed);
+    }
+}
+
+/**
+ * Helper function adding an hour of background failures (minutes 0-59)
+ */
+void addBackground(RateSeries& series, int failures_per_minute)
+{
+    for (std::int64_t minute = 0; minute < 60; ++minute)
+    {
+        addLogins(series, minute, failures_per_minute, true);
+        addLogins(series, minute, 1, false);
+    }
+}
+
+/**
+ * Helper function creating a login at a minute since the epoch
+ */
+LogEntry createLogin(std::int64_t minute, const std::string& username,
+                     const std::string& ip, LoginStatus status)
+{
+    auto timestamp = std::chrono::system_clock::time_point(std::chrono::minutes(minute));
+    return LogEntry(timestamp, username, ip, status);
+}
+
+// ============================================================================
+// Tests for RateSeries
+// ============================================================================
+
+TEST_CASE("RateSeries - Converts timestamps to minutes", "[RateSeries][minuteOf]")
+{
+    REQUIRE(RateSeries::minuteOf(std::chrono::system_clock::from_time_t(0)) == 0);
+    REQUIRE(RateSeries::minuteOf(std::chrono::system_clock::from_time_t(125)) == 2);
+    REQUIRE(RateSeries::minuteOf(std::chrono::system_clock::from_time_t(-1)) == -1);
+}
+
+TEST_CASE("RateSeries - Detects a spike over a steady background", "[RateSeries][spikes]")
+{
+    RateSeries series(4.0);
+    addBackground(series, 2);
+    addLogins(series, 60, 50, true);
+    addLogins(series, 60, 3, false);
+    for (std::int64_t minute = 61; minute < 70; ++minute)
+    {
+        addLogins(series, minute, 2, true);
+    }
+    series.finish();
+
+    REQUIRE(series.failures() == 120 + 50 + 18);
+    REQUIRE(series.spikes().size() == 1);
+
+    const RateSpike& spike = series.spikes()[0];
+    REQUIRE(spike.first_minute == 60);
+    REQUIRE(spike.last_minute == 60);
+    REQUIRE(spike.failures == 50);
+    REQUIRE(spike.successes == 3);
+    REQUIRE(spike.peak_failures == 50);
+    REQUIRE(spike.expected_failures == 2.0);
+    REQUIRE(spike.peak_score == 48.0);
+}
+
+TEST_CASE("RateSeries - Merges consecutive spike minutes", "[RateSeries][spikes]")
+{
+    RateSeries series(4.0);
+    addBackground(series, 2);
+    addLogins(series, 60, 40, true);
+    addLogins(series, 61, 100, true);
+    series.finish();
+
+    REQUIRE(series.spikes().size() == 1);
+    REQUIRE(series.spikes()[0].first_minute == 60);
+    REQUIRE(series.spikes()[0].last_minute == 61);
+    REQUIRE(series.spikes()[0].failures == 140);
+    REQUIRE(series.spikes()[0].peak_failures == 100);
+}
+
+TEST_CASE("RateSeries - No spikes during warm-up or below the minimum", "[RateSeries][spikes]")
+{
+    RateSeries warming(4.0);
+    addLogins(warming, 0, 1, true);
+    addLogins(warming, 5, 100, true);
+    warming.finish();
+    REQUIRE(warming.spikes().empty());
+
+    RateSeries small(4.0);
+    addBackground(small, 0);
+    addLogins(small, 60, RateSeries::kMinSpikeFailures - 1, true);
+    small.finish();
+    REQUIRE(small.spikes().empty());
+}
+
+TEST_CASE("RateSeries - Counts out-of-order entries within the ring", "[RateSeries][add]")
+{
+    RateSeries series(4.0);
+    const std::int64_t ring = static_cast<std::int64_t>(RateSeries::kRingMinutes);
+
+    REQUIRE(series.add(1000, true));
+    REQUIRE(series.add(1000 - ring + 1, true));    // Oldest minute still in the ring
+    REQUIRE_FALSE(series.add(1000 - ring, true));  // Too old
+    REQUIRE(series.lateEntries() == 1);
+
+    // Moving on closes the oldest minutes; they take no more entries
+    REQUIRE(series.add(1000 + ring, true));
+    REQUIRE_FALSE(series.add(1000, true));
+    REQUIRE(series.add(1001, true));
+    REQUIRE(series.lateEntries() == 2);
+    REQUIRE(series.failures() == 4);
+}
+
+TEST_CASE("RateSeries - Long idle gaps are cheap", "[RateSeries][add]")
+{
+    RateSeries series(4.0);
+    addBackground(series, 2);
+    REQUIRE(series.add(100000000, true));
+    series.finish();
+
+    REQUIRE(series.spikes().empty());
+    REQUIRE(series.failures() == 121);
+}
+
+TEST_CASE("RateSeries - Reset forgets everything", "[RateSeries][reset]")
+{
+    RateSeries series(4.0);
+    addBackground(series, 2);
+    addLogins(series, 60, 50, true);
+    series.finish();
+    REQUIRE(series.spikes().size() == 1);
+
+    series.reset();
+    REQUIRE(series.spikes().empty());
+    REQUIRE(series.failures() == 0);
+
+    // Usable again from any minute
+    addLogins(series, 5, 100, true);
+    series.finish();
+    REQUIRE(series.spikes().empty());
+    REQUIRE(series.failures() == 100);
+}
+
+// ============================================================================
+// Tests for RateMonitor
+// ============================================================================
+
+TEST_CASE("RateMonitor - Reports spikes globally and per key", "[RateMonitor][spikes]")
+{
+    RateMonitor monitor(2, 4.0);
+    REQUIRE(monitor.isEnabled());
+
+    for (std::int64_t minute = 0; minute < 60; ++minute)
+    {
+        monitor.add(createLogin(minute, "alice", "10.0.0.1", LoginStatus::FAILED));
+        monitor.add(createLogin(minute, "carol", "10.0.0.2", LoginStatus::SUCCESS));
+    }
+    for (int attempt = 0; attempt < 30; ++attempt)
+    {
+        monitor.add(createLogin(60, "alice", "10.0.0.1", LoginStatus::FAILED));
+    }
+    monitor.finish();
+
+    REQUIRE(monitor.global().spikes().size() == 1);
+
+    auto ip_spikes = monitor.ipSpikes();
+    REQUIRE(ip_spikes.size() == 1);
+    REQUIRE(ip_spikes[0].key == "10.0.0.1");
+    REQUIRE(ip_spikes[0].spike.first_minute == 60);
+
+    auto user_spikes = monitor.userSpikes();
+    REQUIRE(user_spikes.size() == 1);
+    REQUIRE(user_spikes[0].key == "alice");
+}
+
+TEST_CASE("RateMonitor - Keeps following a heavy key among churn", "[RateMonitor][spikes]")
+{
+    RateMonitor monitor(2, 4.0);
+
+    // One new address per minute competes for the second series
+    for (std::int64_t minute = 0; minute < 60; ++minute)
+    {
+        for (int attempt = 0; attempt < 3; ++attempt)
+        {
+            monitor.add(createLogin(minute, "alice", "10.0.0.1", LoginStatus::FAILED));
+        }
+        monitor.add(createLogin(minute, "bob", "192.168.0." + std::to_string(minute), LoginStatus::FAILED));
+    }
+    for (int attempt = 0; attempt < 40; ++attempt)
+    {
+        monitor.add(createLogin(60, "alice", "10.0.0.1", LoginStatus::FAILED));
+    }
+    monitor.finish();
+
+    auto ip_spikes = monitor.ipSpikes();
+    REQUIRE(ip_spikes.size() == 1);
+    REQUIRE(ip_spikes[0].key == "10.0.0.1");
+}
+
+TEST_CASE("RateMonitor - Displaced keys keep their spikes", "[RateMonitor][spikes]")
+{
+    RateMonitor monitor(1, 4.0);
+
+    for (std::int64_t minute = 0; minute < 60; ++minute)
+    {
+        monitor.add(createLogin(minute, "alice", "10.0.0.1", LoginStatus::FAILED));
+    }
+    for (int attempt = 0; attempt < 30; ++attempt)
+    {
+        monitor.add(createLogin(60, "alice", "10.0.0.1", LoginStatus::FAILED));
+    }
+
+    // A new failing address takes the only series
+    monitor.add(createLogin(61, "alice", "10.0.0.2", LoginStatus::FAILED));
+    monitor.finish();
+
+    auto ip_spikes = monitor.ipSpikes();
+    REQUIRE(ip_spikes.size() == 1);
+    REQUIRE(ip_spikes[0].key == "10.0.0.1");
+    REQUIRE(ip_spikes[0].spike.failures == 30);
+}
+
+TEST_CASE("RateMonitor - Disabled monitor counts nothing", "[RateMonitor][add]")
+{
+    RateMonitor monitor(2, 0.0);
+    REQUIRE_FALSE(monitor.isEnabled());
+
+    monitor.add(createLogin(0, "alice", "10.0.0.1", LoginStatus::FAILED));
+    monitor.finish();
+
+    REQUIRE(monitor.global().failures() == 0);
+    REQUIRE(monitor.ipSpikes().empty());
+}
@@ -0,0 +1,139 @@
+#include <catch2/catch_test_macros.hpp>
+#include "ReorderBuffer.h"
+#include "LogEntry.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Unit tests for ReorderBuffer class
+ *
+ * These tests verify:
+ * - Entries within the lateness are released in time order
+ * - Entries are held until the watermark passes them
+ * - Entries later than the watermark are counted and dropped
+ * - Equal timestamps keep their input order
+ * - Jittered input comes out identical to a full sort
+ */
+
+/**
+ * Helper function creating an entry a number of seconds after a base time
+ */
+LogEntry createEntry(long long seconds, const std::string& username = "alice")
+{
+    auto base = std::chrono::system_clock::from_time_t(1768723200);   // 2026-01-18 08:00 UTC
+    return LogEntry(base + std::chrono::seconds(seconds), username, "10.0.0.1", LoginStatus::FAILED);
+}
+
+/**
+ * Helper function pushing entries and returning everything released
+ */
+std::vector<LogEntry> reorder(ReorderBuffer& buffer, std::vector<LogEntry> entries)
+{
+    std::vector<LogEntry> released;
+    for (auto& entry : entries)
+    {
+        buffer.push(std::move(entry), released);
+    }
+    buffer.flush(released);
+    return released;
+}
+
+// ============================================================================
+// Tests for push() and flush()
+// ============================================================================
+
+TEST_CASE("ReorderBuffer - Releases entries in time order", "[ReorderBuffer][push]")
+{
+    ReorderBuffer buffer(std::chrono::seconds(30));
+    auto released = reorder(buffer, {createEntry(10), createEntry(0), createEntry(40),
+                                     createEntry(25), createEntry(60)});
+
+    REQUIRE(released.size() == 5);
+    REQUIRE(std::is_sorted(released.begin(), released.end(),
+                           [](const LogEntry& a, const LogEntry& b)
+                           {
+                               return a.timestamp < b.timestamp;
+                           }));
+    REQUIRE(buffer.lateEntries() == 0);
+}
+
+TEST_CASE("ReorderBuffer - Holds entries until the watermark passes", "[ReorderBuffer][push]")
+{
+    ReorderBuffer buffer(std::chrono::seconds(30));
+    std::vector<LogEntry> released;
+
+    buffer.push(createEntry(0), released);
+    buffer.push(createEntry(20), released);
+    REQUIRE(released.empty());
+
+    // Watermark moves to 5 s: only the first entry is safe to release
+    buffer.push(createEntry(35), released);
+    REQUIRE(released.size() == 1);
+    REQUIRE(released[0].timestamp == createEntry(0).timestamp);
+
+    buffer.flush(released);
+    REQUIRE(released.size() == 3);
+    REQUIRE(buffer.peakSize() == 3);
+}
+
+TEST_CASE("ReorderBuffer - Counts and drops late entries", "[ReorderBuffer][push]")
+{
+    ReorderBuffer buffer(std::chrono::seconds(30));
+    auto released = reorder(buffer, {createEntry(100), createEntry(75), createEntry(60),
+                                     createEntry(69, "late"), createEntry(70)});
+
+    // The watermark is 70 s: 60 and 69 arrived too late, 70 is on time
+    REQUIRE(buffer.lateEntries() == 2);
+    REQUIRE(released.size() == 3);
+    for (const auto& entry : released)
+    {
+        REQUIRE(entry.username != "late");
+    }
+}
+
+TEST_CASE("ReorderBuffer - Equal timestamps keep input order", "[ReorderBuffer][push]")
+{
+    ReorderBuffer buffer(std::chrono::seconds(5));
+    auto released = reorder(buffer, {createEntry(3, "a"), createEntry(1, "b"), createEntry(3, "c"),
+                                     createEntry(1, "d"), createEntry(3, "e")});
+
+    std::vector<std::string> users;
+    for (const auto& entry : released)
+    {
+        users.push_back(entry.username);
+    }
+    REQUIRE(users == std::vector<std::string>{"b", "d", "a", "c", "e"});
+}
+
+TEST_CASE("ReorderBuffer - Jittered input matches a full sort", "[ReorderBuffer][flush]")
+{
+    // Timestamps in order, each moved by up to 60 seconds
+    std::mt19937 random(11);
+    std::vector<LogEntry> entries;
+    for (int i = 0; i < 5000; ++i)
+    {
+        long long jitter = static_cast<long long>(random() % 121) - 60;
+        entries.push_back(createEntry(i * 5 + jitter, "user" + std::to_string(i)));
+    }
+
+    std::vector<LogEntry> sorted = entries;
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const LogEntry& a, const LogEntry& b)
+                     {
+                         return a.timestamp < b.timestamp;
+                     });
+
+    ReorderBuffer buffer(std::chrono::seconds(120));
+    auto released = reorder(buffer, entries);
+
+    REQUIRE(buffer.lateEntries() == 0);
+    REQUIRE(buffer.peakSize() < 100);
+    REQUIRE(released.size() == sorted.size());
+    for (std::size_t i = 0; i < sorted.size(); ++i)
+    {
+        REQUIRE(released[i].username == sorted[i].username);
+    }
+}
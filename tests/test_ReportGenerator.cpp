@@ -12,6 +12,9 @@
  * These tests verify correct report generation including:
  * - Headers and footers
  * - Summary statistics
+ * - Top activity rankings
+ * - Rate spike windows
+ * - Risk score rankings
  * - Anomaly details
  * - File output
  * - Edge cases (empty logs, no anomalies)
@@ -256,6 +259,287 @@ TEST_CASE("ReportGenerator - Report header includes generation time", "[ReportGe
     REQUIRE(report.find("202") != std::string::npos);
 }
 
+TEST_CASE("ReportGenerator - Report includes attached parse diagnostics", "[ReportGenerator][generateReport]") 
+{
+    ReportGenerator generator;
+    ParseDiagnostics diagnostics;
+    diagnostics.record(LogParser::ParseError::BAD_TIMESTAMP, 7, "yesterday | a | b | FAILED");
+    generator.setParseDiagnostics(&diagnostics);
+    
+    std::vector<LogEntry> entries;
+    std::vector<SuspiciousEvent> events;
+    std::ostringstream output;
+    
+    generator.generateReport(entries, events, output);
+    
+    std::string report = output.str();
+    REQUIRE(report.find("PARSE DIAGNOSTICS") != std::string::npos);
+    REQUIRE(report.find("Bad timestamp: 1") != std::string::npos);
+    REQUIRE(report.find("line 7") != std::string::npos);
+}
+
+TEST_CASE("ReportGenerator - Top activity section when attached", "[ReportGenerator][generateReport]") 
+{
+    ReportGenerator generator;
+    TopActivity top_activity(2);
+    
+    std::vector<LogEntry> entries = 
+    {
+        LogEntry(createTestTimestamp(10, 0), "alice", "192.168.1.1", LoginStatus::SUCCESS),
+        LogEntry(createTestTimestamp(10, 1), "bob", "10.0.0.9", LoginStatus::FAILED),
+        LogEntry(createTestTimestamp(10, 2), "bob", "10.0.0.9", LoginStatus::FAILED),
+        LogEntry(createTestTimestamp(10, 3), "carol", "10.0.0.9", LoginStatus::FAILED)
+    };
+    for (const auto& entry : entries) 
+    {
+        top_activity.add(entry);
+    }
+    generator.setTopActivity(&top_activity);
+    
+    std::vector<SuspiciousEvent> events;
+    std::ostringstream output;
+    generator.generateReport(entries, events, output);
+    
+    std::string report = output.str();
+    REQUIRE(report.find("TOP ACTIVITY") != std::string::npos);
+    REQUIRE(report.find("Most Failing IP Addresses:\n  1. 10.0.0.9: 3\n") != std::string::npos);
+    REQUIRE(report.find("Most Targeted Users:\n  1. bob: 2\n  2. carol: 1\n") != std::string::npos);
+    REQUIRE(report.find("Most Active Users:\n  1. bob: 2\n  2. alice: 1\n") != std::string::npos);
+}
+
+TEST_CASE("ReportGenerator - Top activity omitted when disabled", "[ReportGenerator][generateReport]") 
+{
+    ReportGenerator generator;
+    TopActivity top_activity(0);
+    top_activity.add(LogEntry(createTestTimestamp(10, 0), "alice", "192.168.1.1", LoginStatus::FAILED));
+    generator.setTopActivity(&top_activity);
+    
+    std::vector<LogEntry> entries;
+    std::vector<SuspiciousEvent> events;
+    std::ostringstream output;
+    generator.generateReport(entries, events, output);
+    
+    REQUIRE(output.str().find("TOP ACTIVITY") == std::string::npos);
+}
+
+TEST_CASE("ReportGenerator - Rate spikes section when attached", "[ReportGenerator][generateReport]") 
+{
+    ReportGenerator generator;
+    RateMonitor rate_monitor(2, 4.0);
+    
+    // An hour of one failure per minute, then a burst of 30 in one minute
+    std::vector<LogEntry> entries;
+    for (int minute = 0; minute < 60; ++minute) 
+    {
+        entries.push_back(LogEntry(createTestTimestamp(9, minute), "bob", "10.0.0.9", LoginStatus::FAILED));
+    }
+    for (int attempt = 0; attempt < 30; ++attempt) 
+    {
+        entries.push_back(LogEntry(createTestTimestamp(10, 0), "bob", "10.0.0.9", LoginStatus::FAILED));
+    }
+    for (const auto& entry : entries) 
+    {
+        rate_monitor.add(entry);
+    }
+    rate_monitor.finish();
+    generator.setRateMonitor(&rate_monitor);
+    
+    std::vector<SuspiciousEvent> events;
+    std::ostringstream output;
+    generator.generateReport(entries, events, output);
+    
+    std::string report = output.str();
+    REQUIRE(report.find("RATE SPIKES") != std::string::npos);
+    REQUIRE(report.find("all entries:\n  2026-01-18 10:00:00 to 2026-01-18 10:01:00, "
+                        "30 failed and 0 successful logins (peak 30/min, expected 1.0/min") != std::string::npos);
+    REQUIRE(report.find("by IP address:\n  10.0.0.9: 2026-01-18 10:00:00") != std::string::npos);
+    REQUIRE(report.find("by username:\n  bob: 2026-01-18 10:00:00") != std::string::npos);
+}
+
+TEST_CASE("ReportGenerator - Rate spikes omitted when disabled", "[ReportGenerator][generateReport]") 
+{
+    ReportGenerator generator;
+    RateMonitor rate_monitor(2, 0.0);
+    rate_monitor.add(LogEntry(createTestTimestamp(10, 0), "alice", "192.168.1.1", LoginStatus::FAILED));
+    rate_monitor.finish();
+    generator.setRateMonitor(&rate_monitor);
+    
+    std::vector<LogEntry> entries;
+    std::vector<SuspiciousEvent> events;
+    std::ostringstream output;
+    generator.generateReport(entries, events, output);
+    
+    REQUIRE(output.str().find("RATE SPIKES") == std::string::npos);
+}
+
+TEST_CASE("ReportGenerator - Risk scores section when attached", "[ReportGenerator][generateReport]") 
+{
+    ReportGenerator generator;
+    RiskScorer risk_scorer(5);
+    SuspiciousEvent event(SuspiciousEventType::MULTIPLE_FAILED_LOGINS, "alice", "192.168.1.1",
+                          createTestTimestamp(10, 0), createTestTimestamp(10, 5), 10);
+    risk_scorer.add(event);
+    generator.setRiskScorer(&risk_scorer);
+    
+    std::vector<LogEntry> entries;
+    std::vector<SuspiciousEvent> events = {event};
+    std::ostringstream output;
+    generator.generateReport(entries, events, output);
+    
+    std::string report = output.str();
+    REQUIRE(report.find("RISK SCORES") != std::string::npos);
+    REQUIRE(report.find("Riskiest users (of 1 scored):\n"
+                        "  1. alice: 30.0 (1 event, last 2026-01-18 10:05:00)\n"
+                        "     Multiple Failed Login Attempts x1\n") != std::string::npos);
+    REQUIRE(report.find("Riskiest IP addresses (of 1 scored):\n  1. 192.168.1.1: 30.0") != std::string::npos);
+    
+    // Ranked before the detailed events
+    REQUIRE(report.find("RISK SCORES") < report.find("DETECTED ANOMALIES"));
+}
+
+TEST_CASE("ReportGenerator - Risk scores omitted when disabled", "[ReportGenerator][generateReport]") 
+{
+    ReportGenerator generator;
+    RiskScorer risk_scorer(0);
+    generator.setRiskScorer(&risk_scorer);
+    
+    std::vector<LogEntry> entries;
+    std::vector<SuspiciousEvent> events;
+    std::ostringstream output;
+    generator.generateReport(entries, events, output);
+    
+    REQUIRE(output.str().find("RISK SCORES") == std::string::npos);
+}
+
+TEST_CASE("ReportGenerator - Threshold sweep section when attached", "[ReportGenerator][generateReport]") 
+{
+    ReportGenerator generator;
+    ThresholdSweep sweep({2, 3}, {5});
+    sweep.add({LogEntry(createTestTimestamp(10, 0), "alice", "192.168.1.1", LoginStatus::FAILED), 
+               LogEntry(createTestTimestamp(10, 1), "alice", "192.168.1.1", LoginStatus::FAILED)});
+    generator.setThresholdSweep(&sweep);
+    
+    std::vector<LogEntry> entries;
+    std::vector<SuspiciousEvent> events;
+    std::ostringstream output;
+    generator.generateReport(entries, events, output);
+    
+    std::string report = output.str();
+    REQUIRE(report.find("THRESHOLD SWEEP\n") != std::string::npos);
+    REQUIRE(report.find("          2      1\n          3      0\n") != std::string::npos);
+    REQUIRE(report.find("THRESHOLD SWEEP") < report.find("DETECTED ANOMALIES"));
+}
+
+TEST_CASE("ReportGenerator - Parse diagnostics omitted when not attached", "[ReportGenerator][generateReport]") 
+{
+    ReportGenerator generator;
+    std::vector<LogEntry> entries;
+    std::vector<SuspiciousEvent> events;
+    std::ostringstream output;
+    
+    generator.generateReport(entries, events, output);
+    
+    REQUIRE(output.str().find("PARSE DIAGNOSTICS") == std::string::npos);
+}
+
+TEST_CASE("ReportGenerator - Report from totals matches report from entries", "[ReportGenerator][generateReport]") 
+{
+    ReportGenerator generator;
+    
+    std::vector<LogEntry> entries = 
+    {
+        LogEntry(createTestTimestamp(10, 0), "alice", "192.168.1.1", LoginStatus::SUCCESS),
+        LogEntry(createTestTimestamp(11, 0), "bob", "192.168.1.2", LoginStatus::FAILED),
+        LogEntry(createTestTimestamp(12, 0), "bob", "192.168.1.2", LoginStatus::FAILED)
+    };
+    
+    ReportTotals totals;
+    for (const auto& entry : entries) 
+    {
+        totals.add(entry);
+    }
+    
+    REQUIRE(totals.total_entries == 3);
+    REQUIRE(totals.successful_logins == 1);
+    REQUIRE(totals.failed_logins == 2);
+    
+    std::vector<SuspiciousEvent> events;
+    std::ostringstream from_entries;
+    std::ostringstream from_totals;
+    generator.generateReport(entries, events, from_entries);
+    generator.generateReport(totals, events, from_totals);
+    
+    // Only the generation timestamp may differ
+    auto summary = [](const std::string& report) 
+    {
+        return report.substr(report.find("SUMMARY STATISTICS"));
+    };
+    REQUIRE(summary(from_totals.str()) == summary(from_entries.str()));
+}
+
+TEST_CASE("ReportGenerator - Report shows password spraying without a username", "[ReportGenerator][generateReport]") 
+{
+    ReportGenerator generator;
+    std::vector<LogEntry> entries = 
+    {
+        LogEntry(createTestTimestamp(9, 0), "user1", "203.0.113.5", LoginStatus::FAILED)
+    };
+    
+    SuspiciousEvent event(SuspiciousEventType::PASSWORD_SPRAYING, "", "203.0.113.5",
+                          createTestTimestamp(9, 0), createTestTimestamp(9, 5), 25);
+    std::vector<SuspiciousEvent> events = {event};
+    std::ostringstream output;
+    
+    generator.generateReport(entries, events, output);
+    
+    std::string report = output.str();
+    REQUIRE(report.find("Password Spraying") != std::string::npos);
+    REQUIRE(report.find("Username: N/A") != std::string::npos);
+    REQUIRE(report.find("203.0.113.5") != std::string::npos);
+}
+
+TEST_CASE("ReportGenerator - Report shows rule profiles", "[ReportGenerator][generateReport]") 
+{
+    ReportGenerator generator;
+    std::vector<LogEntry> entries = 
+    {
+        LogEntry(createTestTimestamp(9, 0), "alice", "192.168.1.1", LoginStatus::FAILED)
+    };
+    
+    SuspiciousEvent strict(SuspiciousEventType::MULTIPLE_FAILED_LOGINS, "alice", "192.168.1.1",
+                           createTestTimestamp(9, 0), createTestTimestamp(9, 5), 3);
+    strict.profile = "pci";
+    SuspiciousEvent lax = strict;
+    lax.profile = "sox";
+    std::vector<SuspiciousEvent> events = {strict, strict, lax};
+    std::ostringstream output;
+    
+    generator.generateReport(entries, events, output);
+    
+    std::string report = output.str();
+    REQUIRE(report.find("Suspicious Events Detected: 3\n"
+                        "  Profile 'pci': 2\n"
+                        "  Profile 'sox': 1\n") != std::string::npos);
+    REQUIRE(report.find("[3] Multiple Failed Login Attempts\n    Profile: sox\n") != std::string::npos);
+}
+
+TEST_CASE("ReportGenerator - Report shows late entries", "[ReportGenerator][generateReport]") 
+{
+    ReportGenerator generator;
+    ReportTotals totals;
+    totals.add(LogEntry(createTestTimestamp(9, 0), "alice", "192.168.1.1", LoginStatus::SUCCESS));
+    std::vector<SuspiciousEvent> events;
+    
+    std::ostringstream on_time;
+    generator.generateReport(totals, events, on_time);
+    REQUIRE(on_time.str().find("Late Entries Skipped") == std::string::npos);
+    
+    totals.late_entries = 7;
+    std::ostringstream late;
+    generator.generateReport(totals, events, late);
+    REQUIRE(late.str().find("Failed Logins: 0\nLate Entries Skipped: 7\n") != std::string::npos);
+}
+
 // ============================================================================
 // Tests for file output
 // ============================================================================
@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+#include "RiskScorer.h"
+#include <chrono>
+#include <cmath>
+#include <string>
+
+/**
+ * Unit tests for RiskScorer class
+ *
+ * These tests verify:
+ * - Points per event type, scaled by the event count
+ * - Users and every IP address of an event are scored
+ * - Events reported by several rule profiles are scored once
+ * - Decay by half every kHalfLifeHours, in any event order
+ * - Ranking by score with the top-N cut
+ * - Many distinct subjects (table growth)
+ * - Disabled scoring
+ */
+
+/**
+ * Helper function comparing scores
+ */
+bool isClose(double actual, double expected)
+{
+    return std::abs(actual - expected) < 1e-9;
+}
+
+/**
+ * Helper function creating an event ending a number of hours after a base time
+ */
+SuspiciousEvent createEvent(SuspiciousEventType type, const std::string& username,
+                            const std::string& ip, double hours, int count)
+{
+    auto base = std::chrono::system_clock::from_time_t(1768723200);   // 2026-01-18 08:00 UTC
+    auto time = base + std::chrono::seconds(static_cast<long long>(hours * 3600.0));
+    return SuspiciousEvent(type, username, ip, time, time, count);
+}
+
+// ============================================================================
+// Tests for add()
+// ============================================================================
+
+TEST_CASE("RiskScorer - Weighs event types and counts", "[RiskScorer][add]")
+{
+    RiskScorer scorer(10);
+    scorer.add(createEvent(SuspiciousEventType::MULTIPLE_FAILED_LOGINS, "alice", "10.0.0.1", 0, 100));
+    scorer.add(createEvent(SuspiciousEventType::SUCCESS_AFTER_FAILURES, "bob", "10.0.0.2", 0, 1));
+
+    auto users = scorer.topUsers();
+    REQUIRE(users.size() == 2);
+    REQUIRE(users[0].key == "alice");
+    REQUIRE(isClose(users[0].score, 15.0 * 3.0));   // 1 + log10(100)
+    REQUIRE(users[1].key == "bob");
+    REQUIRE(isClose(users[1].score, RiskScorer::weightOf(SuspiciousEventType::SUCCESS_AFTER_FAILURES)));
+
+    REQUIRE(users[0].events == 1);
+    REQUIRE(users[0].events_by_type[static_cast<std::size_t>(SuspiciousEventType::MULTIPLE_FAILED_LOGINS)] == 1);
+}
+
+TEST_CASE("RiskScorer - Scores the user and every IP address", "[RiskScorer][add]")
+{
+    RiskScorer scorer(10);
+    SuspiciousEvent event = createEvent(SuspiciousEventType::MULTIPLE_IP_ADDRESSES, "alice", "10.0.0.1", 0, 1);
+    event.ip_addresses.push_back("10.0.0.2");
+    scorer.add(event);
+
+    // Spraying events have no user
+    scorer.add(createEvent(SuspiciousEventType::PASSWORD_SPRAYING, "", "10.0.0.2", 0, 1));
+
+    REQUIRE(scorer.userCount() == 1);
+    REQUIRE(scorer.ipCount() == 2);
+
+    auto ips = scorer.topIps();
+    REQUIRE(ips[0].key == "10.0.0.2");
+    REQUIRE(isClose(ips[0].score, 10.0 + 25.0));
+    REQUIRE(ips[0].events == 2);
+    REQUIRE(ips[1].key == "10.0.0.1");
+}
+
+TEST_CASE("RiskScorer - Scores events of several profiles once", "[RiskScorer][add]")
+{
+    SuspiciousEvent strict = createEvent(SuspiciousEventType::MULTIPLE_FAILED_LOGINS, "alice", "10.0.0.1", 0, 10);
+    strict.profile = "strict";
+    SuspiciousEvent lax = strict;
+    lax.profile = "lax";
+
+    // The lax profile's longer window gives a different span: its own behaviour
+    SuspiciousEvent lax_longer = createEvent(SuspiciousEventType::MULTIPLE_FAILED_LOGINS, "alice", "10.0.0.1", 1, 10);
+    lax_longer.profile = "lax";
+
+    // Two equal events of one profile are two logins, not a duplicate
+    SuspiciousEvent night = createEvent(SuspiciousEventType::UNUSUAL_LOGIN_HOUR, "bob", "10.0.0.2", 0, 1);
+    night.profile = "strict";
+
+    RiskScorer scorer(10);
+    scorer.add(std::vector<SuspiciousEvent>{strict, lax, lax_longer, night, night});
+
+    auto users = scorer.topUsers();
+    REQUIRE(users.size() == 2);
+    REQUIRE(users[0].key == "alice");
+    REQUIRE(users[0].events == 2);
+    REQUIRE(users[1].key == "bob");
+    REQUIRE(users[1].events == 2);
+}
+
+TEST_CASE("RiskScorer - Older events count less, in any order", "[RiskScorer][add]")
+{
+    double half_life = RiskScorer::kHalfLifeHours;
+
+    RiskScorer in_order(10);
+    in_order.add(createEvent(SuspiciousEventType::DENYLISTED_IP, "alice", "10.0.0.1", 0, 1));
+    in_order.add(createEvent(SuspiciousEventType::DENYLISTED_IP, "alice", "10.0.0.1", half_life, 1));
+
+    RiskScorer reversed(10);
+    reversed.add(createEvent(SuspiciousEventType::DENYLISTED_IP, "alice", "10.0.0.1", half_life, 1));
+    reversed.add(createEvent(SuspiciousEventType::DENYLISTED_IP, "alice", "10.0.0.1", 0, 1));
+
+    REQUIRE(isClose(in_order.topUsers()[0].score, 40.0 + 20.0));
+    REQUIRE(isClose(reversed.topUsers()[0].score, 40.0 + 20.0));
+
+    // Everyone is ranked at the newest event of all
+    in_order.add(createEvent(SuspiciousEventType::DENYLISTED_IP, "bob", "10.0.0.2", 2 * half_life, 1));
+    auto users = in_order.topUsers();
+    REQUIRE(users[0].key == "bob");
+    REQUIRE(users[1].key == "alice");
+    REQUIRE(isClose(users[1].score, 30.0));
+}
+
+// ============================================================================
+// Tests for topUsers() and topIps()
+// ============================================================================
+
+TEST_CASE("RiskScorer - Ranks at most top N subjects", "[RiskScorer][top]")
+{
+    RiskScorer scorer(3);
+    for (int user = 0; user < 10000; ++user)
+    {
+        std::string name = "user" + std::to_string(user);
+        scorer.add(createEvent(SuspiciousEventType::LOGIN_OUTSIDE_BUSINESS_HOURS, name, "10.0.0.1", 0, 1));
+    }
+    for (int repeat = 0; repeat < 3; ++repeat)
+    {
+        scorer.add(createEvent(SuspiciousEventType::LOGIN_OUTSIDE_BUSINESS_HOURS, "user42", "10.0.0.9", 0, 1));
+    }
+
+    REQUIRE(scorer.userCount() == 10000);
+
+    auto users = scorer.topUsers();
+    REQUIRE(users.size() == 3);
+    REQUIRE(users[0].key == "user42");
+    REQUIRE(users[0].events == 4);
+    REQUIRE(users[1].key == "user0");   // Ties by name
+    REQUIRE(users[2].key == "user1");
+
+    auto ips = scorer.topIps();
+    REQUIRE(ips.size() == 2);
+    REQUIRE(ips[0].key == "10.0.0.1");
+}
+
+TEST_CASE("RiskScorer - Disabled scorer keeps nothing", "[RiskScorer][add]")
+{
+    RiskScorer scorer(0);
+    REQUIRE_FALSE(scorer.isEnabled());
+
+    scorer.add(createEvent(SuspiciousEventType::DENYLISTED_IP, "alice", "10.0.0.1", 0, 1));
+
+    REQUIRE(scorer.userCount() == 0);
+    REQUIRE(scorer.topUsers().empty());
+}
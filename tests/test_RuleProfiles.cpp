@@ -0,0 +1,192 @@
+#include <catch2/catch_test_macros.hpp>
+#include "RuleProfiles.h"
+#include "EventDetector.h"
+#include "LogEntry.h"
+#include <chrono>
+#include <ctime>
+#include <string>
+#include <vector>
+
+/**
+ * Unit tests for rule profiles and ProfiledDetector
+ *
+ * These tests verify:
+ * - Parsing of profile specifications and their defaults
+ * - Rejection of invalid names, keys and values
+ * - Each profile reports what a separate detector would, tagged
+ * - Password spraying per profile
+ * - Per-user detection plus sortEvents() matches detectAll()
+ */
+
+/**
+ * Helper function creating a local timestamp on 2026-01-18
+ */
+std::chrono::system_clock::time_point createTimestamp(int hour, int minute)
+{
+    std::tm tm = {};
+    tm.tm_year = 2026 - 1900;
+    tm.tm_mon = 0;
+    tm.tm_mday = 18;
+    tm.tm_hour = hour;
+    tm.tm_min = minute;
+    tm.tm_isdst = -1;
+    return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+}
+
+/**
+ * Helper function creating a profile from a specification
+ */
+RuleProfile createProfile(const std::string& spec)
+{
+    RuleProfile profile;
+    REQUIRE(parseRuleProfile(spec, profile));
+    return profile;
+}
+
+/**
+ * Helper function with failures of two users and an early login
+ */
+std::vector<LogEntry> createEntries()
+{
+    std::vector<LogEntry> entries;
+    for (int minute = 0; minute < 4; ++minute)
+    {
+        entries.emplace_back(createTimestamp(10, minute), "alice", "10.0.0.1", LoginStatus::FAILED);
+        entries.emplace_back(createTimestamp(10, minute), "bob", "10.0.0.2", LoginStatus::FAILED);
+    }
+    entries.emplace_back(createTimestamp(8, 30), "carol", "10.0.0.3", LoginStatus::SUCCESS);
+    return entries;
+}
+
+// ============================================================================
+// Tests for parseRuleProfile()
+// ============================================================================
+
+TEST_CASE("RuleProfiles - Parses name and settings", "[RuleProfiles][parseRuleProfile]")
+{
+    RuleProfile profile;
+    profile.time_window_minutes = 30;   // Inherited setting
+
+    REQUIRE(parseRuleProfile("pci:threshold=3,hours=9-17,spray=10,distributed=4", profile));
+    REQUIRE(profile.name == "pci");
+    REQUIRE(profile.failed_login_threshold == 3);
+    REQUIRE(profile.time_window_minutes == 30);
+    REQUIRE(profile.business_hour_start == 9);
+    REQUIRE(profile.business_hour_end == 17);
+    REQUIRE(profile.spray_user_threshold == 10);
+    REQUIRE(profile.distributed_ip_threshold == 4);
+
+    RuleProfile plain = createProfile("Default_1");
+    REQUIRE(plain.name == "Default_1");
+    REQUIRE(plain.failed_login_threshold == 5);
+}
+
+TEST_CASE("RuleProfiles - Rejects invalid specifications", "[RuleProfiles][parseRuleProfile]")
+{
+    RuleProfile profile;
+    profile.name = "unchanged";
+
+    REQUIRE_FALSE(parseRuleProfile("", profile));
+    REQUIRE_FALSE(parseRuleProfile(":threshold=3", profile));
+    REQUIRE_FALSE(parseRuleProfile("p c", profile));
+    REQUIRE_FALSE(parseRuleProfile("pci:", profile));
+    REQUIRE_FALSE(parseRuleProfile("pci:threshold", profile));
+    REQUIRE_FALSE(parseRuleProfile("pci:threshold=0", profile));
+    REQUIRE_FALSE(parseRuleProfile("pci:window=-5", profile));
+    REQUIRE_FALSE(parseRuleProfile("pci:hours=18-8", profile));
+    REQUIRE_FALSE(parseRuleProfile("pci:hours=9-24", profile));
+    REQUIRE_FALSE(parseRuleProfile("pci:spray=1", profile));
+    REQUIRE_FALSE(parseRuleProfile("pci:speed=900", profile));
+    REQUIRE(profile.name == "unchanged");
+}
+
+// ============================================================================
+// Tests for ProfiledDetector
+// ============================================================================
+
+TEST_CASE("RuleProfiles - Each profile reports with its own thresholds", "[RuleProfiles][detectAll]")
+{
+    std::vector<RuleProfile> profiles = {createProfile("strict:threshold=3,hours=9-17"),
+                                         createProfile("lax")};
+    ProfiledDetector detector(EventDetector(), profiles);
+    auto entries = createEntries();
+
+    auto events = detector.detectAll(entries);
+
+    // Two brute-force bursts and one early login for strict, nothing for lax
+    REQUIRE(events.size() == 3);
+    REQUIRE(events[0].profile == "strict");
+    REQUIRE(events[0].type == SuspiciousEventType::MULTIPLE_FAILED_LOGINS);
+    REQUIRE(events[0].username == "alice");
+    REQUIRE(events[1].username == "bob");
+    REQUIRE(events[2].type == SuspiciousEventType::LOGIN_OUTSIDE_BUSINESS_HOURS);
+    REQUIRE(events[2].username == "carol");
+
+    // Same events as a separate run with the strict thresholds
+    auto separate = EventDetector(3, 10, 9, 17).detectAll(entries);
+    REQUIRE(separate.size() == 3);
+    for (std::size_t i = 0; i < separate.size(); ++i)
+    {
+        REQUIRE(events[i].type == separate[i].type);
+        REQUIRE(events[i].username == separate[i].username);
+        REQUIRE(events[i].description == separate[i].description);
+    }
+}
+
+TEST_CASE("RuleProfiles - Password spraying per profile", "[RuleProfiles][detectAll]")
+{
+    std::vector<LogEntry> entries;
+    for (int user = 0; user < 6; ++user)
+    {
+        entries.emplace_back(createTimestamp(10, user), "user" + std::to_string(user),
+                             "10.9.9.9", LoginStatus::FAILED);
+    }
+
+    EventDetector base;
+    base.setEnabledRules(ruleBit(SuspiciousEventType::PASSWORD_SPRAYING));
+    ProfiledDetector detector(base, {createProfile("a:spray=5"), createProfile("b:spray=10"),
+                                     createProfile("c:spray=5,window=2")});
+
+    auto events = detector.detectAll(entries);
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0].profile == "a");
+    REQUIRE(events[0].type == SuspiciousEventType::PASSWORD_SPRAYING);
+    REQUIRE(events[0].event_count == 6);
+}
+
+TEST_CASE("RuleProfiles - Per-user runs sorted like detectAll", "[RuleProfiles][detectPerUser]")
+{
+    std::vector<RuleProfile> profiles = {createProfile("b:threshold=2"), createProfile("a:threshold=4")};
+    EventDetector base;
+    base.setInputTimeOrdered(true);
+    ProfiledDetector detector(base, profiles);
+    auto entries = createEntries();
+
+    std::vector<SuspiciousEvent> events;
+    for (const char* user : {"bob", "carol", "alice"})
+    {
+        std::vector<LogEntry> user_entries;
+        for (const auto& entry : entries)
+        {
+            if (entry.username == user)
+            {
+                user_entries.push_back(entry);
+            }
+        }
+        auto user_events = detector.detectPerUser(user_entries);
+        events.insert(events.end(), user_events.begin(), user_events.end());
+    }
+    detector.sortEvents(events);
+
+    auto all = detector.detectAll(entries);
+    REQUIRE(events.size() == all.size());
+    REQUIRE(all.size() == 4);   // Two bursts per profile; 8:30 is within business hours
+    for (std::size_t i = 0; i < all.size(); ++i)
+    {
+        REQUIRE(events[i].profile == all[i].profile);
+        REQUIRE(events[i].type == all[i].type);
+        REQUIRE(events[i].username == all[i].username);
+    }
+    REQUIRE(all.front().profile == "b");   // Profiles in the given order
+    REQUIRE(all.back().profile == "a");
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch_test_macros.hpp>
+#include "SlidingDistinctCounter.h"
+#include <chrono>
+#include <string>
+
+/**
+ * Unit tests for SlidingDistinctCounter class
+ * 
+ * These tests verify:
+ * - Exact counting of small sets, ignoring duplicates
+ * - Values leaving the window stop counting
+ * - Estimate accuracy after switching to the sketch
+ * - Expiry of sketched values
+ */
+
+using namespace std::chrono;
+
+/**
+ * Helper function to create a timestamp a number of seconds after a fixed base
+ */
+system_clock::time_point atSecond(int second) 
+{
+    return system_clock::time_point(seconds(1768723200 + second));
+}
+
+/**
+ * Helper function to check an estimate against a relative error bound
+ */
+bool isWithin(size_t estimate, size_t expected, double relative_error) 
+{
+    double difference = static_cast<double>(estimate) - static_cast<double>(expected);
+    if (difference < 0) 
+    {
+        difference = -difference;
+    }
+    return difference <= relative_error * static_cast<double>(expected);
+}
+
+// ============================================================================
+// Tests for exact counting
+// ============================================================================
+
+TEST_CASE("SlidingDistinctCounter - Counts small sets exactly", "[SlidingDistinctCounter][estimate]") 
+{
+    SlidingDistinctCounter counter(minutes(10));
+    REQUIRE(counter.estimate() == 0);
+    
+    for (int i = 0; i < 100; ++i) 
+    {
+        counter.add("10.0.0." + std::to_string(i % 50), atSecond(i));
+    }
+    
+    REQUIRE(counter.isExact());
+    REQUIRE(counter.estimate() == 50);
+}
+
+TEST_CASE("SlidingDistinctCounter - Values leave the window", "[SlidingDistinctCounter][estimate]") 
+{
+    SlidingDistinctCounter counter(seconds(60));
+    
+    counter.add("10.0.0.1", atSecond(0));
+    counter.add("10.0.0.2", atSecond(10));
+    counter.add("10.0.0.3", atSecond(30));
+    REQUIRE(counter.estimate() == 3);
+    
+    // Seeing 10.0.0.1 again keeps it; 10.0.0.2 expires at second 70
+    counter.add("10.0.0.1", atSecond(50));
+    counter.add("10.0.0.4", atSecond(70));
+    REQUIRE(counter.estimate() == 3);
+    
+    counter.add("10.0.0.4", atSecond(200));
+    REQUIRE(counter.estimate() == 1);
+}
+
+// ============================================================================
+// Tests for sketch mode
+// ============================================================================
+
+TEST_CASE("SlidingDistinctCounter - Switches to the sketch beyond the exact limit", "[SlidingDistinctCounter][estimate]") 
+{
+    SlidingDistinctCounter counter(minutes(10));
+    
+    for (int i = 0; i < 5000; ++i) 
+    {
+        counter.add("ip" + std::to_string(i), atSecond(i / 10));
+    }
+    
+    REQUIRE_FALSE(counter.isExact());
+    REQUIRE(isWithin(counter.estimate(), 5000, 0.2));
+}
+
+TEST_CASE("SlidingDistinctCounter - Sketched values leave the window", "[SlidingDistinctCounter][estimate]") 
+{
+    SlidingDistinctCounter counter(seconds(100));
+    
+    // 10 new values per second: the window holds about 1000 at any time
+    for (int i = 0; i < 5000; ++i) 
+    {
+        counter.add("ip" + std::to_string(i), atSecond(i / 10));
+    }
+    
+    REQUIRE_FALSE(counter.isExact());
+    REQUIRE(isWithin(counter.estimate(), 1000, 0.25));
+    
+    // Long after the burst only the latest value remains
+    counter.add("ip0", atSecond(10000));
+    REQUIRE(counter.estimate() <= 2);
+    
+    counter.clear();
+    REQUIRE(counter.isExact());
+    REQUIRE(counter.estimate() == 0);
+}
@@ -0,0 +1,198 @@
+#include <catch2/catch_test_macros.hpp>
+#include "ThresholdSweep.h"
+#include "EventDetector.h"
+#include "LogEntry.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Unit tests for ThresholdSweep class
+ *
+ * These tests verify:
+ * - Grid parsing (lists, ranges, defaults, errors)
+ * - Counts equal the brute-force events of separate detector runs
+ * - Window boundaries in whole minutes
+ * - Per-user and combined input give the same counts
+ * - Matrix output
+ */
+
+/**
+ * Helper function creating a failed login a number of seconds after a base time
+ */
+LogEntry createFailure(const std::string& username, long long seconds)
+{
+    auto base = std::chrono::system_clock::from_time_t(1768723200);   // 2026-01-18 08:00 UTC
+    return LogEntry(base + std::chrono::seconds(seconds), username, "10.0.0.1", LoginStatus::FAILED);
+}
+
+/**
+ * Helper function creating random failures of a few users, in random order
+ */
+std::vector<LogEntry> createRandomFailures(unsigned seed)
+{
+    std::mt19937 random(seed);
+    std::vector<LogEntry> entries;
+    for (int i = 0; i < 3000; ++i)
+    {
+        std::string username = "user" + std::to_string(random() % 20);
+        entries.push_back(createFailure(username, static_cast<long long>(random() % (6 * 3600))));
+    }
+    entries.emplace_back(entries.front().timestamp, "alice", "10.0.0.2", LoginStatus::SUCCESS);
+    return entries;
+}
+
+// ============================================================================
+// Tests for parseGrid()
+// ============================================================================
+
+TEST_CASE("ThresholdSweep - Parses lists and ranges", "[ThresholdSweep][parseGrid]")
+{
+    std::vector<int> thresholds = {5};
+    std::vector<int> windows = {10};
+
+    REQUIRE(ThresholdSweep::parseGrid("threshold=3..6,10 window=30,1,5,5", thresholds, windows));
+    REQUIRE(thresholds == std::vector<int>{3, 4, 5, 6, 10});
+    REQUIRE(windows == std::vector<int>{1, 5, 30});
+
+    // An axis left out keeps its value
+    thresholds = {5};
+    windows = {10};
+    REQUIRE(ThresholdSweep::parseGrid("window=1..3", thresholds, windows));
+    REQUIRE(thresholds == std::vector<int>{5});
+    REQUIRE(windows == std::vector<int>{1, 2, 3});
+
+    REQUIRE(ThresholdSweep::parseGrid("threshold=2;window=4", thresholds, windows));
+    REQUIRE(thresholds == std::vector<int>{2});
+    REQUIRE(windows == std::vector<int>{4});
+}
+
+TEST_CASE("ThresholdSweep - Rejects invalid grids", "[ThresholdSweep][parseGrid]")
+{
+    std::vector<int> thresholds = {5};
+    std::vector<int> windows = {10};
+
+    REQUIRE_FALSE(ThresholdSweep::parseGrid("", thresholds, windows));
+    REQUIRE_FALSE(ThresholdSweep::parseGrid("threshold", thresholds, windows));
+    REQUIRE_FALSE(ThresholdSweep::parseGrid("threshold=0..3", thresholds, windows));
+    REQUIRE_FALSE(ThresholdSweep::parseGrid("threshold=5..3", thresholds, windows));
+    REQUIRE_FALSE(ThresholdSweep::parseGrid("threshold=1..1000000", thresholds, windows));
+    REQUIRE_FALSE(ThresholdSweep::parseGrid("window=5,", thresholds, windows));
+    REQUIRE_FALSE(ThresholdSweep::parseGrid("threshold=3 speed=900", thresholds, windows));
+    REQUIRE(thresholds == std::vector<int>{5});
+    REQUIRE(windows == std::vector<int>{10});
+}
+
+// ============================================================================
+// Tests for add() and addUser()
+// ============================================================================
+
+TEST_CASE("ThresholdSweep - Counts match separate detector runs", "[ThresholdSweep][add]")
+{
+    std::vector<int> thresholds = {2, 3, 5, 8, 13, 40};
+    std::vector<int> windows = {1, 5, 10, 30};
+    auto entries = createRandomFailures(42);
+
+    ThresholdSweep sweep(thresholds, windows);
+    sweep.add(entries);
+
+    for (std::size_t w = 0; w < windows.size(); ++w)
+    {
+        for (std::size_t t = 0; t < thresholds.size(); ++t)
+        {
+            EventDetector detector(thresholds[t], windows[w], 8, 18);
+            auto events = detector.detectMultipleFailedLogins(entries);
+
+            std::vector<std::string> users;
+            for (const auto& event : events)
+            {
+                if (std::find(users.begin(), users.end(), event.username) == users.end())
+                {
+                    users.push_back(event.username);
+                }
+            }
+
+            REQUIRE(sweep.eventCount(t, w) == events.size());
+            REQUIRE(sweep.userCount(t, w) == users.size());
+        }
+    }
+}
+
+TEST_CASE("ThresholdSweep - Windows end after whole minutes", "[ThresholdSweep][add]")
+{
+    ThresholdSweep sweep({2}, {1});
+
+    // 119 seconds apart is within 1 minute (truncated), 120 is not
+    sweep.add({createFailure("alice", 0), createFailure("alice", 119),
+               createFailure("bob", 0), createFailure("bob", 120)});
+
+    REQUIRE(sweep.eventCount(0, 0) == 1);
+    REQUIRE(sweep.userCount(0, 0) == 1);
+}
+
+TEST_CASE("ThresholdSweep - Per-user input matches combined input", "[ThresholdSweep][addUser]")
+{
+    std::vector<int> thresholds = {3, 10};
+    std::vector<int> windows = {5, 60};
+    auto entries = createRandomFailures(7);
+
+    ThresholdSweep combined(thresholds, windows);
+    combined.add(entries);
+
+    ThresholdSweep per_user(thresholds, windows);
+    for (int user = 0; user < 20; ++user)
+    {
+        std::vector<LogEntry> user_entries;
+        for (const auto& entry : entries)
+        {
+            if (entry.username == "user" + std::to_string(user))
+            {
+                user_entries.push_back(entry);
+            }
+        }
+        per_user.addUser(user_entries);
+    }
+
+    for (std::size_t w = 0; w < windows.size(); ++w)
+    {
+        for (std::size_t t = 0; t < thresholds.size(); ++t)
+        {
+            REQUIRE(per_user.eventCount(t, w) == combined.eventCount(t, w));
+            REQUIRE(per_user.userCount(t, w) == combined.userCount(t, w));
+        }
+    }
+}
+
+// ============================================================================
+// Tests for writeMatrix()
+// ============================================================================
+
+TEST_CASE("ThresholdSweep - Writes count matrices", "[ThresholdSweep][writeMatrix]")
+{
+    ThresholdSweep sweep({3, 2}, {10, 1});
+    REQUIRE(sweep.isEnabled());
+    REQUIRE(sweep.thresholds() == std::vector<int>{2, 3});
+    REQUIRE(sweep.windows() == std::vector<int>{1, 10});
+
+    sweep.add({createFailure("alice", 0), createFailure("alice", 60), createFailure("alice", 300)});
+
+    std::ostringstream output;
+    sweep.writeMatrix(output);
+
+    REQUIRE(output.str() ==
+            "Multiple failed login events by threshold (rows) and window (columns):\n"
+            "  threshold   1 min  10 min\n"
+            "          2       1       1\n"
+            "          3       0       1\n"
+            "\n"
+            "Users with such events:\n"
+            "  threshold   1 min  10 min\n"
+            "          2       1       1\n"
+            "          3       0       1\n");
+
+    ThresholdSweep disabled({}, {});
+    REQUIRE_FALSE(disabled.isEnabled());
+}